@@ -12,6 +12,8 @@
 #define NULL_THREAD         (sgl_osal_thread_t)(0)
 #define EXIT_ROUTINE        return SGL_NULL;
 
+#define SGL_OSAL_MAX_NUMA_NODES     (64)
+
 typedef sgl_uintptr_t       sgl_osal_thread_t;
 typedef void*               sgl_osal_thread_return_t;
 typedef void*               sgl_osal_thread_arg_t;
@@ -20,6 +22,11 @@ typedef sgl_uintptr_t       sgl_osal_spinlock_t;
 typedef sgl_uintptr_t       sgl_osal_mutex_t;
 typedef sgl_uintptr_t       sgl_osal_cond_t;
 typedef sgl_uint32_t        sgl_osal_atomic_uint32_t;
+typedef sgl_int32_t         sgl_osal_atomic_int32_t;
+typedef sgl_uint64_t        sgl_osal_atomic_uint64_t;
+typedef sgl_uintptr_t       sgl_osal_wait_queue_t;
+typedef sgl_uintptr_t       sgl_osal_thread_key_t;
+typedef void (*sgl_osal_thread_key_destructor_t)(void *value);
 
 static SGL_ALWAYS_INLINE sgl_uint32_t sgl_osal_atomic_uint32_load_acquire(
     const sgl_osal_atomic_uint32_t *value)
@@ -27,6 +34,19 @@ static SGL_ALWAYS_INLINE sgl_uint32_t sgl_osal_atomic_uint32_load_acquire(
     return *value;
 }
 
+static SGL_ALWAYS_INLINE sgl_uint32_t sgl_osal_atomic_uint32_load_relaxed(
+    const sgl_osal_atomic_uint32_t *value)
+{
+    return *value;
+}
+
+static SGL_ALWAYS_INLINE void sgl_osal_atomic_uint32_store_relaxed(
+    sgl_osal_atomic_uint32_t *value,
+    sgl_uint32_t desired)
+{
+    *value = desired;
+}
+
 static SGL_ALWAYS_INLINE sgl_uint32_t sgl_osal_atomic_uint32_increment_release(
     sgl_osal_atomic_uint32_t *value)
 {
@@ -34,6 +54,127 @@ static SGL_ALWAYS_INLINE sgl_uint32_t sgl_osal_atomic_uint32_increment_release(
     return *value;
 }
 
+static SGL_ALWAYS_INLINE sgl_uint32_t sgl_osal_atomic_uint32_fetch_increment_relaxed(
+    sgl_osal_atomic_uint32_t *value)
+{
+    sgl_uint32_t previous = *value;
+
+    *value += 1U;
+    return previous;
+}
+
+static SGL_ALWAYS_INLINE sgl_uint32_t sgl_osal_atomic_uint32_fetch_add_relaxed(
+    sgl_osal_atomic_uint32_t *value,
+    sgl_uint32_t addend)
+{
+    sgl_uint32_t previous = *value;
+
+    *value += addend;
+    return previous;
+}
+
+static SGL_ALWAYS_INLINE sgl_uint32_t sgl_osal_atomic_uint32_fetch_sub_relaxed(
+    sgl_osal_atomic_uint32_t *value,
+    sgl_uint32_t subtrahend)
+{
+    sgl_uint32_t previous = *value;
+
+    *value -= subtrahend;
+    return previous;
+}
+
+static SGL_ALWAYS_INLINE sgl_uint64_t sgl_osal_atomic_uint64_load_relaxed(
+    const sgl_osal_atomic_uint64_t *value)
+{
+    return *value;
+}
+
+static SGL_ALWAYS_INLINE void sgl_osal_atomic_uint64_add_relaxed(
+    sgl_osal_atomic_uint64_t *value,
+    sgl_uint64_t addend)
+{
+    *value += addend;
+}
+
+static SGL_ALWAYS_INLINE sgl_uint64_t sgl_osal_atomic_uint64_load_acquire(
+    const sgl_osal_atomic_uint64_t *value)
+{
+    return *value;
+}
+
+static SGL_ALWAYS_INLINE void sgl_osal_atomic_uint64_store_relaxed(
+    sgl_osal_atomic_uint64_t *value,
+    sgl_uint64_t desired)
+{
+    *value = desired;
+}
+
+static SGL_ALWAYS_INLINE void sgl_osal_atomic_uint64_store_release(
+    sgl_osal_atomic_uint64_t *value,
+    sgl_uint64_t desired)
+{
+    *value = desired;
+}
+
+static SGL_ALWAYS_INLINE sgl_bool_t sgl_osal_atomic_uint64_compare_exchange_relaxed(
+    sgl_osal_atomic_uint64_t *value,
+    sgl_uint64_t expected,
+    sgl_uint64_t desired)
+{
+    sgl_bool_t result = SGL_FALSE;
+
+    if (*value == expected) {
+        *value = desired;
+        result = SGL_TRUE;
+    }
+
+    return result;
+}
+
+static SGL_ALWAYS_INLINE sgl_int32_t sgl_osal_atomic_int32_load_relaxed(
+    const sgl_osal_atomic_int32_t *value)
+{
+    return *value;
+}
+
+static SGL_ALWAYS_INLINE sgl_int32_t sgl_osal_atomic_int32_load_acquire(
+    const sgl_osal_atomic_int32_t *value)
+{
+    return *value;
+}
+
+static SGL_ALWAYS_INLINE void sgl_osal_atomic_int32_store_relaxed(
+    sgl_osal_atomic_int32_t *value,
+    sgl_int32_t desired)
+{
+    *value = desired;
+}
+
+static SGL_ALWAYS_INLINE sgl_bool_t sgl_osal_atomic_int32_compare_exchange(
+    sgl_osal_atomic_int32_t *value,
+    sgl_int32_t expected,
+    sgl_int32_t desired)
+{
+    sgl_bool_t result = SGL_FALSE;
+
+    if (*value == expected) {
+        *value = desired;
+        result = SGL_TRUE;
+    }
+
+    return result;
+}
+
+static SGL_ALWAYS_INLINE void sgl_osal_atomic_thread_fence(void)
+{
+}
+
+/* Clock */
+static SGL_ALWAYS_INLINE sgl_uint64_t sgl_osal_get_monotonic_ns(void)
+{
+    return 0U;
+}
+
 /* Thread */
 static SGL_ALWAYS_INLINE sgl_osal_thread_t sgl_thread_create(sgl_osal_thread_entry_t start_routine, sgl_osal_thread_arg_t arg)
 {
@@ -52,6 +193,28 @@ static SGL_ALWAYS_INLINE void sgl_osal_thread_exit(sgl_osal_thread_return_t retv
     SGL_UNUSED(retval);
 }
 
+/* Thread-exit hook; there are no other threads to exit. */
+static SGL_ALWAYS_INLINE sgl_bool_t sgl_osal_thread_key_create(
+    sgl_osal_thread_key_t *key,
+    sgl_osal_thread_key_destructor_t destructor)
+{
+    SGL_UNUSED(destructor);
+    *key = 0U;
+    return SGL_TRUE;
+}
+
+static SGL_ALWAYS_INLINE void sgl_osal_thread_key_delete(sgl_osal_thread_key_t key)
+{
+    SGL_UNUSED(key);
+}
+
+static SGL_ALWAYS_INLINE sgl_bool_t sgl_osal_thread_key_set(sgl_osal_thread_key_t key, void *value)
+{
+    SGL_UNUSED(key);
+    SGL_UNUSED(value);
+    return SGL_TRUE;
+}
+
 /* Spinlock */
 static SGL_ALWAYS_INLINE void sgl_osal_spinlock_init(sgl_osal_spinlock_t *spinlock)
 {
@@ -92,6 +255,13 @@ static SGL_ALWAYS_INLINE void sgl_osal_mutex_lock(sgl_osal_mutex_t *mutex)
     SGL_UNUSED(mutex);
 }
 
+static SGL_ALWAYS_INLINE sgl_bool_t sgl_osal_mutex_try_lock(sgl_osal_mutex_t *mutex)
+{
+    SGL_UNUSED(mutex);
+
+    return SGL_TRUE;
+}
+
 static SGL_ALWAYS_INLINE void sgl_osal_mutex_unlock(sgl_osal_mutex_t *mutex)
 {
     SGL_UNUSED(mutex);
@@ -129,9 +299,88 @@ static SGL_ALWAYS_INLINE void sgl_osal_cond_destroy(sgl_osal_cond_t *cond)
     SGL_UNUSED(cond);
 }
 
+/* Wait on address */
+#define SGL_OSAL_WAKE_ALL   (0x7FFFFFFF)
+
+static SGL_ALWAYS_INLINE void sgl_osal_wait_queue_init(sgl_osal_wait_queue_t *queue)
+{
+    SGL_UNUSED(queue);
+}
+
+static SGL_ALWAYS_INLINE void sgl_osal_wait_queue_destroy(sgl_osal_wait_queue_t *queue)
+{
+    SGL_UNUSED(queue);
+}
+
+static SGL_ALWAYS_INLINE void sgl_osal_wait_on_address(
+    sgl_osal_wait_queue_t *queue,
+    const sgl_osal_atomic_uint32_t *address,
+    sgl_uint32_t expected)
+{
+    SGL_UNUSED(queue);
+    SGL_UNUSED(address);
+    SGL_UNUSED(expected);
+}
+
+static SGL_ALWAYS_INLINE void sgl_osal_wait_on_address_for(
+    sgl_osal_wait_queue_t *queue,
+    const sgl_osal_atomic_uint32_t *address,
+    sgl_uint32_t expected,
+    sgl_uint64_t timeout_ns)
+{
+    SGL_UNUSED(queue);
+    SGL_UNUSED(address);
+    SGL_UNUSED(expected);
+    SGL_UNUSED(timeout_ns);
+}
+
+static SGL_ALWAYS_INLINE void sgl_osal_wake_address(
+    sgl_osal_wait_queue_t *queue,
+    sgl_osal_atomic_uint32_t *address,
+    sgl_int32_t count)
+{
+    SGL_UNUSED(queue);
+    SGL_UNUSED(address);
+    SGL_UNUSED(count);
+}
+
 static SGL_ALWAYS_INLINE void sgl_osal_yield_thread(void)
 {
     /* NOP */
 }
 
+static SGL_ALWAYS_INLINE sgl_bool_t sgl_osal_thread_get_affinity(
+    sgl_uint64_t *mask,
+    sgl_size_t words)
+{
+    SGL_UNUSED(mask);
+    SGL_UNUSED(words);
+    return SGL_FALSE;
+}
+
+static SGL_ALWAYS_INLINE sgl_bool_t sgl_osal_thread_set_affinity(
+    const sgl_uint64_t *mask,
+    sgl_size_t words)
+{
+    SGL_UNUSED(mask);
+    SGL_UNUSED(words);
+    return SGL_FALSE;
+}
+
+static SGL_ALWAYS_INLINE sgl_int32_t sgl_osal_get_current_numa_node(void)
+{
+    return -1;
+}
+
+static SGL_ALWAYS_INLINE sgl_int32_t sgl_osal_get_cpu_numa_node(sgl_int32_t cpu)
+{
+    SGL_UNUSED(cpu);
+    return -1;
+}
+
+static SGL_ALWAYS_INLINE sgl_size_t sgl_osal_get_cpu_quota(void)
+{
+    return 0U;
+}
+
 #endif  /* !SGL_OSAL_DUMMY_H_ */
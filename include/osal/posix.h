@@ -10,10 +10,20 @@
 #define SGL_OSAL_POSIX_H_
 
 #include <pthread.h>
+#include <sched.h>
+#include <time.h>
+#if defined(__linux__)
+#include <stdio.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+#endif  /* !__linux__ */
 
 #define NULL_THREAD     (sgl_osal_thread_t)(0)
 #define EXIT_ROUTINE    return SGL_NULL;
 
+#define SGL_OSAL_MAX_NUMA_NODES     (64)
+
 typedef pthread_t           sgl_osal_thread_t;
 typedef void*               sgl_osal_thread_return_t;
 typedef void*               sgl_osal_thread_arg_t;
@@ -21,7 +31,25 @@ typedef sgl_osal_thread_return_t(*sgl_osal_thread_entry_t)(sgl_osal_thread_arg_t
 typedef pthread_spinlock_t  sgl_osal_spinlock_t;
 typedef pthread_mutex_t     sgl_osal_mutex_t;
 typedef pthread_cond_t      sgl_osal_cond_t;
+typedef pthread_key_t       sgl_osal_thread_key_t;
+typedef void (*sgl_osal_thread_key_destructor_t)(void *value);
 typedef sgl_uint32_t        sgl_osal_atomic_uint32_t;
+typedef sgl_int32_t         sgl_osal_atomic_int32_t;
+typedef sgl_uint64_t        sgl_osal_atomic_uint64_t;
+
+/*
+ * Waiters parked on one 32-bit address.  Linux parks on the address itself
+ * with a private futex and keeps nothing here; other systems fall back to a
+ * mutex/condvar pair that every wait and wake of the address goes through.
+ */
+typedef struct {
+#if defined(__linux__)
+    sgl_uint32_t reserved;
+#else
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+#endif  /* !__linux__ */
+} sgl_osal_wait_queue_t;
 
 static SGL_ALWAYS_INLINE sgl_uint32_t sgl_osal_atomic_uint32_load_acquire(
     const sgl_osal_atomic_uint32_t *value)
@@ -29,12 +57,149 @@ static SGL_ALWAYS_INLINE sgl_uint32_t sgl_osal_atomic_uint32_load_acquire(
     return __atomic_load_n(value, __ATOMIC_ACQUIRE);
 }
 
+static SGL_ALWAYS_INLINE sgl_uint32_t sgl_osal_atomic_uint32_load_relaxed(
+    const sgl_osal_atomic_uint32_t *value)
+{
+    return __atomic_load_n(value, __ATOMIC_RELAXED);
+}
+
+static SGL_ALWAYS_INLINE void sgl_osal_atomic_uint32_store_relaxed(
+    sgl_osal_atomic_uint32_t *value,
+    sgl_uint32_t desired)
+{
+    __atomic_store_n(value, desired, __ATOMIC_RELAXED);
+}
+
 static SGL_ALWAYS_INLINE sgl_uint32_t sgl_osal_atomic_uint32_increment_release(
     sgl_osal_atomic_uint32_t *value)
 {
     return __atomic_add_fetch(value, 1U, __ATOMIC_RELEASE);
 }
 
+/* Returns the value before the increment; no ordering beyond atomicity. */
+static SGL_ALWAYS_INLINE sgl_uint32_t sgl_osal_atomic_uint32_fetch_increment_relaxed(
+    sgl_osal_atomic_uint32_t *value)
+{
+    return __atomic_fetch_add(value, 1U, __ATOMIC_RELAXED);
+}
+
+static SGL_ALWAYS_INLINE sgl_uint32_t sgl_osal_atomic_uint32_fetch_add_relaxed(
+    sgl_osal_atomic_uint32_t *value,
+    sgl_uint32_t addend)
+{
+    return __atomic_fetch_add(value, addend, __ATOMIC_RELAXED);
+}
+
+static SGL_ALWAYS_INLINE sgl_uint32_t sgl_osal_atomic_uint32_fetch_sub_relaxed(
+    sgl_osal_atomic_uint32_t *value,
+    sgl_uint32_t subtrahend)
+{
+    return __atomic_fetch_sub(value, subtrahend, __ATOMIC_RELAXED);
+}
+
+/* Statistics counters; 64-bit atomics are lock-free on the supported targets. */
+static SGL_ALWAYS_INLINE sgl_uint64_t sgl_osal_atomic_uint64_load_relaxed(
+    const sgl_osal_atomic_uint64_t *value)
+{
+    return __atomic_load_n(value, __ATOMIC_RELAXED);
+}
+
+static SGL_ALWAYS_INLINE void sgl_osal_atomic_uint64_add_relaxed(
+    sgl_osal_atomic_uint64_t *value,
+    sgl_uint64_t addend)
+{
+    (void)__atomic_fetch_add(value, addend, __ATOMIC_RELAXED);
+}
+
+static SGL_ALWAYS_INLINE sgl_uint64_t sgl_osal_atomic_uint64_load_acquire(
+    const sgl_osal_atomic_uint64_t *value)
+{
+    return __atomic_load_n(value, __ATOMIC_ACQUIRE);
+}
+
+static SGL_ALWAYS_INLINE void sgl_osal_atomic_uint64_store_relaxed(
+    sgl_osal_atomic_uint64_t *value,
+    sgl_uint64_t desired)
+{
+    __atomic_store_n(value, desired, __ATOMIC_RELAXED);
+}
+
+static SGL_ALWAYS_INLINE void sgl_osal_atomic_uint64_store_release(
+    sgl_osal_atomic_uint64_t *value,
+    sgl_uint64_t desired)
+{
+    __atomic_store_n(value, desired, __ATOMIC_RELEASE);
+}
+
+/* Compare-and-swap with no ordering beyond atomicity; SGL_TRUE when value was expected. */
+static SGL_ALWAYS_INLINE sgl_bool_t sgl_osal_atomic_uint64_compare_exchange_relaxed(
+    sgl_osal_atomic_uint64_t *value,
+    sgl_uint64_t expected,
+    sgl_uint64_t desired)
+{
+    sgl_bool_t result = SGL_FALSE;
+
+    if (__atomic_compare_exchange_n(value, &expected, desired, 0,
+                                    __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+        result = SGL_TRUE;
+    }
+
+    return result;
+}
+
+static SGL_ALWAYS_INLINE sgl_int32_t sgl_osal_atomic_int32_load_relaxed(
+    const sgl_osal_atomic_int32_t *value)
+{
+    return __atomic_load_n(value, __ATOMIC_RELAXED);
+}
+
+static SGL_ALWAYS_INLINE sgl_int32_t sgl_osal_atomic_int32_load_acquire(
+    const sgl_osal_atomic_int32_t *value)
+{
+    return __atomic_load_n(value, __ATOMIC_ACQUIRE);
+}
+
+static SGL_ALWAYS_INLINE void sgl_osal_atomic_int32_store_relaxed(
+    sgl_osal_atomic_int32_t *value,
+    sgl_int32_t desired)
+{
+    __atomic_store_n(value, desired, __ATOMIC_RELAXED);
+}
+
+/* Sequentially consistent compare-and-swap; SGL_TRUE when value was expected. */
+static SGL_ALWAYS_INLINE sgl_bool_t sgl_osal_atomic_int32_compare_exchange(
+    sgl_osal_atomic_int32_t *value,
+    sgl_int32_t expected,
+    sgl_int32_t desired)
+{
+    sgl_bool_t result = SGL_FALSE;
+
+    if (__atomic_compare_exchange_n(value, &expected, desired, 0,
+                                    __ATOMIC_SEQ_CST, __ATOMIC_RELAXED)) {
+        result = SGL_TRUE;
+    }
+
+    return result;
+}
+
+static SGL_ALWAYS_INLINE void sgl_osal_atomic_thread_fence(void)
+{
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+}
+
+/* Clock; nanoseconds from an arbitrary origin, 0 when unavailable. */
+static SGL_ALWAYS_INLINE sgl_uint64_t sgl_osal_get_monotonic_ns(void)
+{
+    struct timespec now;
+    sgl_uint64_t result = 0U;
+
+    if (clock_gettime(CLOCK_MONOTONIC, &now) == 0) {
+        result = ((sgl_uint64_t)now.tv_sec * 1000000000U) + (sgl_uint64_t)now.tv_nsec;
+    }
+
+    return result;
+}
+
 /* Thread */
 static SGL_ALWAYS_INLINE sgl_osal_thread_t sgl_thread_create(sgl_osal_thread_entry_t start_routine, sgl_osal_thread_arg_t arg)
 {
@@ -53,6 +218,27 @@ static SGL_ALWAYS_INLINE void sgl_osal_thread_exit(sgl_osal_thread_return_t retv
     pthread_exit(retval);
 }
 
+/*
+ * Thread-exit hook.  A thread that set a non-NULL value for key has
+ * destructor called with it when the thread exits.
+ */
+static SGL_ALWAYS_INLINE sgl_bool_t sgl_osal_thread_key_create(
+    sgl_osal_thread_key_t *key,
+    sgl_osal_thread_key_destructor_t destructor)
+{
+    return (pthread_key_create(key, destructor) == 0) ? SGL_TRUE : SGL_FALSE;
+}
+
+static SGL_ALWAYS_INLINE void sgl_osal_thread_key_delete(sgl_osal_thread_key_t key)
+{
+    (void)pthread_key_delete(key);
+}
+
+static SGL_ALWAYS_INLINE sgl_bool_t sgl_osal_thread_key_set(sgl_osal_thread_key_t key, void *value)
+{
+    return (pthread_setspecific(key, value) == 0) ? SGL_TRUE : SGL_FALSE;
+}
+
 /* Spinlock */
 static SGL_ALWAYS_INLINE void sgl_osal_spinlock_init(sgl_osal_spinlock_t *spinlock)
 {
@@ -96,6 +282,16 @@ static SGL_ALWAYS_INLINE void sgl_osal_mutex_lock(sgl_osal_mutex_t *mutex)
     pthread_mutex_lock(mutex);
 }
 
+static SGL_ALWAYS_INLINE sgl_bool_t sgl_osal_mutex_try_lock(sgl_osal_mutex_t *mutex)
+{
+    sgl_bool_t is_locked;
+
+    is_locked = (pthread_mutex_trylock(mutex) == 0) ?
+        SGL_TRUE : SGL_FALSE;
+
+    return is_locked;
+}
+
 static SGL_ALWAYS_INLINE void sgl_osal_mutex_unlock(sgl_osal_mutex_t *mutex)
 {
     pthread_mutex_unlock(mutex);
@@ -132,9 +328,249 @@ static SGL_ALWAYS_INLINE void sgl_osal_cond_destroy(sgl_osal_cond_t *cond)
     pthread_cond_destroy(cond);
 }
 
+/*
+ * Wait on address.  sgl_osal_wait_on_address() returns once *address may no
+ * longer hold expected; it can return spuriously, so callers re-check the
+ * value in a loop.  Wakers change the value first and then wake up to count
+ * waiters; SGL_OSAL_WAKE_ALL wakes every one.
+ */
+#define SGL_OSAL_WAKE_ALL   (0x7FFFFFFF)
+
+static SGL_ALWAYS_INLINE void sgl_osal_wait_queue_init(sgl_osal_wait_queue_t *queue)
+{
+#if defined(__linux__)
+    queue->reserved = 0U;
+#else
+    pthread_mutex_init(&queue->lock, SGL_NULL);
+    pthread_cond_init(&queue->cond, SGL_NULL);
+#endif  /* !__linux__ */
+}
+
+static SGL_ALWAYS_INLINE void sgl_osal_wait_queue_destroy(sgl_osal_wait_queue_t *queue)
+{
+#if defined(__linux__)
+    SGL_UNUSED(queue);
+#else
+    pthread_mutex_destroy(&queue->lock);
+    pthread_cond_destroy(&queue->cond);
+#endif  /* !__linux__ */
+}
+
+static SGL_ALWAYS_INLINE void sgl_osal_wait_on_address(
+    sgl_osal_wait_queue_t *queue,
+    const sgl_osal_atomic_uint32_t *address,
+    sgl_uint32_t expected)
+{
+#if defined(__linux__)
+    SGL_UNUSED(queue);
+    (void)syscall(SYS_futex, address, FUTEX_WAIT_PRIVATE, expected, SGL_NULL, SGL_NULL, 0);
+#else
+    pthread_mutex_lock(&queue->lock);
+    while (__atomic_load_n(address, __ATOMIC_ACQUIRE) == expected) {
+        pthread_cond_wait(&queue->cond, &queue->lock);
+    }
+    pthread_mutex_unlock(&queue->lock);
+#endif  /* !__linux__ */
+}
+
+/* As sgl_osal_wait_on_address(), but gives up after about timeout_ns. */
+static SGL_ALWAYS_INLINE void sgl_osal_wait_on_address_for(
+    sgl_osal_wait_queue_t *queue,
+    const sgl_osal_atomic_uint32_t *address,
+    sgl_uint32_t expected,
+    sgl_uint64_t timeout_ns)
+{
+    struct timespec timeout;
+#if defined(__linux__)
+    SGL_UNUSED(queue);
+    timeout.tv_sec = (time_t)(timeout_ns / 1000000000U);
+    timeout.tv_nsec = (long)(timeout_ns % 1000000000U);
+    (void)syscall(SYS_futex, address, FUTEX_WAIT_PRIVATE, expected, &timeout, SGL_NULL, 0);
+#else
+    sgl_uint64_t deadline_ns;
+    sgl_bool_t is_waiting;
+
+    /* condition variables time out against the realtime clock */
+    deadline_ns = 0U;
+    if (clock_gettime(CLOCK_REALTIME, &timeout) == 0) {
+        deadline_ns = ((sgl_uint64_t)timeout.tv_sec * 1000000000U) +
+                      (sgl_uint64_t)timeout.tv_nsec + timeout_ns;
+    }
+    timeout.tv_sec = (time_t)(deadline_ns / 1000000000U);
+    timeout.tv_nsec = (long)(deadline_ns % 1000000000U);
+    is_waiting = SGL_TRUE;
+    pthread_mutex_lock(&queue->lock);
+    while ((is_waiting == SGL_TRUE) && (__atomic_load_n(address, __ATOMIC_ACQUIRE) == expected)) {
+        if (pthread_cond_timedwait(&queue->cond, &queue->lock, &timeout) != 0) {
+            is_waiting = SGL_FALSE;
+        }
+    }
+    pthread_mutex_unlock(&queue->lock);
+#endif  /* !__linux__ */
+}
+
+static SGL_ALWAYS_INLINE void sgl_osal_wake_address(
+    sgl_osal_wait_queue_t *queue,
+    sgl_osal_atomic_uint32_t *address,
+    sgl_int32_t count)
+{
+#if defined(__linux__)
+    SGL_UNUSED(queue);
+    (void)syscall(SYS_futex, address, FUTEX_WAKE_PRIVATE, count, SGL_NULL, SGL_NULL, 0);
+#else
+    SGL_UNUSED(address);
+    /* the lock orders this wake after a waiter's check of the value */
+    pthread_mutex_lock(&queue->lock);
+    if (count == 1) {
+        pthread_cond_signal(&queue->cond);
+    }
+    else {
+        pthread_cond_broadcast(&queue->cond);
+    }
+    pthread_mutex_unlock(&queue->lock);
+#endif  /* !__linux__ */
+}
+
 static SGL_ALWAYS_INLINE void sgl_osal_yield_thread(void)
 {
     sched_yield();
 }
 
+/*
+ * CPU placement.  Masks are little-endian bitmaps of CPU ids, one bit per
+ * CPU, and apply to the calling thread; threads it creates inherit them.
+ * The raw system calls keep this usable without _GNU_SOURCE.
+ */
+static SGL_ALWAYS_INLINE sgl_bool_t sgl_osal_thread_get_affinity(
+    sgl_uint64_t *mask,
+    sgl_size_t words)
+{
+    sgl_bool_t result = SGL_FALSE;
+    sgl_size_t i;
+
+    for (i = 0U; i < words; ++i) {
+        mask[i] = 0U;
+    }
+#if defined(__linux__)
+    if (syscall(SYS_sched_getaffinity, 0, words * sizeof(sgl_uint64_t), mask) > 0) {
+        result = SGL_TRUE;
+    }
+#endif  /* !__linux__ */
+
+    return result;
+}
+
+static SGL_ALWAYS_INLINE sgl_bool_t sgl_osal_thread_set_affinity(
+    const sgl_uint64_t *mask,
+    sgl_size_t words)
+{
+    sgl_bool_t result = SGL_FALSE;
+
+#if defined(__linux__)
+    if (syscall(SYS_sched_setaffinity, 0, words * sizeof(sgl_uint64_t), mask) == 0) {
+        result = SGL_TRUE;
+    }
+#else
+    SGL_UNUSED(mask);
+    SGL_UNUSED(words);
+#endif  /* !__linux__ */
+
+    return result;
+}
+
+/* NUMA node the calling thread runs on right now, or -1 when unknown. */
+static SGL_ALWAYS_INLINE sgl_int32_t sgl_osal_get_current_numa_node(void)
+{
+    sgl_int32_t result = -1;
+#if defined(__linux__)
+    unsigned int cpu;
+    unsigned int node;
+
+    if (syscall(SYS_getcpu, &cpu, &node, SGL_NULL) == 0) {
+        result = (sgl_int32_t)node;
+    }
+#endif  /* !__linux__ */
+
+    return result;
+}
+
+/*
+ * NUMA node of a CPU from sysfs, or -1 when unknown.  Kernels built without
+ * NUMA have no node directory and report every CPU on node 0.
+ */
+static SGL_ALWAYS_INLINE sgl_int32_t sgl_osal_get_cpu_numa_node(sgl_int32_t cpu)
+{
+    sgl_int32_t result = -1;
+#if defined(__linux__)
+    char path[64];
+    sgl_int32_t node;
+
+    if (access("/sys/devices/system/node", F_OK) != 0) {
+        result = 0;
+    }
+    for (node = 0; (result < 0) && (node < SGL_OSAL_MAX_NUMA_NODES); ++node) {
+        (void)snprintf(path, sizeof(path),
+                       "/sys/devices/system/node/node%d/cpu%d", (int)node, (int)cpu);
+        if (access(path, F_OK) == 0) {
+            result = node;
+        }
+    }
+#else
+    SGL_UNUSED(cpu);
+#endif  /* !__linux__ */
+
+    return result;
+}
+
+/*
+ * CPUs allowed by the cgroup CPU bandwidth limit, rounded up, or 0 when
+ * there is no limit or it cannot be read.  cgroup v2 keeps "quota period"
+ * in cpu.max, v1 splits them across cfs_quota_us and cfs_period_us; both
+ * are read from the cgroup mounted at /sys/fs/cgroup, which is the
+ * process's own group inside a container.
+ */
+static SGL_ALWAYS_INLINE sgl_size_t sgl_osal_get_cpu_quota(void)
+{
+    sgl_size_t result = 0U;
+#if defined(__linux__)
+    FILE *file;
+    char quota[32];
+    long long quota_us;
+    long long period_us;
+
+    quota_us = -1;
+    period_us = 0;
+    file = fopen("/sys/fs/cgroup/cpu.max", "r");
+    if (file != SGL_NULL) {
+        /* "max" in place of a number means unlimited and fails the scan */
+        if ((fscanf(file, "%31s %lld", quota, &period_us) != 2) ||
+            (sscanf(quota, "%lld", &quota_us) != 1)) {
+            quota_us = -1;
+        }
+        (void)fclose(file);
+    }
+    else {
+        file = fopen("/sys/fs/cgroup/cpu/cpu.cfs_quota_us", "r");
+        if (file != SGL_NULL) {
+            if (fscanf(file, "%lld", &quota_us) != 1) {
+                quota_us = -1;
+            }
+            (void)fclose(file);
+        }
+        file = fopen("/sys/fs/cgroup/cpu/cpu.cfs_period_us", "r");
+        if (file != SGL_NULL) {
+            if (fscanf(file, "%lld", &period_us) != 1) {
+                period_us = 0;
+            }
+            (void)fclose(file);
+        }
+    }
+    if ((quota_us > 0) && (period_us > 0)) {
+        result = (sgl_size_t)((quota_us + period_us - 1) / period_us);
+    }
+#endif  /* !__linux__ */
+
+    return result;
+}
+
 #endif  /* !SGL_OSAL_POSIX_H_ */
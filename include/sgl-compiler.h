@@ -54,6 +54,7 @@
 #define SGL_FALLTHROUGH
 #define SGL_UNREACHABLE()             __assume(0)
 #define SGL_CPU_RELAX()               ((void)0)
+#define SGL_THREAD_LOCAL              __declspec(thread)
 #define SGL_PREFETCH(address, byte_distance, rw, locality) \
     ((void)(address), (void)(byte_distance), (void)(rw), (void)(locality))
 
@@ -78,6 +79,7 @@
 #else
 #define SGL_CPU_RELAX()               __asm__ __volatile__("" ::: "memory")
 #endif
+#define SGL_THREAD_LOCAL              __thread
 #define SGL_PREFETCH(address, byte_distance, rw, locality) \
     __builtin_prefetch( \
         ((const char *)(address)) + (byte_distance), \
@@ -99,6 +101,8 @@
 #define SGL_FALLTHROUGH
 #define SGL_UNREACHABLE()             ((void)0)
 #define SGL_CPU_RELAX()               ((void)0)
+/* only the single-threaded backends build without a known compiler */
+#define SGL_THREAD_LOCAL
 #define SGL_PREFETCH(address, byte_distance, rw, locality) \
     ((void)(address), (void)(byte_distance), (void)(rw), (void)(locality))
 
@@ -30,12 +30,14 @@ extern "C" {
 #define SGL_DIV_ROUNDUP(n, d)                       (((n) + (d) - 1) / (d))
 #define SGL_SAFE_FREE(p)                            if ((p) != SGL_NULL) { sgl_free((p)); (p) = SGL_NULL; }
 #define SGL_THREADPOOL_DEFAULT_MAX_ROUTINE_LISTS    (4U)
+#define SGL_QUEUE_WAIT_FOREVER                      (~(sgl_uint64_t)0U)
 #define SGL_GENERIC_BULK_SIZE                       (4)
 #define SGL_SIMD_BULK_SIZE                          (8)
 #define SGL_BPP32                                   (4)
 #define SGL_BPP24                                   (3)
 #define SGL_BPP16                                   (2)
 #define SGL_BPP8                                    (1)
+#define SGL_IMAGE_MAX_PLANES                        (3)
 
 
 /*
@@ -54,14 +56,69 @@ typedef enum {
     SGL_QUEUE_IS_NOT_EMPTY,
     SGL_QUEUE_IS_FULL,
     SGL_QUEUE_IS_NOT_FULL,
+    SGL_THREADPOOL_TASK_IS_PENDING,
+    SGL_THREADPOOL_CANCELLED,
+    SGL_QUEUE_IS_CLOSED,
 } sgl_result_t;
 
 typedef struct sgl_nearest_neighbor_lookup_table    sgl_nearest_neighbor_lookup_t;
 typedef struct sgl_bilinear_lookup_table            sgl_bilinear_lookup_t;
 typedef struct sgl_bicubic_lookup_table             sgl_bicubic_lookup_t;
 typedef struct sgl_queue                            sgl_queue_t;
+typedef struct sgl_spsc_ring                        sgl_spsc_ring_t;
 typedef struct sgl_threadpool                       sgl_threadpool_t;
+typedef struct sgl_threadpool_task                  sgl_threadpool_task_t;
+typedef struct sgl_threadpool_token                 sgl_threadpool_token_t;
 typedef void(*sgl_threadpool_routine_t)(void *SGL_RESTRICT current, void *SGL_RESTRICT cookie);
+typedef void(*sgl_threadpool_range_routine_t)(sgl_int32_t begin, sgl_int32_t end, void *SGL_RESTRICT cookie);
+typedef struct sgl_threadpool_scratch               sgl_threadpool_scratch_t;
+typedef void(*sgl_threadpool_scratch_routine_t)(sgl_int32_t begin, sgl_int32_t end, sgl_threadpool_scratch_t *SGL_RESTRICT scratch, void *SGL_RESTRICT cookie);
+
+/*
+ * Orientation transforms.  Rotations are clockwise.  The transposing variants
+ * (90, 270, transpose, transverse) swap the destination width and height.
+ * Together the eight values cover every EXIF orientation tag.
+ */
+typedef enum {
+    SGL_ROTATE_0,
+    SGL_ROTATE_90,
+    SGL_ROTATE_180,
+    SGL_ROTATE_270,
+    SGL_FLIP_HORIZONTAL,
+    SGL_FLIP_VERTICAL,
+    SGL_TRANSPOSE,
+    SGL_TRANSVERSE,
+} sgl_rotation_t;
+
+/*
+ * Pixel formats of sgl_image_t.  Packed formats use plane 0 only.  NV12 keeps
+ * interleaved UV in plane 1 and I420 keeps U and V in planes 1 and 2; both
+ * subsample chroma by two in each direction.
+ */
+typedef enum {
+    SGL_PIXEL_FORMAT_GRAY8,
+    SGL_PIXEL_FORMAT_RGB565,
+    SGL_PIXEL_FORMAT_RGB888,
+    SGL_PIXEL_FORMAT_BGR888,
+    SGL_PIXEL_FORMAT_RGBA8888,
+    SGL_PIXEL_FORMAT_BGRA8888,
+    SGL_PIXEL_FORMAT_NV12,
+    SGL_PIXEL_FORMAT_I420,
+} sgl_pixel_format_t;
+
+/*
+ * Non-owning image view.  base is the start of the backing buffer and is
+ * kept by crops; planes[] point at the first pixel of the view and strides[]
+ * are byte distances between rows, so a crop is a pointer adjustment.
+ */
+typedef struct {
+    sgl_uint8_t *base;
+    sgl_int32_t width;
+    sgl_int32_t height;
+    sgl_pixel_format_t format;
+    sgl_uint8_t *planes[SGL_IMAGE_MAX_PLANES];
+    sgl_int32_t strides[SGL_IMAGE_MAX_PLANES];
+} sgl_image_t;
 
 
 /*******************************************************************
@@ -162,33 +219,457 @@ sgl_result_t sgl_simd_resize_bicubic(
                 sgl_int32_t bpp);
 #endif  /* !SGL_CFG_HAS_SIMD */
 
+/*
+ * Fused resize + orientation.  dst is d_width x d_height after the rotation
+ * is applied, so transposing orientations resize the source to
+ * d_height x d_width before placement.  An external look-up table must be
+ * built for that unrotated geometry.  Only dst is written; no full-size
+ * intermediate image is allocated.
+ */
+sgl_result_t sgl_generic_resize_nearest_rotate(
+                sgl_threadpool_t *SGL_RESTRICT pool, sgl_nearest_neighbor_lookup_t *SGL_RESTRICT ext_lut,
+                sgl_uint8_t *SGL_RESTRICT dst, sgl_int32_t d_width, sgl_int32_t d_height,
+                sgl_uint8_t *SGL_RESTRICT src, sgl_int32_t s_width, sgl_int32_t s_height,
+                sgl_int32_t bpp, sgl_rotation_t rotation);
+
+sgl_result_t sgl_generic_resize_bilinear_rotate(
+                sgl_threadpool_t *SGL_RESTRICT pool, sgl_bilinear_lookup_t *SGL_RESTRICT ext_lut,
+                sgl_uint8_t *SGL_RESTRICT dst, sgl_int32_t d_width, sgl_int32_t d_height,
+                sgl_uint8_t *SGL_RESTRICT src, sgl_int32_t s_width, sgl_int32_t s_height,
+                sgl_int32_t bpp, sgl_rotation_t rotation);
+
+sgl_result_t sgl_generic_resize_bicubic_rotate(
+                sgl_threadpool_t *SGL_RESTRICT pool, sgl_bicubic_lookup_t *SGL_RESTRICT ext_lut,
+                sgl_uint8_t *SGL_RESTRICT dst, sgl_int32_t d_width, sgl_int32_t d_height,
+                sgl_uint8_t *SGL_RESTRICT src, sgl_int32_t s_width, sgl_int32_t s_height,
+                sgl_int32_t bpp, sgl_rotation_t rotation);
+
+#if defined(SGL_CFG_HAS_SIMD)
+sgl_result_t sgl_simd_resize_nearest_rotate(
+                sgl_threadpool_t *SGL_RESTRICT pool, sgl_nearest_neighbor_lookup_t *SGL_RESTRICT ext_lut,
+                sgl_uint8_t *SGL_RESTRICT dst, sgl_int32_t d_width, sgl_int32_t d_height,
+                sgl_uint8_t *SGL_RESTRICT src, sgl_int32_t s_width, sgl_int32_t s_height,
+                sgl_int32_t bpp, sgl_rotation_t rotation);
+
+sgl_result_t sgl_simd_resize_bilinear_rotate(
+                sgl_threadpool_t *SGL_RESTRICT pool, sgl_bilinear_lookup_t *SGL_RESTRICT ext_lut,
+                sgl_uint8_t *SGL_RESTRICT dst, sgl_int32_t d_width, sgl_int32_t d_height,
+                sgl_uint8_t *SGL_RESTRICT src, sgl_int32_t s_width, sgl_int32_t s_height,
+                sgl_int32_t bpp, sgl_rotation_t rotation);
+
+sgl_result_t sgl_simd_resize_bicubic_rotate(
+                sgl_threadpool_t *SGL_RESTRICT pool, sgl_bicubic_lookup_t *SGL_RESTRICT ext_lut,
+                sgl_uint8_t *SGL_RESTRICT dst, sgl_int32_t d_width, sgl_int32_t d_height,
+                sgl_uint8_t *SGL_RESTRICT src, sgl_int32_t s_width, sgl_int32_t s_height,
+                sgl_int32_t bpp, sgl_rotation_t rotation);
+#endif  /* !SGL_CFG_HAS_SIMD */
+
+
+/*******************************************************************
+ *                          Rotate
+ *******************************************************************/
+/*
+ * dst receives the s_width x s_height source after the requested transform.
+ * Both buffers are tightly packed and must not overlap.  The implementation
+ * selects the accelerated tile kernels when the configured target provides
+ * them, and splits the source into tile rows when a threadpool is given.
+ */
+sgl_result_t sgl_rotate(
+                sgl_threadpool_t *SGL_RESTRICT pool,
+                sgl_uint8_t *SGL_RESTRICT dst,
+                const sgl_uint8_t *SGL_RESTRICT src, sgl_int32_t s_width, sgl_int32_t s_height,
+                sgl_int32_t bpp, sgl_rotation_t rotation);
+
+
+/*******************************************************************
+ *                          Warp
+ *******************************************************************/
+#define SGL_WARP_ONE    (65536)
+
+/*
+ * matrix is the inverse map from destination to source pixel centers in
+ * Q16.16 (SGL_WARP_ONE == 1.0):
+ *   sx = matrix[0] * x + matrix[1] * y + matrix[2]
+ *   sy = matrix[3] * x + matrix[4] * y + matrix[5]
+ * Samples are blended bilinearly in Q11; destination pixels that map outside
+ * the source receive border on every channel.  All dimensions are limited to
+ * 32767 pixels, and dst must not overlap src.
+ */
+sgl_result_t sgl_warp_affine(
+                sgl_threadpool_t *SGL_RESTRICT pool,
+                sgl_uint8_t *SGL_RESTRICT dst, sgl_int32_t d_width, sgl_int32_t d_height,
+                const sgl_uint8_t *SGL_RESTRICT src, sgl_int32_t s_width, sgl_int32_t s_height,
+                sgl_int32_t bpp, const sgl_int32_t matrix[6], sgl_uint8_t border);
+
+/*
+ * matrix is a homogeneous 3x3 inverse map from destination to source pixel
+ * centers, row major:
+ *   sx = (matrix[0] * x + matrix[1] * y + matrix[2]) / w
+ *   sy = (matrix[3] * x + matrix[4] * y + matrix[5]) / w
+ *   w  =  matrix[6] * x + matrix[7] * y + matrix[8]
+ * Only the ratios matter, so the matrix may be scaled freely; a larger scale
+ * keeps more precision in the projective terms.  With matrix[6] == matrix[7]
+ * == 0 and matrix[8] == SGL_WARP_ONE the result equals sgl_warp_affine().
+ *
+ * The division is evaluated exactly every 16 pixels of a row and the source
+ * position is interpolated linearly in between.  Pixels with w <= 0 or that
+ * map outside the source receive border.  Nearest samples the closest
+ * source pixel; bilinear blends in Q11 like sgl_warp_affine().
+ */
+sgl_result_t sgl_warp_perspective_nearest(
+                sgl_threadpool_t *SGL_RESTRICT pool,
+                sgl_uint8_t *SGL_RESTRICT dst, sgl_int32_t d_width, sgl_int32_t d_height,
+                const sgl_uint8_t *SGL_RESTRICT src, sgl_int32_t s_width, sgl_int32_t s_height,
+                sgl_int32_t bpp, const sgl_int32_t matrix[9], sgl_uint8_t border);
+sgl_result_t sgl_warp_perspective_bilinear(
+                sgl_threadpool_t *SGL_RESTRICT pool,
+                sgl_uint8_t *SGL_RESTRICT dst, sgl_int32_t d_width, sgl_int32_t d_height,
+                const sgl_uint8_t *SGL_RESTRICT src, sgl_int32_t s_width, sgl_int32_t s_height,
+                sgl_int32_t bpp, const sgl_int32_t matrix[9], sgl_uint8_t border);
+
+
+/*******************************************************************
+ *                          Image
+ *******************************************************************/
+/*
+ * Wraps a contiguous buffer.  stride is the plane 0 row size in bytes; 0
+ * selects the packed row size.  Chroma planes follow plane 0 in the buffer:
+ * NV12 chroma rows use stride, I420 chroma rows use stride / 2 rounded up,
+ * and either grows to the chroma row size when width is odd.
+ */
+sgl_result_t sgl_image_wrap(
+                sgl_image_t *SGL_RESTRICT image, sgl_uint8_t *SGL_RESTRICT base,
+                sgl_int32_t width, sgl_int32_t height, sgl_int32_t stride,
+                sgl_pixel_format_t format);
+
+/* Bytes of the buffer sgl_image_wrap() expects, or 0 for invalid geometry. */
+sgl_size_t sgl_image_buffer_size(
+                sgl_int32_t width, sgl_int32_t height, sgl_int32_t stride,
+                sgl_pixel_format_t format);
+
+/*
+ * O(1) sub-view of image; no pixel is copied.  For NV12 and I420 the
+ * x and y offsets must be even so the chroma planes stay aligned.
+ */
+sgl_result_t sgl_image_crop(
+                sgl_image_t *SGL_RESTRICT view, const sgl_image_t *SGL_RESTRICT image,
+                sgl_int32_t x, sgl_int32_t y, sgl_int32_t width, sgl_int32_t height);
+
+/*
+ * View entry points.  dst and src must share the pixel format, and planar
+ * formats are processed plane by plane.  Resize selects the SIMD backend
+ * when SGL_CFG_HAS_SIMD is set and otherwise the generic one.
+ */
+sgl_result_t sgl_image_resize_nearest(
+                sgl_threadpool_t *SGL_RESTRICT pool,
+                const sgl_image_t *SGL_RESTRICT dst, const sgl_image_t *SGL_RESTRICT src);
+
+sgl_result_t sgl_image_resize_bilinear(
+                sgl_threadpool_t *SGL_RESTRICT pool,
+                const sgl_image_t *SGL_RESTRICT dst, const sgl_image_t *SGL_RESTRICT src);
+
+sgl_result_t sgl_image_resize_bicubic(
+                sgl_threadpool_t *SGL_RESTRICT pool,
+                const sgl_image_t *SGL_RESTRICT dst, const sgl_image_t *SGL_RESTRICT src);
+
+/* dst must have the oriented size of src, see sgl_rotation_t. */
+sgl_result_t sgl_image_rotate(
+                sgl_threadpool_t *SGL_RESTRICT pool,
+                const sgl_image_t *SGL_RESTRICT dst, const sgl_image_t *SGL_RESTRICT src,
+                sgl_rotation_t rotation);
+
+/*
+ * Copies src into dst of the same size.  Identical formats copy rows;
+ * RGB888, BGR888, RGBA8888 and BGRA8888 convert between each other (alpha
+ * is set to 255 when added), and GRAY8 expands to them.  Other pairs return
+ * SGL_ERROR_NOT_SUPPORTED.
+ */
+sgl_result_t sgl_image_convert(
+                sgl_threadpool_t *SGL_RESTRICT pool,
+                const sgl_image_t *SGL_RESTRICT dst, const sgl_image_t *SGL_RESTRICT src);
+
 
 /*******************************************************************
  *                          Queue
  *******************************************************************/
+/*
+ * Bounded FIFO of opaque pointers.  enqueue, dequeue, peek and the count
+ * queries are lock-free and safe from any number of threads at once;
+ * enqueue returns SGL_QUEUE_IS_NOT_FULL once the entry is in and
+ * SGL_QUEUE_IS_FULL when there is no room, and dequeue returns SGL_NULL
+ * when there is nothing to take.  An entry being added or taken by another
+ * thread may briefly make the queue look full or empty.  unsafe_enqueue
+ * and copy are for a queue no other thread is using.
+ *
+ * enqueue_bulk and dequeue_bulk move up to count entries, in order, with
+ * one claim on the queue and return how many they moved: fewer than count
+ * when the queue fills up or runs dry, and 0 when an argument or any entry
+ * of data is NULL.
+ *
+ * A queue from create_blocking also takes enqueue_wait and dequeue_wait,
+ * which spin briefly and then sleep until they can go ahead or timeout_ns
+ * runs out (SGL_QUEUE_WAIT_FOREVER never does; 0 tries once).  They return
+ * SGL_QUEUE_IS_NOT_FULL / SGL_QUEUE_IS_NOT_EMPTY on success and
+ * SGL_QUEUE_IS_FULL / SGL_QUEUE_IS_EMPTY on timeout.  close wakes every
+ * waiter: enqueue_wait then returns SGL_QUEUE_IS_CLOSED at once, and
+ * dequeue_wait once the remaining entries are taken.  Close after the last
+ * producer is done; the non-waiting calls ignore it.  Without thread
+ * support there is no clock and the waits try once.  Other queues reject
+ * the waits with SGL_ERROR_INVALID_ARGUMENTS.
+ */
 sgl_queue_t *sgl_queue_create(sgl_size_t capacity);
+sgl_queue_t *sgl_queue_create_blocking(sgl_size_t capacity);
 void sgl_queue_destroy(sgl_queue_t **queue);
 sgl_result_t sgl_queue_copy(sgl_queue_t *SGL_RESTRICT dst, const sgl_queue_t *SGL_RESTRICT src);
 sgl_result_t sgl_queue_unsafe_enqueue(sgl_queue_t *SGL_RESTRICT queue, const void *SGL_RESTRICT data);
 sgl_result_t sgl_queue_enqueue(sgl_queue_t *SGL_RESTRICT queue, const void *SGL_RESTRICT data);
 void *sgl_queue_dequeue(sgl_queue_t *queue);
+sgl_size_t sgl_queue_enqueue_bulk(sgl_queue_t *SGL_RESTRICT queue, void *const *SGL_RESTRICT data, sgl_size_t count);
+sgl_size_t sgl_queue_dequeue_bulk(sgl_queue_t *SGL_RESTRICT queue, void **SGL_RESTRICT data, sgl_size_t count);
+sgl_result_t sgl_queue_enqueue_wait(sgl_queue_t *SGL_RESTRICT queue, const void *SGL_RESTRICT data, sgl_uint64_t timeout_ns);
+sgl_result_t sgl_queue_dequeue_wait(sgl_queue_t *SGL_RESTRICT queue, void **SGL_RESTRICT data, sgl_uint64_t timeout_ns);
+void sgl_queue_close(sgl_queue_t *queue);
 void *sgl_queue_peek(sgl_queue_t *queue);
 sgl_result_t sgl_queue_is_empty(const sgl_queue_t *queue);
 sgl_result_t sgl_queue_is_full(const sgl_queue_t *queue);
 sgl_size_t sgl_queue_get_capacity(const sgl_queue_t *queue);
 sgl_size_t sgl_queue_get_count(const sgl_queue_t *queue);
 
+/*
+ * Single-producer/single-consumer ring of fixed-size payloads, for stage
+ * handoffs with exactly one thread on each end.  The capacity is rounded up
+ * to a power of two.  The producer fills the slot from reserve in place and
+ * publishes it with commit; the consumer reads the slot from peek in place
+ * and hands it back with release.  reserve returns SGL_NULL when full and
+ * peek when empty, and both return the same slot until it is committed or
+ * released.  push and pop copy payload_size bytes through the same slots
+ * and return SGL_QUEUE_IS_NOT_FULL / SGL_QUEUE_IS_FULL and
+ * SGL_QUEUE_IS_NOT_EMPTY / SGL_QUEUE_IS_EMPTY.
+ */
+sgl_spsc_ring_t *sgl_spsc_ring_create(sgl_size_t capacity, sgl_size_t payload_size);
+void sgl_spsc_ring_destroy(sgl_spsc_ring_t **ring);
+void *sgl_spsc_ring_reserve(sgl_spsc_ring_t *ring);
+void sgl_spsc_ring_commit(sgl_spsc_ring_t *ring);
+void *sgl_spsc_ring_peek(sgl_spsc_ring_t *ring);
+void sgl_spsc_ring_release(sgl_spsc_ring_t *ring);
+sgl_result_t sgl_spsc_ring_push(sgl_spsc_ring_t *SGL_RESTRICT ring, const void *SGL_RESTRICT payload);
+sgl_result_t sgl_spsc_ring_pop(sgl_spsc_ring_t *SGL_RESTRICT ring, void *SGL_RESTRICT payload);
+sgl_size_t sgl_spsc_ring_get_capacity(const sgl_spsc_ring_t *ring);
+sgl_size_t sgl_spsc_ring_get_count(const sgl_spsc_ring_t *ring);
+
 
 /*******************************************************************
  *                          Threadpool
  *******************************************************************/
 #if defined(SGL_CFG_HAS_THREAD)
+#define SGL_THREADPOOL_MAX_CPUS         (1024)
+#define SGL_THREADPOOL_CPU_SET_WORDS    (SGL_THREADPOOL_MAX_CPUS / 64)
+
+/* Bit n of bits[n / 64] selects CPU n. */
+typedef struct {
+    sgl_uint64_t bits[SGL_THREADPOOL_CPU_SET_WORDS];
+} sgl_threadpool_cpu_set_t;
+
+typedef enum {
+    SGL_THREADPOOL_PLACEMENT_NONE,      /* OS scheduling, or the whole numa_node */
+    SGL_THREADPOOL_PLACEMENT_COMPACT,   /* one CPU each, filling a node first */
+    SGL_THREADPOOL_PLACEMENT_SCATTER,   /* one CPU each, alternating nodes */
+    SGL_THREADPOOL_PLACEMENT_EXPLICIT,  /* cpu_sets[i] for worker i */
+} sgl_threadpool_placement_t;
+
+typedef enum {
+    SGL_THREADPOOL_WAIT_ADAPTIVE,       /* spin about as long as dispatches are apart */
+    SGL_THREADPOOL_WAIT_SPIN,           /* never park; idle threads keep their CPU */
+    SGL_THREADPOOL_WAIT_PARK,           /* park as soon as there is nothing to do */
+} sgl_threadpool_wait_policy_t;
+
+typedef enum {
+    SGL_THREADPOOL_PRIORITY_NORMAL,     /* plain pools; served oldest first */
+    SGL_THREADPOOL_PRIORITY_HIGH,       /* served ahead of NORMAL work */
+} sgl_threadpool_priority_t;
+
+/*
+ * Creation options; sgl_threadpool_options_init() fills the defaults that
+ * sgl_threadpool_create() uses.  COMPACT and SCATTER pick among the CPUs
+ * the creating thread may run on, restricted to numa_node when it is not
+ * negative.  With is_node_local set, each routine runs on the submitting
+ * thread and the workers of the node it was submitted from, so rows are
+ * processed next to memory the submitter first touched; the whole pool is
+ * used when no worker is placed on that node.
+ *
+ * wait_policy decides how idle workers and waiting submitters wait before
+ * they park.  ADAPTIVE spins for twice the recent average interval between
+ * dispatches, at most spin_limit_us, and parks right away once dispatches
+ * are further apart than that limit.
+ *
+ * max_threads workers are created, num_threads of them active at first;
+ * 0 means num_threads.  Placement plans and EXPLICIT cpu_sets cover all
+ * max_threads.  With follow_cpu_quota set, the active count is further
+ * capped by the cgroup CPU quota, re-read at most once a second while
+ * routines are dispatched.
+ */
+typedef struct {
+    sgl_size_t num_threads;
+    sgl_size_t max_routine_lists;
+    const char *base_name;
+    sgl_threadpool_placement_t placement;
+    const sgl_threadpool_cpu_set_t *cpu_sets;
+    sgl_int32_t numa_node;
+    sgl_bool_t is_node_local;
+    sgl_threadpool_wait_policy_t wait_policy;
+    sgl_uint32_t spin_limit_us;
+    sgl_size_t max_threads;
+    sgl_bool_t follow_cpu_quota;
+} sgl_threadpool_options_t;
+
+void sgl_threadpool_options_init(sgl_threadpool_options_t *options, sgl_size_t num_threads, sgl_size_t max_routine_lists, const char *base_name);
+sgl_threadpool_t *sgl_threadpool_create_with_options(const sgl_threadpool_options_t *options);
 sgl_threadpool_t *sgl_threadpool_create(sgl_size_t num_threads, sgl_size_t max_routine_lists, const char *base_name);
 sgl_result_t sgl_threadpool_destroy(sgl_threadpool_t *pool);
+/* Number of workers currently taking work. */
 sgl_size_t sgl_threadpool_get_num_threads(const sgl_threadpool_t *pool);
+/*
+ * Sets how many of the pool's max_threads workers take work, 1 or more.
+ * Surplus workers finish the routine they are in and then park without
+ * spinning; the rest take over operations already dealt to them.
+ */
+sgl_result_t sgl_threadpool_set_num_threads(sgl_threadpool_t *pool, sgl_size_t num_threads);
+
+/*
+ * Counters kept by every pool whether or not tracing is built in.  Each
+ * worker, and the submitting threads together, add to their own cache line
+ * with relaxed atomics, so a snapshot is consistent per counter but not
+ * across counters.  Counters only grow; diff two snapshots for a rate.
+ *
+ * dispatches counts published routines and parallel_for calls.  Operations
+ * and parallel_for chunks are split by whether a worker of the pool or a
+ * submitting thread ran them.  spin_wakeups counts waits that ended while
+ * spinning and parks the times a thread went to sleep instead.  Completion
+ * waits are attach, parallel_for and wait calls that found their routine
+ * unfinished, with the time they spent until it was.  lock_contentions
+ * counts acquisitions of the pool's task list lock that found it held.
+ * A lane reports the counters of its pool.
+ */
+typedef struct {
+    sgl_uint64_t dispatches;
+    sgl_uint64_t submitter_operations;
+    sgl_uint64_t worker_operations;
+    sgl_uint64_t spin_wakeups;
+    sgl_uint64_t parks;
+    sgl_uint64_t completion_waits;
+    sgl_uint64_t completion_wait_ns;
+    sgl_uint64_t lock_contentions;
+} sgl_threadpool_stats_t;
+
+sgl_result_t sgl_threadpool_get_stats(const sgl_threadpool_t *pool, sgl_threadpool_stats_t *stats);
+
+/*
+ * A lane is a handle on the same workers that submits at another priority;
+ * it is accepted wherever a pool is, including by the resize kernels.  A
+ * worker inside a NORMAL routine checks for queued HIGH work before each
+ * operation or chunk and runs it first, so HIGH latency is bounded by one
+ * operation rather than a whole routine; nothing already running is
+ * preempted.  Each priority has its own max_routine_lists in-flight budget,
+ * so a backlog of NORMAL routines does not hold HIGH submissions back.
+ * Lanes are released with sgl_threadpool_destroy() before their pool.
+ */
+sgl_threadpool_t *sgl_threadpool_create_lane(sgl_threadpool_t *pool, sgl_threadpool_priority_t priority);
+
+/*
+ * Cooperative cancellation.  A token set on a lane applies to everything
+ * submitted through that lane from then on, the resize kernels included.
+ * Participants check it before each operation or chunk; once it is
+ * cancelled, or its deadline on the sgl_osal_get_monotonic_ns() clock has
+ * passed, the remaining operations are skipped and attach, parallel_for,
+ * test, wait and graph_run return SGL_THREADPOOL_CANCELLED.  A routine that
+ * is already running is never interrupted.
+ *
+ * get_completed counts the operations, or parallel_for chunks, that ran
+ * while the token was set, so a caller can tell partial output from none.
+ * A deadline of 0 means none.  set_deadline and reset must not race with
+ * routines using the token; cancel may be called from any thread, including
+ * from inside a routine.  set_token takes a lane only, SGL_NULL detaching
+ * the token, and the token must outlive the work submitted with it.
+ */
+sgl_threadpool_token_t *sgl_threadpool_token_create(void);
+sgl_result_t sgl_threadpool_token_destroy(sgl_threadpool_token_t *token);
+sgl_result_t sgl_threadpool_token_set_deadline(sgl_threadpool_token_t *token, sgl_uint64_t deadline_ns);
+sgl_result_t sgl_threadpool_token_cancel(sgl_threadpool_token_t *token);
+/* Clears the cancelled state and the completed count; keeps the deadline. */
+sgl_result_t sgl_threadpool_token_reset(sgl_threadpool_token_t *token);
+sgl_bool_t sgl_threadpool_token_is_cancelled(const sgl_threadpool_token_t *token);
+sgl_size_t sgl_threadpool_token_get_completed(const sgl_threadpool_token_t *token);
+sgl_result_t sgl_threadpool_set_token(sgl_threadpool_t *lane, sgl_threadpool_token_t *token);
+sgl_threadpool_token_t *sgl_threadpool_get_token(const sgl_threadpool_t *pool);
+
 sgl_result_t sgl_threadpool_attach_routine(sgl_threadpool_t *SGL_RESTRICT pool, sgl_threadpool_routine_t routine, sgl_queue_t *SGL_RESTRICT operations, void *SGL_RESTRICT cookie);
 /* Consumes operation entries; the caller retains ownership of the queue. */
 sgl_result_t sgl_threadpool_attach_routine_consuming(sgl_threadpool_t *SGL_RESTRICT pool, sgl_threadpool_routine_t routine, sgl_queue_t *SGL_RESTRICT operations, void *SGL_RESTRICT cookie);
+
+/*
+ * Asynchronous submission.  submit returns as soon as the routine is queued;
+ * up to max_routine_lists routines are in flight at once and workers drain
+ * them oldest first.  operations and cookie belong to the pool until the
+ * task completes.  Every task must be released with wait or wait_all before
+ * the pool is destroyed.
+ *
+ * test returns SGL_SUCCESS once every operation has run and
+ * SGL_THREADPOOL_TASK_IS_PENDING before that.  wait blocks until then,
+ * restores the queue for the non-consuming variant, frees the task and sets
+ * *task to SGL_NULL.
+ *
+ * A routine may attach, submit, wait and run parallel_for on the pool it
+ * runs on, for example a threaded resize per image inside a batch routine.
+ * Such nested routines are not held back by max_routine_lists, and a
+ * routine waiting on one runs its operations itself before blocking.
+ */
+sgl_result_t sgl_threadpool_submit_routine(sgl_threadpool_t *SGL_RESTRICT pool, sgl_threadpool_routine_t routine, sgl_queue_t *SGL_RESTRICT operations, void *SGL_RESTRICT cookie, sgl_threadpool_task_t **task);
+sgl_result_t sgl_threadpool_submit_routine_consuming(sgl_threadpool_t *SGL_RESTRICT pool, sgl_threadpool_routine_t routine, sgl_queue_t *SGL_RESTRICT operations, void *SGL_RESTRICT cookie, sgl_threadpool_task_t **task);
+sgl_result_t sgl_threadpool_test(const sgl_threadpool_task_t *task);
+sgl_result_t sgl_threadpool_wait(sgl_threadpool_task_t **task);
+sgl_result_t sgl_threadpool_wait_all(sgl_threadpool_task_t **tasks, sgl_size_t count);
+
+/*
+ * Runs routine over [begin, end) in chunks of grain indices, the last one
+ * possibly shorter, and returns when every chunk has run.  Participants claim
+ * chunks from a shared atomic counter; nothing is allocated per call.  A
+ * call may cover several consecutive chunks, faster cores taking more, so
+ * its range starts on a chunk boundary but may be any multiple of grain.
+ */
+sgl_result_t sgl_threadpool_parallel_for(sgl_threadpool_t *SGL_RESTRICT pool, sgl_int32_t begin, sgl_int32_t end, sgl_int32_t grain, sgl_threadpool_range_routine_t routine, void *SGL_RESTRICT cookie);
+
+/*
+ * parallel_for whose routine also receives the scratch arena of the thread
+ * running the chunk.  Every worker and every submitting thread has one; it
+ * persists across calls and is reset after each chunk.
+ * sgl_threadpool_scratch_alloc() returns cache-line aligned memory that stays
+ * valid until the routine returns, or SGL_NULL when none can be allocated.
+ * An arena only grows when a chunk needed more than its capacity, so steady
+ * state chunks do not touch the allocator.
+ */
+sgl_result_t sgl_threadpool_parallel_for_scratch(sgl_threadpool_t *SGL_RESTRICT pool, sgl_int32_t begin, sgl_int32_t end, sgl_int32_t grain, sgl_threadpool_scratch_routine_t routine, void *SGL_RESTRICT cookie);
+void *sgl_threadpool_scratch_alloc(sgl_threadpool_scratch_t *scratch, sgl_size_t size);
+
+/*
+ * Task graph.  A node is a range routine over rows [begin, end) split into
+ * grain-row chunks, as for parallel_for.  An edge makes every chunk of its
+ * downstream node wait for the upstream rows it reads: downstream rows
+ * [b, e) need upstream rows [b * num / den - halo, e * num / den + halo),
+ * rounded outwards and clipped to the upstream range.  A halo covering the
+ * whole upstream range turns the edge into a stage barrier.
+ *
+ * Edges must point from an earlier node to a later one, so every graph is
+ * acyclic.  run executes the graph on the pool's workers and the calling
+ * thread, starting each chunk as soon as its inputs are done, and returns
+ * when every chunk has run.  A graph can be run any number of times.
+ */
+typedef struct sgl_threadpool_graph sgl_threadpool_graph_t;
+
+sgl_threadpool_graph_t *sgl_threadpool_graph_create(sgl_size_t max_nodes, sgl_size_t max_edges);
+sgl_result_t sgl_threadpool_graph_destroy(sgl_threadpool_graph_t *graph);
+sgl_result_t sgl_threadpool_graph_add_node(sgl_threadpool_graph_t *SGL_RESTRICT graph, sgl_int32_t begin, sgl_int32_t end, sgl_int32_t grain, sgl_threadpool_range_routine_t routine, void *SGL_RESTRICT cookie, sgl_size_t *SGL_RESTRICT node);
+sgl_result_t sgl_threadpool_graph_add_edge(sgl_threadpool_graph_t *graph, sgl_size_t upstream, sgl_size_t downstream, sgl_int32_t num, sgl_int32_t den, sgl_int32_t halo);
+sgl_result_t sgl_threadpool_graph_run(sgl_threadpool_t *SGL_RESTRICT pool, sgl_threadpool_graph_t *SGL_RESTRICT graph);
 #endif  /* !SGL_CFG_HAS_THREAD */
 
 #if defined(__cplusplus)
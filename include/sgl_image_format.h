@@ -0,0 +1,141 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright (c) 2025 Dylan Hong
+ *
+ * This code is released under the MIT License.
+ * For conditions of distribution and use, see the LICENSE file.
+ */
+/*
+ * Plane layout of every sgl_pixel_format_t, shared by the image, crop,
+ * resize, rotate and convert modules.
+ */
+#ifndef SGL_IMAGE_FORMAT_H_
+#define SGL_IMAGE_FORMAT_H_
+
+#include <sgl-core.h>
+
+/*
+ * Plane p of a width x height image is
+ *   ((width + (1 << x_shift) - 1) >> x_shift) pixels of bpp[p] bytes wide and
+ *   ((height + (1 << y_shift) - 1) >> y_shift) rows high.
+ */
+typedef struct {
+    sgl_int32_t planes;
+    sgl_int32_t bpp[SGL_IMAGE_MAX_PLANES];
+    sgl_int32_t x_shift[SGL_IMAGE_MAX_PLANES];
+    sgl_int32_t y_shift[SGL_IMAGE_MAX_PLANES];
+} sgl_image_format_info_t;
+
+static SGL_ALWAYS_INLINE void sgl_image_format_set_plane(
+    sgl_image_format_info_t *info,
+    sgl_int32_t plane,
+    sgl_int32_t bpp,
+    sgl_int32_t shift)
+{
+    info->bpp[plane] = bpp;
+    info->x_shift[plane] = shift;
+    info->y_shift[plane] = shift;
+}
+
+/* Returns SGL_FALSE for values outside sgl_pixel_format_t. */
+static SGL_ALWAYS_INLINE sgl_bool_t sgl_image_format_get_info(
+    sgl_pixel_format_t format,
+    sgl_image_format_info_t *info)
+{
+    sgl_bool_t result;
+    sgl_int32_t plane;
+
+    result = SGL_TRUE;
+    info->planes = 1;
+    for (plane = 0; plane < SGL_IMAGE_MAX_PLANES; ++plane) {
+        sgl_image_format_set_plane(info, plane, 0, 0);
+    }
+
+    switch (format) {
+    case SGL_PIXEL_FORMAT_GRAY8:
+        sgl_image_format_set_plane(info, 0, SGL_BPP8, 0);
+        break;
+    case SGL_PIXEL_FORMAT_RGB565:
+        sgl_image_format_set_plane(info, 0, SGL_BPP16, 0);
+        break;
+    case SGL_PIXEL_FORMAT_RGB888:
+    case SGL_PIXEL_FORMAT_BGR888:
+        sgl_image_format_set_plane(info, 0, SGL_BPP24, 0);
+        break;
+    case SGL_PIXEL_FORMAT_RGBA8888:
+    case SGL_PIXEL_FORMAT_BGRA8888:
+        sgl_image_format_set_plane(info, 0, SGL_BPP32, 0);
+        break;
+    case SGL_PIXEL_FORMAT_NV12:
+        info->planes = 2;
+        sgl_image_format_set_plane(info, 0, SGL_BPP8, 0);
+        sgl_image_format_set_plane(info, 1, SGL_BPP16, 1);
+        break;
+    case SGL_PIXEL_FORMAT_I420:
+        info->planes = 3;
+        sgl_image_format_set_plane(info, 0, SGL_BPP8, 0);
+        sgl_image_format_set_plane(info, 1, SGL_BPP8, 1);
+        sgl_image_format_set_plane(info, 2, SGL_BPP8, 1);
+        break;
+    default:
+        result = SGL_FALSE;
+        break;
+    }
+
+    return result;
+}
+
+static SGL_ALWAYS_INLINE sgl_int32_t sgl_image_plane_width(
+    const sgl_image_format_info_t *info,
+    sgl_int32_t plane,
+    sgl_int32_t width)
+{
+    return (width + (1 << info->x_shift[plane]) - 1) >> info->x_shift[plane];
+}
+
+static SGL_ALWAYS_INLINE sgl_int32_t sgl_image_plane_height(
+    const sgl_image_format_info_t *info,
+    sgl_int32_t plane,
+    sgl_int32_t height)
+{
+    return (height + (1 << info->y_shift[plane]) - 1) >> info->y_shift[plane];
+}
+
+/*
+ * Counts the problems of one view: missing planes, empty geometry, or a
+ * stride shorter than the plane row.  info is filled for valid formats.
+ */
+static SGL_ALWAYS_INLINE sgl_int32_t sgl_image_count_errors(
+    const sgl_image_t *image,
+    sgl_image_format_info_t *info)
+{
+    sgl_int32_t errcnt;
+    sgl_int32_t plane;
+    sgl_int64_t row_size;
+
+    errcnt = 0;
+    if (image == SGL_NULL) {
+        errcnt += 1;
+    }
+    else if (sgl_image_format_get_info(image->format, info) == SGL_FALSE) {
+        errcnt += 1;
+    }
+    else if ((image->width <= 0) || (image->height <= 0)) {
+        errcnt += 1;
+    }
+    else {
+        for (plane = 0; plane < info->planes; ++plane) {
+            row_size = (sgl_int64_t)sgl_image_plane_width(info, plane, image->width) *
+                       (sgl_int64_t)info->bpp[plane];
+            if ((image->planes[plane] == SGL_NULL) ||
+                ((sgl_int64_t)image->strides[plane] < row_size)) {
+                errcnt += 1;
+            }
+        }
+    }
+
+    return errcnt;
+}
+
+#endif  /* !SGL_IMAGE_FORMAT_H_ */
@@ -107,6 +107,17 @@ static SGL_ALWAYS_INLINE sgl_queue_t *sgl_memory_as_queue(void *memory)
     return result;
 }
 
+static SGL_ALWAYS_INLINE sgl_spsc_ring_t *sgl_memory_as_spsc_ring(void *memory)
+{
+    sgl_spsc_ring_t *result;
+
+    /* SGL-MEM-DEV-001: typed conversion from generic storage. */
+    /* cppcheck-suppress misra-c2012-11.5 */
+    result = (sgl_spsc_ring_t *)memory;
+
+    return result;
+}
+
 static SGL_ALWAYS_INLINE sgl_threadpool_t *sgl_memory_as_threadpool(void *memory)
 {
     sgl_threadpool_t *result;
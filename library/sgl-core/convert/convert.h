@@ -0,0 +1,52 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright (c) 2025 Dylan Hong
+ *
+ * This code is released under the MIT License.
+ * For conditions of distribution and use, see the LICENSE file.
+ */
+#ifndef CONVERT_H_
+#define CONVERT_H_
+
+#include <sgl-core.h>
+#include <sgl_image_format.h>
+#include <sgl_memory_cast.h>
+
+/* even, so subsampled chroma rows stay inside one chunk */
+#define SGL_CONVERT_ROW_GRAIN           (16)
+#define SGL_CONVERT_NO_ALPHA            (-1)
+
+/*
+ * Byte position of each channel inside one packed pixel.  GRAY8 maps all
+ * three color channels onto its single byte.
+ */
+typedef struct {
+    sgl_int32_t bpp;
+    sgl_int32_t r;
+    sgl_int32_t g;
+    sgl_int32_t b;
+    sgl_int32_t a;
+} sgl_convert_layout_t;
+
+typedef struct {
+    const sgl_image_t *dst;
+    const sgl_image_t *src;
+    sgl_image_format_info_t info;
+    sgl_bool_t copy;
+    sgl_convert_layout_t dst_layout;
+    sgl_convert_layout_t src_layout;
+} sgl_convert_data_t;
+
+static SGL_ALWAYS_INLINE sgl_convert_data_t *sgl_memory_as_convert_data(void *memory)
+{
+    sgl_convert_data_t *result;
+
+    /* SGL-MEM-DEV-001: typed conversion from generic storage. */
+    /* cppcheck-suppress misra-c2012-11.5 */
+    result = (sgl_convert_data_t *)memory;
+
+    return result;
+}
+
+#endif  /* !CONVERT_H_ */
@@ -6,3 +6,249 @@
  * This code is released under the MIT License.
  * For conditions of distribution and use, see the LICENSE file.
  */
+#include <sgl-core.h>
+#include "convert.h"
+
+#if defined(SGL_CFG_HAS_THREAD)
+static void sgl_image_convert_routine(sgl_int32_t begin, sgl_int32_t end, void *SGL_RESTRICT cookie);
+#endif  /* !SGL_CFG_HAS_THREAD */
+
+static void sgl_convert_set_layout(
+    sgl_convert_layout_t *layout,
+    sgl_int32_t bpp,
+    sgl_int32_t r,
+    sgl_int32_t g,
+    sgl_int32_t b,
+    sgl_int32_t a)
+{
+    layout->bpp = bpp;
+    layout->r = r;
+    layout->g = g;
+    layout->b = b;
+    layout->a = a;
+}
+
+/* Returns SGL_FALSE for formats without an 8-bit-per-channel RGB layout. */
+static sgl_bool_t sgl_convert_get_layout(
+    sgl_pixel_format_t format,
+    sgl_convert_layout_t *layout)
+{
+    sgl_bool_t result;
+
+    result = SGL_TRUE;
+    switch (format) {
+    case SGL_PIXEL_FORMAT_GRAY8:
+        sgl_convert_set_layout(layout, SGL_BPP8, 0, 0, 0, SGL_CONVERT_NO_ALPHA);
+        break;
+    case SGL_PIXEL_FORMAT_RGB888:
+        sgl_convert_set_layout(layout, SGL_BPP24, 0, 1, 2, SGL_CONVERT_NO_ALPHA);
+        break;
+    case SGL_PIXEL_FORMAT_BGR888:
+        sgl_convert_set_layout(layout, SGL_BPP24, 2, 1, 0, SGL_CONVERT_NO_ALPHA);
+        break;
+    case SGL_PIXEL_FORMAT_RGBA8888:
+        sgl_convert_set_layout(layout, SGL_BPP32, 0, 1, 2, 3);
+        break;
+    case SGL_PIXEL_FORMAT_BGRA8888:
+        sgl_convert_set_layout(layout, SGL_BPP32, 2, 1, 0, 3);
+        break;
+    default:
+        result = SGL_FALSE;
+        break;
+    }
+
+    return result;
+}
+
+static void sgl_convert_copy_rows(
+    const sgl_convert_data_t *data,
+    sgl_int32_t start_row,
+    sgl_int32_t row_count)
+{
+    const sgl_image_format_info_t *info;
+    sgl_size_t row_size;
+    sgl_int32_t plane;
+    sgl_int32_t row;
+    sgl_int32_t end_row;
+
+    info = &data->info;
+    for (plane = 0; plane < info->planes; ++plane) {
+        /* luma ranges start on even rows, so chroma ranges stay disjoint */
+        row = start_row >> info->y_shift[plane];
+        end_row = sgl_image_plane_height(info, plane, start_row + row_count);
+        row_size = (sgl_size_t)sgl_image_plane_width(info, plane, data->src->width) *
+                   (sgl_size_t)info->bpp[plane];
+        for (; row < end_row; ++row) {
+            (void)sgl_memcpy(
+                &data->dst->planes[plane][(sgl_ptrdiff_t)row * data->dst->strides[plane]],
+                &data->src->planes[plane][(sgl_ptrdiff_t)row * data->src->strides[plane]],
+                row_size);
+        }
+    }
+}
+
+static void sgl_convert_swizzle_rows(
+    const sgl_convert_data_t *data,
+    sgl_int32_t start_row,
+    sgl_int32_t row_count)
+{
+    const sgl_convert_layout_t *d;
+    const sgl_convert_layout_t *s;
+    const sgl_uint8_t *src;
+    sgl_uint8_t *dst;
+    sgl_int32_t row;
+    sgl_int32_t col;
+
+    d = &data->dst_layout;
+    s = &data->src_layout;
+    for (row = start_row; row < (start_row + row_count); ++row) {
+        src = &data->src->planes[0][(sgl_ptrdiff_t)row * data->src->strides[0]];
+        dst = &data->dst->planes[0][(sgl_ptrdiff_t)row * data->dst->strides[0]];
+        for (col = 0; col < data->src->width; ++col) {
+            dst[d->r] = src[s->r];
+            dst[d->g] = src[s->g];
+            dst[d->b] = src[s->b];
+            if (d->a != SGL_CONVERT_NO_ALPHA) {
+                dst[d->a] = (s->a != SGL_CONVERT_NO_ALPHA) ? src[s->a] : (sgl_uint8_t)0xFFU;
+            }
+            src = &src[s->bpp];
+            dst = &dst[d->bpp];
+        }
+    }
+}
+
+static void sgl_convert_range(
+    const sgl_convert_data_t *data,
+    sgl_int32_t start_row,
+    sgl_int32_t row_count)
+{
+    if (data->copy == SGL_TRUE) {
+        sgl_convert_copy_rows(data, start_row, row_count);
+    }
+    else {
+        sgl_convert_swizzle_rows(data, start_row, row_count);
+    }
+}
+
+static sgl_int32_t sgl_image_convert_count_errors(
+    const sgl_image_t *dst,
+    const sgl_image_t *src,
+    sgl_image_format_info_t *info)
+{
+    sgl_image_format_info_t dst_info;
+    sgl_int32_t errcnt;
+
+    errcnt = sgl_image_count_errors(dst, &dst_info);
+    errcnt += sgl_image_count_errors(src, info);
+    if ((errcnt == 0) &&
+        ((dst->width != src->width) || (dst->height != src->height) ||
+         (dst->planes[0] == src->planes[0]))) {
+        errcnt += 1;
+    }
+
+    return errcnt;
+}
+
+/* GRAY8 only expands; reducing color to gray needs a luma transform. */
+static sgl_bool_t sgl_convert_set_data(
+    sgl_convert_data_t *data,
+    const sgl_image_t *dst,
+    const sgl_image_t *src,
+    const sgl_image_format_info_t *info)
+{
+    sgl_bool_t result;
+
+    data->dst = dst;
+    data->src = src;
+    data->info = *info;
+    data->copy = SGL_FALSE;
+    result = SGL_TRUE;
+    if (dst->format == src->format) {
+        data->copy = SGL_TRUE;
+    }
+    else if ((sgl_convert_get_layout(dst->format, &data->dst_layout) == SGL_FALSE) ||
+             (sgl_convert_get_layout(src->format, &data->src_layout) == SGL_FALSE) ||
+             (dst->format == SGL_PIXEL_FORMAT_GRAY8)) {
+        result = SGL_FALSE;
+    }
+    else {
+        /* channel reorder */
+    }
+
+    return result;
+}
+
+#if defined(SGL_CFG_HAS_THREAD)
+static sgl_result_t sgl_image_convert_threaded(
+    sgl_threadpool_t *SGL_RESTRICT pool,
+    sgl_convert_data_t *data)
+{
+    sgl_result_t result;
+
+    /* multi-threaded convert */
+    result = sgl_threadpool_parallel_for(
+        pool, 0, data->src->height, SGL_CONVERT_ROW_GRAIN, sgl_image_convert_routine, (void *)data);
+
+    return result;
+}
+#endif  /* !SGL_CFG_HAS_THREAD */
+
+static sgl_result_t sgl_image_convert_run(
+    sgl_threadpool_t *SGL_RESTRICT pool,
+    sgl_convert_data_t *data)
+{
+    sgl_result_t result;
+
+    result = SGL_SUCCESS;
+    if (pool == SGL_NULL) {
+        sgl_convert_range(data, 0, data->src->height);
+    }
+#if defined(SGL_CFG_HAS_THREAD)
+    else if (sgl_threadpool_get_num_threads(pool) <= 1U) {
+        sgl_convert_range(data, 0, data->src->height);
+    }
+    else {
+        result = sgl_image_convert_threaded(pool, data);
+    }
+#else
+    else {
+        result = SGL_ERROR_NOT_SUPPORTED;
+    }
+#endif  /* !SGL_CFG_HAS_THREAD */
+
+    return result;
+}
+
+sgl_result_t sgl_image_convert(
+                sgl_threadpool_t *SGL_RESTRICT pool,
+                const sgl_image_t *SGL_RESTRICT dst, const sgl_image_t *SGL_RESTRICT src)
+{
+    sgl_result_t result = SGL_SUCCESS;
+    sgl_image_format_info_t info;
+    sgl_convert_data_t data;
+    sgl_int32_t errcnt = 0;
+
+    errcnt = sgl_image_convert_count_errors(dst, src, &info);
+
+    /* check error count */
+    if (errcnt != 0) {
+        result = SGL_ERROR_INVALID_ARGUMENTS;
+    }
+    else if (sgl_convert_set_data(&data, dst, src, &info) == SGL_FALSE) {
+        result = SGL_ERROR_NOT_SUPPORTED;
+    }
+    else {
+        result = sgl_image_convert_run(pool, &data);
+    }
+
+    return result;
+}
+
+#if defined(SGL_CFG_HAS_THREAD)
+static void sgl_image_convert_routine(sgl_int32_t begin, sgl_int32_t end, void *SGL_RESTRICT cookie)
+{
+    const sgl_convert_data_t *data = sgl_memory_as_convert_data(cookie);
+
+    sgl_convert_range(data, begin, end - begin);
+}
+#endif  /* !SGL_CFG_HAS_THREAD */
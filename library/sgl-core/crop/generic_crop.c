@@ -6,3 +6,78 @@
  * This code is released under the MIT License.
  * For conditions of distribution and use, see the LICENSE file.
  */
+#include <sgl-core.h>
+#include <sgl_image_format.h>
+
+static sgl_int32_t sgl_image_crop_count_errors(
+    const sgl_image_t *view,
+    const sgl_image_t *image,
+    sgl_int32_t x,
+    sgl_int32_t y,
+    sgl_int32_t width,
+    sgl_int32_t height,
+    sgl_image_format_info_t *info)
+{
+    sgl_int32_t errcnt;
+    sgl_int32_t plane;
+    sgl_int32_t mask;
+
+    errcnt = sgl_image_count_errors(image, info);
+    if (view == SGL_NULL) {
+        errcnt += 1;
+    }
+
+    /* check boundary */
+    if ((errcnt == 0) &&
+        ((x < 0) || (y < 0) || (width <= 0) || (height <= 0) ||
+         (width > (image->width - x)) || (height > (image->height - y)))) {
+        errcnt += 1;
+    }
+
+    /* subsampled planes need offsets on a chroma sample */
+    for (plane = 0; (errcnt == 0) && (plane < info->planes); ++plane) {
+        mask = (1 << info->x_shift[plane]) - 1;
+        if (((x & mask) != 0) || ((y & ((1 << info->y_shift[plane]) - 1)) != 0)) {
+            errcnt += 1;
+        }
+    }
+
+    return errcnt;
+}
+
+/*
+ * Design and Operation
+ * --------------------
+ * A crop only moves the plane pointers; strides and base are inherited, so
+ * chained crops and the operations reading them never copy pixels.
+ *
+ *   planes[p] += (y >> y_shift[p]) * strides[p] + (x >> x_shift[p]) * bpp[p]
+ */
+sgl_result_t sgl_image_crop(
+                sgl_image_t *SGL_RESTRICT view, const sgl_image_t *SGL_RESTRICT image,
+                sgl_int32_t x, sgl_int32_t y, sgl_int32_t width, sgl_int32_t height)
+{
+    sgl_result_t result = SGL_SUCCESS;
+    sgl_image_format_info_t info;
+    sgl_int32_t errcnt = 0;
+    sgl_int32_t plane;
+
+    errcnt = sgl_image_crop_count_errors(view, image, x, y, width, height, &info);
+
+    /* check error count */
+    if (errcnt != 0) {
+        result = SGL_ERROR_INVALID_ARGUMENTS;
+    }
+    else {
+        *view = *image;
+        view->width = width;
+        view->height = height;
+        for (plane = 0; plane < info.planes; ++plane) {
+            view->planes[plane] = &image->planes[plane][
+                ((sgl_ptrdiff_t)(y >> info.y_shift[plane]) * image->strides[plane]) +
+                ((sgl_ptrdiff_t)(x >> info.x_shift[plane]) * info.bpp[plane])];
+        }
+    }
+
+    return result;
+}
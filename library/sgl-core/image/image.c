@@ -0,0 +1,151 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright (c) 2025 Dylan Hong
+ *
+ * This code is released under the MIT License.
+ * For conditions of distribution and use, see the LICENSE file.
+ */
+#include <sgl-core.h>
+#include <sgl_image_format.h>
+
+/*
+ * Design and Operation
+ * --------------------
+ * A wrapped buffer stores its planes back to back.  Chroma rows keep the
+ * luma stride for interleaved NV12 and half of it for I420, so a padded
+ * luma stride pads every plane.  A chroma row is never shorter than its
+ * subsampled pixels: an odd-width NV12 image holds (width + 1) / 2 UV pairs,
+ * one byte more than the packed luma row.
+ *
+ *   base -> +-------------------------+
+ *           | plane 0: height rows    |  stride
+ *           +-------------------------+
+ *           | plane 1: chroma rows    |  stride (NV12) or stride / 2 (I420)
+ *           |                         |  at least the chroma row size
+ *           +-------------------------+
+ *           | plane 2: chroma rows    |  I420 only
+ *           +-------------------------+
+ */
+static sgl_int32_t sgl_image_wrap_stride(
+    const sgl_image_format_info_t *info,
+    sgl_int32_t plane,
+    sgl_int32_t width,
+    sgl_int32_t stride)
+{
+    sgl_int32_t result;
+    sgl_int32_t row_size;
+
+    result = stride;
+    if ((plane > 0) && (info->bpp[plane] == SGL_BPP8)) {
+        /* planar chroma: one byte per subsampled pixel */
+        result = SGL_DIV_ROUNDUP(stride, 1 << info->x_shift[plane]);
+    }
+
+    /* odd widths round the subsampled row up past the luma stride */
+    row_size = sgl_image_plane_width(info, plane, width) * info->bpp[plane];
+    if (result < row_size) {
+        result = row_size;
+    }
+
+    return result;
+}
+
+static sgl_int32_t sgl_image_wrap_count_errors(
+    sgl_int32_t width,
+    sgl_int32_t height,
+    sgl_int32_t stride,
+    sgl_pixel_format_t format,
+    sgl_image_format_info_t *info)
+{
+    sgl_int32_t errcnt;
+
+    errcnt = 0;
+    if (sgl_image_format_get_info(format, info) == SGL_FALSE) {
+        errcnt += 1;
+    }
+    else if ((width <= 0) || (height <= 0) || (stride < 0)) {
+        errcnt += 1;
+    }
+    else if ((stride != 0) && ((sgl_int64_t)stride < ((sgl_int64_t)width * info->bpp[0]))) {
+        errcnt += 1;
+    }
+    else if ((((sgl_int64_t)width * info->bpp[0]) > (sgl_int64_t)0x7FFFFFFF) ||
+             (((sgl_int64_t)width + 1) > (sgl_int64_t)0x7FFFFFFF)) {
+        /* the chroma row of an odd width is one byte longer than width */
+        errcnt += 1;
+    }
+    else {
+        /* valid geometry */
+    }
+
+    return errcnt;
+}
+
+sgl_size_t sgl_image_buffer_size(
+                sgl_int32_t width, sgl_int32_t height, sgl_int32_t stride,
+                sgl_pixel_format_t format)
+{
+    sgl_image_format_info_t info;
+    sgl_size_t size;
+    sgl_int32_t plane;
+
+    size = 0U;
+    if (sgl_image_wrap_count_errors(width, height, stride, format, &info) == 0) {
+        if (stride == 0) {
+            stride = width * info.bpp[0];
+        }
+        for (plane = 0; plane < info.planes; ++plane) {
+            size += (sgl_size_t)sgl_image_wrap_stride(&info, plane, width, stride) *
+                    (sgl_size_t)sgl_image_plane_height(&info, plane, height);
+        }
+    }
+
+    return size;
+}
+
+sgl_result_t sgl_image_wrap(
+                sgl_image_t *SGL_RESTRICT image, sgl_uint8_t *SGL_RESTRICT base,
+                sgl_int32_t width, sgl_int32_t height, sgl_int32_t stride,
+                sgl_pixel_format_t format)
+{
+    sgl_result_t result = SGL_SUCCESS;
+    sgl_image_format_info_t info;
+    sgl_uint8_t *plane_base;
+    sgl_int32_t errcnt = 0;
+    sgl_int32_t plane;
+
+    errcnt = sgl_image_wrap_count_errors(width, height, stride, format, &info);
+    if ((image == SGL_NULL) || (base == SGL_NULL)) {
+        errcnt += 1;
+    }
+
+    /* check error count */
+    if (errcnt != 0) {
+        result = SGL_ERROR_INVALID_ARGUMENTS;
+    }
+    else {
+        if (stride == 0) {
+            stride = width * info.bpp[0];
+        }
+        image->base = base;
+        image->width = width;
+        image->height = height;
+        image->format = format;
+        plane_base = base;
+        for (plane = 0; plane < SGL_IMAGE_MAX_PLANES; ++plane) {
+            if (plane < info.planes) {
+                image->planes[plane] = plane_base;
+                image->strides[plane] = sgl_image_wrap_stride(&info, plane, width, stride);
+                plane_base = &plane_base[(sgl_size_t)image->strides[plane] *
+                                         (sgl_size_t)sgl_image_plane_height(&info, plane, height)];
+            }
+            else {
+                image->planes[plane] = SGL_NULL;
+                image->strides[plane] = 0;
+            }
+        }
+    }
+
+    return result;
+}
@@ -18,6 +18,32 @@
 
 #define SGL_MEMORY_BLOCK_MAGIC          (0x53474C4DU)
 #define SGL_MEMORY_MIN_PAYLOAD_SIZE     (sizeof(sgl_memory_alignment_t))
+#define SGL_MEMORY_SL_INDEX_COUNT_LOG2  (4U)
+#define SGL_MEMORY_SL_INDEX_COUNT       ((sgl_size_t)1U << SGL_MEMORY_SL_INDEX_COUNT_LOG2)
+#define SGL_MEMORY_SMALL_BLOCK_SIZE     (SGL_MEMORY_SL_INDEX_COUNT * sizeof(sgl_memory_alignment_t))
+#define SGL_MEMORY_FL_INDEX_COUNT       (sizeof(sgl_size_t) * 8U)
+
+#if defined(SGL_CFG_HAS_THREAD)
+/* Largest request a thread magazine serves, as a power of two. */
+#if !defined(SGL_MEMORY_MAGAZINE_MAX_SIZE_LOG2)
+#define SGL_MEMORY_MAGAZINE_MAX_SIZE_LOG2   (13U)
+#endif
+/* Blocks a thread keeps per size class. */
+#if !defined(SGL_MEMORY_MAGAZINE_ROUNDS)
+#define SGL_MEMORY_MAGAZINE_ROUNDS          (8U)
+#endif
+/* Bytes a thread keeps in all classes together, capped at 1/64 of the pool. */
+#if !defined(SGL_MEMORY_MAGAZINE_MAX_BYTES)
+#define SGL_MEMORY_MAGAZINE_MAX_BYTES       (32U * 1024U)
+#endif
+#define SGL_MEMORY_MAGAZINE_POOL_SHARE      (64U)
+#define SGL_MEMORY_MAGAZINE_MAX_SIZE        ((sgl_size_t)1U << SGL_MEMORY_MAGAZINE_MAX_SIZE_LOG2)
+#define SGL_MEMORY_MAGAZINE_BATCH           ((SGL_MEMORY_MAGAZINE_ROUNDS + 1U) / 2U)
+/* classes up to MAX_SIZE for any alignment of at least four bytes */
+#define SGL_MEMORY_MAGAZINE_CLASS_COUNT \
+    (((SGL_MEMORY_MAGAZINE_MAX_SIZE_LOG2 - SGL_MEMORY_SL_INDEX_COUNT_LOG2 - 1U) * \
+      SGL_MEMORY_SL_INDEX_COUNT) + 1U)
+#endif  /* !SGL_CFG_HAS_THREAD */
 
 /*
  * Design overview
@@ -44,14 +70,68 @@
  *      The next physical block is calculated from header size + payload size.
  *      These links allow adjacent free blocks to be coalesced.
  *
- *   2. Free-list order
- *      previous_free/next_free form a doubly linked list containing only free
- *      blocks. Allocation performs a first-fit search through this list.
+ *   2. Size-class order
+ *      previous_free/next_free link each free block into the list of its
+ *      size class. The classes form a two-level segregated fit (TLSF): the
+ *      first level is the power of two below the size, the second splits
+ *      that range into SGL_MEMORY_SL_INDEX_COUNT equal steps. Sizes below
+ *      SGL_MEMORY_SMALL_BLOCK_SIZE share first-level 0 in alignment steps.
+ *
+ *        size 1000 = 0b1111101000: first level 2^9, second level
+ *        (1000 >> (9 - 4)) - 16 = 15, the class [992, 1024)
+ *
+ *      One bitmap marks the first levels that have any free block and one
+ *      bitmap per first level marks its non-empty second levels:
+ *
+ *        fl_bitmap        0 0 1 0 1 1 0 ...
+ *        sl_bitmap[fl]    0 0 0 1 0 0 0 0 0 1 0 0 0 0 0 0
+ *        free_lists[fl][sl] -> block -> block -> ...
+ *
+ *      Allocation rounds the request up to the next class boundary, so any
+ *      block of that class or above fits without looking at its size. The
+ *      first such class is the lowest set bit at or above it in sl_bitmap,
+ *      or else in fl_bitmap, which makes both malloc and free a fixed number
+ *      of steps whatever the pool history. When that finds nothing, the head
+ *      of the request's own class is still checked once.
+ *
+ * Freeing merges a block with free physical neighbours at once, so no two
+ * free blocks are ever adjacent.
  *
  * Allocation and release modify shared block metadata, so each complete
  * operation is serialized by the pool mutex. Pool initialization and
  * deinitialization must be performed while no other thread is using the
  * allocator.
+ *
+ * Thread magazines
+ * ----------------
+ * With threads, requests up to SGL_MEMORY_MAGAZINE_MAX_SIZE bytes first go
+ * to a magazine private to the calling thread: per size class, a short
+ * stack of blocks chained through next_free. Hits and misses that the
+ * magazine can absorb take no lock; the pool mutex is taken once per batch.
+ *
+ *   malloc: class empty  -> lock, take one block + up to BATCH - 1 more
+ *   free:   class full   -> lock, give BATCH back, then keep the block
+ *
+ * A magazine serves a request from the class it rounds up to and keeps a
+ * released block in the class its size rounds down to, so every block in a
+ * class holds any request served from it. Refills ask the pool for the
+ * class lower bound, which makes a freed block land back in the class it
+ * was taken for.
+ *
+ *   request 1000 -> class [1024, 1088) -> block of 1024 -> freed into
+ *   class [1024, 1088)
+ *
+ * Cached blocks stay allocated as far as the pool is concerned and are
+ * flagged is_cached, so a second free of one is ignored. A thread holds at
+ * most SGL_MEMORY_MAGAZINE_ROUNDS blocks per class and at most
+ * magazine_limit bytes overall. When a request still fails, the calling
+ * thread's magazine is returned to the pool and the request retried once.
+ *
+ * Each magazine registers in the pool on first use and sets a thread key,
+ * so the thread-exit hook returns its blocks. Deinitialization returns the
+ * blocks of every registered magazine and moves the pool to a new
+ * generation; a magazine from an older generation is empty and registers
+ * again when its thread next allocates.
  */
 typedef union {
     /*
@@ -73,20 +153,46 @@ union sgl_memory_block {
         sgl_memory_block_t *next_free;
         sgl_uint32_t magic;
         sgl_bool_t is_free;
+        sgl_bool_t is_cached;
     } fields;
     sgl_memory_alignment_t alignment;
 };
 
+#if defined(SGL_CFG_HAS_THREAD)
+typedef struct sgl_memory_magazine sgl_memory_magazine_t;
+
+struct sgl_memory_magazine {
+    sgl_memory_block_t *rounds[SGL_MEMORY_MAGAZINE_CLASS_COUNT];
+    sgl_uint16_t counts[SGL_MEMORY_MAGAZINE_CLASS_COUNT];
+    sgl_size_t cached_bytes;
+    sgl_uint32_t generation;
+    sgl_memory_magazine_t *previous;
+    sgl_memory_magazine_t *next;
+};
+#endif  /* !SGL_CFG_HAS_THREAD */
+
 typedef struct {
     sgl_uintptr_t begin;
     sgl_uintptr_t end;
-    sgl_memory_block_t *free_list;
+    sgl_size_t fl_bitmap;
+    sgl_size_t sl_bitmap[SGL_MEMORY_FL_INDEX_COUNT];
+    sgl_memory_block_t *free_lists[SGL_MEMORY_FL_INDEX_COUNT][SGL_MEMORY_SL_INDEX_COUNT];
     sgl_size_t allocation_count;
     sgl_bool_t is_initialized;
     sgl_osal_mutex_t lock;
+#if defined(SGL_CFG_HAS_THREAD)
+    sgl_memory_magazine_t *magazines;
+    sgl_size_t magazine_limit;
+    sgl_uint32_t generation;
+    sgl_bool_t has_magazines;
+    sgl_osal_thread_key_t magazine_key;
+#endif  /* !SGL_CFG_HAS_THREAD */
 } sgl_memory_pool_t;
 
 static sgl_memory_pool_t sgl_memory_pool;
+#if defined(SGL_CFG_HAS_THREAD)
+static SGL_THREAD_LOCAL sgl_memory_magazine_t sgl_memory_magazine;
+#endif  /* !SGL_CFG_HAS_THREAD */
 
 static SGL_ALWAYS_INLINE sgl_uintptr_t sgl_memory_address_from_void(const void *memory)
 {
@@ -162,14 +268,81 @@ static sgl_memory_block_t *sgl_memory_next_physical(sgl_memory_block_t *block)
     return next_block;
 }
 
+/*
+ * Index of the highest set bit of a nonzero value.  Halving the word a
+ * fixed number of times keeps this constant-time without compiler builtins.
+ */
+static sgl_size_t sgl_memory_find_last_set(sgl_size_t value)
+{
+    sgl_size_t remaining = value;
+    sgl_size_t index = 0U;
+    sgl_size_t shift;
+
+    for (shift = SGL_MEMORY_FL_INDEX_COUNT / 2U; shift > 0U; shift /= 2U) {
+        if ((remaining >> shift) != 0U) {
+            remaining >>= shift;
+            index += shift;
+        }
+    }
+
+    return index;
+}
+
+/* Index of the lowest set bit of a nonzero value. */
+static sgl_size_t sgl_memory_find_first_set(sgl_size_t value)
+{
+    return sgl_memory_find_last_set(value & (~value + 1U));
+}
+
+/* Size class holding free blocks of exactly size bytes. */
+static void sgl_memory_mapping_insert(sgl_size_t size, sgl_size_t *fl, sgl_size_t *sl)
+{
+    sgl_size_t msb;
+
+    if (size < SGL_MEMORY_SMALL_BLOCK_SIZE) {
+        *fl = 0U;
+        *sl = size / sizeof(sgl_memory_alignment_t);
+    }
+    else {
+        msb = sgl_memory_find_last_set(size);
+        *sl = (size >> (msb - SGL_MEMORY_SL_INDEX_COUNT_LOG2)) ^ SGL_MEMORY_SL_INDEX_COUNT;
+        *fl = msb - sgl_memory_find_last_set(SGL_MEMORY_SMALL_BLOCK_SIZE) + 1U;
+    }
+}
+
+/* Lower bound of the first class whose every block holds size bytes. */
+static sgl_size_t sgl_memory_round_size(sgl_size_t size)
+{
+    sgl_size_t rounded = size;
+    sgl_size_t step;
+
+    if (size >= SGL_MEMORY_SMALL_BLOCK_SIZE) {
+        step = (sgl_size_t)1U << (sgl_memory_find_last_set(size) - SGL_MEMORY_SL_INDEX_COUNT_LOG2);
+        rounded = (size + step - 1U) & ~(step - 1U);
+    }
+
+    return rounded;
+}
+
 static void sgl_memory_remove_free_block(sgl_memory_block_t *block)
 {
+    sgl_size_t fl;
+    sgl_size_t sl;
+
     /* Detach a block without changing its physical neighbours. */
+    sgl_memory_mapping_insert(block->fields.size, &fl, &sl);
     if (block->fields.previous_free != SGL_NULL) {
         block->fields.previous_free->fields.next_free = block->fields.next_free;
     }
     else {
-        sgl_memory_pool.free_list = block->fields.next_free;
+        sgl_memory_pool.free_lists[fl][sl] = block->fields.next_free;
+        if (block->fields.next_free == SGL_NULL) {
+            /* the class ran empty */
+            sgl_memory_pool.sl_bitmap[fl] &= ~((sgl_size_t)1U << sl);
+            if (sgl_memory_pool.sl_bitmap[fl] == 0U) {
+                sgl_memory_pool.fl_bitmap &= ~((sgl_size_t)1U << fl);
+            }
+        }
     }
 
     if (block->fields.next_free != SGL_NULL) {
@@ -182,14 +355,62 @@ static void sgl_memory_remove_free_block(sgl_memory_block_t *block)
 
 static void sgl_memory_insert_free_block(sgl_memory_block_t *block)
 {
-    /* Free-list order is not address order; insertion at the head is O(1). */
+    sgl_memory_block_t *head;
+    sgl_size_t fl;
+    sgl_size_t sl;
+
+    /* Class lists are not in address order; insertion at the head is O(1). */
+    sgl_memory_mapping_insert(block->fields.size, &fl, &sl);
+    head = sgl_memory_pool.free_lists[fl][sl];
     block->fields.is_free = SGL_TRUE;
     block->fields.previous_free = SGL_NULL;
-    block->fields.next_free = sgl_memory_pool.free_list;
-    if (sgl_memory_pool.free_list != SGL_NULL) {
-        sgl_memory_pool.free_list->fields.previous_free = block;
+    block->fields.next_free = head;
+    if (head != SGL_NULL) {
+        head->fields.previous_free = block;
     }
-    sgl_memory_pool.free_list = block;
+    sgl_memory_pool.free_lists[fl][sl] = block;
+    sgl_memory_pool.sl_bitmap[fl] |= (sgl_size_t)1U << sl;
+    sgl_memory_pool.fl_bitmap |= (sgl_size_t)1U << fl;
+}
+
+/* A free block of at least size bytes, or SGL_NULL; it stays in its list. */
+static sgl_memory_block_t *sgl_memory_find_free_block(sgl_size_t size)
+{
+    sgl_memory_block_t *block = SGL_NULL;
+    sgl_size_t fl;
+    sgl_size_t sl;
+    sgl_size_t fl_map;
+    sgl_size_t sl_map;
+
+    sl_map = 0U;
+    if (size <= (SGL_SIZE_MAX / 2U)) {
+        /* round up to the next class boundary: every block there fits */
+        sgl_memory_mapping_insert(sgl_memory_round_size(size), &fl, &sl);
+        sl_map = sgl_memory_pool.sl_bitmap[fl] & (~(sgl_size_t)0U << sl);
+        if (sl_map == 0U) {
+            fl_map = sgl_memory_pool.fl_bitmap & (~(sgl_size_t)0U << (fl + 1U));
+            if (fl_map != 0U) {
+                fl = sgl_memory_find_first_set(fl_map);
+                sl_map = sgl_memory_pool.sl_bitmap[fl];
+            }
+        }
+    }
+    if (sl_map != 0U) {
+        block = sgl_memory_pool.free_lists[fl][sgl_memory_find_first_set(sl_map)];
+    }
+    else if (size <= (SGL_SIZE_MAX / 2U)) {
+        /* only the request's own class is left; its head may still be large enough */
+        sgl_memory_mapping_insert(size, &fl, &sl);
+        block = sgl_memory_pool.free_lists[fl][sl];
+        if ((block != SGL_NULL) && (block->fields.size < size)) {
+            block = SGL_NULL;
+        }
+    }
+    else {
+        /* larger than any pool */
+    }
+
+    return block;
 }
 
 static void sgl_memory_split_block(sgl_memory_block_t *block, sgl_size_t size)
@@ -222,6 +443,7 @@ static void sgl_memory_split_block(sgl_memory_block_t *block, sgl_size_t size)
         remainder->fields.next_free = SGL_NULL;
         remainder->fields.magic = SGL_MEMORY_BLOCK_MAGIC;
         remainder->fields.is_free = SGL_TRUE;
+        remainder->fields.is_cached = SGL_FALSE;
 
         block->fields.size = size;
         next = sgl_memory_next_physical(remainder);
@@ -263,6 +485,331 @@ static sgl_memory_block_t *sgl_memory_merge_with_next(sgl_memory_block_t *block)
     return block;
 }
 
+/* Pool side of malloc; the caller holds the pool lock. */
+static sgl_memory_block_t *sgl_memory_allocate_block(sgl_size_t size)
+{
+    sgl_memory_block_t *block;
+
+    block = sgl_memory_find_free_block(size);
+    if (block != SGL_NULL) {
+        sgl_memory_remove_free_block(block);
+        sgl_memory_split_block(block, size);
+        block->fields.is_free = SGL_FALSE;
+        block->fields.is_cached = SGL_FALSE;
+        sgl_memory_pool.allocation_count++;
+    }
+
+    return block;
+}
+
+/* Pool side of free; the caller holds the pool lock. */
+static void sgl_memory_release_block(sgl_memory_block_t *block)
+{
+    sgl_memory_block_t *merged;
+    sgl_memory_block_t *previous;
+
+    /*
+     * Merge right first, then left. If the left block is free it is
+     * already in the free list and must be detached before growing.
+     * The final combined block is inserted exactly once.
+     */
+    block->fields.is_free = SGL_TRUE;
+    merged = sgl_memory_merge_with_next(block);
+    previous = merged->fields.previous_physical;
+    if ((previous != SGL_NULL) && previous->fields.is_free) {
+        sgl_memory_remove_free_block(previous);
+        previous->fields.size += sizeof(sgl_memory_block_t) + merged->fields.size;
+        merged = previous;
+        previous = sgl_memory_next_physical(merged);
+        if (previous != SGL_NULL) {
+            previous->fields.previous_physical = merged;
+        }
+    }
+    sgl_memory_insert_free_block(merged);
+    sgl_memory_pool.allocation_count--;
+}
+
+static SGL_ALWAYS_INLINE sgl_bool_t sgl_memory_is_live_block(const sgl_memory_block_t *block)
+{
+    return ((block->fields.magic == SGL_MEMORY_BLOCK_MAGIC) &&
+            (block->fields.is_free == SGL_FALSE) &&
+            (block->fields.is_cached == SGL_FALSE)) ? SGL_TRUE : SGL_FALSE;
+}
+
+#if defined(SGL_CFG_HAS_THREAD)
+static sgl_size_t sgl_memory_magazine_index(sgl_size_t size)
+{
+    sgl_size_t fl;
+    sgl_size_t sl;
+
+    sgl_memory_mapping_insert(size, &fl, &sl);
+
+    return (fl * SGL_MEMORY_SL_INDEX_COUNT) + sl;
+}
+
+static void sgl_memory_magazine_push(sgl_memory_magazine_t *magazine, sgl_size_t index,
+                                     sgl_memory_block_t *block)
+{
+    block->fields.is_cached = SGL_TRUE;
+    block->fields.next_free = magazine->rounds[index];
+    magazine->rounds[index] = block;
+    magazine->counts[index]++;
+    magazine->cached_bytes += block->fields.size;
+}
+
+static sgl_memory_block_t *sgl_memory_magazine_pop(sgl_memory_magazine_t *magazine, sgl_size_t index)
+{
+    sgl_memory_block_t *block;
+
+    block = magazine->rounds[index];
+    if (block != SGL_NULL) {
+        magazine->rounds[index] = block->fields.next_free;
+        magazine->counts[index]--;
+        magazine->cached_bytes -= block->fields.size;
+        block->fields.next_free = SGL_NULL;
+        block->fields.is_cached = SGL_FALSE;
+    }
+
+    return block;
+}
+
+/* Give up to count blocks of one class back to the pool; the caller holds the lock. */
+static void sgl_memory_magazine_flush(sgl_memory_magazine_t *magazine, sgl_size_t index, sgl_size_t count)
+{
+    sgl_size_t flushed;
+
+    for (flushed = 0U; (flushed < count) && (magazine->rounds[index] != SGL_NULL); ++flushed) {
+        sgl_memory_release_block(sgl_memory_magazine_pop(magazine, index));
+    }
+}
+
+/* Give every block back to the pool; the caller holds the lock. */
+static void sgl_memory_magazine_drain(sgl_memory_magazine_t *magazine)
+{
+    sgl_size_t index;
+
+    for (index = 0U; index < SGL_MEMORY_MAGAZINE_CLASS_COUNT; ++index) {
+        sgl_memory_magazine_flush(magazine, index, SGL_MEMORY_MAGAZINE_ROUNDS);
+    }
+}
+
+/* Drain and unregister a magazine; the caller holds the lock. */
+static void sgl_memory_magazine_detach(sgl_memory_magazine_t *magazine)
+{
+    sgl_memory_magazine_drain(magazine);
+    if (magazine->previous != SGL_NULL) {
+        magazine->previous->next = magazine->next;
+    }
+    else {
+        sgl_memory_pool.magazines = magazine->next;
+    }
+    if (magazine->next != SGL_NULL) {
+        magazine->next->previous = magazine->previous;
+    }
+    magazine->previous = SGL_NULL;
+    magazine->next = SGL_NULL;
+    magazine->generation = 0U;
+}
+
+/* Thread-exit hook of every thread that registered a magazine. */
+static void sgl_memory_magazine_exit(void *value)
+{
+    SGL_UNUSED(value);
+    if (sgl_memory_pool.is_initialized == SGL_TRUE) {
+        sgl_osal_mutex_lock(&sgl_memory_pool.lock);
+        if (sgl_memory_magazine.generation == sgl_memory_pool.generation) {
+            sgl_memory_magazine_detach(&sgl_memory_magazine);
+        }
+        sgl_osal_mutex_unlock(&sgl_memory_pool.lock);
+    }
+}
+
+/* The calling thread's magazine, registered with the pool on first use, or SGL_NULL. */
+static sgl_memory_magazine_t *sgl_memory_magazine_attach(void)
+{
+    sgl_memory_magazine_t *magazine = SGL_NULL;
+
+    if (sgl_memory_pool.has_magazines == SGL_TRUE) {
+        magazine = &sgl_memory_magazine;
+        if (magazine->generation != sgl_memory_pool.generation) {
+            /* whatever it held went back with an earlier pool generation */
+            (void)sgl_memset(magazine, 0, sizeof(*magazine));
+            if (sgl_osal_thread_key_set(sgl_memory_pool.magazine_key, magazine) == SGL_TRUE) {
+                sgl_osal_mutex_lock(&sgl_memory_pool.lock);
+                magazine->generation = sgl_memory_pool.generation;
+                magazine->next = sgl_memory_pool.magazines;
+                if (magazine->next != SGL_NULL) {
+                    magazine->next->previous = magazine;
+                }
+                sgl_memory_pool.magazines = magazine;
+                sgl_osal_mutex_unlock(&sgl_memory_pool.lock);
+            }
+            else {
+                /* without the exit hook the blocks could outlive the thread */
+                magazine = SGL_NULL;
+            }
+        }
+    }
+
+    return magazine;
+}
+
+/* A block for an aligned request from the calling thread's magazine, or SGL_NULL. */
+static sgl_memory_block_t *sgl_memory_magazine_allocate(sgl_size_t size)
+{
+    sgl_memory_magazine_t *magazine = SGL_NULL;
+    sgl_memory_block_t *block = SGL_NULL;
+    sgl_memory_block_t *round;
+    sgl_size_t rounded = 0U;
+    sgl_size_t index;
+    sgl_size_t count;
+
+    if (size <= SGL_MEMORY_MAGAZINE_MAX_SIZE) {
+        rounded = sgl_memory_round_size(size);
+        if ((rounded <= SGL_MEMORY_MAGAZINE_MAX_SIZE) && (rounded <= sgl_memory_pool.magazine_limit)) {
+            magazine = sgl_memory_magazine_attach();
+        }
+    }
+    if (magazine != SGL_NULL) {
+        index = sgl_memory_magazine_index(rounded);
+        block = sgl_memory_magazine_pop(magazine, index);
+        if (block == SGL_NULL) {
+            /* one block for the caller and the rest of a batch for its next requests */
+            sgl_osal_mutex_lock(&sgl_memory_pool.lock);
+            block = sgl_memory_allocate_block(rounded);
+            round = block;
+            for (count = 1U;
+                 (round != SGL_NULL) && (count < SGL_MEMORY_MAGAZINE_BATCH) &&
+                 ((magazine->cached_bytes + rounded) <= sgl_memory_pool.magazine_limit);
+                 ++count) {
+                round = sgl_memory_allocate_block(rounded);
+                if (round != SGL_NULL) {
+                    sgl_memory_magazine_push(magazine, index, round);
+                }
+            }
+            sgl_osal_mutex_unlock(&sgl_memory_pool.lock);
+        }
+    }
+
+    return block;
+}
+
+/* Keep a live block in the calling thread's magazine; SGL_FALSE leaves it to the pool. */
+static sgl_bool_t sgl_memory_magazine_release(sgl_memory_block_t *block)
+{
+    sgl_memory_magazine_t *magazine = SGL_NULL;
+    sgl_size_t index;
+    sgl_bool_t is_cached = SGL_FALSE;
+
+    if ((sgl_memory_is_live_block(block) == SGL_TRUE) &&
+        (block->fields.size <= SGL_MEMORY_MAGAZINE_MAX_SIZE) &&
+        (block->fields.size <= sgl_memory_pool.magazine_limit)) {
+        magazine = sgl_memory_magazine_attach();
+    }
+    if (magazine != SGL_NULL) {
+        index = sgl_memory_magazine_index(block->fields.size);
+        if ((magazine->counts[index] >= SGL_MEMORY_MAGAZINE_ROUNDS) ||
+            ((magazine->cached_bytes + block->fields.size) > sgl_memory_pool.magazine_limit)) {
+            sgl_osal_mutex_lock(&sgl_memory_pool.lock);
+            sgl_memory_magazine_flush(magazine, index, SGL_MEMORY_MAGAZINE_BATCH);
+            if ((magazine->cached_bytes + block->fields.size) > sgl_memory_pool.magazine_limit) {
+                sgl_memory_magazine_drain(magazine);
+            }
+            sgl_osal_mutex_unlock(&sgl_memory_pool.lock);
+        }
+        sgl_memory_magazine_push(magazine, index, block);
+        is_cached = SGL_TRUE;
+    }
+
+    return is_cached;
+}
+
+/*
+ * Return the calling thread's blocks before a request gives up; the caller
+ * holds the lock. Other threads' magazines are theirs alone while they run.
+ */
+static sgl_bool_t sgl_memory_magazine_reclaim(void)
+{
+    sgl_bool_t is_reclaimed = SGL_FALSE;
+
+    if ((sgl_memory_pool.has_magazines == SGL_TRUE) &&
+        (sgl_memory_magazine.generation == sgl_memory_pool.generation) &&
+        (sgl_memory_magazine.cached_bytes != 0U)) {
+        sgl_memory_magazine_drain(&sgl_memory_magazine);
+        is_reclaimed = SGL_TRUE;
+    }
+
+    return is_reclaimed;
+}
+
+static void sgl_memory_magazine_initialize(sgl_size_t usable_size)
+{
+    sgl_memory_pool.magazines = SGL_NULL;
+    sgl_memory_pool.magazine_limit = usable_size / SGL_MEMORY_MAGAZINE_POOL_SHARE;
+    if (sgl_memory_pool.magazine_limit > SGL_MEMORY_MAGAZINE_MAX_BYTES) {
+        sgl_memory_pool.magazine_limit = SGL_MEMORY_MAGAZINE_MAX_BYTES;
+    }
+    /* generation 0 marks a magazine that is not registered */
+    sgl_memory_pool.generation++;
+    if (sgl_memory_pool.generation == 0U) {
+        sgl_memory_pool.generation = 1U;
+    }
+    sgl_memory_pool.has_magazines =
+        sgl_osal_thread_key_create(&sgl_memory_pool.magazine_key, sgl_memory_magazine_exit);
+}
+
+/* Return every registered magazine's blocks; the caller holds the lock. */
+static void sgl_memory_magazine_reclaim_all(void)
+{
+    while (sgl_memory_pool.magazines != SGL_NULL) {
+        sgl_memory_magazine_detach(sgl_memory_pool.magazines);
+    }
+    /* magazines of threads that did not allocate since are stale from here on */
+    sgl_memory_pool.generation++;
+    if (sgl_memory_pool.generation == 0U) {
+        sgl_memory_pool.generation = 1U;
+    }
+}
+
+static void sgl_memory_magazine_deinitialize(void)
+{
+    if (sgl_memory_pool.has_magazines == SGL_TRUE) {
+        sgl_osal_thread_key_delete(sgl_memory_pool.magazine_key);
+        sgl_memory_pool.has_magazines = SGL_FALSE;
+    }
+}
+#else
+static SGL_ALWAYS_INLINE sgl_memory_block_t *sgl_memory_magazine_allocate(sgl_size_t size)
+{
+    SGL_UNUSED(size);
+    return SGL_NULL;
+}
+
+static SGL_ALWAYS_INLINE sgl_bool_t sgl_memory_magazine_release(sgl_memory_block_t *block)
+{
+    SGL_UNUSED(block);
+    return SGL_FALSE;
+}
+
+static SGL_ALWAYS_INLINE sgl_bool_t sgl_memory_magazine_reclaim(void)
+{
+    return SGL_FALSE;
+}
+
+static SGL_ALWAYS_INLINE void sgl_memory_magazine_initialize(sgl_size_t usable_size)
+{
+    SGL_UNUSED(usable_size);
+}
+
+static SGL_ALWAYS_INLINE void sgl_memory_magazine_reclaim_all(void)
+{
+}
+
+static SGL_ALWAYS_INLINE void sgl_memory_magazine_deinitialize(void)
+{
+}
+#endif  /* !SGL_CFG_HAS_THREAD */
+
 sgl_result_t sgl_memory_pool_initialize(void *memory, sgl_size_t size)
 {
     sgl_uintptr_t raw_address;
@@ -288,6 +835,9 @@ sgl_result_t sgl_memory_pool_initialize(void *memory, sgl_size_t size)
             sgl_memory_pool.begin = aligned_address;
             sgl_memory_pool.end = sgl_memory_pool.begin + usable_size;
             sgl_memory_pool.allocation_count = 0U;
+            sgl_memory_pool.fl_bitmap = 0U;
+            (void)sgl_memset(sgl_memory_pool.sl_bitmap, 0, sizeof(sgl_memory_pool.sl_bitmap));
+            (void)sgl_memset(sgl_memory_pool.free_lists, 0, sizeof(sgl_memory_pool.free_lists));
             sgl_osal_mutex_init(&sgl_memory_pool.lock);
 
             /*
@@ -300,8 +850,9 @@ sgl_result_t sgl_memory_pool_initialize(void *memory, sgl_size_t size)
             first->fields.previous_free = SGL_NULL;
             first->fields.next_free = SGL_NULL;
             first->fields.magic = SGL_MEMORY_BLOCK_MAGIC;
-            first->fields.is_free = SGL_TRUE;
-            sgl_memory_pool.free_list = first;
+            first->fields.is_cached = SGL_FALSE;
+            sgl_memory_insert_free_block(first);
+            sgl_memory_magazine_initialize(usable_size);
             sgl_memory_pool.is_initialized = SGL_TRUE;
             result = SGL_SUCCESS;
         }
@@ -316,6 +867,8 @@ sgl_result_t sgl_memory_pool_deinitialize(void)
 
     if (sgl_memory_pool.is_initialized == SGL_TRUE) {
         sgl_osal_mutex_lock(&sgl_memory_pool.lock);
+        /* blocks parked in thread magazines are not live allocations */
+        sgl_memory_magazine_reclaim_all();
         /*
          * Refuse to detach the caller-owned buffer while any returned pointer is
          * still live. After deinitialization the allocator no longer owns or
@@ -325,7 +878,7 @@ sgl_result_t sgl_memory_pool_deinitialize(void)
             sgl_memory_pool.is_initialized = SGL_FALSE;
             sgl_memory_pool.begin = 0U;
             sgl_memory_pool.end = 0U;
-            sgl_memory_pool.free_list = SGL_NULL;
+            sgl_memory_pool.fl_bitmap = 0U;
             result = SGL_SUCCESS;
         }
         else {
@@ -333,6 +886,7 @@ sgl_result_t sgl_memory_pool_deinitialize(void)
         }
         sgl_osal_mutex_unlock(&sgl_memory_pool.lock);
         if (result == SGL_SUCCESS) {
+            sgl_memory_magazine_deinitialize();
             sgl_osal_mutex_destroy(&sgl_memory_pool.lock);
         }
     }
@@ -357,21 +911,19 @@ void *sgl_malloc(sgl_size_t size)
         else {
             aligned_size = sgl_memory_align_size(size);
             if (aligned_size != 0U) {
-                sgl_osal_mutex_lock(&sgl_memory_pool.lock);
-                /* First-fit balances implementation size and predictable cost. */
-                block = sgl_memory_pool.free_list;
-                while ((block != SGL_NULL) && (block->fields.size < aligned_size)) {
-                    block = block->fields.next_free;
+                block = sgl_memory_magazine_allocate(aligned_size);
+                if (block == SGL_NULL) {
+                    sgl_osal_mutex_lock(&sgl_memory_pool.lock);
+                    block = sgl_memory_allocate_block(aligned_size);
+                    if ((block == SGL_NULL) && (sgl_memory_magazine_reclaim() == SGL_TRUE)) {
+                        /* the pool may only have been short of what this thread kept */
+                        block = sgl_memory_allocate_block(aligned_size);
+                    }
+                    sgl_osal_mutex_unlock(&sgl_memory_pool.lock);
                 }
-
                 if (block != SGL_NULL) {
-                    sgl_memory_remove_free_block(block);
-                    sgl_memory_split_block(block, aligned_size);
-                    block->fields.is_free = SGL_FALSE;
-                    sgl_memory_pool.allocation_count++;
                     memory = &sgl_memory_as_uint8(block)[sizeof(sgl_memory_block_t)];
                 }
-                sgl_osal_mutex_unlock(&sgl_memory_pool.lock);
             }
         }
     }
@@ -399,37 +951,20 @@ void *sgl_calloc(sgl_size_t count, sgl_size_t size)
 void sgl_free(void *memory)
 {
     sgl_memory_block_t *block;
-    sgl_memory_block_t *previous;
     sgl_uintptr_t address;
 
     if (memory != SGL_NULL) {
         address = sgl_memory_address_from_void(memory);
         if ((sgl_memory_pool.is_initialized == SGL_TRUE) &&
             (address >= sgl_memory_pool.begin) && (address < sgl_memory_pool.end)) {
-            sgl_osal_mutex_lock(&sgl_memory_pool.lock);
             block = sgl_memory_block_from_address(address - (sgl_uintptr_t)sizeof(sgl_memory_block_t));
-            if ((block->fields.magic == SGL_MEMORY_BLOCK_MAGIC) && (block->fields.is_free == SGL_FALSE)) {
-                /*
-                 * Merge right first, then left. If the left block is free it is
-                 * already in the free list and must be detached before growing.
-                 * The final combined block is inserted exactly once.
-                 */
-                block->fields.is_free = SGL_TRUE;
-                block = sgl_memory_merge_with_next(block);
-                previous = block->fields.previous_physical;
-                if ((previous != SGL_NULL) && previous->fields.is_free) {
-                    sgl_memory_remove_free_block(previous);
-                    previous->fields.size += sizeof(sgl_memory_block_t) + block->fields.size;
-                    block = previous;
-                    previous = sgl_memory_next_physical(block);
-                    if (previous != SGL_NULL) {
-                        previous->fields.previous_physical = block;
-                    }
+            if (sgl_memory_magazine_release(block) == SGL_FALSE) {
+                sgl_osal_mutex_lock(&sgl_memory_pool.lock);
+                if (sgl_memory_is_live_block(block) == SGL_TRUE) {
+                    sgl_memory_release_block(block);
                 }
-                sgl_memory_insert_free_block(block);
-                sgl_memory_pool.allocation_count--;
+                sgl_osal_mutex_unlock(&sgl_memory_pool.lock);
             }
-            sgl_osal_mutex_unlock(&sgl_memory_pool.lock);
         }
     }
 }
@@ -11,48 +11,124 @@
 #include "sgl_trace.h"
 #include <sgl_memory_cast.h>
 
+/*
+ * Design and Operation
+ * --------------------
+ * A bounded MPMC ring after Vyukov.  Every cell carries a sequence number
+ * that tells which lap of the ring may use it next, so producers and
+ * consumers synchronize per cell and only race each other with one CAS on
+ * their own position:
+ *
+ *   sequence == position       free for the producer of that position
+ *   sequence == position + 1   filled, ready for its consumer
+ *
+ *   head (producers): CAS head, write data, publish sequence = pos + 1
+ *   tail (consumers): CAS tail, read data,  publish sequence = pos + capacity
+ *
+ * A producer finding a cell still a lap behind reports full, a consumer
+ * finding it not yet filled reports empty; nobody waits on anybody.
+ * Positions are 64-bit and never wrap in practice, so any capacity works;
+ * a power of two maps positions to cells with a mask instead of a division.
+ * head and tail each sit on their own cache line, away from the read-only
+ * fields, and there is no shared count: it is head - tail.
+ *
+ * The bulk calls check how many cells in a row are ready and move the
+ * position past all of them with one CAS.  Nobody else can touch a claimed
+ * cell until its sequence is published, so the entries are then copied in
+ * at most two runs, split where the ring wraps:
+ *
+ *   cells: [ 5 6 7 . . . . 1 2 3 4 ]    claim of 7 starting at cell 7
+ *            ^^^^^ second run  ^^^^^^^ first run
+ *
+ * Blocking queues add a signal per side on top of the same ring.  Every
+ * successful enqueue moves not_empty.event and every dequeue moves
+ * not_full.event; a waiter snapshots the event before its attempt, spins
+ * on it for a while, then registers in waiters and parks on the event
+ * through the OSAL.  The mover's fence after its increment and the
+ * waiter's fence after registering make sure one of them sees the other,
+ * so the wake-up is skipped only when nobody is parked:
+ *
+ *   mover:   publish cell, event++ (release), fence, waiters? -> wake
+ *   waiter:  snapshot event, attempt, waiters++, fence, event same? -> park
+ *
+ * close moves both events and wakes everyone; waiting enqueues then fail
+ * and waiting dequeues drain what is left before they report it.
+ */
+typedef struct {
+    sgl_osal_atomic_uint64_t sequence;
+    void *data;
+} sgl_queue_cell_t;
+
+typedef struct {
+    sgl_osal_atomic_uint32_t event;
+    sgl_osal_atomic_uint32_t waiters;
+    sgl_osal_wait_queue_t wait_queue;
+} sgl_queue_signal_t;
+
+#define SGL_QUEUE_CACHE_LINE_SIZE    (64U)
+#define SGL_QUEUE_PADDING(size) \
+    (SGL_QUEUE_CACHE_LINE_SIZE - ((size) % SGL_QUEUE_CACHE_LINE_SIZE))
+
+/* Event polls before a waiter parks; cheap next to a futex round trip. */
+#if !defined(SGL_QUEUE_SPIN_COUNT)
+#define SGL_QUEUE_SPIN_COUNT         (1024U)
+#endif
+
 struct sgl_queue {
-    void **data;
+    sgl_queue_cell_t *cells;
     sgl_size_t capacity;
-    sgl_size_t count;
-    sgl_size_t head;
-    sgl_size_t tail;
-    sgl_osal_spinlock_t lock;
+    sgl_uint64_t mask;
+    sgl_osal_atomic_uint32_t is_closed;
+    sgl_bool_t is_blocking;
+    sgl_uint8_t reserved[SGL_QUEUE_PADDING(
+        sizeof(sgl_queue_cell_t *) + sizeof(sgl_size_t) + sizeof(sgl_uint64_t) +
+        sizeof(sgl_osal_atomic_uint32_t) + sizeof(sgl_bool_t))];
+    sgl_osal_atomic_uint64_t head;
+    sgl_uint8_t head_padding[SGL_QUEUE_CACHE_LINE_SIZE - sizeof(sgl_osal_atomic_uint64_t)];
+    sgl_osal_atomic_uint64_t tail;
+    sgl_uint8_t tail_padding[SGL_QUEUE_CACHE_LINE_SIZE - sizeof(sgl_osal_atomic_uint64_t)];
+    sgl_queue_signal_t not_empty;
+    sgl_uint8_t not_empty_padding[SGL_QUEUE_PADDING(sizeof(sgl_queue_signal_t))];
+    sgl_queue_signal_t not_full;
+    sgl_uint8_t not_full_padding[SGL_QUEUE_PADDING(sizeof(sgl_queue_signal_t))];
 };
 
-#define SGL_QUEUE_CACHE_LINE_SIZE    (64U)
 #define SGL_QUEUE_DATA_OFFSET \
     ((sizeof(sgl_queue_t) + SGL_QUEUE_CACHE_LINE_SIZE - 1U) & \
      ~(SGL_QUEUE_CACHE_LINE_SIZE - 1U))
 
-#if defined(SGL_CFG_HAS_LTTNG)
-/*
- * A profiling build pays one trylock only to distinguish uncontended queue
- * access from the shared-ring contention interval shown in Trace Compass.
- */
-static SGL_ALWAYS_INLINE void sgl_queue_profiled_lock(
-    sgl_queue_t *queue,
-    const char *operation)
-{
-    if (sgl_osal_spinlock_try_lock(&queue->lock) == SGL_FALSE) {
-        SGL_TRACE_QUEUE_LOCK_CONTENDED(queue, operation);
-        sgl_osal_spinlock_lock(&queue->lock);
-        SGL_TRACE_QUEUE_LOCK_ACQUIRED(queue, operation);
-    }
-}
-#else
-#define sgl_queue_profiled_lock(queue, operation) \
-    sgl_osal_spinlock_lock(&(queue)->lock)
-#endif
-
-static SGL_ALWAYS_INLINE void **sgl_queue_data_address(sgl_queue_t *queue)
+static SGL_ALWAYS_INLINE sgl_queue_cell_t *sgl_queue_cells_address(sgl_queue_t *queue)
 {
     sgl_uint8_t *address;
+    sgl_queue_cell_t *result;
 
     /* cppcheck-suppress misra-c2012-11.3 */
     address = (sgl_uint8_t *)queue;
+    /* SGL-MEM-DEV-001: typed conversion from generic storage. */
+    /* cppcheck-suppress misra-c2012-11.5 */
+    result = (sgl_queue_cell_t *)(void *)&address[SGL_QUEUE_DATA_OFFSET];
+
+    return result;
+}
+
+static SGL_ALWAYS_INLINE sgl_queue_cell_t *sgl_queue_cell(const sgl_queue_t *queue, sgl_uint64_t position)
+{
+    sgl_size_t index;
+
+    if (queue->mask != 0U) {
+        index = (sgl_size_t)(position & queue->mask);
+    }
+    else {
+        index = (sgl_size_t)(position % (sgl_uint64_t)queue->capacity);
+    }
+
+    return &queue->cells[index];
+}
 
-    return sgl_memory_as_void_ptr_array(&address[SGL_QUEUE_DATA_OFFSET]);
+/* Signed distance from position to sequence; both only grow. */
+static SGL_ALWAYS_INLINE sgl_int64_t sgl_queue_lap(sgl_uint64_t sequence, sgl_uint64_t position)
+{
+    return (sgl_int64_t)(sequence - position);
 }
 
 static SGL_ALWAYS_INLINE void *sgl_queue_as_void_ptr(const void *data)
@@ -76,7 +152,102 @@ static SGL_ALWAYS_INLINE void *sgl_queue_as_void_ptr(const void *data)
     return result;
 }
 
-sgl_queue_t *sgl_queue_create(sgl_size_t capacity)
+/* Ready-to-use cells: cell i is free for position i. */
+static void sgl_queue_reset(sgl_queue_t *queue)
+{
+    sgl_size_t i;
+
+    for (i = 0U; i < queue->capacity; ++i) {
+        sgl_osal_atomic_uint64_store_relaxed(&queue->cells[i].sequence, (sgl_uint64_t)i);
+        queue->cells[i].data = SGL_NULL;
+    }
+    sgl_osal_atomic_uint64_store_relaxed(&queue->head, 0U);
+    sgl_osal_atomic_uint64_store_relaxed(&queue->tail, 0U);
+}
+
+/* Publishes a change on signal, then wakes up to count parked threads. */
+static void sgl_queue_notify(sgl_queue_signal_t *signal, sgl_size_t count)
+{
+    sgl_int32_t wake_count;
+
+    (void)sgl_osal_atomic_uint32_increment_release(&signal->event);
+    sgl_osal_atomic_thread_fence();
+    if (sgl_osal_atomic_uint32_load_relaxed(&signal->waiters) != 0U) {
+        wake_count = SGL_OSAL_WAKE_ALL;
+        if (count < (sgl_size_t)SGL_OSAL_WAKE_ALL) {
+            wake_count = (sgl_int32_t)count;
+        }
+        sgl_osal_wake_address(&signal->wait_queue, &signal->event, wake_count);
+    }
+}
+
+/* Absolute monotonic deadline; 0 when there is no clock to wait against. */
+static sgl_uint64_t sgl_queue_deadline(sgl_uint64_t timeout_ns)
+{
+    sgl_uint64_t now;
+    sgl_uint64_t deadline = SGL_QUEUE_WAIT_FOREVER;
+
+    if (timeout_ns != SGL_QUEUE_WAIT_FOREVER) {
+        now = sgl_osal_get_monotonic_ns();
+        if (now == 0U) {
+            deadline = 0U;
+        }
+        else if (timeout_ns < (SGL_QUEUE_WAIT_FOREVER - now)) {
+            deadline = now + timeout_ns;
+        }
+        else {
+            /* too far out to tell from forever */
+        }
+    }
+
+    return deadline;
+}
+
+/*
+ * Waits for signal's event to move from event.  Spins first, then parks
+ * until a wake-up or the deadline.  Returns SGL_FALSE once the deadline has
+ * passed; otherwise the caller tries again, as the wake may be spurious.
+ */
+static sgl_bool_t sgl_queue_wait(sgl_queue_signal_t *signal, sgl_uint32_t event, sgl_uint64_t deadline)
+{
+    sgl_bool_t result = SGL_TRUE;
+    sgl_uint64_t now;
+    sgl_uint32_t iteration;
+
+    now = 0U;
+    if (deadline != SGL_QUEUE_WAIT_FOREVER) {
+        now = sgl_osal_get_monotonic_ns();
+        if ((now == 0U) || (now >= deadline)) {
+            result = SGL_FALSE;
+        }
+    }
+    if (result == SGL_TRUE) {
+        for (iteration = 0U;
+             (iteration < SGL_QUEUE_SPIN_COUNT) &&
+             (sgl_osal_atomic_uint32_load_acquire(&signal->event) == event);
+             ++iteration) {
+            SGL_CPU_RELAX();
+        }
+    }
+    if ((result == SGL_TRUE) &&
+        (sgl_osal_atomic_uint32_load_acquire(&signal->event) == event)) {
+        (void)sgl_osal_atomic_uint32_fetch_increment_relaxed(&signal->waiters);
+        sgl_osal_atomic_thread_fence();
+        if (sgl_osal_atomic_uint32_load_acquire(&signal->event) == event) {
+            if (deadline == SGL_QUEUE_WAIT_FOREVER) {
+                sgl_osal_wait_on_address(&signal->wait_queue, &signal->event, event);
+            }
+            else {
+                sgl_osal_wait_on_address_for(&signal->wait_queue, &signal->event, event, deadline - now);
+            }
+        }
+        (void)sgl_osal_atomic_uint32_fetch_sub_relaxed(&signal->waiters, 1U);
+    }
+
+    return result;
+}
+
+static sgl_queue_t *sgl_queue_allocate(sgl_size_t capacity, sgl_bool_t is_blocking)
 {
     sgl_queue_t *queue = SGL_NULL;
     sgl_size_t allocation_size;
@@ -85,55 +256,92 @@ sgl_queue_t *sgl_queue_create(sgl_size_t capacity)
     /*
      * Queue allocation layout
      * -----------------------
-     * Keep metadata and the pointer ring in one allocation to remove one
+     * Keep metadata and the cell ring in one allocation to remove one
      * allocator lock/unlock pair from each short-lived resize submission.
-     * A cache-line-sized gap prevents the spinlock/count writes from sharing
-     * a line with the first operation pointers consumed by worker threads.
+     * The cache-line-sized head and tail lines keep position updates off
+     * the read-only fields and off the first cells consumed by workers.
      *
      *   allocation
-     *   +---------------- metadata ----------------+ gap + pointer ring ...
-     *   ^ queue                                    ^ queue->data
+     *   +- fields -+- head -+- tail -+ gap + cell ring ...
+     *   ^ queue                            ^ queue->cells
      */
     maximum_capacity =
-        (SGL_SIZE_MAX - SGL_QUEUE_DATA_OFFSET) / sizeof(void *);
+        (SGL_SIZE_MAX - SGL_QUEUE_DATA_OFFSET) / sizeof(sgl_queue_cell_t);
     if ((0U < capacity) && (capacity <= maximum_capacity)) {
         allocation_size = SGL_QUEUE_DATA_OFFSET +
-            (sizeof(void *) * capacity);
+            (sizeof(sgl_queue_cell_t) * capacity);
         queue = sgl_memory_as_queue(sgl_malloc(allocation_size));
         if (queue != SGL_NULL) {
-            queue->data = sgl_queue_data_address(queue);
-            queue->head = 0U;
-            queue->tail = 0U;
-            queue->count = 0U;
+            queue->cells = sgl_queue_cells_address(queue);
             queue->capacity = capacity;
-            sgl_osal_spinlock_init(&queue->lock);
+            queue->mask = 0U;
+            if ((capacity & (capacity - 1U)) == 0U) {
+                queue->mask = (sgl_uint64_t)capacity - 1U;
+            }
+            queue->is_blocking = is_blocking;
+            sgl_osal_atomic_uint32_store_relaxed(&queue->is_closed, 0U);
+            sgl_osal_atomic_uint32_store_relaxed(&queue->not_empty.event, 0U);
+            sgl_osal_atomic_uint32_store_relaxed(&queue->not_empty.waiters, 0U);
+            sgl_osal_atomic_uint32_store_relaxed(&queue->not_full.event, 0U);
+            sgl_osal_atomic_uint32_store_relaxed(&queue->not_full.waiters, 0U);
+            if (is_blocking == SGL_TRUE) {
+                sgl_osal_wait_queue_init(&queue->not_empty.wait_queue);
+                sgl_osal_wait_queue_init(&queue->not_full.wait_queue);
+            }
+            sgl_queue_reset(queue);
         }
     }
 
     return queue;
 }
 
+sgl_queue_t *sgl_queue_create(sgl_size_t capacity)
+{
+    return sgl_queue_allocate(capacity, SGL_FALSE);
+}
+
+sgl_queue_t *sgl_queue_create_blocking(sgl_size_t capacity)
+{
+    return sgl_queue_allocate(capacity, SGL_TRUE);
+}
+
 void sgl_queue_destroy(sgl_queue_t **queue)
 {
     if (queue != SGL_NULL) {
         if (*queue != SGL_NULL) {
-            sgl_osal_spinlock_destroy(&(*queue)->lock);
+            if ((*queue)->is_blocking == SGL_TRUE) {
+                sgl_osal_wait_queue_destroy(&(*queue)->not_empty.wait_queue);
+                sgl_osal_wait_queue_destroy(&(*queue)->not_full.wait_queue);
+            }
             sgl_free(*queue);
             *queue = SGL_NULL;
         }
     }
 }
 
+/* Neither queue may be in use by other threads; dst gets src's entries in order. */
 sgl_result_t sgl_queue_copy(sgl_queue_t *SGL_RESTRICT dst, const sgl_queue_t *SGL_RESTRICT src)
 {
     sgl_result_t result = SGL_SUCCESS;
+    sgl_uint64_t position;
+    sgl_uint64_t head;
+    sgl_uint64_t count;
+    sgl_queue_cell_t *cell;
 
     if ((dst != SGL_NULL) && (src != SGL_NULL)) {
         if (src->capacity <= dst->capacity) {
-            dst->count = src->count;
-            dst->head = src->head;
-            dst->tail = src->tail;
-            (void)sgl_memcpy(dst->data, src->data, sizeof(const void *) * src->capacity);
+            sgl_queue_reset(dst);
+            head = sgl_osal_atomic_uint64_load_relaxed(&src->head);
+            count = 0U;
+            for (position = sgl_osal_atomic_uint64_load_relaxed(&src->tail);
+                 position != head;
+                 ++position) {
+                cell = &dst->cells[count];
+                cell->data = sgl_queue_cell(src, position)->data;
+                sgl_osal_atomic_uint64_store_relaxed(&cell->sequence, count + 1U);
+                count++;
+            }
+            sgl_osal_atomic_uint64_store_relaxed(&dst->head, count);
         }
         else {
             result = SGL_ERROR_MISSMATCHED_CAPACITY;
@@ -149,18 +357,20 @@ sgl_result_t sgl_queue_copy(sgl_queue_t *SGL_RESTRICT dst, const sgl_queue_t *SG
 sgl_result_t sgl_queue_unsafe_enqueue(sgl_queue_t *SGL_RESTRICT queue, const void *SGL_RESTRICT data)
 {
     sgl_result_t result = SGL_SUCCESS;
-    sgl_size_t head;
+    sgl_queue_cell_t *cell;
+    sgl_uint64_t position;
 
     if ((queue != SGL_NULL) && (data != SGL_NULL)) {
-        result = sgl_queue_is_full(queue);
-        if (SGL_LIKELY(result == SGL_QUEUE_IS_NOT_FULL)) {
-            head = queue->head;
-            queue->data[head] = sgl_queue_as_void_ptr(data);
-            if (queue->capacity <= ++head) {
-                head = 0;
-            }
-            queue->head = head;
-            queue->count++;
+        position = sgl_osal_atomic_uint64_load_relaxed(&queue->head);
+        cell = sgl_queue_cell(queue, position);
+        if (SGL_LIKELY(sgl_osal_atomic_uint64_load_relaxed(&cell->sequence) == position)) {
+            cell->data = sgl_queue_as_void_ptr(data);
+            sgl_osal_atomic_uint64_store_relaxed(&cell->sequence, position + 1U);
+            sgl_osal_atomic_uint64_store_relaxed(&queue->head, position + 1U);
+            result = SGL_QUEUE_IS_NOT_FULL;
+        }
+        else {
+            result = SGL_QUEUE_IS_FULL;
         }
     }
     else {
@@ -173,21 +383,50 @@ sgl_result_t sgl_queue_unsafe_enqueue(sgl_queue_t *SGL_RESTRICT queue, const voi
 sgl_result_t sgl_queue_enqueue(sgl_queue_t *SGL_RESTRICT queue, const void *SGL_RESTRICT data)
 {
     sgl_result_t result = SGL_SUCCESS;
-    sgl_size_t head;
+    sgl_queue_cell_t *cell;
+    sgl_uint64_t position;
+    sgl_int64_t lap;
+    sgl_bool_t is_contended;
 
     if ((queue != SGL_NULL) && (data != SGL_NULL)) {
-        sgl_queue_profiled_lock(queue, SGL_TRACE_QUEUE_ENQUEUE);
-        result = sgl_queue_is_full(queue);
-        if (SGL_LIKELY(result == SGL_QUEUE_IS_NOT_FULL)) {
-            head = queue->head;
-            queue->data[head] = sgl_queue_as_void_ptr(data);
-            if (queue->capacity <= ++head) {
-                head = 0;
+        is_contended = SGL_FALSE;
+        cell = SGL_NULL;
+        position = sgl_osal_atomic_uint64_load_relaxed(&queue->head);
+        while (result == SGL_SUCCESS) {
+            cell = sgl_queue_cell(queue, position);
+            lap = sgl_queue_lap(sgl_osal_atomic_uint64_load_acquire(&cell->sequence), position);
+            if (lap == 0) {
+                if (sgl_osal_atomic_uint64_compare_exchange_relaxed(
+                        &queue->head, position, position + 1U) == SGL_TRUE) {
+                    result = SGL_QUEUE_IS_NOT_FULL;
+                }
+                else {
+                    if (is_contended == SGL_FALSE) {
+                        SGL_TRACE_QUEUE_LOCK_CONTENDED(queue, SGL_TRACE_QUEUE_ENQUEUE);
+                        is_contended = SGL_TRUE;
+                    }
+                    position = sgl_osal_atomic_uint64_load_relaxed(&queue->head);
+                }
+            }
+            else if (lap < 0) {
+                /* the cell's previous lap has not been consumed */
+                result = SGL_QUEUE_IS_FULL;
+            }
+            else {
+                /* another producer took this position */
+                position = sgl_osal_atomic_uint64_load_relaxed(&queue->head);
             }
-            queue->head = head;
-            queue->count++;
         }
-        sgl_osal_spinlock_unlock(&queue->lock);
+        if (result == SGL_QUEUE_IS_NOT_FULL) {
+            cell->data = sgl_queue_as_void_ptr(data);
+            sgl_osal_atomic_uint64_store_release(&cell->sequence, position + 1U);
+            if (queue->is_blocking == SGL_TRUE) {
+                sgl_queue_notify(&queue->not_empty, 1U);
+            }
+        }
+        if (is_contended == SGL_TRUE) {
+            SGL_TRACE_QUEUE_LOCK_ACQUIRED(queue, SGL_TRACE_QUEUE_ENQUEUE);
+        }
     }
     else {
         result = SGL_ERROR_INVALID_ARGUMENTS;
@@ -198,42 +437,293 @@ sgl_result_t sgl_queue_enqueue(sgl_queue_t *SGL_RESTRICT queue, const void *SGL_
 
 void *sgl_queue_dequeue(sgl_queue_t *queue)
 {
-    sgl_result_t result;
     void *data = SGL_NULL;
-    sgl_size_t tail;
+    sgl_queue_cell_t *cell;
+    sgl_uint64_t position;
+    sgl_int64_t lap;
+    sgl_bool_t is_searching;
+    sgl_bool_t is_contended;
 
     if (queue != SGL_NULL) {
-        sgl_queue_profiled_lock(queue, SGL_TRACE_QUEUE_DEQUEUE);
-        result = sgl_queue_is_empty(queue);
-        if (SGL_LIKELY(result == SGL_QUEUE_IS_NOT_EMPTY)) {
-            tail = queue->tail;
-            data = queue->data[tail];
-            if (queue->capacity <= ++tail) {
-                tail = 0;
+        is_searching = SGL_TRUE;
+        is_contended = SGL_FALSE;
+        position = sgl_osal_atomic_uint64_load_relaxed(&queue->tail);
+        while (is_searching == SGL_TRUE) {
+            cell = sgl_queue_cell(queue, position);
+            lap = sgl_queue_lap(sgl_osal_atomic_uint64_load_acquire(&cell->sequence), position + 1U);
+            if (lap == 0) {
+                if (sgl_osal_atomic_uint64_compare_exchange_relaxed(
+                        &queue->tail, position, position + 1U) == SGL_TRUE) {
+                    data = cell->data;
+                    sgl_osal_atomic_uint64_store_release(
+                        &cell->sequence, position + (sgl_uint64_t)queue->capacity);
+                    is_searching = SGL_FALSE;
+                }
+                else {
+                    if (is_contended == SGL_FALSE) {
+                        SGL_TRACE_QUEUE_LOCK_CONTENDED(queue, SGL_TRACE_QUEUE_DEQUEUE);
+                        is_contended = SGL_TRUE;
+                    }
+                    position = sgl_osal_atomic_uint64_load_relaxed(&queue->tail);
+                }
             }
-            queue->tail = tail;
-            queue->count--;
+            else if (lap < 0) {
+                /* not filled yet */
+                is_searching = SGL_FALSE;
+            }
+            else {
+                /* another consumer took this position */
+                position = sgl_osal_atomic_uint64_load_relaxed(&queue->tail);
+            }
+        }
+        if (is_contended == SGL_TRUE) {
+            SGL_TRACE_QUEUE_LOCK_ACQUIRED(queue, SGL_TRACE_QUEUE_DEQUEUE);
+        }
+        if ((data != SGL_NULL) && (queue->is_blocking == SGL_TRUE)) {
+            sgl_queue_notify(&queue->not_full, 1U);
         }
-        sgl_osal_spinlock_unlock(&queue->lock);
     }
 
     return data;
 }
 
+/*
+ * Claims up to count positions from *position on, each of whose cells has
+ * sequence position + i + offset, with one CAS.  Returns how many; position
+ * holds the first of them.
+ */
+static sgl_size_t sgl_queue_claim(
+    const sgl_queue_t *queue,
+    sgl_osal_atomic_uint64_t *position,
+    sgl_uint64_t offset,
+    sgl_size_t count,
+    sgl_uint64_t *first,
+    const char *operation)
+{
+    sgl_uint64_t current;
+    sgl_size_t ready;
+    sgl_size_t claimed;
+    sgl_int64_t lap;
+    sgl_bool_t is_searching;
+    sgl_bool_t is_contended;
+
+    SGL_UNUSED(operation);
+    claimed = 0U;
+    is_searching = (count > 0U) ? SGL_TRUE : SGL_FALSE;
+    is_contended = SGL_FALSE;
+    current = sgl_osal_atomic_uint64_load_relaxed(position);
+    *first = current;
+    while (is_searching == SGL_TRUE) {
+        ready = 0U;
+        lap = 0;
+        while ((ready < count) && (ready < queue->capacity) && (lap == 0)) {
+            lap = sgl_queue_lap(
+                sgl_osal_atomic_uint64_load_acquire(
+                    &sgl_queue_cell(queue, current + ready)->sequence),
+                current + ready + offset);
+            if (lap == 0) {
+                ready++;
+            }
+        }
+        if (ready == 0U) {
+            if (lap < 0) {
+                /* full or empty at the first position */
+                is_searching = SGL_FALSE;
+            }
+            else {
+                /* another thread took this position */
+                current = sgl_osal_atomic_uint64_load_relaxed(position);
+            }
+        }
+        else if (sgl_osal_atomic_uint64_compare_exchange_relaxed(
+                     position, current, current + ready) == SGL_TRUE) {
+            claimed = ready;
+            *first = current;
+            is_searching = SGL_FALSE;
+        }
+        else {
+            if (is_contended == SGL_FALSE) {
+                SGL_TRACE_QUEUE_LOCK_CONTENDED(queue, operation);
+                is_contended = SGL_TRUE;
+            }
+            current = sgl_osal_atomic_uint64_load_relaxed(position);
+        }
+    }
+    if (is_contended == SGL_TRUE) {
+        SGL_TRACE_QUEUE_LOCK_ACQUIRED(queue, operation);
+    }
+
+    return claimed;
+}
+
+/* Index of the cell of position and how many cells follow it before the wrap. */
+static sgl_size_t sgl_queue_run(
+    const sgl_queue_t *queue,
+    sgl_uint64_t position,
+    sgl_size_t count,
+    sgl_size_t *index)
+{
+    sgl_size_t run;
+
+    *index = (sgl_size_t)(sgl_queue_cell(queue, position) - queue->cells);
+    run = queue->capacity - *index;
+
+    return (count < run) ? count : run;
+}
+
+sgl_size_t sgl_queue_enqueue_bulk(sgl_queue_t *SGL_RESTRICT queue, void *const *SGL_RESTRICT data, sgl_size_t count)
+{
+    sgl_queue_cell_t *cell;
+    sgl_uint64_t first;
+    sgl_size_t claimed;
+    sgl_size_t index;
+    sgl_size_t run;
+    sgl_size_t valid;
+    sgl_size_t i;
+
+    claimed = 0U;
+    if ((queue != SGL_NULL) && (data != SGL_NULL)) {
+        /* like sgl_queue_enqueue, a NULL entry is rejected; all or nothing */
+        valid = count;
+        for (i = 0U; i < count; ++i) {
+            if (data[i] == SGL_NULL) {
+                valid = 0U;
+            }
+        }
+        claimed = sgl_queue_claim(
+            queue, &queue->head, 0U, valid, &first, SGL_TRACE_QUEUE_ENQUEUE);
+        run = sgl_queue_run(queue, first, claimed, &index);
+        for (i = 0U; i < claimed; ++i) {
+            /* second run starts over at cell 0 */
+            cell = (i < run) ? &queue->cells[index + i] : &queue->cells[i - run];
+            cell->data = data[i];
+            sgl_osal_atomic_uint64_store_release(&cell->sequence, first + i + 1U);
+        }
+        if ((claimed > 0U) && (queue->is_blocking == SGL_TRUE)) {
+            sgl_queue_notify(&queue->not_empty, claimed);
+        }
+    }
+
+    return claimed;
+}
+
+sgl_size_t sgl_queue_dequeue_bulk(sgl_queue_t *SGL_RESTRICT queue, void **SGL_RESTRICT data, sgl_size_t count)
+{
+    sgl_queue_cell_t *cell;
+    sgl_uint64_t first;
+    sgl_size_t claimed;
+    sgl_size_t index;
+    sgl_size_t run;
+    sgl_size_t i;
+
+    claimed = 0U;
+    if ((queue != SGL_NULL) && (data != SGL_NULL)) {
+        claimed = sgl_queue_claim(
+            queue, &queue->tail, 1U, count, &first, SGL_TRACE_QUEUE_DEQUEUE);
+        run = sgl_queue_run(queue, first, claimed, &index);
+        for (i = 0U; i < claimed; ++i) {
+            cell = (i < run) ? &queue->cells[index + i] : &queue->cells[i - run];
+            data[i] = cell->data;
+            sgl_osal_atomic_uint64_store_release(
+                &cell->sequence, first + i + (sgl_uint64_t)queue->capacity);
+        }
+        if ((claimed > 0U) && (queue->is_blocking == SGL_TRUE)) {
+            sgl_queue_notify(&queue->not_full, claimed);
+        }
+    }
+
+    return claimed;
+}
+
+sgl_result_t sgl_queue_enqueue_wait(sgl_queue_t *SGL_RESTRICT queue, const void *SGL_RESTRICT data, sgl_uint64_t timeout_ns)
+{
+    sgl_result_t result = SGL_SUCCESS;
+    sgl_uint64_t deadline;
+    sgl_uint32_t event;
+
+    if ((queue != SGL_NULL) && (data != SGL_NULL) && (queue->is_blocking == SGL_TRUE)) {
+        deadline = sgl_queue_deadline(timeout_ns);
+        while (result == SGL_SUCCESS) {
+            /* snapshot before the attempt so a dequeue in between is not missed */
+            event = sgl_osal_atomic_uint32_load_acquire(&queue->not_full.event);
+            if (sgl_osal_atomic_uint32_load_acquire(&queue->is_closed) != 0U) {
+                result = SGL_QUEUE_IS_CLOSED;
+            }
+            else if (sgl_queue_enqueue(queue, data) == SGL_QUEUE_IS_NOT_FULL) {
+                result = SGL_QUEUE_IS_NOT_FULL;
+            }
+            else if (sgl_queue_wait(&queue->not_full, event, deadline) == SGL_FALSE) {
+                result = SGL_QUEUE_IS_FULL;
+            }
+            else {
+                /* something moved; try again */
+            }
+        }
+    }
+    else {
+        result = SGL_ERROR_INVALID_ARGUMENTS;
+    }
+
+    return result;
+}
+
+sgl_result_t sgl_queue_dequeue_wait(sgl_queue_t *SGL_RESTRICT queue, void **SGL_RESTRICT data, sgl_uint64_t timeout_ns)
+{
+    sgl_result_t result = SGL_SUCCESS;
+    sgl_uint64_t deadline;
+    sgl_uint32_t event;
+    sgl_uint32_t is_closed;
+
+    if ((queue != SGL_NULL) && (data != SGL_NULL) && (queue->is_blocking == SGL_TRUE)) {
+        deadline = sgl_queue_deadline(timeout_ns);
+        while (result == SGL_SUCCESS) {
+            event = sgl_osal_atomic_uint32_load_acquire(&queue->not_empty.event);
+            /* read before the attempt: entries from before the close are seen */
+            is_closed = sgl_osal_atomic_uint32_load_acquire(&queue->is_closed);
+            *data = sgl_queue_dequeue(queue);
+            if (*data != SGL_NULL) {
+                result = SGL_QUEUE_IS_NOT_EMPTY;
+            }
+            else if (is_closed != 0U) {
+                result = SGL_QUEUE_IS_CLOSED;
+            }
+            else if (sgl_queue_wait(&queue->not_empty, event, deadline) == SGL_FALSE) {
+                result = SGL_QUEUE_IS_EMPTY;
+            }
+            else {
+                /* something moved; try again */
+            }
+        }
+    }
+    else {
+        result = SGL_ERROR_INVALID_ARGUMENTS;
+    }
+
+    return result;
+}
+
+void sgl_queue_close(sgl_queue_t *queue)
+{
+    if ((queue != SGL_NULL) && (queue->is_blocking == SGL_TRUE)) {
+        (void)sgl_osal_atomic_uint32_increment_release(&queue->is_closed);
+        sgl_queue_notify(&queue->not_empty, SGL_SIZE_MAX);
+        sgl_queue_notify(&queue->not_full, SGL_SIZE_MAX);
+    }
+}
+
+/* The entry stays valid only while no other thread dequeues it. */
 void *sgl_queue_peek(sgl_queue_t *queue)
 {
-    sgl_result_t result;
     void *data = SGL_NULL;
-    sgl_size_t tail;
+    const sgl_queue_cell_t *cell;
+    sgl_uint64_t position;
 
     if (queue != SGL_NULL) {
-        sgl_queue_profiled_lock(queue, SGL_TRACE_QUEUE_PEEK);
-        result = sgl_queue_is_empty(queue);
-        if (SGL_LIKELY(result == SGL_QUEUE_IS_NOT_EMPTY)) {
-            tail = queue->tail;
-            data = queue->data[tail];
+        position = sgl_osal_atomic_uint64_load_relaxed(&queue->tail);
+        cell = sgl_queue_cell(queue, position);
+        if (sgl_osal_atomic_uint64_load_acquire(&cell->sequence) == (position + 1U)) {
+            data = cell->data;
         }
-        sgl_osal_spinlock_unlock(&queue->lock);
     }
 
     return data;
@@ -241,12 +731,12 @@ void *sgl_queue_peek(sgl_queue_t *queue)
 
 sgl_result_t sgl_queue_is_empty(const sgl_queue_t *queue)
 {
-    return (queue->count == 0U) ? SGL_QUEUE_IS_EMPTY : SGL_QUEUE_IS_NOT_EMPTY;
+    return (sgl_queue_get_count(queue) == 0U) ? SGL_QUEUE_IS_EMPTY : SGL_QUEUE_IS_NOT_EMPTY;
 }
 
 sgl_result_t sgl_queue_is_full(const sgl_queue_t *queue)
 {
-    return (queue->count == queue->capacity) ? SGL_QUEUE_IS_FULL : SGL_QUEUE_IS_NOT_FULL;
+    return (sgl_queue_get_count(queue) == queue->capacity) ? SGL_QUEUE_IS_FULL : SGL_QUEUE_IS_NOT_FULL;
 }
 
 sgl_size_t sgl_queue_get_capacity(const sgl_queue_t *queue)
@@ -254,7 +744,24 @@ sgl_size_t sgl_queue_get_capacity(const sgl_queue_t *queue)
     return (queue != SGL_NULL) ? queue->capacity : (sgl_size_t)0U;
 }
 
+/*
+ * Entries claimed by producers and not yet by consumers.  tail is read
+ * first with acquire, so the head load cannot move ahead of it and head
+ * can only be ahead of tail; under concurrent use the count is a snapshot
+ * clamped to the capacity.
+ */
 sgl_size_t sgl_queue_get_count(const sgl_queue_t *queue)
 {
-    return (queue != SGL_NULL) ? queue->count : (sgl_size_t)0U;
+    sgl_uint64_t tail;
+    sgl_uint64_t count = 0U;
+
+    if (queue != SGL_NULL) {
+        tail = sgl_osal_atomic_uint64_load_acquire(&queue->tail);
+        count = sgl_osal_atomic_uint64_load_relaxed(&queue->head) - tail;
+        if (count > (sgl_uint64_t)queue->capacity) {
+            count = (sgl_uint64_t)queue->capacity;
+        }
+    }
+
+    return (sgl_size_t)count;
 }
@@ -0,0 +1,230 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright (c) 2025 Dylan Hong
+ *
+ * This code is released under the MIT License.
+ * For conditions of distribution and use, see the LICENSE file.
+ */
+#include <sgl-core.h>
+#include "sgl-osal.h"
+#include <sgl_memory_cast.h>
+
+/*
+ * Design and Operation
+ * --------------------
+ * A ring of fixed-size slots between exactly one producer and one consumer.
+ * Each side owns one position and only ever writes its own, so there are no
+ * CASes and no per-slot state; the slot payload is written in place:
+ *
+ *   producer: slot = reserve(), fill slot, commit()    head++ (release)
+ *   consumer: slot = peek(),    read slot, release()   tail++ (release)
+ *
+ * Each side keeps the last value it read of the other's position next to
+ * its own, on its own cache line.  The producer only re-reads tail when its
+ * copy says the ring is full and the consumer only re-reads head when its
+ * copy says it is empty, so in steady state neither touches the other's
+ * line on every call.
+ *
+ *   +- fields -+- head, cached_tail -+- tail, cached_head -+ gap + slots ...
+ *                producer line          consumer line
+ *
+ * The capacity is rounded up to a power of two so positions map to slots
+ * with a mask.  Slots are rounded up to SGL_SPSC_RING_SLOT_ALIGNMENT bytes.
+ */
+#define SGL_SPSC_RING_CACHE_LINE_SIZE    (64U)
+#define SGL_SPSC_RING_SLOT_ALIGNMENT     (16U)
+
+struct sgl_spsc_ring {
+    sgl_uint8_t *slots;
+    sgl_uint64_t mask;
+    sgl_size_t capacity;
+    sgl_size_t stride;
+    sgl_size_t payload_size;
+    sgl_uint8_t reserved[SGL_SPSC_RING_CACHE_LINE_SIZE -
+                         (sizeof(sgl_uint8_t *) + sizeof(sgl_uint64_t) + (3U * sizeof(sgl_size_t)))];
+    sgl_osal_atomic_uint64_t head;
+    sgl_uint64_t cached_tail;
+    sgl_uint8_t producer_padding[SGL_SPSC_RING_CACHE_LINE_SIZE - (2U * sizeof(sgl_uint64_t))];
+    sgl_osal_atomic_uint64_t tail;
+    sgl_uint64_t cached_head;
+    sgl_uint8_t consumer_padding[SGL_SPSC_RING_CACHE_LINE_SIZE - (2U * sizeof(sgl_uint64_t))];
+};
+
+#define SGL_SPSC_RING_DATA_OFFSET \
+    ((sizeof(sgl_spsc_ring_t) + SGL_SPSC_RING_CACHE_LINE_SIZE - 1U) & \
+     ~(SGL_SPSC_RING_CACHE_LINE_SIZE - 1U))
+
+static SGL_ALWAYS_INLINE sgl_uint8_t *sgl_spsc_ring_slot(const sgl_spsc_ring_t *ring, sgl_uint64_t position)
+{
+    return &ring->slots[(sgl_size_t)(position & ring->mask) * ring->stride];
+}
+
+sgl_spsc_ring_t *sgl_spsc_ring_create(sgl_size_t capacity, sgl_size_t payload_size)
+{
+    sgl_spsc_ring_t *ring = SGL_NULL;
+    sgl_uint8_t *memory;
+    sgl_size_t rounded;
+    sgl_size_t stride;
+
+    stride = 0U;
+    rounded = 1U;
+    if ((capacity > 0U) && (payload_size > 0U) &&
+        (payload_size <= (SGL_SIZE_MAX - SGL_SPSC_RING_SLOT_ALIGNMENT))) {
+        stride = (payload_size + SGL_SPSC_RING_SLOT_ALIGNMENT - 1U) &
+                 ~(SGL_SPSC_RING_SLOT_ALIGNMENT - 1U);
+        while ((rounded < capacity) && (rounded <= (SGL_SIZE_MAX / 2U))) {
+            rounded *= 2U;
+        }
+    }
+    if ((stride > 0U) && (rounded >= capacity) &&
+        (rounded <= ((SGL_SIZE_MAX - SGL_SPSC_RING_DATA_OFFSET) / stride))) {
+        memory = sgl_memory_as_uint8(sgl_malloc(SGL_SPSC_RING_DATA_OFFSET + (rounded * stride)));
+        ring = sgl_memory_as_spsc_ring(memory);
+        if (ring != SGL_NULL) {
+            ring->slots = &memory[SGL_SPSC_RING_DATA_OFFSET];
+            ring->mask = (sgl_uint64_t)rounded - 1U;
+            ring->capacity = rounded;
+            ring->stride = stride;
+            ring->payload_size = payload_size;
+            sgl_osal_atomic_uint64_store_relaxed(&ring->head, 0U);
+            ring->cached_tail = 0U;
+            sgl_osal_atomic_uint64_store_relaxed(&ring->tail, 0U);
+            ring->cached_head = 0U;
+        }
+    }
+
+    return ring;
+}
+
+void sgl_spsc_ring_destroy(sgl_spsc_ring_t **ring)
+{
+    if (ring != SGL_NULL) {
+        SGL_SAFE_FREE(*ring);
+    }
+}
+
+void *sgl_spsc_ring_reserve(sgl_spsc_ring_t *ring)
+{
+    void *slot = SGL_NULL;
+    sgl_uint64_t head;
+
+    if (ring != SGL_NULL) {
+        head = sgl_osal_atomic_uint64_load_relaxed(&ring->head);
+        if ((head - ring->cached_tail) == (sgl_uint64_t)ring->capacity) {
+            /* full as far as we know; see what the consumer released since */
+            ring->cached_tail = sgl_osal_atomic_uint64_load_acquire(&ring->tail);
+        }
+        if ((head - ring->cached_tail) < (sgl_uint64_t)ring->capacity) {
+            slot = sgl_spsc_ring_slot(ring, head);
+        }
+    }
+
+    return slot;
+}
+
+void sgl_spsc_ring_commit(sgl_spsc_ring_t *ring)
+{
+    sgl_uint64_t head;
+
+    if (ring != SGL_NULL) {
+        head = sgl_osal_atomic_uint64_load_relaxed(&ring->head);
+        /* only a slot handed out by reserve can be committed */
+        if ((head - ring->cached_tail) < (sgl_uint64_t)ring->capacity) {
+            sgl_osal_atomic_uint64_store_release(&ring->head, head + 1U);
+        }
+    }
+}
+
+void *sgl_spsc_ring_peek(sgl_spsc_ring_t *ring)
+{
+    void *slot = SGL_NULL;
+    sgl_uint64_t tail;
+
+    if (ring != SGL_NULL) {
+        tail = sgl_osal_atomic_uint64_load_relaxed(&ring->tail);
+        if (ring->cached_head == tail) {
+            /* empty as far as we know; see what the producer committed since */
+            ring->cached_head = sgl_osal_atomic_uint64_load_acquire(&ring->head);
+        }
+        if (ring->cached_head != tail) {
+            slot = sgl_spsc_ring_slot(ring, tail);
+        }
+    }
+
+    return slot;
+}
+
+void sgl_spsc_ring_release(sgl_spsc_ring_t *ring)
+{
+    sgl_uint64_t tail;
+
+    if (ring != SGL_NULL) {
+        tail = sgl_osal_atomic_uint64_load_relaxed(&ring->tail);
+        /* only a slot handed out by peek can be released */
+        if (ring->cached_head != tail) {
+            sgl_osal_atomic_uint64_store_release(&ring->tail, tail + 1U);
+        }
+    }
+}
+
+sgl_result_t sgl_spsc_ring_push(sgl_spsc_ring_t *SGL_RESTRICT ring, const void *SGL_RESTRICT payload)
+{
+    sgl_result_t result = SGL_ERROR_INVALID_ARGUMENTS;
+    void *slot;
+
+    if ((ring != SGL_NULL) && (payload != SGL_NULL)) {
+        result = SGL_QUEUE_IS_FULL;
+        slot = sgl_spsc_ring_reserve(ring);
+        if (slot != SGL_NULL) {
+            (void)sgl_memcpy(slot, payload, ring->payload_size);
+            sgl_spsc_ring_commit(ring);
+            result = SGL_QUEUE_IS_NOT_FULL;
+        }
+    }
+
+    return result;
+}
+
+sgl_result_t sgl_spsc_ring_pop(sgl_spsc_ring_t *SGL_RESTRICT ring, void *SGL_RESTRICT payload)
+{
+    sgl_result_t result = SGL_ERROR_INVALID_ARGUMENTS;
+    const void *slot;
+
+    if ((ring != SGL_NULL) && (payload != SGL_NULL)) {
+        result = SGL_QUEUE_IS_EMPTY;
+        slot = sgl_spsc_ring_peek(ring);
+        if (slot != SGL_NULL) {
+            (void)sgl_memcpy(payload, slot, ring->payload_size);
+            sgl_spsc_ring_release(ring);
+            result = SGL_QUEUE_IS_NOT_EMPTY;
+        }
+    }
+
+    return result;
+}
+
+sgl_size_t sgl_spsc_ring_get_capacity(const sgl_spsc_ring_t *ring)
+{
+    sgl_size_t capacity = 0U;
+
+    if (ring != SGL_NULL) {
+        capacity = ring->capacity;
+    }
+
+    return capacity;
+}
+
+/* A snapshot from any thread; tail is read first so head is never behind it. */
+sgl_size_t sgl_spsc_ring_get_count(const sgl_spsc_ring_t *ring)
+{
+    sgl_uint64_t tail;
+    sgl_size_t count = 0U;
+
+    if (ring != SGL_NULL) {
+        tail = sgl_osal_atomic_uint64_load_acquire(&ring->tail);
+        count = (sgl_size_t)(sgl_osal_atomic_uint64_load_acquire(&ring->head) - tail);
+    }
+
+    return count;
+}
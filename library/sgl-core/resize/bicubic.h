@@ -37,11 +37,6 @@ typedef struct  {
     sgl_int32_t dst_stride;
 } sgl_bicubic_data_t;
 
-typedef struct  {
-    sgl_int32_t row;
-    sgl_int32_t count;
-} sgl_bicubic_current_t;
-
 struct sgl_bicubic_lookup_table {
     sgl_int32_t d_width;
     sgl_int32_t d_height;
@@ -51,28 +46,6 @@ struct sgl_bicubic_lookup_table {
     bicubic_row_lookup_t row_lookup;
 };
 
-static SGL_ALWAYS_INLINE sgl_bicubic_current_t *sgl_memory_as_bicubic_current(void *memory)
-{
-    sgl_bicubic_current_t *result;
-
-    /* SGL-MEM-DEV-001: typed conversion from generic storage. */
-    /* cppcheck-suppress misra-c2012-11.5 */
-    result = (sgl_bicubic_current_t *)memory;
-
-    return result;
-}
-
-static SGL_ALWAYS_INLINE const sgl_bicubic_current_t *sgl_memory_as_const_bicubic_current(const void *memory)
-{
-    const sgl_bicubic_current_t *result;
-
-    /* SGL-MEM-DEV-001: typed conversion from generic storage. */
-    /* cppcheck-suppress misra-c2012-11.5 */
-    result = (const sgl_bicubic_current_t *)memory;
-
-    return result;
-}
-
 static SGL_ALWAYS_INLINE sgl_bicubic_data_t *sgl_memory_as_bicubic_data(void *memory)
 {
     sgl_bicubic_data_t *result;
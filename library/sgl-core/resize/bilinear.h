@@ -35,11 +35,6 @@ typedef struct  {
     sgl_int32_t dst_stride;
 } sgl_bilinear_data_t;
 
-typedef struct  {
-    sgl_int32_t row;
-    sgl_int32_t count;
-} sgl_bilinear_current_t;
-
 struct sgl_bilinear_lookup_table {
     sgl_int32_t d_width;
     sgl_int32_t d_height;
@@ -49,28 +44,6 @@ struct sgl_bilinear_lookup_table {
     bilinear_row_lookup_t row_lookup;
 };
 
-static SGL_ALWAYS_INLINE sgl_bilinear_current_t *sgl_memory_as_bilinear_current(void *memory)
-{
-    sgl_bilinear_current_t *result;
-
-    /* SGL-MEM-DEV-001: typed conversion from generic storage. */
-    /* cppcheck-suppress misra-c2012-11.5 */
-    result = (sgl_bilinear_current_t *)memory;
-
-    return result;
-}
-
-static SGL_ALWAYS_INLINE const sgl_bilinear_current_t *sgl_memory_as_const_bilinear_current(const void *memory)
-{
-    const sgl_bilinear_current_t *result;
-
-    /* SGL-MEM-DEV-001: typed conversion from generic storage. */
-    /* cppcheck-suppress misra-c2012-11.5 */
-    result = (const sgl_bilinear_current_t *)memory;
-
-    return result;
-}
-
 static SGL_ALWAYS_INLINE sgl_bilinear_data_t *sgl_memory_as_bilinear_data(void *memory)
 {
     sgl_bilinear_data_t *result;
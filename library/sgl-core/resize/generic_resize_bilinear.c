@@ -9,11 +9,16 @@
 #include <sgl-core.h>
 #include "bilinear.h"
 #include "resize_bitops.h"
+#include "resize_strided.h"
 #include "sgl_trace.h"
 #include "threaded_resize.h"
 
 #if defined(SGL_CFG_HAS_THREAD)
-static void sgl_generic_resize_bilinear_routine(void *SGL_RESTRICT current, void *SGL_RESTRICT cookie);
+static void sgl_generic_resize_bilinear_routine(
+    sgl_int32_t begin,
+    sgl_int32_t end,
+    sgl_threadpool_scratch_t *SGL_RESTRICT scratch,
+    void *SGL_RESTRICT cookie);
 #endif  /* !SGL_CFG_HAS_THREAD */
 
 #define SGL_BILINEAR_PAIR_SHIFT (32U)
@@ -303,15 +308,28 @@ static SGL_ALWAYS_INLINE void sgl_generic_bilinear_vertical_bpp32(
     }
 }
 
-static sgl_result_t sgl_generic_resize_bilinear_range_separable_bpp32(
+static SGL_ALWAYS_INLINE sgl_size_t sgl_generic_bilinear_row_storage_size_bpp32(
+    const sgl_bilinear_data_t *data)
+{
+    return sizeof(sgl_q11_ext_t) *
+           (sgl_size_t)SGL_RESIZE_BPP32_BYTE_OFFSET(data->lut->d_width) *
+           (sgl_size_t)SGL_GENERIC_BILINEAR_ROW_CACHE_COUNT;
+}
+
+/*
+ * row_storage holds the horizontally filtered row cache and must be
+ * sgl_generic_bilinear_row_storage_size_bpp32() bytes.  The single-threaded
+ * path allocates it once; workers take it from their scratch arena, so a
+ * chunk no longer pays for a malloc/free pair.
+ */
+static void sgl_generic_resize_bilinear_range_separable_bpp32(
     sgl_bilinear_data_t *data,
+    sgl_q11_ext_t *row_storage,
     sgl_int32_t start_row,
     sgl_int32_t row_count)
 {
-    sgl_result_t result;
     sgl_generic_bilinear_row_cache_t
         cache[SGL_GENERIC_BILINEAR_ROW_CACHE_COUNT];
-    sgl_q11_ext_t *row_storage;
     const sgl_q11_ext_t *top_row;
     const sgl_q11_ext_t *bottom_row;
     sgl_int32_t row;
@@ -323,8 +341,6 @@ static sgl_result_t sgl_generic_resize_bilinear_range_separable_bpp32(
     sgl_int32_t y2;
     sgl_uint8_t *dst_row;
 
-    result = SGL_SUCCESS;
-    row_storage = SGL_NULL;
     d_height = data->lut->d_height;
     row_width = SGL_RESIZE_BPP32_BYTE_OFFSET(data->lut->d_width);
     end_row = start_row + row_count;
@@ -332,39 +348,26 @@ static sgl_result_t sgl_generic_resize_bilinear_range_separable_bpp32(
         end_row = d_height;
     }
 
-    row_storage = sgl_memory_as_q11_ext(sgl_malloc(
-        sizeof(sgl_q11_ext_t) * (sgl_size_t)row_width *
-        (sgl_size_t)SGL_GENERIC_BILINEAR_ROW_CACHE_COUNT));
-
-    if (row_storage != SGL_NULL) {
-        for (slot = 0; slot < SGL_GENERIC_BILINEAR_ROW_CACHE_COUNT; ++slot) {
-            cache[slot].y = -1;
-            cache[slot].row = &row_storage[slot * row_width];
-        }
-
-        for (row = start_row; row < end_row; ++row) {
-            y1 = data->lut->row_lookup.y1[row];
-            y2 = data->lut->row_lookup.y2[row];
-            top_row = sgl_generic_bilinear_get_cached_row_bpp32(
-                cache, y1, data);
-            bottom_row = sgl_generic_bilinear_get_cached_row_bpp32(
-                cache, y2, data);
-            dst_row = &data->dst[row * data->dst_stride];
-            sgl_generic_bilinear_vertical_bpp32(
-                dst_row,
-                top_row,
-                bottom_row,
-                (sgl_q11_ext_t)data->lut->row_lookup.q[row],
-                row_width);
-        }
-    }
-    else {
-        result = SGL_ERROR_MEMORY_ALLOCATION;
+    for (slot = 0; slot < SGL_GENERIC_BILINEAR_ROW_CACHE_COUNT; ++slot) {
+        cache[slot].y = -1;
+        cache[slot].row = &row_storage[slot * row_width];
     }
 
-    SGL_SAFE_FREE(row_storage);
-
-    return result;
+    for (row = start_row; row < end_row; ++row) {
+        y1 = data->lut->row_lookup.y1[row];
+        y2 = data->lut->row_lookup.y2[row];
+        top_row = sgl_generic_bilinear_get_cached_row_bpp32(
+            cache, y1, data);
+        bottom_row = sgl_generic_bilinear_get_cached_row_bpp32(
+            cache, y2, data);
+        dst_row = &data->dst[row * data->dst_stride];
+        sgl_generic_bilinear_vertical_bpp32(
+            dst_row,
+            top_row,
+            bottom_row,
+            (sgl_q11_ext_t)data->lut->row_lookup.q[row],
+            row_width);
+    }
 }
 
 static SGL_ALWAYS_INLINE void sgl_generic_resize_bilinear_line_stripe_scalar(
@@ -513,16 +516,15 @@ static SGL_ALWAYS_INLINE sgl_bool_t sgl_generic_resize_bilinear_is_same_size(
 
 static SGL_ALWAYS_INLINE void sgl_generic_resize_bilinear_copy_same_size(
     sgl_uint8_t *SGL_RESTRICT dst,
+    sgl_int32_t dst_stride,
     sgl_int32_t d_width,
     sgl_int32_t d_height,
     sgl_uint8_t *SGL_RESTRICT src,
+    sgl_int32_t src_stride,
     sgl_int32_t bpp)
 {
-    sgl_size_t copy_size;
-
-    copy_size = (sgl_size_t)d_width * (sgl_size_t)d_height * (sgl_size_t)bpp;
     if (dst != src) {
-        (void)sgl_memcpy(dst, src, copy_size);
+        sgl_resize_copy_rows(dst, dst_stride, src, src_stride, d_width, d_height, bpp);
     }
 }
 
@@ -561,16 +563,16 @@ static SGL_ALWAYS_INLINE void sgl_generic_resize_bilinear_set_data(
     sgl_bilinear_lookup_t *lut,
     sgl_uint8_t *SGL_RESTRICT dst,
     sgl_uint8_t *SGL_RESTRICT src,
-    sgl_int32_t s_width,
-    sgl_int32_t d_width,
+    sgl_int32_t src_stride,
+    sgl_int32_t dst_stride,
     sgl_int32_t bpp)
 {
     data->bpp = bpp;
     data->src = src;
     data->dst = dst;
     data->lut = lut;
-    data->src_stride = s_width * bpp;
-    data->dst_stride = d_width * bpp;
+    data->src_stride = src_stride;
+    data->dst_stride = dst_stride;
 }
 
 static SGL_ALWAYS_INLINE void sgl_generic_resize_bilinear_single_fallback(
@@ -590,14 +592,19 @@ static sgl_result_t sgl_generic_resize_bilinear_single(
     sgl_int32_t bpp)
 {
     sgl_result_t result;
+    sgl_q11_ext_t *row_storage;
 
     result = SGL_SUCCESS;
     switch (bpp) {
     case SGL_BPP32:
-        result = sgl_generic_resize_bilinear_range_separable_bpp32(
-            data, 0, d_height);
-        if (result != SGL_SUCCESS) {
-            result = SGL_SUCCESS;
+        row_storage = sgl_memory_as_q11_ext(sgl_malloc(
+            sgl_generic_bilinear_row_storage_size_bpp32(data)));
+        if (row_storage != SGL_NULL) {
+            sgl_generic_resize_bilinear_range_separable_bpp32(
+                data, row_storage, 0, d_height);
+            SGL_SAFE_FREE(row_storage);
+        }
+        else {
             sgl_generic_resize_bilinear_single_fallback(data, d_height);
         }
         break;
@@ -638,48 +645,15 @@ static sgl_result_t sgl_generic_resize_bilinear_threaded(
     sgl_int32_t bpp)
 {
     sgl_result_t result;
-    sgl_bilinear_current_t *currents;
-    sgl_queue_t *operations;
-    sgl_int32_t i;
-    sgl_int32_t num_operations;
-    sgl_int32_t mod_operations;
     sgl_int32_t bulk_size;
 
-    result = SGL_ERROR_MEMORY_ALLOCATION;
-    currents = SGL_NULL;
-    operations = SGL_NULL;
     bulk_size = sgl_generic_resize_bilinear_thread_bulk_size(
         pool, d_height, bpp);
-    num_operations = d_height / bulk_size;
-    mod_operations = d_height % bulk_size;
-    if (mod_operations != 0) {
-        num_operations += 1;
-    }
 
-    operations = sgl_queue_create((sgl_size_t)num_operations);
-    currents = sgl_memory_as_bilinear_current(sgl_malloc(
-        sizeof(sgl_bilinear_current_t) * (sgl_size_t)num_operations));
-    if ((operations != SGL_NULL) && (currents != SGL_NULL)) {
-        for (i = 0; i < num_operations; ++i) {
-            currents[i].row = i * bulk_size;
-            currents[i].count = bulk_size;
-            (void)sgl_queue_unsafe_enqueue(operations, (const void *)&currents[i]);
-        }
-
-        if (mod_operations != 0) {
-            currents[num_operations - 1].count = mod_operations;
-        }
-
-        /* multi-threaded resize */
-        result = sgl_threadpool_attach_routine_consuming(
-            pool,
-            sgl_generic_resize_bilinear_routine,
-            operations,
-            (void *)data);
-        sgl_queue_destroy(&operations);
-    }
-    SGL_SAFE_FREE(currents);
-    SGL_SAFE_FREE(operations);
+    /* multi-threaded resize */
+    result = sgl_threadpool_parallel_for_scratch(
+        pool, 0, d_height, bulk_size,
+        sgl_generic_resize_bilinear_routine, (void *)data);
 
     return result;
 }
@@ -709,10 +683,10 @@ static sgl_result_t sgl_generic_resize_bilinear_run(
     return result;
 }
 
-sgl_result_t sgl_generic_resize_bilinear(
+sgl_result_t sgl_generic_resize_bilinear_strided(
                 sgl_threadpool_t *SGL_RESTRICT pool, sgl_bilinear_lookup_t *SGL_RESTRICT ext_lut,
-                sgl_uint8_t *SGL_RESTRICT dst, sgl_int32_t d_width, sgl_int32_t d_height,
-                sgl_uint8_t *SGL_RESTRICT src, sgl_int32_t s_width, sgl_int32_t s_height,
+                sgl_uint8_t *SGL_RESTRICT dst, sgl_int32_t d_width, sgl_int32_t d_height, sgl_int32_t dst_stride,
+                sgl_uint8_t *SGL_RESTRICT src, sgl_int32_t s_width, sgl_int32_t s_height, sgl_int32_t src_stride,
                 sgl_int32_t bpp)
 {
     sgl_result_t result = SGL_SUCCESS;
@@ -733,6 +707,8 @@ sgl_result_t sgl_generic_resize_bilinear(
         (ext_lut != SGL_NULL));
     errcnt = sgl_generic_resize_bilinear_count_errors(
         dst, d_width, d_height, src, s_width, s_height, bpp);
+    errcnt += sgl_resize_count_stride_errors(
+        d_width, dst_stride, s_width, src_stride, bpp);
 
     /* check error count */
     if (errcnt != 0) {
@@ -740,14 +716,15 @@ sgl_result_t sgl_generic_resize_bilinear(
     }
     else if (sgl_generic_resize_bilinear_is_same_size(
                  d_width, d_height, s_width, s_height) == SGL_TRUE) {
-        sgl_generic_resize_bilinear_copy_same_size(dst, d_width, d_height, src, bpp);
+        sgl_generic_resize_bilinear_copy_same_size(
+            dst, dst_stride, d_width, d_height, src, src_stride, bpp);
     }
     else {
         lut = sgl_generic_resize_bilinear_select_lut(
             ext_lut, &temp_lut, d_width, d_height, s_width, s_height);
         if (lut != SGL_NULL) {
             sgl_generic_resize_bilinear_set_data(
-                &data, lut, dst, src, s_width, d_width, bpp);
+                &data, lut, dst, src, src_stride, dst_stride, bpp);
             result = sgl_generic_resize_bilinear_run(pool, &data, d_height, bpp);
 
             if (temp_lut != SGL_NULL) {
@@ -763,26 +740,48 @@ sgl_result_t sgl_generic_resize_bilinear(
     return result;
 }
 
+sgl_result_t sgl_generic_resize_bilinear(
+                sgl_threadpool_t *SGL_RESTRICT pool, sgl_bilinear_lookup_t *SGL_RESTRICT ext_lut,
+                sgl_uint8_t *SGL_RESTRICT dst, sgl_int32_t d_width, sgl_int32_t d_height,
+                sgl_uint8_t *SGL_RESTRICT src, sgl_int32_t s_width, sgl_int32_t s_height,
+                sgl_int32_t bpp)
+{
+    sgl_result_t result;
+
+    result = sgl_generic_resize_bilinear_strided(
+        pool, ext_lut, dst, d_width, d_height, d_width * bpp,
+        src, s_width, s_height, s_width * bpp, bpp);
+
+    return result;
+}
+
 #if defined(SGL_CFG_HAS_THREAD)
-static void sgl_generic_resize_bilinear_routine(void *SGL_RESTRICT current, void *SGL_RESTRICT cookie)
+static void sgl_generic_resize_bilinear_routine(
+    sgl_int32_t begin,
+    sgl_int32_t end,
+    sgl_threadpool_scratch_t *SGL_RESTRICT scratch,
+    void *SGL_RESTRICT cookie)
 {
-    const sgl_bilinear_current_t *cur = sgl_memory_as_const_bilinear_current(current);
     sgl_bilinear_data_t *data = sgl_memory_as_bilinear_data(cookie);
-    sgl_result_t result;
+    sgl_q11_ext_t *row_storage;
     sgl_int32_t row;
 
-    result = SGL_ERROR_NOT_SUPPORTED;
+    row_storage = SGL_NULL;
     switch (data->bpp) {
     case SGL_BPP32:
-        result = sgl_generic_resize_bilinear_range_separable_bpp32(
-            data, cur->row, cur->count);
+        row_storage = sgl_memory_as_q11_ext(sgl_threadpool_scratch_alloc(
+            scratch, sgl_generic_bilinear_row_storage_size_bpp32(data)));
+        if (row_storage != SGL_NULL) {
+            sgl_generic_resize_bilinear_range_separable_bpp32(
+                data, row_storage, begin, end - begin);
+        }
         break;
     default:
         break;
     }
 
-    if (result != SGL_SUCCESS) {
-        for (row = cur->row; row < (cur->row + cur->count); ++row) {
+    if (row_storage == SGL_NULL) {
+        for (row = begin; row < end; ++row) {
             sgl_generic_resize_bilinear_line_stripe(row, data);
         }
     }
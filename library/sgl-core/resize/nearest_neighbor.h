@@ -21,11 +21,6 @@ typedef struct  {
     sgl_int32_t dst_stride;
 } sgl_nearest_neighbor_data_t;
 
-typedef struct  {
-    sgl_int32_t row;
-    sgl_int32_t count;
-} sgl_nearest_neighbor_current_t;
-
 struct sgl_nearest_neighbor_lookup_table {
     sgl_int32_t d_width;
     sgl_int32_t d_height;
@@ -55,28 +50,6 @@ void sgl_resize_nearest_neighbor_dispatch_packed_range(
     sgl_int32_t row_count,
     sgl_nearest_neighbor_data_t *data);
 
-static SGL_ALWAYS_INLINE sgl_nearest_neighbor_current_t *sgl_memory_as_nearest_neighbor_current(void *memory)
-{
-    sgl_nearest_neighbor_current_t *result;
-
-    /* SGL-MEM-DEV-001: typed conversion from generic storage. */
-    /* cppcheck-suppress misra-c2012-11.5 */
-    result = (sgl_nearest_neighbor_current_t *)memory;
-
-    return result;
-}
-
-static SGL_ALWAYS_INLINE const sgl_nearest_neighbor_current_t *sgl_memory_as_const_nearest_neighbor_current(const void *memory)
-{
-    const sgl_nearest_neighbor_current_t *result;
-
-    /* SGL-MEM-DEV-001: typed conversion from generic storage. */
-    /* cppcheck-suppress misra-c2012-11.5 */
-    result = (const sgl_nearest_neighbor_current_t *)memory;
-
-    return result;
-}
-
 static SGL_ALWAYS_INLINE sgl_nearest_neighbor_data_t *sgl_memory_as_nearest_neighbor_data(void *memory)
 {
     sgl_nearest_neighbor_data_t *result;
@@ -10,6 +10,7 @@
 #include "bicubic.h"
 #include "resize_bitops.h"
 #include "resize_prefetch.h"
+#include "resize_strided.h"
 #include "sgl_trace.h"
 #include "threaded_resize.h"
 
@@ -33,7 +34,11 @@ typedef struct {
 } sgl_simd_bicubic_row_cache_t;
 
 #if defined(SGL_CFG_HAS_THREAD)
-static void sgl_simd_resize_bicubic_routine(void *SGL_RESTRICT current, void *SGL_RESTRICT cookie);
+static void sgl_simd_resize_bicubic_routine(
+    sgl_int32_t begin,
+    sgl_int32_t end,
+    sgl_threadpool_scratch_t *SGL_RESTRICT scratch,
+    void *SGL_RESTRICT cookie);
 #endif  /* !SGL_CFG_HAS_THREAD */
 
 static SGL_ALWAYS_INLINE uint8x8_t sgl_neon_vset_u8(const sgl_uint8_t *y_buf, const sgl_int32_t *x, sgl_int32_t ch, sgl_int32_t bpp)
@@ -356,14 +361,28 @@ static SGL_ALWAYS_INLINE void sgl_simd_bicubic_vertical_bpp32(
     }
 }
 
+static SGL_ALWAYS_INLINE sgl_size_t sgl_simd_bicubic_row_storage_size_bpp32(
+    const sgl_bicubic_data_t *data)
+{
+    return sizeof(sgl_q11_ext_t) *
+           (sgl_size_t)SGL_RESIZE_BPP32_BYTE_OFFSET(data->lut->d_width) *
+           (sgl_size_t)SGL_SIMD_BICUBIC_ROW_CACHE_COUNT;
+}
+
+/*
+ * storage may come from a worker's scratch arena; with SGL_NULL the row
+ * cache is allocated here and released before returning.
+ */
 static sgl_result_t sgl_simd_resize_bicubic_range_separable_bpp32(
     sgl_bicubic_data_t *SGL_RESTRICT data,
+    sgl_q11_ext_t *storage,
     sgl_int32_t start_row,
     sgl_int32_t row_count)
 {
     sgl_result_t result;
     sgl_simd_bicubic_row_cache_t cache[SGL_SIMD_BICUBIC_ROW_CACHE_COUNT];
     sgl_q11_ext_t *row_storage;
+    sgl_q11_ext_t *owned_storage;
     sgl_q11_ext_t *row1;
     sgl_q11_ext_t *row2;
     sgl_q11_ext_t *row3;
@@ -375,16 +394,19 @@ static sgl_result_t sgl_simd_resize_bicubic_range_separable_bpp32(
     sgl_int32_t slot;
 
     result = SGL_SUCCESS;
-    row_storage = SGL_NULL;
     row_width = SGL_RESIZE_BPP32_BYTE_OFFSET(data->lut->d_width);
     end_row = start_row + row_count;
     if (end_row > data->lut->d_height) {
         end_row = data->lut->d_height;
     }
 
-    row_storage = sgl_memory_as_q11_ext(sgl_malloc(
-        sizeof(sgl_q11_ext_t) * (sgl_size_t)row_width *
-        (sgl_size_t)SGL_SIMD_BICUBIC_ROW_CACHE_COUNT));
+    owned_storage = SGL_NULL;
+    row_storage = storage;
+    if (row_storage == SGL_NULL) {
+        owned_storage = sgl_memory_as_q11_ext(sgl_malloc(
+            sgl_simd_bicubic_row_storage_size_bpp32(data)));
+        row_storage = owned_storage;
+    }
     if (row_storage != SGL_NULL) {
         for (slot = 0; slot < SGL_SIMD_BICUBIC_ROW_CACHE_COUNT; ++slot) {
             cache[slot].y = -1;
@@ -415,7 +437,7 @@ static sgl_result_t sgl_simd_resize_bicubic_range_separable_bpp32(
         result = SGL_ERROR_MEMORY_ALLOCATION;
     }
 
-    SGL_SAFE_FREE(row_storage);
+    SGL_SAFE_FREE(owned_storage);
 
     return result;
 }
@@ -1136,11 +1158,11 @@ static sgl_bool_t sgl_simd_resize_bicubic_is_same_size(
 }
 
 static void sgl_simd_resize_bicubic_copy_same_size(
-                sgl_uint8_t *SGL_RESTRICT dst,
-                const sgl_uint8_t *SGL_RESTRICT src,
+                sgl_uint8_t *SGL_RESTRICT dst, sgl_int32_t dst_stride,
+                const sgl_uint8_t *SGL_RESTRICT src, sgl_int32_t src_stride,
                 sgl_int32_t d_width, sgl_int32_t d_height, sgl_int32_t bpp)
 {
-    (void)sgl_memcpy(dst, src, (sgl_size_t)d_width * (sgl_size_t)d_height * (sgl_size_t)bpp);
+    sgl_resize_copy_rows(dst, dst_stride, src, src_stride, d_width, d_height, bpp);
 }
 
 static sgl_bicubic_lookup_t *sgl_simd_resize_bicubic_select_lut(
@@ -1172,16 +1194,16 @@ static sgl_bicubic_lookup_t *sgl_simd_resize_bicubic_select_lut(
 static void sgl_simd_resize_bicubic_set_data(
                 sgl_bicubic_data_t *SGL_RESTRICT data,
                 sgl_bicubic_lookup_t *SGL_RESTRICT lut,
-                sgl_uint8_t *SGL_RESTRICT dst, sgl_int32_t d_width,
-                sgl_uint8_t *SGL_RESTRICT src, sgl_int32_t s_width,
+                sgl_uint8_t *SGL_RESTRICT dst, sgl_int32_t dst_stride,
+                sgl_uint8_t *SGL_RESTRICT src, sgl_int32_t src_stride,
                 sgl_int32_t bpp)
 {
     data->bpp = bpp;
     data->src = src;
     data->dst = dst;
     data->lut = lut;
-    data->src_stride = s_width * bpp;
-    data->dst_stride = d_width * bpp;
+    data->src_stride = src_stride;
+    data->dst_stride = dst_stride;
 }
 
 static void sgl_simd_resize_bicubic_single(sgl_bicubic_data_t *SGL_RESTRICT data, sgl_int32_t d_height)
@@ -1194,7 +1216,7 @@ static void sgl_simd_resize_bicubic_single(sgl_bicubic_data_t *SGL_RESTRICT data
         (data->src_stride > data->dst_stride))
     {
         result = sgl_simd_resize_bicubic_range_separable_bpp32(
-            data, 0, d_height);
+            data, SGL_NULL, 0, d_height);
     }
 
     if (result != SGL_SUCCESS) {
@@ -1210,12 +1232,7 @@ static sgl_result_t sgl_simd_resize_bicubic_threaded(
                 sgl_bicubic_data_t *SGL_RESTRICT data,
                 sgl_int32_t d_height)
 {
-    sgl_result_t result = SGL_ERROR_MEMORY_ALLOCATION;
-    sgl_bicubic_current_t *currents;
-    sgl_queue_t *operations = SGL_NULL;
-    sgl_int32_t i;
-    sgl_int32_t num_operations;
-    sgl_int32_t mod_operations;
+    sgl_result_t result;
     sgl_int32_t bulk_size;
     sgl_int32_t minimum_bulk;
 
@@ -1227,33 +1244,11 @@ static sgl_result_t sgl_simd_resize_bicubic_threaded(
     }
     bulk_size = sgl_resize_thread_bulk_size(
         pool, d_height, minimum_bulk);
-    num_operations = d_height / bulk_size;
-    mod_operations = d_height % bulk_size;
-    if (mod_operations != 0) {
-        num_operations += 1;
-    }
-
-    operations = sgl_queue_create((sgl_size_t)num_operations);
-    currents = sgl_memory_as_bicubic_current(
-        sgl_malloc(sizeof(sgl_bicubic_current_t) * (sgl_size_t)num_operations));
-    if ((operations != SGL_NULL) && (currents != SGL_NULL)) {
-        for (i = 0; i < num_operations; ++i) {
-            currents[i].row = i * bulk_size;
-            currents[i].count = bulk_size;
-            (void)sgl_queue_unsafe_enqueue(operations, (const void *)&currents[i]);
-        }
 
-        if (mod_operations != 0) {
-            currents[num_operations - 1].count = mod_operations;
-        }
-
-        /* Multi-threaded resize. */
-        result = sgl_threadpool_attach_routine_consuming(
-            pool, sgl_simd_resize_bicubic_routine, operations, (void *)data);
-        sgl_queue_destroy(&operations);
-    }
-    SGL_SAFE_FREE(currents);
-    SGL_SAFE_FREE(operations);
+    /* Multi-threaded resize. */
+    result = sgl_threadpool_parallel_for_scratch(
+        pool, 0, d_height, bulk_size,
+        sgl_simd_resize_bicubic_routine, (void *)data);
 
     return result;
 }
@@ -1283,10 +1278,10 @@ static sgl_result_t sgl_simd_resize_bicubic_run(
     return result;
 }
 
-sgl_result_t sgl_simd_resize_bicubic(
+sgl_result_t sgl_simd_resize_bicubic_strided(
                 sgl_threadpool_t *SGL_RESTRICT pool, sgl_bicubic_lookup_t *SGL_RESTRICT ext_lut,
-                sgl_uint8_t *SGL_RESTRICT dst, sgl_int32_t d_width, sgl_int32_t d_height,
-                sgl_uint8_t *SGL_RESTRICT src, sgl_int32_t s_width, sgl_int32_t s_height,
+                sgl_uint8_t *SGL_RESTRICT dst, sgl_int32_t d_width, sgl_int32_t d_height, sgl_int32_t dst_stride,
+                sgl_uint8_t *SGL_RESTRICT src, sgl_int32_t s_width, sgl_int32_t s_height, sgl_int32_t src_stride,
                 sgl_int32_t bpp)
 {
     sgl_result_t result = SGL_SUCCESS;
@@ -1306,17 +1301,19 @@ sgl_result_t sgl_simd_resize_bicubic(
         SGL_TRACE_REQUESTED_THREADS(pool),
         (ext_lut != SGL_NULL));
     errcnt = sgl_simd_resize_bicubic_count_errors(dst, d_width, d_height, src, s_width, s_height, bpp);
+    errcnt += sgl_resize_count_stride_errors(
+        d_width, dst_stride, s_width, src_stride, bpp);
 
     if (errcnt == 0) {
         if (sgl_simd_resize_bicubic_is_same_size(d_width, d_height, s_width, s_height) == SGL_TRUE) {
-            sgl_simd_resize_bicubic_copy_same_size(dst, src, d_width, d_height, bpp);
+            sgl_simd_resize_bicubic_copy_same_size(dst, dst_stride, src, src_stride, d_width, d_height, bpp);
         }
         else {
             lut = sgl_simd_resize_bicubic_select_lut(ext_lut, &temp_lut, d_width, d_height, s_width, s_height);
         }
 
         if (lut != SGL_NULL) {
-            sgl_simd_resize_bicubic_set_data(&data, lut, dst, d_width, src, s_width, bpp);
+            sgl_simd_resize_bicubic_set_data(&data, lut, dst, dst_stride, src, src_stride, bpp);
             result = sgl_simd_resize_bicubic_run(pool, &data, d_height);
         }
 
@@ -1335,10 +1332,28 @@ sgl_result_t sgl_simd_resize_bicubic(
     return result;
 }
 
+sgl_result_t sgl_simd_resize_bicubic(
+                sgl_threadpool_t *SGL_RESTRICT pool, sgl_bicubic_lookup_t *SGL_RESTRICT ext_lut,
+                sgl_uint8_t *SGL_RESTRICT dst, sgl_int32_t d_width, sgl_int32_t d_height,
+                sgl_uint8_t *SGL_RESTRICT src, sgl_int32_t s_width, sgl_int32_t s_height,
+                sgl_int32_t bpp)
+{
+    sgl_result_t result;
+
+    result = sgl_simd_resize_bicubic_strided(
+        pool, ext_lut, dst, d_width, d_height, d_width * bpp,
+        src, s_width, s_height, s_width * bpp, bpp);
+
+    return result;
+}
+
 #if defined(SGL_CFG_HAS_THREAD)
-static void sgl_simd_resize_bicubic_routine(void *SGL_RESTRICT current, void *SGL_RESTRICT cookie)
+static void sgl_simd_resize_bicubic_routine(
+    sgl_int32_t begin,
+    sgl_int32_t end,
+    sgl_threadpool_scratch_t *SGL_RESTRICT scratch,
+    void *SGL_RESTRICT cookie)
 {
-    const sgl_bicubic_current_t *cur = sgl_memory_as_const_bicubic_current(current);
     sgl_bicubic_data_t *data = sgl_memory_as_bicubic_data(cookie);
     sgl_result_t result;
     sgl_int32_t row;
@@ -1348,11 +1363,14 @@ static void sgl_simd_resize_bicubic_routine(void *SGL_RESTRICT current, void *SG
         (data->src_stride > data->dst_stride))
     {
         result = sgl_simd_resize_bicubic_range_separable_bpp32(
-            data, cur->row, cur->count);
+            data,
+            sgl_memory_as_q11_ext(sgl_threadpool_scratch_alloc(
+                scratch, sgl_simd_bicubic_row_storage_size_bpp32(data))),
+            begin, end - begin);
     }
 
     if (result != SGL_SUCCESS) {
-        for (row = cur->row; row < (cur->row + cur->count); ++row) {
+        for (row = begin; row < end; ++row) {
             sgl_simd_resize_bicubic_line_stripe(row, data);
         }
     }
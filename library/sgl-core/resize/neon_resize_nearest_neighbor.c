@@ -9,6 +9,7 @@
 #include <sgl-core.h>
 #include "nearest_neighbor.h"
 #include "resize_bitops.h"
+#include "resize_strided.h"
 #include "sgl_trace.h"
 #include "threaded_resize.h"
 
@@ -62,7 +63,7 @@ static SGL_ALWAYS_INLINE sgl_int32_t sgl_simd_nearest_shift_right_nonnegative(
 }
 
 #if defined(SGL_CFG_HAS_THREAD)
-static void sgl_simd_resize_nearest_neighbor_routine(void *SGL_RESTRICT current, void *SGL_RESTRICT cookie);
+static void sgl_simd_resize_nearest_neighbor_routine(sgl_int32_t begin, sgl_int32_t end, void *SGL_RESTRICT cookie);
 #endif  /* !SGL_CFG_HAS_THREAD */
 
 #if defined(SGL_CFG_IS_ARM64)
@@ -585,16 +586,15 @@ static SGL_ALWAYS_INLINE sgl_bool_t sgl_simd_resize_nearest_is_same_size(
 
 static SGL_ALWAYS_INLINE void sgl_simd_resize_nearest_copy_same_size(
     sgl_uint8_t *SGL_RESTRICT dst,
+    sgl_int32_t dst_stride,
     sgl_int32_t d_width,
     sgl_int32_t d_height,
     sgl_uint8_t *SGL_RESTRICT src,
+    sgl_int32_t src_stride,
     sgl_int32_t bpp)
 {
-    sgl_size_t copy_size;
-
-    copy_size = (sgl_size_t)d_width * (sgl_size_t)d_height * (sgl_size_t)bpp;
     if (dst != src) {
-        (void)sgl_memcpy(dst, src, copy_size);
+        sgl_resize_copy_rows(dst, dst_stride, src, src_stride, d_width, d_height, bpp);
     }
 }
 
@@ -633,16 +633,16 @@ static SGL_ALWAYS_INLINE void sgl_simd_resize_nearest_set_data(
     sgl_nearest_neighbor_lookup_t *lut,
     sgl_uint8_t *SGL_RESTRICT dst,
     sgl_uint8_t *SGL_RESTRICT src,
-    sgl_int32_t s_width,
-    sgl_int32_t d_width,
+    sgl_int32_t src_stride,
+    sgl_int32_t dst_stride,
     sgl_int32_t bpp)
 {
     data->bpp = bpp;
     data->src = src;
     data->dst = dst;
     data->lut = lut;
-    data->src_stride = s_width * bpp;
-    data->dst_stride = d_width * bpp;
+    data->src_stride = src_stride;
+    data->dst_stride = dst_stride;
 }
 
 static SGL_ALWAYS_INLINE void sgl_simd_resize_nearest_single(
@@ -669,48 +669,15 @@ static sgl_result_t sgl_simd_resize_nearest_threaded(
     sgl_int32_t d_height)
 {
     sgl_result_t result;
-    sgl_nearest_neighbor_current_t *currents;
-    sgl_queue_t *operations;
-    sgl_int32_t i;
-    sgl_int32_t num_operations;
-    sgl_int32_t mod_operations;
     sgl_int32_t bulk_size;
 
-    result = SGL_ERROR_MEMORY_ALLOCATION;
-    currents = SGL_NULL;
-    operations = SGL_NULL;
     bulk_size = sgl_resize_uniform_thread_bulk_size(
         pool, d_height, SGL_SIMD_BULK_SIZE);
-    num_operations = d_height / bulk_size;
-    mod_operations = d_height % bulk_size;
-    if (mod_operations != 0) {
-        num_operations += 1;
-    }
-
-    operations = sgl_queue_create((sgl_size_t)num_operations);
-    currents = sgl_memory_as_nearest_neighbor_current(sgl_malloc(
-        sizeof(sgl_nearest_neighbor_current_t) * (sgl_size_t)num_operations));
-    if ((operations != SGL_NULL) && (currents != SGL_NULL)) {
-        for (i = 0; i < num_operations; ++i) {
-            currents[i].row = i * bulk_size;
-            currents[i].count = bulk_size;
-            (void)sgl_queue_unsafe_enqueue(operations, (const void *)&currents[i]);
-        }
 
-        if (mod_operations != 0) {
-            currents[num_operations - 1].count = mod_operations;
-        }
-
-        /* multi-threaded resize */
-        result = sgl_threadpool_attach_routine_consuming(
-            pool,
-            sgl_simd_resize_nearest_neighbor_routine,
-            operations,
-            (void *)data);
-        sgl_queue_destroy(&operations);
-    }
-    SGL_SAFE_FREE(currents);
-    SGL_SAFE_FREE(operations);
+    /* multi-threaded resize */
+    result = sgl_threadpool_parallel_for(
+        pool, 0, d_height, bulk_size,
+        sgl_simd_resize_nearest_neighbor_routine, (void *)data);
 
     return result;
 }
@@ -745,10 +712,10 @@ static sgl_result_t sgl_simd_resize_nearest_run(
     return result;
 }
 
-sgl_result_t sgl_simd_resize_nearest(
+sgl_result_t sgl_simd_resize_nearest_strided(
                 sgl_threadpool_t *SGL_RESTRICT pool, sgl_nearest_neighbor_lookup_t *SGL_RESTRICT ext_lut,
-                sgl_uint8_t *SGL_RESTRICT dst, sgl_int32_t d_width, sgl_int32_t d_height,
-                sgl_uint8_t *SGL_RESTRICT src, sgl_int32_t s_width, sgl_int32_t s_height,
+                sgl_uint8_t *SGL_RESTRICT dst, sgl_int32_t d_width, sgl_int32_t d_height, sgl_int32_t dst_stride,
+                sgl_uint8_t *SGL_RESTRICT src, sgl_int32_t s_width, sgl_int32_t s_height, sgl_int32_t src_stride,
                 sgl_int32_t bpp)
 {
     sgl_result_t result = SGL_SUCCESS;
@@ -769,6 +736,8 @@ sgl_result_t sgl_simd_resize_nearest(
         (ext_lut != SGL_NULL));
     errcnt = sgl_simd_resize_nearest_count_errors(
         dst, d_width, d_height, src, s_width, s_height, bpp);
+    errcnt += sgl_resize_count_stride_errors(
+        d_width, dst_stride, s_width, src_stride, bpp);
 
     /* check error count */
     if (errcnt != 0) {
@@ -776,14 +745,15 @@ sgl_result_t sgl_simd_resize_nearest(
     }
     else if (sgl_simd_resize_nearest_is_same_size(
                  d_width, d_height, s_width, s_height) == SGL_TRUE) {
-        sgl_simd_resize_nearest_copy_same_size(dst, d_width, d_height, src, bpp);
+        sgl_simd_resize_nearest_copy_same_size(
+            dst, dst_stride, d_width, d_height, src, src_stride, bpp);
     }
     else {
         lut = sgl_simd_resize_nearest_select_lut(
             ext_lut, &temp_lut, d_width, d_height, s_width, s_height);
         if (lut != SGL_NULL) {
             sgl_simd_resize_nearest_set_data(
-                &data, lut, dst, src, s_width, d_width, bpp);
+                &data, lut, dst, src, src_stride, dst_stride, bpp);
             result = sgl_simd_resize_nearest_run(pool, &data, d_height);
 
             if (temp_lut != SGL_NULL) {
@@ -799,19 +769,33 @@ sgl_result_t sgl_simd_resize_nearest(
     return result;
 }
 
+sgl_result_t sgl_simd_resize_nearest(
+                sgl_threadpool_t *SGL_RESTRICT pool, sgl_nearest_neighbor_lookup_t *SGL_RESTRICT ext_lut,
+                sgl_uint8_t *SGL_RESTRICT dst, sgl_int32_t d_width, sgl_int32_t d_height,
+                sgl_uint8_t *SGL_RESTRICT src, sgl_int32_t s_width, sgl_int32_t s_height,
+                sgl_int32_t bpp)
+{
+    sgl_result_t result;
+
+    result = sgl_simd_resize_nearest_strided(
+        pool, ext_lut, dst, d_width, d_height, d_width * bpp,
+        src, s_width, s_height, s_width * bpp, bpp);
+
+    return result;
+}
+
 #if defined(SGL_CFG_HAS_THREAD)
-static void sgl_simd_resize_nearest_neighbor_routine(void *SGL_RESTRICT current, void *SGL_RESTRICT cookie)
+static void sgl_simd_resize_nearest_neighbor_routine(sgl_int32_t begin, sgl_int32_t end, void *SGL_RESTRICT cookie)
 {
-    const sgl_nearest_neighbor_current_t *cur = sgl_memory_as_const_nearest_neighbor_current(current);
     sgl_nearest_neighbor_data_t *data = sgl_memory_as_nearest_neighbor_data(cookie);
     sgl_int32_t row;
 
     if (sgl_simd_resize_nearest_uses_packed_range(data) == SGL_TRUE) {
         sgl_resize_nearest_neighbor_dispatch_packed_range(
-            cur->row, cur->count, data);
+            begin, end - begin, data);
     }
     else {
-        for (row = cur->row; row < (cur->row + cur->count); ++row) {
+        for (row = begin; row < end; ++row) {
             sgl_simd_resize_nearest_neighbor_line_stripe(row, data);
         }
     }
@@ -0,0 +1,152 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright (c) 2025 Dylan Hong
+ *
+ * This code is released under the MIT License.
+ * For conditions of distribution and use, see the LICENSE file.
+ */
+#include <sgl-core.h>
+#include <sgl_image_format.h>
+#include "resize_strided.h"
+
+typedef enum {
+    SGL_RESIZE_IMAGE_NEAREST,
+    SGL_RESIZE_IMAGE_BILINEAR,
+    SGL_RESIZE_IMAGE_BICUBIC,
+} sgl_resize_image_method_t;
+
+static sgl_int32_t sgl_resize_image_count_errors(
+    const sgl_image_t *dst,
+    const sgl_image_t *src,
+    sgl_image_format_info_t *info)
+{
+    sgl_image_format_info_t dst_info;
+    sgl_int32_t errcnt;
+
+    errcnt = sgl_image_count_errors(dst, &dst_info);
+    errcnt += sgl_image_count_errors(src, info);
+    if ((errcnt == 0) && (dst->format != src->format)) {
+        errcnt += 1;
+    }
+
+    return errcnt;
+}
+
+static sgl_result_t sgl_resize_image_plane(
+    sgl_threadpool_t *SGL_RESTRICT pool,
+    sgl_resize_image_method_t method,
+    sgl_uint8_t *SGL_RESTRICT dst, sgl_int32_t d_width, sgl_int32_t d_height, sgl_int32_t dst_stride,
+    sgl_uint8_t *SGL_RESTRICT src, sgl_int32_t s_width, sgl_int32_t s_height, sgl_int32_t src_stride,
+    sgl_int32_t bpp)
+{
+    sgl_result_t result;
+
+    switch (method) {
+    case SGL_RESIZE_IMAGE_NEAREST:
+#if defined(SGL_CFG_HAS_SIMD)
+        result = sgl_simd_resize_nearest_strided(
+            pool, SGL_NULL, dst, d_width, d_height, dst_stride,
+            src, s_width, s_height, src_stride, bpp);
+#else
+        result = sgl_generic_resize_nearest_strided(
+            pool, SGL_NULL, dst, d_width, d_height, dst_stride,
+            src, s_width, s_height, src_stride, bpp);
+#endif  /* !SGL_CFG_HAS_SIMD */
+        break;
+    case SGL_RESIZE_IMAGE_BILINEAR:
+#if defined(SGL_CFG_HAS_SIMD)
+        result = sgl_simd_resize_bilinear_strided(
+            pool, SGL_NULL, dst, d_width, d_height, dst_stride,
+            src, s_width, s_height, src_stride, bpp);
+#else
+        result = sgl_generic_resize_bilinear_strided(
+            pool, SGL_NULL, dst, d_width, d_height, dst_stride,
+            src, s_width, s_height, src_stride, bpp);
+#endif  /* !SGL_CFG_HAS_SIMD */
+        break;
+    default:
+#if defined(SGL_CFG_HAS_SIMD)
+        result = sgl_simd_resize_bicubic_strided(
+            pool, SGL_NULL, dst, d_width, d_height, dst_stride,
+            src, s_width, s_height, src_stride, bpp);
+#else
+        result = sgl_generic_resize_bicubic_strided(
+            pool, SGL_NULL, dst, d_width, d_height, dst_stride,
+            src, s_width, s_height, src_stride, bpp);
+#endif  /* !SGL_CFG_HAS_SIMD */
+        break;
+    }
+
+    return result;
+}
+
+/* Each plane resizes independently with its own subsampled geometry. */
+static sgl_result_t sgl_resize_image(
+    sgl_threadpool_t *SGL_RESTRICT pool,
+    sgl_resize_image_method_t method,
+    const sgl_image_t *SGL_RESTRICT dst,
+    const sgl_image_t *SGL_RESTRICT src)
+{
+    sgl_result_t result = SGL_SUCCESS;
+    sgl_image_format_info_t info;
+    sgl_int32_t errcnt = 0;
+    sgl_int32_t plane;
+
+    errcnt = sgl_resize_image_count_errors(dst, src, &info);
+
+    /* check error count */
+    if (errcnt != 0) {
+        result = SGL_ERROR_INVALID_ARGUMENTS;
+    }
+    else {
+        for (plane = 0; (result == SGL_SUCCESS) && (plane < info.planes); ++plane) {
+            result = sgl_resize_image_plane(
+                pool, method,
+                dst->planes[plane],
+                sgl_image_plane_width(&info, plane, dst->width),
+                sgl_image_plane_height(&info, plane, dst->height),
+                dst->strides[plane],
+                src->planes[plane],
+                sgl_image_plane_width(&info, plane, src->width),
+                sgl_image_plane_height(&info, plane, src->height),
+                src->strides[plane],
+                info.bpp[plane]);
+        }
+    }
+
+    return result;
+}
+
+sgl_result_t sgl_image_resize_nearest(
+                sgl_threadpool_t *SGL_RESTRICT pool,
+                const sgl_image_t *SGL_RESTRICT dst, const sgl_image_t *SGL_RESTRICT src)
+{
+    sgl_result_t result;
+
+    result = sgl_resize_image(pool, SGL_RESIZE_IMAGE_NEAREST, dst, src);
+
+    return result;
+}
+
+sgl_result_t sgl_image_resize_bilinear(
+                sgl_threadpool_t *SGL_RESTRICT pool,
+                const sgl_image_t *SGL_RESTRICT dst, const sgl_image_t *SGL_RESTRICT src)
+{
+    sgl_result_t result;
+
+    result = sgl_resize_image(pool, SGL_RESIZE_IMAGE_BILINEAR, dst, src);
+
+    return result;
+}
+
+sgl_result_t sgl_image_resize_bicubic(
+                sgl_threadpool_t *SGL_RESTRICT pool,
+                const sgl_image_t *SGL_RESTRICT dst, const sgl_image_t *SGL_RESTRICT src)
+{
+    sgl_result_t result;
+
+    result = sgl_resize_image(pool, SGL_RESIZE_IMAGE_BICUBIC, dst, src);
+
+    return result;
+}
@@ -0,0 +1,642 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright (c) 2025 Dylan Hong
+ *
+ * This code is released under the MIT License.
+ * For conditions of distribution and use, see the LICENSE file.
+ */
+#include <sgl-core.h>
+#include "sgl-osal.h"
+#include "bicubic.h"
+#include "bilinear.h"
+#include "nearest_neighbor.h"
+#include "rotate.h"
+
+#define SGL_RESIZE_ROTATE_BAND_BYTES    (262144)
+
+typedef enum {
+    SGL_RESIZE_ROTATE_NEAREST,
+    SGL_RESIZE_ROTATE_BILINEAR,
+    SGL_RESIZE_ROTATE_BICUBIC,
+} sgl_resize_rotate_method_t;
+
+/*
+ * Design and Operation
+ * --------------------
+ * A rotated resize is the plain resize of the unrotated output R followed by
+ * the orientation transform.  For transposing orientations R is d_height x
+ * d_width, so the column LUT is built from the destination height and the
+ * row LUT from the destination width.
+ *
+ * R is never materialized.  It is produced in bands of rows through a view of
+ * the full LUT whose row arrays start at the band, and each band is placed
+ * with the rotate kernels while it is still in cache.
+ *
+ *   src ---- resize rows [r, r + n) ----> band scratch (~256 KiB)
+ *                                              |
+ *                        rotate placement      v
+ *   dst <------------ origin + r * y_step, 8x8 tiles / reversed rows
+ *
+ * Only the destination-sized image is written to memory.  Bands are
+ * independent, so threaded execution hands one band to each operation and
+ * every worker owns its scratch.
+ *
+ * The 256 KiB budget is a soft target.  A band is never shorter than one
+ * 8-row tile, so each worker's scratch is max(256 KiB, 8 * r_width * bpp)
+ * bytes; a 40000-pixel RGBA row takes about 1.2 MiB.
+ */
+typedef struct {
+    sgl_rotate_data_t place;
+    sgl_resize_rotate_method_t method;
+    sgl_bool_t simd;
+    sgl_nearest_neighbor_lookup_t *nearest;
+    sgl_bilinear_lookup_t *bilinear;
+    sgl_bicubic_lookup_t *bicubic;
+    sgl_uint8_t *src;
+    sgl_int32_t s_width;
+    sgl_int32_t s_height;
+    sgl_int32_t r_width;
+    sgl_int32_t r_height;
+    sgl_int32_t bpp;
+    sgl_int32_t band_rows;
+    sgl_osal_atomic_uint32_t errors;
+} sgl_resize_rotate_data_t;
+
+static SGL_ALWAYS_INLINE sgl_resize_rotate_data_t *sgl_memory_as_resize_rotate_data(void *memory)
+{
+    sgl_resize_rotate_data_t *result;
+
+    /* SGL-MEM-DEV-001: typed conversion from generic storage. */
+    /* cppcheck-suppress misra-c2012-11.5 */
+    result = (sgl_resize_rotate_data_t *)memory;
+
+    return result;
+}
+
+static sgl_bool_t sgl_resize_rotate_is_transposed(sgl_rotation_t rotation)
+{
+    sgl_bool_t result;
+
+    result = SGL_FALSE;
+    if ((rotation == SGL_ROTATE_90) || (rotation == SGL_ROTATE_270) ||
+        (rotation == SGL_TRANSPOSE) || (rotation == SGL_TRANSVERSE)) {
+        result = SGL_TRUE;
+    }
+
+    return result;
+}
+
+static sgl_int32_t sgl_resize_rotate_count_errors(
+    const sgl_uint8_t *dst,
+    sgl_int32_t d_width,
+    sgl_int32_t d_height,
+    const sgl_uint8_t *src,
+    sgl_int32_t s_width,
+    sgl_int32_t s_height,
+    sgl_int32_t bpp,
+    sgl_rotation_t rotation)
+{
+    sgl_int32_t errcnt;
+
+    errcnt = 0;
+
+    /* check buffer address */
+    if ((dst == SGL_NULL) || (src == SGL_NULL) || (dst == src)) {
+        errcnt += 1;
+    }
+
+    /* check boundary */
+    if ((d_width <= 0) || (d_height <= 0) || (s_width <= 0) || (s_height <= 0)) {
+        errcnt += 1;
+    }
+
+    /* check bpp(bytes per pixel) */
+    if (bpp <= 0) {
+        errcnt += 1;
+    }
+
+    /* check orientation */
+    if ((rotation < SGL_ROTATE_0) || (rotation > SGL_TRANSVERSE)) {
+        errcnt += 1;
+    }
+
+    return errcnt;
+}
+
+/*
+ * Band height: a tile multiple whose scratch stays within the band budget,
+ * or one tile when a single tile of rows already exceeds it.
+ */
+static sgl_int32_t sgl_resize_rotate_band_rows(sgl_int32_t r_width, sgl_int32_t bpp)
+{
+    sgl_int64_t row_bytes;
+    sgl_int64_t rows;
+
+    row_bytes = (sgl_int64_t)r_width * (sgl_int64_t)bpp;
+    rows = (sgl_int64_t)SGL_RESIZE_ROTATE_BAND_BYTES / row_bytes;
+    rows = (rows / SGL_ROTATE_TILE) * SGL_ROTATE_TILE;
+    if (rows < SGL_ROTATE_TILE) {
+        rows = SGL_ROTATE_TILE;
+    }
+    if (rows > SGL_ROTATE_BLOCK) {
+        rows = SGL_ROTATE_BLOCK;
+    }
+
+    return (sgl_int32_t)rows;
+}
+
+static sgl_result_t sgl_resize_rotate_nearest_band(
+    const sgl_resize_rotate_data_t *data,
+    sgl_uint8_t *SGL_RESTRICT band,
+    sgl_int32_t row,
+    sgl_int32_t count)
+{
+    sgl_nearest_neighbor_lookup_t view;
+    sgl_result_t result;
+
+    view = *data->nearest;
+    view.d_height = count;
+    view.y = &data->nearest->y[row];
+#if defined(SGL_CFG_HAS_SIMD)
+    if (data->simd == SGL_TRUE) {
+        result = sgl_simd_resize_nearest(
+            SGL_NULL, &view, band, data->r_width, count,
+            data->src, data->s_width, data->s_height, data->bpp);
+    }
+    else
+#endif  /* !SGL_CFG_HAS_SIMD */
+    {
+        result = sgl_generic_resize_nearest(
+            SGL_NULL, &view, band, data->r_width, count,
+            data->src, data->s_width, data->s_height, data->bpp);
+    }
+
+    return result;
+}
+
+static sgl_result_t sgl_resize_rotate_bilinear_band(
+    const sgl_resize_rotate_data_t *data,
+    sgl_uint8_t *SGL_RESTRICT band,
+    sgl_int32_t row,
+    sgl_int32_t count)
+{
+    sgl_bilinear_lookup_t view;
+    const bilinear_row_lookup_t *rows;
+    sgl_result_t result;
+
+    view = *data->bilinear;
+    rows = &data->bilinear->row_lookup;
+    view.d_height = count;
+    view.row_lookup.y1 = &rows->y1[row];
+    view.row_lookup.y2 = &rows->y2[row];
+    view.row_lookup.q = &rows->q[row];
+    view.row_lookup.inv_q = &rows->inv_q[row];
+#if defined(SGL_CFG_HAS_SIMD)
+    if (data->simd == SGL_TRUE) {
+        result = sgl_simd_resize_bilinear(
+            SGL_NULL, &view, band, data->r_width, count,
+            data->src, data->s_width, data->s_height, data->bpp);
+    }
+    else
+#endif  /* !SGL_CFG_HAS_SIMD */
+    {
+        result = sgl_generic_resize_bilinear(
+            SGL_NULL, &view, band, data->r_width, count,
+            data->src, data->s_width, data->s_height, data->bpp);
+    }
+
+    return result;
+}
+
+static sgl_result_t sgl_resize_rotate_bicubic_band(
+    const sgl_resize_rotate_data_t *data,
+    sgl_uint8_t *SGL_RESTRICT band,
+    sgl_int32_t row,
+    sgl_int32_t count)
+{
+    sgl_bicubic_lookup_t view;
+    const bicubic_row_lookup_t *rows;
+    sgl_result_t result;
+
+    view = *data->bicubic;
+    rows = &data->bicubic->row_lookup;
+    view.d_height = count;
+    view.row_lookup.y1 = &rows->y1[row];
+    view.row_lookup.y2 = &rows->y2[row];
+    view.row_lookup.y3 = &rows->y3[row];
+    view.row_lookup.y4 = &rows->y4[row];
+    view.row_lookup.q = &rows->q[row];
+#if defined(SGL_CFG_HAS_SIMD)
+    if (data->simd == SGL_TRUE) {
+        result = sgl_simd_resize_bicubic(
+            SGL_NULL, &view, band, data->r_width, count,
+            data->src, data->s_width, data->s_height, data->bpp);
+    }
+    else
+#endif  /* !SGL_CFG_HAS_SIMD */
+    {
+        result = sgl_generic_resize_bicubic(
+            SGL_NULL, &view, band, data->r_width, count,
+            data->src, data->s_width, data->s_height, data->bpp);
+    }
+
+    return result;
+}
+
+/* Resizes rows [row, row + count) of R into band and places them in dst. */
+static sgl_result_t sgl_resize_rotate_band(
+    const sgl_resize_rotate_data_t *data,
+    sgl_uint8_t *SGL_RESTRICT band,
+    sgl_int32_t row,
+    sgl_int32_t count)
+{
+    sgl_rotate_data_t place;
+    sgl_result_t result;
+
+    switch (data->method) {
+    case SGL_RESIZE_ROTATE_NEAREST:
+        result = sgl_resize_rotate_nearest_band(data, band, row, count);
+        break;
+    case SGL_RESIZE_ROTATE_BILINEAR:
+        result = sgl_resize_rotate_bilinear_band(data, band, row, count);
+        break;
+    default:
+        result = sgl_resize_rotate_bicubic_band(data, band, row, count);
+        break;
+    }
+
+    if (result == SGL_SUCCESS) {
+        place = data->place;
+        place.src = band;
+        place.s_height = count;
+        place.origin = &place.origin[(sgl_ptrdiff_t)row * place.y_step];
+        sgl_rotate_range(&place, 0, count);
+    }
+
+    return result;
+}
+
+static SGL_ALWAYS_INLINE sgl_size_t sgl_resize_rotate_band_size(
+    const sgl_resize_rotate_data_t *data)
+{
+    return (sgl_size_t)data->r_width * (sgl_size_t)data->bpp *
+           (sgl_size_t)data->band_rows;
+}
+
+/* band may come from a worker's scratch arena; SGL_NULL allocates one here. */
+static sgl_result_t sgl_resize_rotate_range(
+    sgl_resize_rotate_data_t *data,
+    sgl_uint8_t *storage,
+    sgl_int32_t start_row,
+    sgl_int32_t row_count)
+{
+    sgl_result_t result;
+    sgl_uint8_t *band;
+    sgl_uint8_t *owned_band;
+    sgl_int32_t row;
+    sgl_int32_t end_row;
+    sgl_int32_t count;
+
+    result = SGL_ERROR_MEMORY_ALLOCATION;
+    owned_band = SGL_NULL;
+    band = storage;
+    if (band == SGL_NULL) {
+        owned_band = sgl_memory_as_uint8(sgl_malloc(
+            sgl_resize_rotate_band_size(data)));
+        band = owned_band;
+    }
+    if (band != SGL_NULL) {
+        result = SGL_SUCCESS;
+        end_row = start_row + row_count;
+        for (row = start_row; (row < end_row) && (result == SGL_SUCCESS);
+             row += data->band_rows) {
+            count = end_row - row;
+            if (count > data->band_rows) {
+                count = data->band_rows;
+            }
+            result = sgl_resize_rotate_band(data, band, row, count);
+        }
+    }
+    SGL_SAFE_FREE(owned_band);
+
+    return result;
+}
+
+#if defined(SGL_CFG_HAS_THREAD)
+static void sgl_resize_rotate_routine(
+    sgl_int32_t begin,
+    sgl_int32_t end,
+    sgl_threadpool_scratch_t *SGL_RESTRICT scratch,
+    void *SGL_RESTRICT cookie)
+{
+    sgl_resize_rotate_data_t *data = sgl_memory_as_resize_rotate_data(cookie);
+    sgl_uint8_t *band;
+
+    band = sgl_memory_as_uint8(sgl_threadpool_scratch_alloc(
+        scratch, sgl_resize_rotate_band_size(data)));
+    if (sgl_resize_rotate_range(data, band, begin, end - begin) != SGL_SUCCESS) {
+        (void)sgl_osal_atomic_uint32_increment_release(&data->errors);
+    }
+}
+
+static sgl_result_t sgl_resize_rotate_threaded(
+    sgl_threadpool_t *SGL_RESTRICT pool,
+    sgl_resize_rotate_data_t *data)
+{
+    sgl_result_t result;
+
+    /* multi-threaded resize and placement */
+    result = sgl_threadpool_parallel_for_scratch(
+        pool, 0, data->r_height, data->band_rows,
+        sgl_resize_rotate_routine, (void *)data);
+    if ((result == SGL_SUCCESS) &&
+        (sgl_osal_atomic_uint32_load_acquire(&data->errors) != 0U)) {
+        result = SGL_ERROR_MEMORY_ALLOCATION;
+    }
+
+    return result;
+}
+#endif  /* !SGL_CFG_HAS_THREAD */
+
+static sgl_result_t sgl_resize_rotate_run(
+    sgl_threadpool_t *SGL_RESTRICT pool,
+    sgl_resize_rotate_data_t *data)
+{
+    sgl_result_t result;
+
+    if (pool == SGL_NULL) {
+        result = sgl_resize_rotate_range(data, SGL_NULL, 0, data->r_height);
+    }
+#if defined(SGL_CFG_HAS_THREAD)
+    else if ((sgl_threadpool_get_num_threads(pool) <= 1U) ||
+             (data->r_height <= data->band_rows)) {
+        result = sgl_resize_rotate_range(data, SGL_NULL, 0, data->r_height);
+    }
+    else {
+        result = sgl_resize_rotate_threaded(pool, data);
+    }
+#else
+    else {
+        result = SGL_ERROR_NOT_SUPPORTED;
+    }
+#endif  /* !SGL_CFG_HAS_THREAD */
+
+    return result;
+}
+
+static void sgl_resize_rotate_set_data(
+    sgl_resize_rotate_data_t *data,
+    sgl_resize_rotate_method_t method,
+    sgl_bool_t simd,
+    sgl_uint8_t *SGL_RESTRICT dst,
+    sgl_int32_t d_width,
+    sgl_int32_t d_height,
+    sgl_uint8_t *SGL_RESTRICT src,
+    sgl_int32_t s_width,
+    sgl_int32_t s_height,
+    sgl_int32_t bpp,
+    sgl_rotation_t rotation)
+{
+    data->method = method;
+    data->simd = simd;
+    data->nearest = SGL_NULL;
+    data->bilinear = SGL_NULL;
+    data->bicubic = SGL_NULL;
+    data->src = src;
+    data->s_width = s_width;
+    data->s_height = s_height;
+    data->bpp = bpp;
+    data->errors = 0U;
+    if (sgl_resize_rotate_is_transposed(rotation) == SGL_TRUE) {
+        /* swap the roles of the destination axes */
+        data->r_width = d_height;
+        data->r_height = d_width;
+    }
+    else {
+        data->r_width = d_width;
+        data->r_height = d_height;
+    }
+    data->band_rows = sgl_resize_rotate_band_rows(data->r_width, bpp);
+    sgl_rotate_set_data(
+        &data->place,
+        dst, (sgl_ptrdiff_t)d_width * bpp,
+        SGL_NULL, (sgl_ptrdiff_t)data->r_width * bpp,
+        data->r_width, data->r_height, bpp, rotation);
+}
+
+static sgl_bool_t sgl_resize_rotate_lut_matches(
+    sgl_int32_t lut_d_width, sgl_int32_t lut_d_height,
+    sgl_int32_t lut_s_width, sgl_int32_t lut_s_height,
+    const sgl_resize_rotate_data_t *data)
+{
+    sgl_bool_t result;
+
+    result = SGL_FALSE;
+    if ((lut_d_width == data->r_width) && (lut_d_height == data->r_height) &&
+        (lut_s_width == data->s_width) && (lut_s_height == data->s_height)) {
+        result = SGL_TRUE;
+    }
+
+    return result;
+}
+
+static sgl_result_t sgl_resize_nearest_rotate(
+    sgl_bool_t simd,
+    sgl_threadpool_t *SGL_RESTRICT pool, sgl_nearest_neighbor_lookup_t *SGL_RESTRICT ext_lut,
+    sgl_uint8_t *SGL_RESTRICT dst, sgl_int32_t d_width, sgl_int32_t d_height,
+    sgl_uint8_t *SGL_RESTRICT src, sgl_int32_t s_width, sgl_int32_t s_height,
+    sgl_int32_t bpp, sgl_rotation_t rotation)
+{
+    sgl_result_t result = SGL_ERROR_MEMORY_ALLOCATION;
+    sgl_resize_rotate_data_t data;
+    sgl_nearest_neighbor_lookup_t *temp_lut = SGL_NULL;
+
+    if (sgl_resize_rotate_count_errors(
+            dst, d_width, d_height, src, s_width, s_height, bpp, rotation) != 0) {
+        result = SGL_ERROR_INVALID_ARGUMENTS;
+    }
+    else {
+        sgl_resize_rotate_set_data(
+            &data, SGL_RESIZE_ROTATE_NEAREST, simd,
+            dst, d_width, d_height, src, s_width, s_height, bpp, rotation);
+        if ((ext_lut != SGL_NULL) &&
+            (sgl_resize_rotate_lut_matches(
+                 ext_lut->d_width, ext_lut->d_height,
+                 ext_lut->s_width, ext_lut->s_height, &data) == SGL_TRUE)) {
+            /* apply external look-up table */
+            data.nearest = ext_lut;
+        }
+        else {
+            /* create temp look-up table */
+            temp_lut = sgl_generic_create_nearest_neighbor_lut(
+                data.r_width, data.r_height, s_width, s_height);
+            data.nearest = temp_lut;
+        }
+        if (data.nearest != SGL_NULL) {
+            result = sgl_resize_rotate_run(pool, &data);
+        }
+        if (temp_lut != SGL_NULL) {
+            /* destroy temp look-up table */
+            sgl_generic_destroy_nearest_neighbor_lut(temp_lut);
+        }
+    }
+
+    return result;
+}
+
+static sgl_result_t sgl_resize_bilinear_rotate(
+    sgl_bool_t simd,
+    sgl_threadpool_t *SGL_RESTRICT pool, sgl_bilinear_lookup_t *SGL_RESTRICT ext_lut,
+    sgl_uint8_t *SGL_RESTRICT dst, sgl_int32_t d_width, sgl_int32_t d_height,
+    sgl_uint8_t *SGL_RESTRICT src, sgl_int32_t s_width, sgl_int32_t s_height,
+    sgl_int32_t bpp, sgl_rotation_t rotation)
+{
+    sgl_result_t result = SGL_ERROR_MEMORY_ALLOCATION;
+    sgl_resize_rotate_data_t data;
+    sgl_bilinear_lookup_t *temp_lut = SGL_NULL;
+
+    if (sgl_resize_rotate_count_errors(
+            dst, d_width, d_height, src, s_width, s_height, bpp, rotation) != 0) {
+        result = SGL_ERROR_INVALID_ARGUMENTS;
+    }
+    else {
+        sgl_resize_rotate_set_data(
+            &data, SGL_RESIZE_ROTATE_BILINEAR, simd,
+            dst, d_width, d_height, src, s_width, s_height, bpp, rotation);
+        if ((ext_lut != SGL_NULL) &&
+            (sgl_resize_rotate_lut_matches(
+                 ext_lut->d_width, ext_lut->d_height,
+                 ext_lut->s_width, ext_lut->s_height, &data) == SGL_TRUE)) {
+            /* apply external look-up table */
+            data.bilinear = ext_lut;
+        }
+        else {
+            /* create temp look-up table */
+            temp_lut = sgl_generic_create_bilinear_lut(
+                data.r_width, data.r_height, s_width, s_height);
+            data.bilinear = temp_lut;
+        }
+        if (data.bilinear != SGL_NULL) {
+            result = sgl_resize_rotate_run(pool, &data);
+        }
+        if (temp_lut != SGL_NULL) {
+            /* destroy temp look-up table */
+            sgl_generic_destroy_bilinear_lut(temp_lut);
+        }
+    }
+
+    return result;
+}
+
+static sgl_result_t sgl_resize_bicubic_rotate(
+    sgl_bool_t simd,
+    sgl_threadpool_t *SGL_RESTRICT pool, sgl_bicubic_lookup_t *SGL_RESTRICT ext_lut,
+    sgl_uint8_t *SGL_RESTRICT dst, sgl_int32_t d_width, sgl_int32_t d_height,
+    sgl_uint8_t *SGL_RESTRICT src, sgl_int32_t s_width, sgl_int32_t s_height,
+    sgl_int32_t bpp, sgl_rotation_t rotation)
+{
+    sgl_result_t result = SGL_ERROR_MEMORY_ALLOCATION;
+    sgl_resize_rotate_data_t data;
+    sgl_bicubic_lookup_t *temp_lut = SGL_NULL;
+
+    if (sgl_resize_rotate_count_errors(
+            dst, d_width, d_height, src, s_width, s_height, bpp, rotation) != 0) {
+        result = SGL_ERROR_INVALID_ARGUMENTS;
+    }
+    else {
+        sgl_resize_rotate_set_data(
+            &data, SGL_RESIZE_ROTATE_BICUBIC, simd,
+            dst, d_width, d_height, src, s_width, s_height, bpp, rotation);
+        if ((ext_lut != SGL_NULL) &&
+            (sgl_resize_rotate_lut_matches(
+                 ext_lut->d_width, ext_lut->d_height,
+                 ext_lut->s_width, ext_lut->s_height, &data) == SGL_TRUE)) {
+            /* apply external look-up table */
+            data.bicubic = ext_lut;
+        }
+        else {
+            /* create temp look-up table */
+            temp_lut = sgl_generic_create_bicubic_lut(
+                data.r_width, data.r_height, s_width, s_height);
+            data.bicubic = temp_lut;
+        }
+        if (data.bicubic != SGL_NULL) {
+            result = sgl_resize_rotate_run(pool, &data);
+        }
+        if (temp_lut != SGL_NULL) {
+            /* destroy temp look-up table */
+            sgl_generic_destroy_bicubic_lut(temp_lut);
+        }
+    }
+
+    return result;
+}
+
+sgl_result_t sgl_generic_resize_nearest_rotate(
+                sgl_threadpool_t *SGL_RESTRICT pool, sgl_nearest_neighbor_lookup_t *SGL_RESTRICT ext_lut,
+                sgl_uint8_t *SGL_RESTRICT dst, sgl_int32_t d_width, sgl_int32_t d_height,
+                sgl_uint8_t *SGL_RESTRICT src, sgl_int32_t s_width, sgl_int32_t s_height,
+                sgl_int32_t bpp, sgl_rotation_t rotation)
+{
+    return sgl_resize_nearest_rotate(
+        SGL_FALSE, pool, ext_lut, dst, d_width, d_height,
+        src, s_width, s_height, bpp, rotation);
+}
+
+sgl_result_t sgl_generic_resize_bilinear_rotate(
+                sgl_threadpool_t *SGL_RESTRICT pool, sgl_bilinear_lookup_t *SGL_RESTRICT ext_lut,
+                sgl_uint8_t *SGL_RESTRICT dst, sgl_int32_t d_width, sgl_int32_t d_height,
+                sgl_uint8_t *SGL_RESTRICT src, sgl_int32_t s_width, sgl_int32_t s_height,
+                sgl_int32_t bpp, sgl_rotation_t rotation)
+{
+    return sgl_resize_bilinear_rotate(
+        SGL_FALSE, pool, ext_lut, dst, d_width, d_height,
+        src, s_width, s_height, bpp, rotation);
+}
+
+sgl_result_t sgl_generic_resize_bicubic_rotate(
+                sgl_threadpool_t *SGL_RESTRICT pool, sgl_bicubic_lookup_t *SGL_RESTRICT ext_lut,
+                sgl_uint8_t *SGL_RESTRICT dst, sgl_int32_t d_width, sgl_int32_t d_height,
+                sgl_uint8_t *SGL_RESTRICT src, sgl_int32_t s_width, sgl_int32_t s_height,
+                sgl_int32_t bpp, sgl_rotation_t rotation)
+{
+    return sgl_resize_bicubic_rotate(
+        SGL_FALSE, pool, ext_lut, dst, d_width, d_height,
+        src, s_width, s_height, bpp, rotation);
+}
+
+#if defined(SGL_CFG_HAS_SIMD)
+sgl_result_t sgl_simd_resize_nearest_rotate(
+                sgl_threadpool_t *SGL_RESTRICT pool, sgl_nearest_neighbor_lookup_t *SGL_RESTRICT ext_lut,
+                sgl_uint8_t *SGL_RESTRICT dst, sgl_int32_t d_width, sgl_int32_t d_height,
+                sgl_uint8_t *SGL_RESTRICT src, sgl_int32_t s_width, sgl_int32_t s_height,
+                sgl_int32_t bpp, sgl_rotation_t rotation)
+{
+    return sgl_resize_nearest_rotate(
+        SGL_TRUE, pool, ext_lut, dst, d_width, d_height,
+        src, s_width, s_height, bpp, rotation);
+}
+
+sgl_result_t sgl_simd_resize_bilinear_rotate(
+                sgl_threadpool_t *SGL_RESTRICT pool, sgl_bilinear_lookup_t *SGL_RESTRICT ext_lut,
+                sgl_uint8_t *SGL_RESTRICT dst, sgl_int32_t d_width, sgl_int32_t d_height,
+                sgl_uint8_t *SGL_RESTRICT src, sgl_int32_t s_width, sgl_int32_t s_height,
+                sgl_int32_t bpp, sgl_rotation_t rotation)
+{
+    return sgl_resize_bilinear_rotate(
+        SGL_TRUE, pool, ext_lut, dst, d_width, d_height,
+        src, s_width, s_height, bpp, rotation);
+}
+
+sgl_result_t sgl_simd_resize_bicubic_rotate(
+                sgl_threadpool_t *SGL_RESTRICT pool, sgl_bicubic_lookup_t *SGL_RESTRICT ext_lut,
+                sgl_uint8_t *SGL_RESTRICT dst, sgl_int32_t d_width, sgl_int32_t d_height,
+                sgl_uint8_t *SGL_RESTRICT src, sgl_int32_t s_width, sgl_int32_t s_height,
+                sgl_int32_t bpp, sgl_rotation_t rotation)
+{
+    return sgl_resize_bicubic_rotate(
+        SGL_TRUE, pool, ext_lut, dst, d_width, d_height,
+        src, s_width, s_height, bpp, rotation);
+}
+#endif  /* !SGL_CFG_HAS_SIMD */
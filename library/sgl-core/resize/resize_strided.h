@@ -0,0 +1,109 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright (c) 2025 Dylan Hong
+ *
+ * This code is released under the MIT License.
+ * For conditions of distribution and use, see the LICENSE file.
+ */
+#ifndef SGL_RESIZE_STRIDED_H_
+#define SGL_RESIZE_STRIDED_H_
+
+#include <sgl-core.h>
+
+/*
+ * Strided resize entry points
+ * ---------------------------
+ * Row kernels already address rows through data->src_stride and
+ * data->dst_stride, so a view with padding or a crop offset resizes in place.
+ * The public packed functions pass width * bpp; sgl_image_resize_*() passes
+ * the plane strides of its views.
+ *
+ *   packed  : stride == width * bpp
+ *   view    : stride >= width * bpp, row y at base + y * stride
+ */
+sgl_result_t sgl_generic_resize_nearest_strided(
+                sgl_threadpool_t *SGL_RESTRICT pool, sgl_nearest_neighbor_lookup_t *SGL_RESTRICT ext_lut,
+                sgl_uint8_t *SGL_RESTRICT dst, sgl_int32_t d_width, sgl_int32_t d_height, sgl_int32_t dst_stride,
+                sgl_uint8_t *SGL_RESTRICT src, sgl_int32_t s_width, sgl_int32_t s_height, sgl_int32_t src_stride,
+                sgl_int32_t bpp);
+
+sgl_result_t sgl_generic_resize_bilinear_strided(
+                sgl_threadpool_t *SGL_RESTRICT pool, sgl_bilinear_lookup_t *SGL_RESTRICT ext_lut,
+                sgl_uint8_t *SGL_RESTRICT dst, sgl_int32_t d_width, sgl_int32_t d_height, sgl_int32_t dst_stride,
+                sgl_uint8_t *SGL_RESTRICT src, sgl_int32_t s_width, sgl_int32_t s_height, sgl_int32_t src_stride,
+                sgl_int32_t bpp);
+
+sgl_result_t sgl_generic_resize_bicubic_strided(
+                sgl_threadpool_t *SGL_RESTRICT pool, sgl_bicubic_lookup_t *SGL_RESTRICT ext_lut,
+                sgl_uint8_t *SGL_RESTRICT dst, sgl_int32_t d_width, sgl_int32_t d_height, sgl_int32_t dst_stride,
+                sgl_uint8_t *SGL_RESTRICT src, sgl_int32_t s_width, sgl_int32_t s_height, sgl_int32_t src_stride,
+                sgl_int32_t bpp);
+
+#if defined(SGL_CFG_HAS_SIMD)
+sgl_result_t sgl_simd_resize_nearest_strided(
+                sgl_threadpool_t *SGL_RESTRICT pool, sgl_nearest_neighbor_lookup_t *SGL_RESTRICT ext_lut,
+                sgl_uint8_t *SGL_RESTRICT dst, sgl_int32_t d_width, sgl_int32_t d_height, sgl_int32_t dst_stride,
+                sgl_uint8_t *SGL_RESTRICT src, sgl_int32_t s_width, sgl_int32_t s_height, sgl_int32_t src_stride,
+                sgl_int32_t bpp);
+
+sgl_result_t sgl_simd_resize_bilinear_strided(
+                sgl_threadpool_t *SGL_RESTRICT pool, sgl_bilinear_lookup_t *SGL_RESTRICT ext_lut,
+                sgl_uint8_t *SGL_RESTRICT dst, sgl_int32_t d_width, sgl_int32_t d_height, sgl_int32_t dst_stride,
+                sgl_uint8_t *SGL_RESTRICT src, sgl_int32_t s_width, sgl_int32_t s_height, sgl_int32_t src_stride,
+                sgl_int32_t bpp);
+
+sgl_result_t sgl_simd_resize_bicubic_strided(
+                sgl_threadpool_t *SGL_RESTRICT pool, sgl_bicubic_lookup_t *SGL_RESTRICT ext_lut,
+                sgl_uint8_t *SGL_RESTRICT dst, sgl_int32_t d_width, sgl_int32_t d_height, sgl_int32_t dst_stride,
+                sgl_uint8_t *SGL_RESTRICT src, sgl_int32_t s_width, sgl_int32_t s_height, sgl_int32_t src_stride,
+                sgl_int32_t bpp);
+#endif  /* !SGL_CFG_HAS_SIMD */
+
+/* A stride shorter than one row of pixels would overlap the next row. */
+static SGL_ALWAYS_INLINE sgl_int32_t sgl_resize_count_stride_errors(
+    sgl_int32_t d_width,
+    sgl_int32_t dst_stride,
+    sgl_int32_t s_width,
+    sgl_int32_t src_stride,
+    sgl_int32_t bpp)
+{
+    sgl_int32_t errcnt;
+
+    errcnt = 0;
+    if (((sgl_int64_t)dst_stride < ((sgl_int64_t)d_width * (sgl_int64_t)bpp)) ||
+        ((sgl_int64_t)src_stride < ((sgl_int64_t)s_width * (sgl_int64_t)bpp))) {
+        errcnt += 1;
+    }
+
+    return errcnt;
+}
+
+/* Same-size resize is a copy; packed images take one memcpy. */
+static SGL_ALWAYS_INLINE void sgl_resize_copy_rows(
+    sgl_uint8_t *SGL_RESTRICT dst,
+    sgl_int32_t dst_stride,
+    const sgl_uint8_t *SGL_RESTRICT src,
+    sgl_int32_t src_stride,
+    sgl_int32_t width,
+    sgl_int32_t height,
+    sgl_int32_t bpp)
+{
+    sgl_size_t row_size;
+    sgl_int32_t row;
+
+    row_size = (sgl_size_t)width * (sgl_size_t)bpp;
+    if (((sgl_size_t)dst_stride == row_size) && ((sgl_size_t)src_stride == row_size)) {
+        (void)sgl_memcpy(dst, src, row_size * (sgl_size_t)height);
+    }
+    else {
+        for (row = 0; row < height; ++row) {
+            (void)sgl_memcpy(
+                &dst[(sgl_ptrdiff_t)row * dst_stride],
+                &src[(sgl_ptrdiff_t)row * src_stride],
+                row_size);
+        }
+    }
+}
+
+#endif  /* SGL_RESIZE_STRIDED_H_ */
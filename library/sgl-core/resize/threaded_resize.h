@@ -11,8 +11,8 @@
 
 #include <sgl-core.h>
 
-#define SGL_RESIZE_CHUNKS_PER_WORKER          (4U)
-#define SGL_RESIZE_LARGE_CHUNKS_PER_WORKER    (8U)
+#define SGL_RESIZE_CHUNKS_PER_WORKER          (8U)
+#define SGL_RESIZE_LARGE_CHUNKS_PER_WORKER    (16U)
 #define SGL_RESIZE_LARGE_HEIGHT               (480)
 #define SGL_RESIZE_UNIFORM_CHUNKS_PER_WORKER  (1U)
 #define SGL_RESIZE_NEAREST_MIN_THREAD_BYTES \
@@ -22,19 +22,25 @@
 /*
  * Threaded resize row partitioning
  * --------------------------------
- * Fixed 4/8-row tasks make queue management dominate small and medium resize
+ * Fixed 4/8-row tasks make dispatch overhead dominate small and medium resize
  * calls.  Use a bounded number of tasks while preserving the minimum row unit
- * required by each scalar, SIMD, or cache-backed implementation.
+ * required by each scalar, SIMD, or cache-backed implementation.  Chunks are
+ * the claim unit of parallel_for, which hands faster cores several at once
+ * by their measured rows per microsecond, so the split stays fine enough
+ * for slower cores to take single chunks at the tail.  To retune the
+ * ratios for a target, compare sgl_threadpool_get_stats() around a resize:
+ * a long completion wait with few operations per dispatch means the tail
+ * is too coarse, and rising lock contention means chunks are too small.
  *
  *   destination rows
  *          |
  *          v
- *   workers x 4 target chunks (x 8 above 480 rows)
+ *   workers x 8 target chunks (x 16 above 480 rows)
  *          |
  *          v
  *   round chunk rows up to minimum_bulk
  *          |
- *          +----> about four/eight queue operations per worker
+ *          +----> about eight/sixteen operations per worker
  */
 static SGL_ALWAYS_INLINE sgl_int32_t sgl_resize_thread_bulk_size(
     const sgl_threadpool_t *pool,
@@ -109,7 +115,7 @@ static SGL_ALWAYS_INLINE sgl_int32_t sgl_resize_uniform_thread_bulk_size(
 }
 
 /*
- * Nearest-neighbor is memory-bound.  Below this output size, queue publication
+ * Nearest-neighbor is memory-bound.  Below this output size, task publication
  * and worker wake-up cost more than the row copies saved by parallelism.
  */
 static SGL_ALWAYS_INLINE sgl_bool_t sgl_resize_nearest_should_use_threadpool(
@@ -0,0 +1,210 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright (c) 2025 Dylan Hong
+ *
+ * This code is released under the MIT License.
+ * For conditions of distribution and use, see the LICENSE file.
+ */
+#include <immintrin.h>
+#include <sgl-core.h>
+#include "rotate.h"
+
+static SGL_ALWAYS_INLINE __m128i sgl_avx2_rotate_load64(const sgl_uint8_t *src)
+{
+    return _mm_loadl_epi64((const __m128i *)(const void *)src);
+}
+
+static SGL_ALWAYS_INLINE void sgl_avx2_rotate_store64x2(
+    sgl_uint8_t *SGL_RESTRICT dst0,
+    sgl_uint8_t *SGL_RESTRICT dst1,
+    __m128i v)
+{
+    _mm_storel_epi64((__m128i *)(void *)dst0, v);
+    _mm_storel_epi64((__m128i *)(void *)dst1, _mm_srli_si128(v, 8));
+}
+
+/*
+ * 8x8 byte transpose with 8-, 16- and 32-bit unpacks.  Each 128-bit result
+ * holds two destination rows.
+ *
+ *   unpack_epi8    a0 b0 a1 b1 ... a7 b7
+ *   unpack_epi16   a0 b0 c0 d0 a1 b1 c1 d1 ...
+ *   unpack_epi32   a0 b0 c0 d0 e0 f0 g0 h0 | a1 b1 ... h1
+ */
+static void sgl_avx2_rotate_tile_bpp8(
+    sgl_uint8_t *SGL_RESTRICT dst, sgl_ptrdiff_t dst_stride,
+    const sgl_uint8_t *SGL_RESTRICT src, sgl_ptrdiff_t src_stride)
+{
+    __m128i t01 = _mm_unpacklo_epi8(sgl_avx2_rotate_load64(&src[0 * src_stride]), sgl_avx2_rotate_load64(&src[1 * src_stride]));
+    __m128i t23 = _mm_unpacklo_epi8(sgl_avx2_rotate_load64(&src[2 * src_stride]), sgl_avx2_rotate_load64(&src[3 * src_stride]));
+    __m128i t45 = _mm_unpacklo_epi8(sgl_avx2_rotate_load64(&src[4 * src_stride]), sgl_avx2_rotate_load64(&src[5 * src_stride]));
+    __m128i t67 = _mm_unpacklo_epi8(sgl_avx2_rotate_load64(&src[6 * src_stride]), sgl_avx2_rotate_load64(&src[7 * src_stride]));
+    __m128i x03 = _mm_unpacklo_epi16(t01, t23);
+    __m128i x47 = _mm_unpackhi_epi16(t01, t23);
+    __m128i y03 = _mm_unpacklo_epi16(t45, t67);
+    __m128i y47 = _mm_unpackhi_epi16(t45, t67);
+
+    sgl_avx2_rotate_store64x2(&dst[0 * dst_stride], &dst[1 * dst_stride], _mm_unpacklo_epi32(x03, y03));
+    sgl_avx2_rotate_store64x2(&dst[2 * dst_stride], &dst[3 * dst_stride], _mm_unpackhi_epi32(x03, y03));
+    sgl_avx2_rotate_store64x2(&dst[4 * dst_stride], &dst[5 * dst_stride], _mm_unpacklo_epi32(x47, y47));
+    sgl_avx2_rotate_store64x2(&dst[6 * dst_stride], &dst[7 * dst_stride], _mm_unpackhi_epi32(x47, y47));
+}
+
+static void sgl_avx2_rotate_tile_bpp16(
+    sgl_uint8_t *SGL_RESTRICT dst, sgl_ptrdiff_t dst_stride,
+    const sgl_uint8_t *SGL_RESTRICT src, sgl_ptrdiff_t src_stride)
+{
+    __m128i r[SGL_ROTATE_TILE];
+    __m128i t[SGL_ROTATE_TILE];
+    __m128i u[SGL_ROTATE_TILE];
+    sgl_int32_t i;
+
+    for (i = 0; i < SGL_ROTATE_TILE; ++i) {
+        r[i] = _mm_loadu_si128((const __m128i *)(const void *)&src[(sgl_ptrdiff_t)i * src_stride]);
+    }
+    for (i = 0; i < SGL_ROTATE_TILE; i += 2) {
+        t[i] = _mm_unpacklo_epi16(r[i], r[i + 1]);
+        t[i + 1] = _mm_unpackhi_epi16(r[i], r[i + 1]);
+    }
+    /* u[0..3] hold rows a..d, u[4..7] rows e..h; two columns per vector */
+    u[0] = _mm_unpacklo_epi32(t[0], t[2]);
+    u[1] = _mm_unpackhi_epi32(t[0], t[2]);
+    u[2] = _mm_unpacklo_epi32(t[1], t[3]);
+    u[3] = _mm_unpackhi_epi32(t[1], t[3]);
+    u[4] = _mm_unpacklo_epi32(t[4], t[6]);
+    u[5] = _mm_unpackhi_epi32(t[4], t[6]);
+    u[6] = _mm_unpacklo_epi32(t[5], t[7]);
+    u[7] = _mm_unpackhi_epi32(t[5], t[7]);
+    for (i = 0; i < 4; ++i) {
+        _mm_storeu_si128((__m128i *)(void *)&dst[(sgl_ptrdiff_t)(2 * i) * dst_stride], _mm_unpacklo_epi64(u[i], u[i + 4]));
+        _mm_storeu_si128((__m128i *)(void *)&dst[(sgl_ptrdiff_t)((2 * i) + 1) * dst_stride], _mm_unpackhi_epi64(u[i], u[i + 4]));
+    }
+}
+
+/*
+ * 8x8 dword transpose.  In-lane unpacks build 4x4 transposes in both 128-bit
+ * lanes; permute2x128 then joins the matching lanes of rows a..d and e..h.
+ */
+static void sgl_avx2_rotate_tile_bpp32(
+    sgl_uint8_t *SGL_RESTRICT dst, sgl_ptrdiff_t dst_stride,
+    const sgl_uint8_t *SGL_RESTRICT src, sgl_ptrdiff_t src_stride)
+{
+    __m256i r[SGL_ROTATE_TILE];
+    __m256i t[SGL_ROTATE_TILE];
+    __m256i u[SGL_ROTATE_TILE];
+    sgl_int32_t i;
+
+    for (i = 0; i < SGL_ROTATE_TILE; ++i) {
+        r[i] = _mm256_loadu_si256((const __m256i *)(const void *)&src[(sgl_ptrdiff_t)i * src_stride]);
+    }
+    for (i = 0; i < SGL_ROTATE_TILE; i += 2) {
+        t[i] = _mm256_unpacklo_epi32(r[i], r[i + 1]);
+        t[i + 1] = _mm256_unpackhi_epi32(r[i], r[i + 1]);
+    }
+    u[0] = _mm256_unpacklo_epi64(t[0], t[2]);
+    u[1] = _mm256_unpackhi_epi64(t[0], t[2]);
+    u[2] = _mm256_unpacklo_epi64(t[1], t[3]);
+    u[3] = _mm256_unpackhi_epi64(t[1], t[3]);
+    u[4] = _mm256_unpacklo_epi64(t[4], t[6]);
+    u[5] = _mm256_unpackhi_epi64(t[4], t[6]);
+    u[6] = _mm256_unpacklo_epi64(t[5], t[7]);
+    u[7] = _mm256_unpackhi_epi64(t[5], t[7]);
+    for (i = 0; i < 4; ++i) {
+        _mm256_storeu_si256((__m256i *)(void *)&dst[(sgl_ptrdiff_t)i * dst_stride], _mm256_permute2x128_si256(u[i], u[i + 4], 0x20));
+        _mm256_storeu_si256((__m256i *)(void *)&dst[(sgl_ptrdiff_t)(i + 4) * dst_stride], _mm256_permute2x128_si256(u[i], u[i + 4], 0x31));
+    }
+}
+
+static void sgl_avx2_rotate_reverse_bpp8(
+    sgl_uint8_t *SGL_RESTRICT dst,
+    const sgl_uint8_t *SGL_RESTRICT src,
+    sgl_int32_t count)
+{
+    const __m128i mask = _mm_setr_epi8(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0);
+    __m128i v;
+    sgl_int32_t i;
+
+    for (i = 0; (i + 16) <= count; i += 16) {
+        v = _mm_loadu_si128((const __m128i *)(const void *)&src[count - i - 16]);
+        _mm_storeu_si128((__m128i *)(void *)&dst[i], _mm_shuffle_epi8(v, mask));
+    }
+    sgl_generic_rotate_reverse(&dst[i], src, count - i, SGL_BPP8);
+}
+
+static void sgl_avx2_rotate_reverse_bpp16(
+    sgl_uint8_t *SGL_RESTRICT dst,
+    const sgl_uint8_t *SGL_RESTRICT src,
+    sgl_int32_t count)
+{
+    const __m128i mask = _mm_setr_epi8(14, 15, 12, 13, 10, 11, 8, 9, 6, 7, 4, 5, 2, 3, 0, 1);
+    __m128i v;
+    sgl_int32_t i;
+
+    for (i = 0; (i + 8) <= count; i += 8) {
+        v = _mm_loadu_si128((const __m128i *)(const void *)&src[(count - i - 8) * SGL_BPP16]);
+        _mm_storeu_si128((__m128i *)(void *)&dst[i * SGL_BPP16], _mm_shuffle_epi8(v, mask));
+    }
+    sgl_generic_rotate_reverse(&dst[i * SGL_BPP16], src, count - i, SGL_BPP16);
+}
+
+static void sgl_avx2_rotate_reverse_bpp32(
+    sgl_uint8_t *SGL_RESTRICT dst,
+    const sgl_uint8_t *SGL_RESTRICT src,
+    sgl_int32_t count)
+{
+    const __m256i index = _mm256_setr_epi32(7, 6, 5, 4, 3, 2, 1, 0);
+    __m256i v;
+    sgl_int32_t i;
+
+    for (i = 0; (i + 8) <= count; i += 8) {
+        v = _mm256_loadu_si256((const __m256i *)(const void *)&src[(count - i - 8) * SGL_BPP32]);
+        _mm256_storeu_si256((__m256i *)(void *)&dst[i * SGL_BPP32], _mm256_permutevar8x32_epi32(v, index));
+    }
+    sgl_generic_rotate_reverse(&dst[i * SGL_BPP32], src, count - i, SGL_BPP32);
+}
+
+/* Three-byte pixels have no cheap lane permutation; the generic path is used. */
+sgl_rotate_tile_kernel_t sgl_simd_rotate_tile_kernel(sgl_int32_t bpp)
+{
+    sgl_rotate_tile_kernel_t kernel;
+
+    switch (bpp) {
+    case SGL_BPP8:
+        kernel = sgl_avx2_rotate_tile_bpp8;
+        break;
+    case SGL_BPP16:
+        kernel = sgl_avx2_rotate_tile_bpp16;
+        break;
+    case SGL_BPP32:
+        kernel = sgl_avx2_rotate_tile_bpp32;
+        break;
+    default:
+        kernel = SGL_NULL;
+        break;
+    }
+
+    return kernel;
+}
+
+sgl_rotate_reverse_kernel_t sgl_simd_rotate_reverse_kernel(sgl_int32_t bpp)
+{
+    sgl_rotate_reverse_kernel_t kernel;
+
+    switch (bpp) {
+    case SGL_BPP8:
+        kernel = sgl_avx2_rotate_reverse_bpp8;
+        break;
+    case SGL_BPP16:
+        kernel = sgl_avx2_rotate_reverse_bpp16;
+        break;
+    case SGL_BPP32:
+        kernel = sgl_avx2_rotate_reverse_bpp32;
+        break;
+    default:
+        kernel = SGL_NULL;
+        break;
+    }
+
+    return kernel;
+}
@@ -6,3 +6,561 @@
  * This code is released under the MIT License.
  * For conditions of distribution and use, see the LICENSE file.
  */
+#include <sgl-core.h>
+#include <sgl_image_format.h>
+#include "rotate.h"
+
+#if defined(SGL_CFG_HAS_THREAD)
+static void sgl_rotate_routine(sgl_int32_t begin, sgl_int32_t end, void *SGL_RESTRICT cookie);
+#endif  /* !SGL_CFG_HAS_THREAD */
+
+static SGL_ALWAYS_INLINE void sgl_generic_rotate_transpose_fixed(
+    sgl_uint8_t *SGL_RESTRICT dst, sgl_ptrdiff_t dst_stride,
+    const sgl_uint8_t *SGL_RESTRICT src, sgl_ptrdiff_t src_stride,
+    sgl_int32_t cols, sgl_int32_t rows, sgl_int32_t bpp)
+{
+    const sgl_uint8_t *s;
+    sgl_uint8_t *d;
+    sgl_int32_t i;
+    sgl_int32_t j;
+    sgl_int32_t k;
+
+    for (i = 0; i < rows; ++i) {
+        s = &src[(sgl_ptrdiff_t)i * src_stride];
+        d = &dst[(sgl_ptrdiff_t)i * bpp];
+        for (j = 0; j < cols; ++j) {
+            for (k = 0; k < bpp; ++k) {
+                d[k] = s[k];
+            }
+            s = &s[bpp];
+            d = &d[dst_stride];
+        }
+    }
+}
+
+void sgl_generic_rotate_transpose_block(
+    sgl_uint8_t *SGL_RESTRICT dst, sgl_ptrdiff_t dst_stride,
+    const sgl_uint8_t *SGL_RESTRICT src, sgl_ptrdiff_t src_stride,
+    sgl_int32_t cols, sgl_int32_t rows, sgl_int32_t bpp)
+{
+    sgl_generic_rotate_transpose_fixed(
+        dst, dst_stride, src, src_stride, cols, rows, bpp);
+}
+
+/* Constant bpp lets the compiler unroll the pixel copy of full tiles. */
+static void sgl_generic_rotate_tile_bpp8(
+    sgl_uint8_t *SGL_RESTRICT dst, sgl_ptrdiff_t dst_stride,
+    const sgl_uint8_t *SGL_RESTRICT src, sgl_ptrdiff_t src_stride)
+{
+    sgl_generic_rotate_transpose_fixed(
+        dst, dst_stride, src, src_stride,
+        SGL_ROTATE_TILE, SGL_ROTATE_TILE, SGL_BPP8);
+}
+
+static void sgl_generic_rotate_tile_bpp16(
+    sgl_uint8_t *SGL_RESTRICT dst, sgl_ptrdiff_t dst_stride,
+    const sgl_uint8_t *SGL_RESTRICT src, sgl_ptrdiff_t src_stride)
+{
+    sgl_generic_rotate_transpose_fixed(
+        dst, dst_stride, src, src_stride,
+        SGL_ROTATE_TILE, SGL_ROTATE_TILE, SGL_BPP16);
+}
+
+static void sgl_generic_rotate_tile_bpp24(
+    sgl_uint8_t *SGL_RESTRICT dst, sgl_ptrdiff_t dst_stride,
+    const sgl_uint8_t *SGL_RESTRICT src, sgl_ptrdiff_t src_stride)
+{
+    sgl_generic_rotate_transpose_fixed(
+        dst, dst_stride, src, src_stride,
+        SGL_ROTATE_TILE, SGL_ROTATE_TILE, SGL_BPP24);
+}
+
+static void sgl_generic_rotate_tile_bpp32(
+    sgl_uint8_t *SGL_RESTRICT dst, sgl_ptrdiff_t dst_stride,
+    const sgl_uint8_t *SGL_RESTRICT src, sgl_ptrdiff_t src_stride)
+{
+    sgl_generic_rotate_transpose_fixed(
+        dst, dst_stride, src, src_stride,
+        SGL_ROTATE_TILE, SGL_ROTATE_TILE, SGL_BPP32);
+}
+
+void sgl_generic_rotate_reverse(
+    sgl_uint8_t *SGL_RESTRICT dst,
+    const sgl_uint8_t *SGL_RESTRICT src,
+    sgl_int32_t count,
+    sgl_int32_t bpp)
+{
+    const sgl_uint8_t *s;
+    sgl_int32_t i;
+    sgl_int32_t k;
+
+    s = &src[(sgl_ptrdiff_t)(count - 1) * bpp];
+    for (i = 0; i < count; ++i) {
+        for (k = 0; k < bpp; ++k) {
+            dst[k] = s[k];
+        }
+        dst = &dst[bpp];
+        s -= bpp;
+    }
+}
+
+static sgl_int32_t sgl_rotate_count_errors(
+    const sgl_uint8_t *dst,
+    const sgl_uint8_t *src,
+    sgl_int32_t s_width,
+    sgl_int32_t s_height,
+    sgl_int32_t bpp,
+    sgl_rotation_t rotation)
+{
+    sgl_int32_t errcnt;
+
+    errcnt = 0;
+
+    /* check buffer address */
+    if ((dst == SGL_NULL) || (src == SGL_NULL)) {
+        errcnt += 1;
+    }
+    else if ((dst == src) && (rotation != SGL_ROTATE_0)) {
+        /* in-place transforms are not supported */
+        errcnt += 1;
+    }
+    else {
+        /* valid buffers */
+    }
+
+    /* check boundary */
+    if ((s_width <= 0) || (s_height <= 0)) {
+        errcnt += 1;
+    }
+
+    /* check bpp(bytes per pixel) */
+    if (bpp <= 0) {
+        errcnt += 1;
+    }
+
+    /* check orientation */
+    if ((rotation < SGL_ROTATE_0) || (rotation > SGL_TRANSVERSE)) {
+        errcnt += 1;
+    }
+
+    return errcnt;
+}
+
+static sgl_rotate_tile_kernel_t sgl_rotate_select_tile_kernel(sgl_int32_t bpp)
+{
+    sgl_rotate_tile_kernel_t kernel;
+
+    kernel = SGL_NULL;
+#if defined(SGL_ROTATE_HAS_SIMD_KERNELS)
+    kernel = sgl_simd_rotate_tile_kernel(bpp);
+#endif  /* !SGL_ROTATE_HAS_SIMD_KERNELS */
+    if (kernel == SGL_NULL) {
+        switch (bpp) {
+        case SGL_BPP8:
+            kernel = sgl_generic_rotate_tile_bpp8;
+            break;
+        case SGL_BPP16:
+            kernel = sgl_generic_rotate_tile_bpp16;
+            break;
+        case SGL_BPP24:
+            kernel = sgl_generic_rotate_tile_bpp24;
+            break;
+        case SGL_BPP32:
+            kernel = sgl_generic_rotate_tile_bpp32;
+            break;
+        default:
+            /* wider pixels use the block transpose */
+            break;
+        }
+    }
+
+    return kernel;
+}
+
+static sgl_rotate_reverse_kernel_t sgl_rotate_select_reverse_kernel(sgl_int32_t bpp)
+{
+    sgl_rotate_reverse_kernel_t kernel;
+
+    kernel = SGL_NULL;
+#if defined(SGL_ROTATE_HAS_SIMD_KERNELS)
+    kernel = sgl_simd_rotate_reverse_kernel(bpp);
+#else
+    SGL_UNUSED_PARAM(bpp);
+#endif  /* !SGL_ROTATE_HAS_SIMD_KERNELS */
+
+    return kernel;
+}
+
+/*
+ * Destination placement of every orientation.  d_stride is the row stride of
+ * the destination, at least s_height pixels for transposed outputs.
+ *
+ *   orientation      origin                          x_step     y_step
+ *   ROTATE_0         0                               bpp        d_stride
+ *   FLIP_HORIZONTAL  (w - 1) * bpp                   -bpp       d_stride
+ *   FLIP_VERTICAL    (h - 1) * d_stride              bpp        -d_stride
+ *   ROTATE_180       both                            -bpp       -d_stride
+ *   TRANSPOSE        0                               d_stride   bpp
+ *   ROTATE_90        (h - 1) * bpp                   d_stride   -bpp
+ *   ROTATE_270       (w - 1) * d_stride              -d_stride  bpp
+ *   TRANSVERSE       both                            -d_stride  -bpp
+ */
+void sgl_rotate_set_data(
+    sgl_rotate_data_t *data,
+    sgl_uint8_t *SGL_RESTRICT dst,
+    sgl_ptrdiff_t d_stride,
+    const sgl_uint8_t *SGL_RESTRICT src,
+    sgl_ptrdiff_t s_stride,
+    sgl_int32_t s_width,
+    sgl_int32_t s_height,
+    sgl_int32_t bpp,
+    sgl_rotation_t rotation)
+{
+    sgl_ptrdiff_t pixel;
+    sgl_ptrdiff_t offset;
+
+    pixel = (sgl_ptrdiff_t)bpp;
+    offset = 0;
+    data->src = src;
+    data->s_width = s_width;
+    data->s_height = s_height;
+    data->bpp = bpp;
+    data->src_stride = s_stride;
+    data->tile = SGL_NULL;
+    data->reverse = SGL_NULL;
+
+    if ((rotation == SGL_ROTATE_0) || (rotation == SGL_ROTATE_180) ||
+        (rotation == SGL_FLIP_HORIZONTAL) || (rotation == SGL_FLIP_VERTICAL)) {
+        data->transposed = SGL_FALSE;
+        data->x_step = pixel;
+        data->y_step = d_stride;
+        if ((rotation == SGL_FLIP_HORIZONTAL) || (rotation == SGL_ROTATE_180)) {
+            offset += (sgl_ptrdiff_t)(s_width - 1) * pixel;
+            data->x_step = -pixel;
+            data->reverse = sgl_rotate_select_reverse_kernel(bpp);
+        }
+        if ((rotation == SGL_FLIP_VERTICAL) || (rotation == SGL_ROTATE_180)) {
+            offset += (sgl_ptrdiff_t)(s_height - 1) * d_stride;
+            data->y_step = -d_stride;
+        }
+    }
+    else {
+        data->transposed = SGL_TRUE;
+        data->x_step = d_stride;
+        data->y_step = pixel;
+        data->tile = sgl_rotate_select_tile_kernel(bpp);
+        if ((rotation == SGL_ROTATE_90) || (rotation == SGL_TRANSVERSE)) {
+            offset += (sgl_ptrdiff_t)(s_height - 1) * pixel;
+            data->y_step = -pixel;
+        }
+        if ((rotation == SGL_ROTATE_270) || (rotation == SGL_TRANSVERSE)) {
+            offset += (sgl_ptrdiff_t)(s_width - 1) * d_stride;
+            data->x_step = -d_stride;
+        }
+    }
+    data->origin = &dst[offset];
+}
+
+static void sgl_rotate_rows_range(
+    const sgl_rotate_data_t *data,
+    sgl_int32_t start_row,
+    sgl_int32_t row_count)
+{
+    const sgl_uint8_t *s;
+    sgl_uint8_t *d;
+    sgl_size_t row_size;
+    sgl_int32_t y;
+
+    row_size = (sgl_size_t)data->s_width * (sgl_size_t)data->bpp;
+    for (y = start_row; y < (start_row + row_count); ++y) {
+        s = &data->src[(sgl_ptrdiff_t)y * data->src_stride];
+        d = &data->origin[(sgl_ptrdiff_t)y * data->y_step];
+        if (data->x_step > 0) {
+            (void)sgl_memcpy(d, s, row_size);
+        }
+        else {
+            /* the mirrored row starts at the last source pixel */
+            d = &d[(sgl_ptrdiff_t)(data->s_width - 1) * data->x_step];
+            if (data->reverse != SGL_NULL) {
+                data->reverse(d, s, data->s_width);
+            }
+            else {
+                sgl_generic_rotate_reverse(d, s, data->s_width, data->bpp);
+            }
+        }
+    }
+}
+
+static SGL_ALWAYS_INLINE void sgl_rotate_transpose_tile(
+    const sgl_rotate_data_t *data,
+    sgl_int32_t x,
+    sgl_int32_t y,
+    sgl_int32_t cols,
+    sgl_int32_t rows)
+{
+    const sgl_uint8_t *s;
+    sgl_uint8_t *d;
+    sgl_ptrdiff_t s_stride;
+
+    s = &data->src[((sgl_ptrdiff_t)y * data->src_stride) +
+                   ((sgl_ptrdiff_t)x * data->bpp)];
+    d = &data->origin[((sgl_ptrdiff_t)x * data->x_step) +
+                      ((sgl_ptrdiff_t)y * data->y_step)];
+    s_stride = data->src_stride;
+    if (data->y_step < 0) {
+        /*
+         * Destination columns run upward.  Walk the source rows from the
+         * bottom so the kernel always writes ascending destination bytes.
+         */
+        s = &s[(sgl_ptrdiff_t)(rows - 1) * s_stride];
+        d = &d[(sgl_ptrdiff_t)(rows - 1) * data->y_step];
+        s_stride = -s_stride;
+    }
+
+    if ((cols == SGL_ROTATE_TILE) && (rows == SGL_ROTATE_TILE) &&
+        (data->tile != SGL_NULL)) {
+        data->tile(d, data->x_step, s, s_stride);
+    }
+    else {
+        sgl_generic_rotate_transpose_block(
+            d, data->x_step, s, s_stride, cols, rows, data->bpp);
+    }
+}
+
+static void sgl_rotate_transpose_range(
+    const sgl_rotate_data_t *data,
+    sgl_int32_t start_row,
+    sgl_int32_t row_count)
+{
+    sgl_int32_t end_row;
+    sgl_int32_t block_y;
+    sgl_int32_t block_x;
+    sgl_int32_t block_rows;
+    sgl_int32_t block_cols;
+    sgl_int32_t tile_y;
+    sgl_int32_t tile_x;
+    sgl_int32_t rows;
+    sgl_int32_t cols;
+
+    end_row = start_row + row_count;
+    for (block_y = start_row; block_y < end_row; block_y += SGL_ROTATE_BLOCK) {
+        block_rows = end_row - block_y;
+        if (block_rows > SGL_ROTATE_BLOCK) {
+            block_rows = SGL_ROTATE_BLOCK;
+        }
+        for (block_x = 0; block_x < data->s_width; block_x += SGL_ROTATE_BLOCK) {
+            block_cols = data->s_width - block_x;
+            if (block_cols > SGL_ROTATE_BLOCK) {
+                block_cols = SGL_ROTATE_BLOCK;
+            }
+            for (tile_y = 0; tile_y < block_rows; tile_y += SGL_ROTATE_TILE) {
+                rows = block_rows - tile_y;
+                if (rows > SGL_ROTATE_TILE) {
+                    rows = SGL_ROTATE_TILE;
+                }
+                for (tile_x = 0; tile_x < block_cols; tile_x += SGL_ROTATE_TILE) {
+                    cols = block_cols - tile_x;
+                    if (cols > SGL_ROTATE_TILE) {
+                        cols = SGL_ROTATE_TILE;
+                    }
+                    sgl_rotate_transpose_tile(
+                        data, block_x + tile_x, block_y + tile_y, cols, rows);
+                }
+            }
+        }
+    }
+}
+
+void sgl_rotate_range(
+    const sgl_rotate_data_t *data,
+    sgl_int32_t start_row,
+    sgl_int32_t row_count)
+{
+    if (data->transposed == SGL_TRUE) {
+        sgl_rotate_transpose_range(data, start_row, row_count);
+    }
+    else {
+        sgl_rotate_rows_range(data, start_row, row_count);
+    }
+}
+
+#if defined(SGL_CFG_HAS_THREAD)
+static sgl_bool_t sgl_rotate_should_use_threadpool(
+    const sgl_threadpool_t *pool,
+    const sgl_rotate_data_t *data)
+{
+    sgl_uint64_t output_bytes;
+    /* SGL_FALSE is the project's explicitly typed boolean sentinel. */
+    /* cppcheck-suppress misra-c2012-10.5 */
+    sgl_bool_t result = SGL_FALSE;
+
+    output_bytes = (sgl_uint64_t)(sgl_uint32_t)data->s_width *
+        (sgl_uint64_t)(sgl_uint32_t)data->s_height *
+        (sgl_uint64_t)(sgl_uint32_t)data->bpp;
+    if ((sgl_threadpool_get_num_threads(pool) > 1U) &&
+        (output_bytes >= SGL_ROTATE_MIN_THREAD_BYTES)) {
+        result = SGL_TRUE;
+    }
+
+    return result;
+}
+
+/*
+ * Chunks are whole 64-row blocks so that no 8x8 tile is split between two
+ * workers.  Each chunk writes a disjoint set of destination columns
+ * (transposed) or rows (non-transposed).
+ */
+static sgl_result_t sgl_rotate_threaded(
+    sgl_threadpool_t *SGL_RESTRICT pool,
+    sgl_rotate_data_t *data)
+{
+    sgl_result_t result;
+
+    /* multi-threaded rotate */
+    result = sgl_threadpool_parallel_for(
+        pool, 0, data->s_height, SGL_ROTATE_BLOCK, sgl_rotate_routine, (void *)data);
+
+    return result;
+}
+#endif  /* !SGL_CFG_HAS_THREAD */
+
+static sgl_result_t sgl_rotate_run(
+    sgl_threadpool_t *SGL_RESTRICT pool,
+    sgl_rotate_data_t *data)
+{
+    sgl_result_t result;
+
+    result = SGL_SUCCESS;
+    if (pool == SGL_NULL) {
+        sgl_rotate_range(data, 0, data->s_height);
+    }
+#if defined(SGL_CFG_HAS_THREAD)
+    else if (sgl_rotate_should_use_threadpool(pool, data) == SGL_FALSE) {
+        sgl_rotate_range(data, 0, data->s_height);
+    }
+    else {
+        result = sgl_rotate_threaded(pool, data);
+    }
+#else
+    else {
+        result = SGL_ERROR_NOT_SUPPORTED;
+    }
+#endif  /* !SGL_CFG_HAS_THREAD */
+
+    return result;
+}
+
+sgl_result_t sgl_rotate(
+                sgl_threadpool_t *SGL_RESTRICT pool,
+                sgl_uint8_t *SGL_RESTRICT dst,
+                const sgl_uint8_t *SGL_RESTRICT src, sgl_int32_t s_width, sgl_int32_t s_height,
+                sgl_int32_t bpp, sgl_rotation_t rotation)
+{
+    sgl_result_t result = SGL_SUCCESS;
+    sgl_rotate_data_t data;
+    sgl_int32_t errcnt = 0;
+
+    errcnt = sgl_rotate_count_errors(dst, src, s_width, s_height, bpp, rotation);
+
+    /* check error count */
+    if (errcnt != 0) {
+        result = SGL_ERROR_INVALID_ARGUMENTS;
+    }
+    else if (dst == src) {
+        /* identity transform of the same buffer */
+    }
+    else {
+        sgl_rotate_set_data(
+            &data,
+            dst, (sgl_ptrdiff_t)sgl_rotate_oriented_width(s_width, s_height, rotation) * bpp,
+            src, (sgl_ptrdiff_t)s_width * bpp,
+            s_width, s_height, bpp, rotation);
+        result = sgl_rotate_run(pool, &data);
+    }
+
+    return result;
+}
+
+static sgl_int32_t sgl_image_rotate_count_errors(
+    const sgl_image_t *dst,
+    const sgl_image_t *src,
+    sgl_rotation_t rotation,
+    sgl_image_format_info_t *info)
+{
+    sgl_image_format_info_t dst_info;
+    sgl_int32_t errcnt;
+
+    errcnt = sgl_image_count_errors(dst, &dst_info);
+    errcnt += sgl_image_count_errors(src, info);
+
+    /* check orientation */
+    if ((rotation < SGL_ROTATE_0) || (rotation > SGL_TRANSVERSE)) {
+        errcnt += 1;
+    }
+    else if (errcnt == 0) {
+        /* dst must hold the oriented source */
+        if ((dst->format != src->format) ||
+            (dst->width != sgl_rotate_oriented_width(src->width, src->height, rotation)) ||
+            (dst->height != sgl_rotate_oriented_width(src->height, src->width, rotation))) {
+            errcnt += 1;
+        }
+        else if ((dst->planes[0] == src->planes[0]) && (rotation != SGL_ROTATE_0)) {
+            /* in-place transforms are not supported */
+            errcnt += 1;
+        }
+        else {
+            /* valid views */
+        }
+    }
+    else {
+        /* invalid views */
+    }
+
+    return errcnt;
+}
+
+sgl_result_t sgl_image_rotate(
+                sgl_threadpool_t *SGL_RESTRICT pool,
+                const sgl_image_t *SGL_RESTRICT dst, const sgl_image_t *SGL_RESTRICT src,
+                sgl_rotation_t rotation)
+{
+    sgl_result_t result = SGL_SUCCESS;
+    sgl_image_format_info_t info;
+    sgl_rotate_data_t data;
+    sgl_int32_t errcnt = 0;
+    sgl_int32_t plane;
+
+    errcnt = sgl_image_rotate_count_errors(dst, src, rotation, &info);
+
+    /* check error count */
+    if (errcnt != 0) {
+        result = SGL_ERROR_INVALID_ARGUMENTS;
+    }
+    else if (dst->planes[0] == src->planes[0]) {
+        /* identity transform of the same view */
+    }
+    else {
+        /* chroma planes rotate with their own subsampled geometry */
+        for (plane = 0; (result == SGL_SUCCESS) && (plane < info.planes); ++plane) {
+            sgl_rotate_set_data(
+                &data,
+                dst->planes[plane], (sgl_ptrdiff_t)dst->strides[plane],
+                src->planes[plane], (sgl_ptrdiff_t)src->strides[plane],
+                sgl_image_plane_width(&info, plane, src->width),
+                sgl_image_plane_height(&info, plane, src->height),
+                info.bpp[plane], rotation);
+            result = sgl_rotate_run(pool, &data);
+        }
+    }
+
+    return result;
+}
+
+#if defined(SGL_CFG_HAS_THREAD)
+static void sgl_rotate_routine(sgl_int32_t begin, sgl_int32_t end, void *SGL_RESTRICT cookie)
+{
+    const sgl_rotate_data_t *data = sgl_memory_as_rotate_data(cookie);
+
+    sgl_rotate_range(data, begin, end - begin);
+}
+#endif  /* !SGL_CFG_HAS_THREAD */
@@ -0,0 +1,284 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright (c) 2025 Dylan Hong
+ *
+ * This code is released under the MIT License.
+ * For conditions of distribution and use, see the LICENSE file.
+ */
+#include <arm_neon.h>
+#include <sgl-core.h>
+#include "rotate.h"
+
+/*
+ * 8x8 byte transpose in three vtrn stages.  Pairs of rows are interleaved
+ * at 8-, 16- and then 32-bit granularity; afterwards vector n holds source
+ * column n.
+ *
+ *   rows a..h      vtrn_u8        vtrn_u16          vtrn_u32
+ *   a0 a1 a2 ..    a0 b0 a2 b2    a0 b0 c0 d0 a4    a0 b0 c0 d0 e0 f0 g0 h0
+ *   b0 b1 b2 ..    a1 b1 a3 b3    a2 b2 c2 d2 a6    ...
+ */
+static SGL_ALWAYS_INLINE void sgl_neon_rotate_transpose_u8x8(uint8x8_t v[SGL_ROTATE_TILE])
+{
+    uint8x8x2_t t01 = vtrn_u8(v[0], v[1]);
+    uint8x8x2_t t23 = vtrn_u8(v[2], v[3]);
+    uint8x8x2_t t45 = vtrn_u8(v[4], v[5]);
+    uint8x8x2_t t67 = vtrn_u8(v[6], v[7]);
+    uint16x4x2_t x02 = vtrn_u16(vreinterpret_u16_u8(t01.val[0]), vreinterpret_u16_u8(t23.val[0]));
+    uint16x4x2_t x13 = vtrn_u16(vreinterpret_u16_u8(t01.val[1]), vreinterpret_u16_u8(t23.val[1]));
+    uint16x4x2_t y02 = vtrn_u16(vreinterpret_u16_u8(t45.val[0]), vreinterpret_u16_u8(t67.val[0]));
+    uint16x4x2_t y13 = vtrn_u16(vreinterpret_u16_u8(t45.val[1]), vreinterpret_u16_u8(t67.val[1]));
+    uint32x2x2_t c04 = vtrn_u32(vreinterpret_u32_u16(x02.val[0]), vreinterpret_u32_u16(y02.val[0]));
+    uint32x2x2_t c26 = vtrn_u32(vreinterpret_u32_u16(x02.val[1]), vreinterpret_u32_u16(y02.val[1]));
+    uint32x2x2_t c15 = vtrn_u32(vreinterpret_u32_u16(x13.val[0]), vreinterpret_u32_u16(y13.val[0]));
+    uint32x2x2_t c37 = vtrn_u32(vreinterpret_u32_u16(x13.val[1]), vreinterpret_u32_u16(y13.val[1]));
+
+    v[0] = vreinterpret_u8_u32(c04.val[0]);
+    v[1] = vreinterpret_u8_u32(c15.val[0]);
+    v[2] = vreinterpret_u8_u32(c26.val[0]);
+    v[3] = vreinterpret_u8_u32(c37.val[0]);
+    v[4] = vreinterpret_u8_u32(c04.val[1]);
+    v[5] = vreinterpret_u8_u32(c15.val[1]);
+    v[6] = vreinterpret_u8_u32(c26.val[1]);
+    v[7] = vreinterpret_u8_u32(c37.val[1]);
+}
+
+static void sgl_neon_rotate_tile_bpp8(
+    sgl_uint8_t *SGL_RESTRICT dst, sgl_ptrdiff_t dst_stride,
+    const sgl_uint8_t *SGL_RESTRICT src, sgl_ptrdiff_t src_stride)
+{
+    uint8x8_t v[SGL_ROTATE_TILE];
+    sgl_int32_t i;
+
+    for (i = 0; i < SGL_ROTATE_TILE; ++i) {
+        v[i] = vld1_u8(&src[(sgl_ptrdiff_t)i * src_stride]);
+    }
+    sgl_neon_rotate_transpose_u8x8(v);
+    for (i = 0; i < SGL_ROTATE_TILE; ++i) {
+        vst1_u8(&dst[(sgl_ptrdiff_t)i * dst_stride], v[i]);
+    }
+}
+
+/* Three-channel pixels are split into planes, transposed, and re-interleaved. */
+static void sgl_neon_rotate_tile_bpp24(
+    sgl_uint8_t *SGL_RESTRICT dst, sgl_ptrdiff_t dst_stride,
+    const sgl_uint8_t *SGL_RESTRICT src, sgl_ptrdiff_t src_stride)
+{
+    uint8x8_t c0[SGL_ROTATE_TILE];
+    uint8x8_t c1[SGL_ROTATE_TILE];
+    uint8x8_t c2[SGL_ROTATE_TILE];
+    uint8x8x3_t pixels;
+    sgl_int32_t i;
+
+    for (i = 0; i < SGL_ROTATE_TILE; ++i) {
+        pixels = vld3_u8(&src[(sgl_ptrdiff_t)i * src_stride]);
+        c0[i] = pixels.val[0];
+        c1[i] = pixels.val[1];
+        c2[i] = pixels.val[2];
+    }
+    sgl_neon_rotate_transpose_u8x8(c0);
+    sgl_neon_rotate_transpose_u8x8(c1);
+    sgl_neon_rotate_transpose_u8x8(c2);
+    for (i = 0; i < SGL_ROTATE_TILE; ++i) {
+        pixels.val[0] = c0[i];
+        pixels.val[1] = c1[i];
+        pixels.val[2] = c2[i];
+        vst3_u8(&dst[(sgl_ptrdiff_t)i * dst_stride], pixels);
+    }
+}
+
+static void sgl_neon_rotate_tile_bpp16(
+    sgl_uint8_t *SGL_RESTRICT dst, sgl_ptrdiff_t dst_stride,
+    const sgl_uint8_t *SGL_RESTRICT src, sgl_ptrdiff_t src_stride)
+{
+    uint16x8_t r[SGL_ROTATE_TILE];
+    uint16x8x2_t t01;
+    uint16x8x2_t t23;
+    uint16x8x2_t t45;
+    uint16x8x2_t t67;
+    uint32x4x2_t x02;
+    uint32x4x2_t x13;
+    uint32x4x2_t y02;
+    uint32x4x2_t y13;
+    sgl_int32_t i;
+
+    for (i = 0; i < SGL_ROTATE_TILE; ++i) {
+        r[i] = vreinterpretq_u16_u8(vld1q_u8(&src[(sgl_ptrdiff_t)i * src_stride]));
+    }
+    t01 = vtrnq_u16(r[0], r[1]);
+    t23 = vtrnq_u16(r[2], r[3]);
+    t45 = vtrnq_u16(r[4], r[5]);
+    t67 = vtrnq_u16(r[6], r[7]);
+    x02 = vtrnq_u32(vreinterpretq_u32_u16(t01.val[0]), vreinterpretq_u32_u16(t23.val[0]));
+    x13 = vtrnq_u32(vreinterpretq_u32_u16(t01.val[1]), vreinterpretq_u32_u16(t23.val[1]));
+    y02 = vtrnq_u32(vreinterpretq_u32_u16(t45.val[0]), vreinterpretq_u32_u16(t67.val[0]));
+    y13 = vtrnq_u32(vreinterpretq_u32_u16(t45.val[1]), vreinterpretq_u32_u16(t67.val[1]));
+
+    /* low halves hold columns 0..3, high halves hold columns 4..7 */
+    vst1q_u8(&dst[0 * dst_stride], vreinterpretq_u8_u32(vcombine_u32(vget_low_u32(x02.val[0]), vget_low_u32(y02.val[0]))));
+    vst1q_u8(&dst[1 * dst_stride], vreinterpretq_u8_u32(vcombine_u32(vget_low_u32(x13.val[0]), vget_low_u32(y13.val[0]))));
+    vst1q_u8(&dst[2 * dst_stride], vreinterpretq_u8_u32(vcombine_u32(vget_low_u32(x02.val[1]), vget_low_u32(y02.val[1]))));
+    vst1q_u8(&dst[3 * dst_stride], vreinterpretq_u8_u32(vcombine_u32(vget_low_u32(x13.val[1]), vget_low_u32(y13.val[1]))));
+    vst1q_u8(&dst[4 * dst_stride], vreinterpretq_u8_u32(vcombine_u32(vget_high_u32(x02.val[0]), vget_high_u32(y02.val[0]))));
+    vst1q_u8(&dst[5 * dst_stride], vreinterpretq_u8_u32(vcombine_u32(vget_high_u32(x13.val[0]), vget_high_u32(y13.val[0]))));
+    vst1q_u8(&dst[6 * dst_stride], vreinterpretq_u8_u32(vcombine_u32(vget_high_u32(x02.val[1]), vget_high_u32(y02.val[1]))));
+    vst1q_u8(&dst[7 * dst_stride], vreinterpretq_u8_u32(vcombine_u32(vget_high_u32(x13.val[1]), vget_high_u32(y13.val[1]))));
+}
+
+static SGL_ALWAYS_INLINE void sgl_neon_rotate_transpose_u32x4(
+    sgl_uint8_t *SGL_RESTRICT dst, sgl_ptrdiff_t dst_stride,
+    const sgl_uint8_t *SGL_RESTRICT src, sgl_ptrdiff_t src_stride)
+{
+    uint32x4_t r0 = vreinterpretq_u32_u8(vld1q_u8(&src[0 * src_stride]));
+    uint32x4_t r1 = vreinterpretq_u32_u8(vld1q_u8(&src[1 * src_stride]));
+    uint32x4_t r2 = vreinterpretq_u32_u8(vld1q_u8(&src[2 * src_stride]));
+    uint32x4_t r3 = vreinterpretq_u32_u8(vld1q_u8(&src[3 * src_stride]));
+    uint32x4x2_t t01 = vtrnq_u32(r0, r1);
+    uint32x4x2_t t23 = vtrnq_u32(r2, r3);
+
+    vst1q_u8(&dst[0 * dst_stride], vreinterpretq_u8_u32(vcombine_u32(vget_low_u32(t01.val[0]), vget_low_u32(t23.val[0]))));
+    vst1q_u8(&dst[1 * dst_stride], vreinterpretq_u8_u32(vcombine_u32(vget_low_u32(t01.val[1]), vget_low_u32(t23.val[1]))));
+    vst1q_u8(&dst[2 * dst_stride], vreinterpretq_u8_u32(vcombine_u32(vget_high_u32(t01.val[0]), vget_high_u32(t23.val[0]))));
+    vst1q_u8(&dst[3 * dst_stride], vreinterpretq_u8_u32(vcombine_u32(vget_high_u32(t01.val[1]), vget_high_u32(t23.val[1]))));
+}
+
+/* Four 4x4 word transposes; quadrant (i, j) of the source lands at (j, i). */
+static void sgl_neon_rotate_tile_bpp32(
+    sgl_uint8_t *SGL_RESTRICT dst, sgl_ptrdiff_t dst_stride,
+    const sgl_uint8_t *SGL_RESTRICT src, sgl_ptrdiff_t src_stride)
+{
+    sgl_ptrdiff_t src_half;
+    sgl_ptrdiff_t dst_half;
+
+    src_half = 4 * src_stride;
+    dst_half = 4 * dst_stride;
+    sgl_neon_rotate_transpose_u32x4(dst, dst_stride, src, src_stride);
+    sgl_neon_rotate_transpose_u32x4(&dst[16], dst_stride, &src[src_half], src_stride);
+    sgl_neon_rotate_transpose_u32x4(&dst[dst_half], dst_stride, &src[16], src_stride);
+    sgl_neon_rotate_transpose_u32x4(&dst[dst_half + 16], dst_stride, &src[src_half + 16], src_stride);
+}
+
+static SGL_ALWAYS_INLINE uint8x16_t sgl_neon_rotate_reverse_u8x16(uint8x16_t v)
+{
+    uint8x16_t r = vrev64q_u8(v);
+
+    return vcombine_u8(vget_high_u8(r), vget_low_u8(r));
+}
+
+/*
+ * Row reversal walks the source backwards one vector at a time, reverses the
+ * lanes, and stores forward.  The generic loop finishes the tail.
+ *
+ *   src  [ ....... | v1 | v0 ]      dst  [ rev(v0) | rev(v1) | ....... ]
+ */
+static void sgl_neon_rotate_reverse_bpp8(
+    sgl_uint8_t *SGL_RESTRICT dst,
+    const sgl_uint8_t *SGL_RESTRICT src,
+    sgl_int32_t count)
+{
+    sgl_int32_t i;
+
+    for (i = 0; (i + 16) <= count; i += 16) {
+        vst1q_u8(&dst[i], sgl_neon_rotate_reverse_u8x16(vld1q_u8(&src[count - i - 16])));
+    }
+    sgl_generic_rotate_reverse(&dst[i], src, count - i, SGL_BPP8);
+}
+
+static void sgl_neon_rotate_reverse_bpp16(
+    sgl_uint8_t *SGL_RESTRICT dst,
+    const sgl_uint8_t *SGL_RESTRICT src,
+    sgl_int32_t count)
+{
+    uint16x8_t r;
+    sgl_int32_t i;
+
+    for (i = 0; (i + 8) <= count; i += 8) {
+        r = vrev64q_u16(vreinterpretq_u16_u8(vld1q_u8(&src[(count - i - 8) * SGL_BPP16])));
+        vst1q_u8(&dst[i * SGL_BPP16], vreinterpretq_u8_u16(vcombine_u16(vget_high_u16(r), vget_low_u16(r))));
+    }
+    sgl_generic_rotate_reverse(&dst[i * SGL_BPP16], src, count - i, SGL_BPP16);
+}
+
+static void sgl_neon_rotate_reverse_bpp24(
+    sgl_uint8_t *SGL_RESTRICT dst,
+    const sgl_uint8_t *SGL_RESTRICT src,
+    sgl_int32_t count)
+{
+    uint8x16x3_t pixels;
+    sgl_int32_t i;
+
+    for (i = 0; (i + 16) <= count; i += 16) {
+        pixels = vld3q_u8(&src[(count - i - 16) * SGL_BPP24]);
+        pixels.val[0] = sgl_neon_rotate_reverse_u8x16(pixels.val[0]);
+        pixels.val[1] = sgl_neon_rotate_reverse_u8x16(pixels.val[1]);
+        pixels.val[2] = sgl_neon_rotate_reverse_u8x16(pixels.val[2]);
+        vst3q_u8(&dst[i * SGL_BPP24], pixels);
+    }
+    sgl_generic_rotate_reverse(&dst[i * SGL_BPP24], src, count - i, SGL_BPP24);
+}
+
+static void sgl_neon_rotate_reverse_bpp32(
+    sgl_uint8_t *SGL_RESTRICT dst,
+    const sgl_uint8_t *SGL_RESTRICT src,
+    sgl_int32_t count)
+{
+    uint32x4_t r;
+    sgl_int32_t i;
+
+    for (i = 0; (i + 4) <= count; i += 4) {
+        r = vrev64q_u32(vreinterpretq_u32_u8(vld1q_u8(&src[(count - i - 4) * SGL_BPP32])));
+        vst1q_u8(&dst[i * SGL_BPP32], vreinterpretq_u8_u32(vcombine_u32(vget_high_u32(r), vget_low_u32(r))));
+    }
+    sgl_generic_rotate_reverse(&dst[i * SGL_BPP32], src, count - i, SGL_BPP32);
+}
+
+sgl_rotate_tile_kernel_t sgl_simd_rotate_tile_kernel(sgl_int32_t bpp)
+{
+    sgl_rotate_tile_kernel_t kernel;
+
+    switch (bpp) {
+    case SGL_BPP8:
+        kernel = sgl_neon_rotate_tile_bpp8;
+        break;
+    case SGL_BPP16:
+        kernel = sgl_neon_rotate_tile_bpp16;
+        break;
+    case SGL_BPP24:
+        kernel = sgl_neon_rotate_tile_bpp24;
+        break;
+    case SGL_BPP32:
+        kernel = sgl_neon_rotate_tile_bpp32;
+        break;
+    default:
+        kernel = SGL_NULL;
+        break;
+    }
+
+    return kernel;
+}
+
+sgl_rotate_reverse_kernel_t sgl_simd_rotate_reverse_kernel(sgl_int32_t bpp)
+{
+    sgl_rotate_reverse_kernel_t kernel;
+
+    switch (bpp) {
+    case SGL_BPP8:
+        kernel = sgl_neon_rotate_reverse_bpp8;
+        break;
+    case SGL_BPP16:
+        kernel = sgl_neon_rotate_reverse_bpp16;
+        break;
+    case SGL_BPP24:
+        kernel = sgl_neon_rotate_reverse_bpp24;
+        break;
+    case SGL_BPP32:
+        kernel = sgl_neon_rotate_reverse_bpp32;
+        break;
+    default:
+        kernel = SGL_NULL;
+        break;
+    }
+
+    return kernel;
+}
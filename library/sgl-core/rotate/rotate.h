@@ -0,0 +1,141 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright (c) 2025 Dylan Hong
+ *
+ * This code is released under the MIT License.
+ * For conditions of distribution and use, see the LICENSE file.
+ */
+#ifndef ROTATE_H_
+#define ROTATE_H_
+
+#include <sgl-core.h>
+#include <sgl_memory_cast.h>
+
+#define SGL_ROTATE_TILE                 (8)
+#define SGL_ROTATE_BLOCK                (64)
+#define SGL_ROTATE_MIN_THREAD_BYTES     ((sgl_uint64_t)2097152U)
+
+#if defined(SGL_CFG_HAS_NEON) || defined(SGL_CFG_HAS_AVX2)
+#define SGL_ROTATE_HAS_SIMD_KERNELS
+#endif  /* !SGL_CFG_HAS_NEON || SGL_CFG_HAS_AVX2 */
+
+/*
+ * Transposes one SGL_ROTATE_TILE x SGL_ROTATE_TILE pixel tile:
+ *   dst[j * dst_stride + i * bpp] = src[i * src_stride + j * bpp]
+ * Both strides may be negative; the caller folds the flip into them.
+ */
+typedef void (*sgl_rotate_tile_kernel_t)(
+    sgl_uint8_t *SGL_RESTRICT dst, sgl_ptrdiff_t dst_stride,
+    const sgl_uint8_t *SGL_RESTRICT src, sgl_ptrdiff_t src_stride);
+
+/* Stores count pixels of src into dst in reverse pixel order. */
+typedef void (*sgl_rotate_reverse_kernel_t)(
+    sgl_uint8_t *SGL_RESTRICT dst,
+    const sgl_uint8_t *SGL_RESTRICT src,
+    sgl_int32_t count);
+
+/*
+ * Design and Operation
+ * --------------------
+ * Every orientation is an affine map of source pixel (x, y) onto the packed
+ * destination.  origin, x_step and y_step are byte offsets, so the eight
+ * EXIF orientations only differ in the signs and in which step is the pixel
+ * size and which is the destination stride.
+ *
+ *   dst(x, y) = origin + x * x_step + y * y_step
+ *
+ *   non-transposed (0, 180, flips)     transposed (90, 270, transpose, transverse)
+ *   |x_step| == bpp                    |x_step| == s_height * bpp
+ *   |y_step| == d_stride               |y_step| == bpp
+ *   rows: memcpy or reversed copy      8x8 tiles inside 64x64 cache blocks
+ *
+ * A tile transpose reads eight source rows and writes eight destination rows,
+ * so both sides touch whole cache lines.  The 64x64 block keeps the active
+ * destination rows resident while the tiles of one block row are written.
+ */
+typedef struct {
+    const sgl_uint8_t *SGL_RESTRICT src;
+    sgl_uint8_t *SGL_RESTRICT origin;
+    sgl_int32_t s_width;
+    sgl_int32_t s_height;
+    sgl_int32_t bpp;
+    sgl_bool_t transposed;
+    sgl_ptrdiff_t src_stride;
+    sgl_ptrdiff_t x_step;
+    sgl_ptrdiff_t y_step;
+    sgl_rotate_tile_kernel_t tile;
+    sgl_rotate_reverse_kernel_t reverse;
+} sgl_rotate_data_t;
+
+/* Destination width of an s_width x s_height source after rotation. */
+static SGL_ALWAYS_INLINE sgl_int32_t sgl_rotate_oriented_width(
+    sgl_int32_t s_width,
+    sgl_int32_t s_height,
+    sgl_rotation_t rotation)
+{
+    sgl_int32_t width;
+
+    width = s_width;
+    if ((rotation == SGL_ROTATE_90) || (rotation == SGL_ROTATE_270) ||
+        (rotation == SGL_TRANSPOSE) || (rotation == SGL_TRANSVERSE)) {
+        width = s_height;
+    }
+
+    return width;
+}
+
+/*
+ * Fills data with the placement of an s_width x s_height source and the
+ * kernels for bpp.  d_stride and s_stride are the row strides in bytes.
+ * sgl_rotate_range() then places source rows
+ * [start_row, start_row + row_count); disjoint row ranges write disjoint
+ * destination bytes, so ranges may run on different workers.
+ */
+void sgl_rotate_set_data(
+    sgl_rotate_data_t *data,
+    sgl_uint8_t *SGL_RESTRICT dst,
+    sgl_ptrdiff_t d_stride,
+    const sgl_uint8_t *SGL_RESTRICT src,
+    sgl_ptrdiff_t s_stride,
+    sgl_int32_t s_width,
+    sgl_int32_t s_height,
+    sgl_int32_t bpp,
+    sgl_rotation_t rotation);
+
+void sgl_rotate_range(
+    const sgl_rotate_data_t *data,
+    sgl_int32_t start_row,
+    sgl_int32_t row_count);
+
+/* Accelerated kernels; SGL_NULL selects the generic implementation. */
+#if defined(SGL_ROTATE_HAS_SIMD_KERNELS)
+sgl_rotate_tile_kernel_t sgl_simd_rotate_tile_kernel(sgl_int32_t bpp);
+sgl_rotate_reverse_kernel_t sgl_simd_rotate_reverse_kernel(sgl_int32_t bpp);
+#endif  /* !SGL_ROTATE_HAS_SIMD_KERNELS */
+
+/* Generic pixel-block transpose used for edge tiles and unsupported bpp. */
+void sgl_generic_rotate_transpose_block(
+    sgl_uint8_t *SGL_RESTRICT dst, sgl_ptrdiff_t dst_stride,
+    const sgl_uint8_t *SGL_RESTRICT src, sgl_ptrdiff_t src_stride,
+    sgl_int32_t cols, sgl_int32_t rows, sgl_int32_t bpp);
+
+/* Generic pixel reversal used for row tails and unsupported bpp. */
+void sgl_generic_rotate_reverse(
+    sgl_uint8_t *SGL_RESTRICT dst,
+    const sgl_uint8_t *SGL_RESTRICT src,
+    sgl_int32_t count,
+    sgl_int32_t bpp);
+
+static SGL_ALWAYS_INLINE sgl_rotate_data_t *sgl_memory_as_rotate_data(void *memory)
+{
+    sgl_rotate_data_t *result;
+
+    /* SGL-MEM-DEV-001: typed conversion from generic storage. */
+    /* cppcheck-suppress misra-c2012-11.5 */
+    result = (sgl_rotate_data_t *)memory;
+
+    return result;
+}
+
+#endif  /* !ROTATE_H_ */
@@ -14,533 +14,2584 @@
 #include "sgl-osal.h"
 #include "sgl_trace.h"
 #include <sgl_memory_cast.h>
+#include "threadpool_placement.h"
+#include "threadpool_scratch.h"
 
-#if !defined(SGL_THREADPOOL_SPIN_WAIT_ITERATIONS)
-#define SGL_THREADPOOL_SPIN_WAIT_ITERATIONS    (65536U)
+#if !defined(SGL_THREADPOOL_DEFAULT_SPIN_LIMIT_US)
+#define SGL_THREADPOOL_DEFAULT_SPIN_LIMIT_US   (200U)
 #endif
 
+#if !defined(SGL_THREADPOOL_QUOTA_CHECK_INTERVAL_MS)
+#define SGL_THREADPOOL_QUOTA_CHECK_INTERVAL_MS  (1000U)
+#endif
+
+#define SGL_THREADPOOL_MAX_SPIN_LIMIT_US        (1000000U)
+#define SGL_THREADPOOL_SPIN_BATCH               (64U)
+#define SGL_THREADPOOL_NS_PER_US                (1000U)
+#define SGL_THREADPOOL_NS_PER_MS                (1000000U)
+
+#define SGL_THREADPOOL_CACHE_LINE_SIZE          (64U)
+#define SGL_THREADPOOL_ALIGN_UP(size) \
+    (((size) + SGL_THREADPOOL_CACHE_LINE_SIZE - 1U) & \
+     ~(SGL_THREADPOOL_CACHE_LINE_SIZE - 1U))
+#define SGL_THREADPOOL_MAX_OPERATIONS           ((sgl_size_t)0x7FFFFFFF)
+#define SGL_THREADPOOL_SUBMITTER_DEQUE          (0U)
+#define SGL_THREADPOOL_PRIORITY_COUNT           ((sgl_size_t)SGL_THREADPOOL_PRIORITY_HIGH + 1U)
+#define SGL_THREADPOOL_THROUGHPUT_SHIFT         (16U)   /* units per us in Q16 */
+#define SGL_THREADPOOL_THROUGHPUT_WEIGHT        (4U)    /* EWMA keeps 3/4 of the history */
+#define SGL_THREADPOOL_THROUGHPUT_MAX           ((sgl_uint64_t)0xFFFFFFFFU)
+#define SGL_THREADPOOL_CLAIM_RATIO_ONE          ((sgl_uint64_t)256U)
+
+/*
+ * Chase-Lev deque over a fixed slice of the task's operation array.  All
+ * operations are placed before the task is published, so the deque never
+ * grows: the owner pops at bottom, thieves advance top with a CAS.
+ */
+typedef struct {
+    sgl_osal_atomic_int32_t top;
+    sgl_osal_atomic_int32_t bottom;
+    void **items;
+} sgl_threadpool_deque_t;
+
+#define SGL_THREADPOOL_DEQUE_STRIDE \
+    SGL_THREADPOOL_ALIGN_UP(sizeof(sgl_threadpool_deque_t))
+#define SGL_THREADPOOL_SCRATCH_STRIDE \
+    SGL_THREADPOOL_ALIGN_UP(sizeof(sgl_threadpool_scratch_t))
+
+/*
+ * Statistics of one worker, or of all submitting threads together.  Only
+ * relaxed adds touch a slot, and each sits on its own cache line.
+ */
+typedef struct {
+    sgl_osal_atomic_uint64_t dispatches;
+    sgl_osal_atomic_uint64_t operations;
+    sgl_osal_atomic_uint64_t spin_wakeups;
+    sgl_osal_atomic_uint64_t parks;
+    sgl_osal_atomic_uint64_t completion_waits;
+    sgl_osal_atomic_uint64_t completion_wait_ns;
+    sgl_osal_atomic_uint64_t lock_contentions;
+} sgl_threadpool_stats_slot_t;
+
+#define SGL_THREADPOOL_STATS_STRIDE \
+    SGL_THREADPOOL_ALIGN_UP(sizeof(sgl_threadpool_stats_slot_t))
+
+struct sgl_threadpool_task {
+    sgl_threadpool_t *pool;
+    sgl_threadpool_task_t *next;
+    sgl_threadpool_routine_t routine;
+    sgl_threadpool_range_routine_t range_routine;
+    sgl_threadpool_scratch_routine_t scratch_routine;
+    void *cookie;
+    sgl_queue_t *operations;
+    sgl_int32_t range_begin;
+    sgl_int32_t range_end;
+    sgl_int32_t grain;
+    sgl_osal_atomic_uint32_t next_chunk;
+    sgl_uint8_t *deques;
+    sgl_size_t *slots;
+    void **items;
+    sgl_size_t num_deques;
+    sgl_size_t slot_count;
+    sgl_int32_t node;
+    sgl_threadpool_priority_t priority;
+    sgl_size_t operation_count;
+    sgl_size_t active_workers;
+    sgl_uint32_t generation;
+    sgl_bool_t is_listed;
+    sgl_bool_t preserve_operations;
+    sgl_threadpool_token_t *token;
+    sgl_osal_atomic_uint32_t is_cancelled;
+    sgl_osal_atomic_uint32_t is_done;
+};
+
+/* workers poll deadline_ns while the client may move it, so it is atomic */
+struct sgl_threadpool_token {
+    sgl_osal_atomic_uint32_t is_cancelled;
+    sgl_osal_atomic_uint32_t completed;
+    sgl_osal_atomic_uint64_t deadline_ns;
+};
+
+typedef struct {
+    sgl_threadpool_t *pool;
+    sgl_size_t deque_index;
+    sgl_int32_t node;
+    sgl_threadpool_scratch_t *scratch;
+    sgl_threadpool_stats_slot_t *stats;
+    sgl_osal_atomic_uint32_t throughput;
+    sgl_osal_thread_t thread;
+} sgl_threadpool_worker_t;
+
 struct sgl_threadpool {
+    sgl_threadpool_t *shared;
+    sgl_threadpool_priority_t priority;
+    sgl_threadpool_token_t *token;
     const char *base_name;
     sgl_size_t num_threads;
-    sgl_osal_thread_t *threads;
+    sgl_size_t requested_threads;
+    sgl_size_t cpu_quota;
+    sgl_osal_atomic_uint32_t active_threads;
+    sgl_size_t max_routine_lists;
+    sgl_threadpool_worker_t *workers;
+    sgl_uint8_t *scratch_arenas;
+    sgl_uint8_t *stats;
+    sgl_threadpool_scratch_t **free_scratch;
+    sgl_size_t free_scratch_count;
     sgl_osal_mutex_t lock;
-    sgl_osal_cond_t worker_cond;
-    sgl_osal_cond_t submitter_cond;
-    sgl_threadpool_routine_t routine;
-    void *SGL_RESTRICT cookie;
-    sgl_queue_t *operations;
-    sgl_queue_t *completed_operations;
-    sgl_size_t active_workers;
-    sgl_size_t claimed_workers;
-    sgl_size_t worker_limit;
+    sgl_osal_wait_queue_t worker_wait;
+    sgl_osal_wait_queue_t submitter_wait;
+    sgl_osal_wait_queue_t resize_wait;
+    sgl_threadpool_task_t *head;
+    sgl_threadpool_task_t *tail;
+    sgl_size_t inflight_tasks[SGL_THREADPOOL_PRIORITY_COUNT];
+    sgl_osal_atomic_uint32_t high_tasks;
     sgl_osal_atomic_uint32_t routine_generation;
     sgl_osal_atomic_uint32_t completion_generation;
-    sgl_bool_t has_routine;
-    sgl_bool_t is_done;
+    sgl_osal_atomic_uint32_t resize_generation;
+    sgl_threadpool_wait_policy_t wait_policy;
+    sgl_uint64_t spin_limit_ns;
+    sgl_uint64_t last_dispatch_ns;
+    sgl_uint64_t dispatch_interval_ns;
+    sgl_osal_atomic_uint32_t spin_ns;
+    sgl_bool_t is_node_local;
+    sgl_bool_t is_following_quota;
+    sgl_osal_atomic_int32_t quota_check_ms;
     sgl_bool_t is_exit_threadpool;
 };
 
 /*
  * Threadpool routine ownership
  * ----------------------------
- * attach_routine() publishes one active routine at a time into pool-owned
- * storage.  Because this API is synchronous, the submitting thread executes
- * operations while up to num_threads - 1 workers join the same generation.
- * This work-first path avoids paying a worker wake-up before useful work can
- * begin and keeps the requested number of compute threads unchanged.
+ * Every submission becomes a pool-owned task.  At submission the caller's
+ * queue is drained once, with a single bulk dequeue, and its operations are
+ * dealt in contiguous blocks into one Chase-Lev deque per participant:
+ * deque 0 belongs to the submitting thread of a synchronous attach, deque
+ * i + 1 to worker i.  A participant pops its
+ * own deque from the bottom and, once that is empty, steals from the top of
+ * the others, so the only shared writes while a routine runs are CASes on the
+ * top index of a deque that is actually being stolen from.
+ *
+ *   operations: o0 o1 o2 o3 o4 o5 o6 o7
+ *
+ *   deque 0 (submitter): o0 o1 o2   <- pop bottom
+ *   deque 1 (worker 0):  o3 o4 o5   <- pop bottom
+ *   deque 2 (worker 1):  o6 o7      <- pop bottom, then steal top of 0/1
+ *
+ * The blocks lie back to back in submission order, so the drain writes
+ * straight into them and a preserving call refills the queue with a single
+ * bulk enqueue.
  *
- * Worker publication and submit completion use separate condition variables.
- * A completion broadcast therefore wakes waiting submitters without waking
- * every idle worker and sending it immediately back to sleep.
+ * Tasks that may still have operations sit in a FIFO list; a participant
+ * claims a task by taking one operation under pool->lock, then keeps taking
+ * from that task without the pool lock until every deque is empty.  Several
+ * routines can therefore be in flight at once, and idle workers move on to
+ * the next task as soon as the oldest one has nothing left to hand out.
  *
- *   submitting thread                       worker threads
- *   -----------------                       --------------
- *   reserve operation
- *   publish generation  ------------------> reserve + claim generation
- *   execute + dequeue  <---- shared queue -> execute + dequeue
- *   finish caller       ------------------+ finish worker
- *                                          |
- *   wait/clear routine  <--- submitter_cond +--- last participant
+ * A task is complete when every deque is empty and its last participant has
+ * finished; that participant unlinks it, publishes is_done with release
+ * semantics, advances completion_generation and wakes the submitters parked
+ * on it.  A Chase-Lev pop can hide the last element of a deque from thieves
+ * only while its owner is taking it, and the owner is itself a participant,
+ * so no operation is left behind when the count drops to zero.  The waiter refills a preserving caller's
+ * queue in the original order from the operation array.
  *
- * pool->lock protects publication, active worker count, done flag, and exit
- * flag.  Release/acquire generation counters bound active spinning before the
- * condition-variable fallback.  Queue spinlocks protect only queue contents.
- * The worker loop exits only through the locked claim path, so ThreadSanitizer
- * sees a single synchronization contract without serializing execution.
+ * A node-local pool tags each task with the NUMA node of the submitting
+ * thread; only workers placed on that node, or not placed at all, are dealt
+ * operations and claim the task.
+ *
+ * parallel_for() publishes a range task instead: it lives on the caller's
+ * stack, has no deques and hands out chunk indices from one atomic counter,
+ * so dispatch needs neither a queue nor an allocation.
+ *
+ *   [begin ........................................ end)
+ *    chunk 0 | chunk 1 | chunk 2 | ... | chunk n-1 (short)
+ *        ^ next_chunk += claim by whichever participant is free
+ *
+ * Cores of one SoC need not be equally fast, so a claim is not always one
+ * chunk.  Each worker keeps an EWMA of the range units it runs per
+ * microsecond, and a claim takes about 1 / (2 * participants) of what is
+ * left, scaled by the worker's throughput against the mean of the active
+ * workers and capped at twice the even share.  Fast cores take large
+ * claims early, claims shrink as the range drains, and slow cores end up
+ * with single chunks at the tail:
+ *
+ *   big    |=======|====|==|=|
+ *   LITTLE |==|=|=|=|
+ *
+ * Each worker owns a scratch arena for scratch range routines, and the pool
+ * keeps one more per possible task in flight for submitting threads.  A
+ * submitter takes one from free_scratch when it joins a task and returns it
+ * when it leaves, both under the lock it already holds then.  A task in
+ * flight holds at most one, so only nested tasks, which are not counted
+ * against the budget, can find the stack empty; they run without one.
+ *
+ * pool->lock protects the task list, participant counts, the in-flight
+ * count, the exit flag and the dispatch clock.  It is never held while a
+ * thread waits or wakes another: idle workers wait on routine_generation and
+ * submitters on completion_generation directly, a futex on Linux, and the
+ * counters are advanced before the wake.  Waiters first spin for as long as
+ * the wait policy allows:
+ *
+ *   SPIN       spin until the counter moves, yielding between batches
+ *   PARK       no spinning
+ *   ADAPTIVE   spin_ns = 2 * avg(dispatch interval), or 0 once avg > limit
+ *
+ * The average is a 1/4-weighted moving average updated at every publish, so
+ * a burst of row dispatches keeps workers hot while a pool that sees one
+ * dispatch per frame lets them sleep.
+ *
+ * All num_threads workers are spawned at creation; workers[0, active_threads)
+ * take work and the rest park on resize_generation, which only a resize or
+ * destroy advances, so a shrunk pool costs no CPU and a grown one needs no
+ * thread creation.  active_threads is min(requested_threads, cpu_quota) and
+ * changes under pool->lock:
+ *
+ *   workers:  w0 w1 w2 | w3 w4 w5       active_threads = 3
+ *             claim     park on resize_generation
+ *
+ * New tasks deal operations to active workers only.  Operations dealt to a
+ * worker before it was parked are stolen by the others, and a queued task
+ * tied to a node without active workers is opened to the whole pool.
+ *
+ * A lane is a second sgl_threadpool_t whose shared pointer leads to the pool
+ * that owns the workers; every entry point resolves it first and tags the
+ * task with the lane's priority.  HIGH tasks are listed ahead of NORMAL
+ * ones, and high_tasks counts the listed ones.  A worker running a NORMAL
+ * routine reads it before each operation or chunk and, when it is set,
+ * joins the HIGH tasks as a second participant context before continuing:
+ *
+ *   list:   H1 -> H2 -> N1 -> N2
+ *   worker in N1:  op | op | (H1 queued) H1 op, H1 op | op | ...
+ *
+ * The worker never leaves N1 while doing so, so N1's participant count and
+ * completion are untouched.  Nothing is held across the detour either: it
+ * starts between claims, and a scratch arena is reset after every claim.
+ *
+ * A routine may submit to its own pool.  The worker it runs on is found
+ * through a thread-local pointer, and such a nested task skips the
+ * in-flight budget, which the outer task may be holding.  Operations of a
+ * nested task go to one deque, the caller's, and the rest of the pool
+ * steals from it.  The caller helps first: attach and parallel_for run it
+ * as its submitting participant, and wait on a submitted one joins it as
+ * a participant on the worker's deque before blocking, so a join only
+ * ever waits for operations already running elsewhere:
+ *
+ *   worker 2 in T1: op -> attach(T2) -> T2 deque 0 = all ops
+ *                                         pop bottom   <- steal top: workers 0,1,3
+ *                                       (T2 drained) wait for stolen ops -> op ...
+ *
+ * A lane may carry a cancellation token, copied into each task it submits.
+ * Participants test it where they would call the routine; once it has
+ * fired they keep taking operations and chunks but skip them, so the
+ * deques and the chunk counter drain exactly as before and completion
+ * needs no second path.  The task then reports cancelled to its waiter,
+ * and the token counts only the operations that ran.
  */
 typedef struct {
-    sgl_threadpool_routine_t routine;
-    void *cookie;
-    sgl_queue_t *operations;
-    sgl_queue_t *completed_operations;
+    sgl_threadpool_task_t *task;
     void *first_operation;
+    sgl_uint32_t first_chunk;
+    sgl_size_t deque_index;
+    sgl_threadpool_scratch_t *scratch;
+    sgl_uint32_t detour_generation;
+    /* the worker's throughput; SGL_NULL for submitters, which count as average */
+    sgl_osal_atomic_uint32_t *throughput;
 } sgl_threadpool_routine_context_t;
 
-static SGL_ALWAYS_INLINE sgl_osal_thread_t *sgl_threadpool_memory_as_osal_thread(void *memory)
+/* the worker running on this thread, SGL_NULL outside the pools */
+static SGL_THREAD_LOCAL sgl_threadpool_worker_t *sgl_threadpool_current_worker = SGL_NULL;
+/* the pool whose routine this thread is inside, worker or submitter */
+static SGL_THREAD_LOCAL const sgl_threadpool_t *sgl_threadpool_current_pool = SGL_NULL;
+
+static SGL_ALWAYS_INLINE sgl_threadpool_worker_t *sgl_threadpool_memory_as_worker(void *memory)
+{
+    sgl_threadpool_worker_t *result;
+
+    /* SGL-MEM-DEV-001: typed conversion from generic storage. */
+    /* cppcheck-suppress misra-c2012-11.5 */
+    result = (sgl_threadpool_worker_t *)memory;
+
+    return result;
+}
+
+static SGL_ALWAYS_INLINE sgl_threadpool_token_t *sgl_threadpool_memory_as_token(void *memory)
+{
+    sgl_threadpool_token_t *result;
+
+    /* SGL-MEM-DEV-001: typed conversion from generic storage. */
+    /* cppcheck-suppress misra-c2012-11.5 */
+    result = (sgl_threadpool_token_t *)memory;
+
+    return result;
+}
+
+static SGL_ALWAYS_INLINE sgl_threadpool_task_t *sgl_threadpool_memory_as_task(void *memory)
+{
+    sgl_threadpool_task_t *result;
+
+    /* SGL-MEM-DEV-001: typed conversion from generic storage. */
+    /* cppcheck-suppress misra-c2012-11.5 */
+    result = (sgl_threadpool_task_t *)memory;
+
+    return result;
+}
+
+static SGL_ALWAYS_INLINE sgl_threadpool_cpu_set_t *sgl_threadpool_memory_as_cpu_set(void *memory)
+{
+    sgl_threadpool_cpu_set_t *result;
+
+    /* SGL-MEM-DEV-001: typed conversion from generic storage. */
+    /* cppcheck-suppress misra-c2012-11.5 */
+    result = (sgl_threadpool_cpu_set_t *)memory;
+
+    return result;
+}
+
+static SGL_ALWAYS_INLINE sgl_threadpool_scratch_t **sgl_threadpool_memory_as_scratch_array(void *memory)
+{
+    sgl_threadpool_scratch_t **result;
+
+    /* SGL-MEM-DEV-001: typed conversion from generic storage. */
+    /* cppcheck-suppress misra-c2012-11.5 */
+    result = (sgl_threadpool_scratch_t **)memory;
+
+    return result;
+}
+
+static SGL_ALWAYS_INLINE sgl_size_t *sgl_threadpool_memory_as_size_array(void *memory)
+{
+    sgl_size_t *result;
+
+    /* SGL-MEM-DEV-001: typed conversion from generic storage. */
+    /* cppcheck-suppress misra-c2012-11.5 */
+    result = (sgl_size_t *)memory;
+
+    return result;
+}
+
+static SGL_ALWAYS_INLINE sgl_threadpool_deque_t *sgl_threadpool_task_deque(
+    const sgl_threadpool_task_t *task,
+    sgl_size_t index)
+{
+    sgl_threadpool_deque_t *result;
+
+    /* SGL-MEM-DEV-001: typed conversion from generic storage. */
+    /* cppcheck-suppress misra-c2012-11.3 */
+    result = (sgl_threadpool_deque_t *)&task->deques[index * SGL_THREADPOOL_DEQUE_STRIDE];
+
+    return result;
+}
+
+static sgl_osal_thread_return_t sgl_threadpool_routine(sgl_osal_thread_arg_t arg);
+static sgl_size_t sgl_threadpool_deque_offset(
+    sgl_size_t slot,
+    sgl_size_t operation_count,
+    sgl_size_t slot_count);
+static void *sgl_threadpool_deque_pop(sgl_threadpool_deque_t *deque);
+static sgl_bool_t sgl_threadpool_deque_steal(
+    sgl_threadpool_deque_t *deque,
+    void **operation);
+static void *sgl_threadpool_take_operation(
+    const sgl_threadpool_task_t *task,
+    sgl_size_t deque_index);
+static sgl_threadpool_task_t *sgl_threadpool_create_task(
+    sgl_threadpool_t *pool,
+    sgl_queue_t *operations,
+    sgl_bool_t has_participant,
+    const sgl_threadpool_worker_t *nested,
+    sgl_int32_t node);
+static sgl_bool_t sgl_threadpool_worker_is_eligible(
+    const sgl_threadpool_worker_t *worker,
+    sgl_int32_t node);
+static sgl_int32_t sgl_threadpool_submitter_node(const sgl_threadpool_t *pool);
+static sgl_result_t sgl_threadpool_spawn_workers(
+    sgl_threadpool_t *pool,
+    const sgl_threadpool_cpu_set_t *sets);
+static void sgl_threadpool_restore_operations(const sgl_threadpool_task_t *task);
+static sgl_bool_t sgl_threadpool_claim_work(
+    sgl_threadpool_task_t *task,
+    sgl_threadpool_routine_context_t *routine);
+static sgl_bool_t sgl_threadpool_should_detour(
+    const sgl_threadpool_t *pool,
+    const sgl_threadpool_routine_context_t *routine);
+static sgl_bool_t sgl_threadpool_execute_range(
+    const sgl_threadpool_t *pool,
+    const sgl_threadpool_routine_context_t *routine,
+    sgl_size_t *completed_operations);
+static sgl_result_t sgl_threadpool_publish_task(
+    sgl_threadpool_t *pool,
+    sgl_threadpool_task_t *task,
+    sgl_threadpool_routine_context_t *participant);
+static void sgl_threadpool_run_claimed(
+    sgl_threadpool_t *pool,
+    sgl_threadpool_routine_context_t *routine,
+    sgl_threadpool_routine_context_t *urgent);
+static void sgl_threadpool_help_task(
+    sgl_threadpool_t *pool,
+    sgl_threadpool_task_t *task);
+static void sgl_threadpool_wait_task(
+    sgl_threadpool_t *pool,
+    sgl_threadpool_task_t *task);
+static void sgl_threadpool_unlink_task(
+    sgl_threadpool_t *pool,
+    sgl_threadpool_task_t *previous,
+    sgl_threadpool_task_t *task);
+static void sgl_threadpool_remove_task(
+    sgl_threadpool_t *pool,
+    sgl_threadpool_task_t *task);
+static sgl_bool_t sgl_threadpool_claim_locked(
+    sgl_threadpool_t *pool,
+    sgl_threadpool_routine_context_t *routine,
+    sgl_threadpool_priority_t minimum);
+static sgl_bool_t sgl_threadpool_try_claim_routine(
+    sgl_threadpool_t *pool,
+    sgl_threadpool_routine_context_t *routine);
+static void sgl_threadpool_track_dispatch(sgl_threadpool_t *pool);
+static sgl_bool_t sgl_threadpool_spin_until_changed(
+    const sgl_threadpool_t *pool,
+    const sgl_osal_atomic_uint32_t *value,
+    sgl_uint32_t expected);
+static void sgl_threadpool_wait_until_changed(
+    sgl_threadpool_t *pool,
+    sgl_osal_wait_queue_t *queue,
+    const sgl_osal_atomic_uint32_t *value,
+    sgl_uint32_t expected);
+static void sgl_threadpool_wake_waiters(
+    sgl_threadpool_t *pool,
+    sgl_osal_wait_queue_t *queue,
+    sgl_osal_atomic_uint32_t *value,
+    sgl_size_t count);
+static sgl_bool_t sgl_threadpool_execute_routine(
+    const sgl_threadpool_routine_context_t *routine,
+    const sgl_threadpool_t *pool,
+    const char *role);
+static void sgl_threadpool_serve_high_priority(
+    sgl_threadpool_t *pool,
+    sgl_threadpool_routine_context_t *suspended,
+    sgl_threadpool_routine_context_t *routine);
+static void sgl_threadpool_finish_routine(
+    sgl_threadpool_t *pool,
+    sgl_threadpool_routine_context_t *routine);
+static sgl_result_t sgl_threadpool_submit_internal(
+    sgl_threadpool_t *SGL_RESTRICT pool,
+    sgl_threadpool_routine_t routine,
+    sgl_queue_t *SGL_RESTRICT operations,
+    void *SGL_RESTRICT cookie,
+    sgl_bool_t preserve_operations,
+    sgl_threadpool_routine_context_t *participant,
+    sgl_threadpool_task_t **task);
+static sgl_result_t sgl_threadpool_attach_routine_internal(
+    sgl_threadpool_t *SGL_RESTRICT pool,
+    sgl_threadpool_routine_t routine,
+    sgl_queue_t *SGL_RESTRICT operations,
+    void *SGL_RESTRICT cookie,
+    sgl_bool_t preserve_operations);
+
+/* Slot index num_threads collects the submitting threads. */
+static SGL_ALWAYS_INLINE sgl_threadpool_stats_slot_t *sgl_threadpool_stats_at(
+    const sgl_threadpool_t *pool,
+    sgl_size_t index)
+{
+    sgl_threadpool_stats_slot_t *result;
+
+    /* SGL-MEM-DEV-001: typed conversion from generic storage. */
+    /* cppcheck-suppress misra-c2012-11.5 */
+    result = (sgl_threadpool_stats_slot_t *)(void *)&pool->stats[index * SGL_THREADPOOL_STATS_STRIDE];
+
+    return result;
+}
+
+/* The calling thread's slot: its own if it is a worker of pool. */
+static SGL_ALWAYS_INLINE sgl_threadpool_stats_slot_t *sgl_threadpool_stats_of(const sgl_threadpool_t *pool)
+{
+    const sgl_threadpool_worker_t *worker;
+    sgl_threadpool_stats_slot_t *result;
+
+    worker = sgl_threadpool_current_worker;
+    if ((worker != SGL_NULL) && (worker->pool == pool)) {
+        result = worker->stats;
+    }
+    else {
+        result = sgl_threadpool_stats_at(pool, pool->num_threads);
+    }
+
+    return result;
+}
+
+/* Takes pool->lock, counting the acquisitions that found it held. */
+static void sgl_threadpool_lock(sgl_threadpool_t *pool)
+{
+    if (sgl_osal_mutex_try_lock(&pool->lock) == SGL_FALSE) {
+        sgl_osal_atomic_uint64_add_relaxed(&sgl_threadpool_stats_of(pool)->lock_contentions, 1U);
+        sgl_osal_mutex_lock(&pool->lock);
+    }
+}
+
+/* First array index of a slot when operation_count items are dealt in blocks. */
+static sgl_size_t sgl_threadpool_deque_offset(
+    sgl_size_t slot,
+    sgl_size_t operation_count,
+    sgl_size_t slot_count)
+{
+    sgl_size_t remainder;
+    sgl_size_t offset;
+
+    remainder = operation_count % slot_count;
+    offset = slot * (operation_count / slot_count);
+    offset += (slot < remainder) ? slot : remainder;
+
+    return offset;
+}
+
+/* Owner side: takes the most recently dealt operation of its own deque. */
+static void *sgl_threadpool_deque_pop(sgl_threadpool_deque_t *deque)
+{
+    void *operation;
+    sgl_int32_t bottom;
+    sgl_int32_t top;
+
+    operation = SGL_NULL;
+    bottom = sgl_osal_atomic_int32_load_relaxed(&deque->bottom) - 1;
+    sgl_osal_atomic_int32_store_relaxed(&deque->bottom, bottom);
+    sgl_osal_atomic_thread_fence();
+    top = sgl_osal_atomic_int32_load_relaxed(&deque->top);
+    if (top <= bottom) {
+        operation = deque->items[bottom];
+        if (top == bottom) {
+            /* last element: race the thieves for it */
+            if (sgl_osal_atomic_int32_compare_exchange(
+                    &deque->top, top, top + 1) == SGL_FALSE) {
+                operation = SGL_NULL;
+            }
+            sgl_osal_atomic_int32_store_relaxed(&deque->bottom, bottom + 1);
+        }
+    }
+    else {
+        sgl_osal_atomic_int32_store_relaxed(&deque->bottom, bottom + 1);
+    }
+
+    return operation;
+}
+
+/*
+ * Thief side.  Returns SGL_FALSE only when the deque looked empty; a lost
+ * CAS returns SGL_TRUE with a NULL operation so the caller retries.
+ */
+static sgl_bool_t sgl_threadpool_deque_steal(
+    sgl_threadpool_deque_t *deque,
+    void **operation)
+{
+    sgl_bool_t is_populated;
+    sgl_int32_t top;
+    sgl_int32_t bottom;
+
+    is_populated = SGL_FALSE;
+    *operation = SGL_NULL;
+    top = sgl_osal_atomic_int32_load_acquire(&deque->top);
+    sgl_osal_atomic_thread_fence();
+    bottom = sgl_osal_atomic_int32_load_acquire(&deque->bottom);
+    if (top < bottom) {
+        is_populated = SGL_TRUE;
+        if (sgl_osal_atomic_int32_compare_exchange(
+                &deque->top, top, top + 1) == SGL_TRUE) {
+            *operation = deque->items[top];
+        }
+    }
+
+    return is_populated;
+}
+
+/* Own deque first, then the others starting with the next participant. */
+static void *sgl_threadpool_take_operation(
+    const sgl_threadpool_task_t *task,
+    sgl_size_t deque_index)
+{
+    void *operation;
+    sgl_threadpool_deque_t *victim;
+    sgl_size_t i;
+
+    operation = sgl_threadpool_deque_pop(sgl_threadpool_task_deque(task, deque_index));
+    for (i = 1U; (i < task->num_deques) && (operation == SGL_NULL); ++i) {
+        victim = sgl_threadpool_task_deque(task, (deque_index + i) % task->num_deques);
+        while ((sgl_threadpool_deque_steal(victim, &operation) == SGL_TRUE) &&
+               (operation == SGL_NULL)) {
+            SGL_CPU_RELAX();
+        }
+    }
+
+    return operation;
+}
+
+static sgl_bool_t sgl_threadpool_worker_is_eligible(
+    const sgl_threadpool_worker_t *worker,
+    sgl_int32_t node)
+{
+    sgl_bool_t result = SGL_FALSE;
+
+    if ((node < 0) || (worker->node < 0) || (worker->node == node)) {
+        result = SGL_TRUE;
+    }
+
+    return result;
+}
+
+static SGL_ALWAYS_INLINE sgl_size_t sgl_threadpool_active_threads(const sgl_threadpool_t *pool)
+{
+    return (sgl_size_t)sgl_osal_atomic_uint32_load_relaxed(&pool->active_threads);
+}
+
+static sgl_bool_t sgl_threadpool_node_has_worker(
+    const sgl_threadpool_t *pool,
+    sgl_int32_t node)
+{
+    sgl_bool_t has_worker;
+    sgl_size_t active;
+    sgl_size_t i;
+
+    has_worker = SGL_FALSE;
+    active = sgl_threadpool_active_threads(pool);
+    for (i = 0U; (node >= 0) && (i < active); ++i) {
+        if (pool->workers[i].node == node) {
+            has_worker = SGL_TRUE;
+        }
+    }
+
+    return has_worker;
+}
+
+/* Node the current routine is tied to, or -1 when every worker may run it. */
+static sgl_int32_t sgl_threadpool_submitter_node(const sgl_threadpool_t *pool)
+{
+    sgl_int32_t node;
+
+    node = -1;
+    if (pool->is_node_local == SGL_TRUE) {
+        node = sgl_osal_get_current_numa_node();
+        if (sgl_threadpool_node_has_worker(pool, node) == SGL_FALSE) {
+            node = -1;
+        }
+    }
+
+    return node;
+}
+
+/*
+ * One allocation holds the task, a cache-line spaced deque per participant,
+ * the slot table and the operation array the deques index into.  The
+ * caller's queue is drained here and its operations are dealt in blocks
+ * over the slots, the deques of the participants that can own work: every
+ * active eligible worker, plus the submitter when it joins.
+ */
+static sgl_threadpool_task_t *sgl_threadpool_create_task(
+    sgl_threadpool_t *pool,
+    sgl_queue_t *operations,
+    sgl_bool_t has_participant,
+    const sgl_threadpool_worker_t *nested,
+    sgl_int32_t node)
+{
+    sgl_threadpool_task_t *task;
+    sgl_threadpool_deque_t *deque;
+    sgl_uint8_t *memory;
+    sgl_size_t operation_count;
+    sgl_size_t num_deques;
+    sgl_size_t offset;
+    sgl_size_t active;
+    sgl_size_t i;
+
+    operation_count = sgl_queue_get_count(operations);
+    num_deques = pool->num_threads + 1U;
+    task = SGL_NULL;
+    if (operation_count <= SGL_THREADPOOL_MAX_OPERATIONS) {
+        memory = sgl_memory_as_uint8(sgl_calloc(
+            1U,
+            SGL_THREADPOOL_ALIGN_UP(sizeof(sgl_threadpool_task_t)) +
+            (num_deques * SGL_THREADPOOL_DEQUE_STRIDE) +
+            (num_deques * sizeof(sgl_size_t)) +
+            (operation_count * sizeof(void *))));
+        task = sgl_threadpool_memory_as_task(memory);
+    }
+
+    if (task != SGL_NULL) {
+        task->deques = &memory[SGL_THREADPOOL_ALIGN_UP(sizeof(sgl_threadpool_task_t))];
+        task->slots = sgl_threadpool_memory_as_size_array(
+            &task->deques[num_deques * SGL_THREADPOOL_DEQUE_STRIDE]);
+        task->items = sgl_memory_as_void_ptr_array(&task->slots[num_deques]);
+        task->num_deques = num_deques;
+        task->node = node;
+        task->operations = operations;
+        /* the submitter is the only consumer, so this takes the whole count */
+        operation_count = sgl_queue_dequeue_bulk(operations, task->items, operation_count);
+        task->operation_count = operation_count;
+
+        task->slot_count = 0U;
+        if (has_participant == SGL_TRUE) {
+            task->slots[task->slot_count] = SGL_THREADPOOL_SUBMITTER_DEQUE;
+            task->slot_count++;
+        }
+        if (nested != SGL_NULL) {
+            /* everything on the calling worker's side; the others steal */
+            if (has_participant == SGL_FALSE) {
+                task->slots[task->slot_count] = nested->deque_index;
+                task->slot_count++;
+            }
+        }
+        else {
+            /* a resize racing with this only skews the deal; thieves even it out */
+            active = sgl_threadpool_active_threads(pool);
+            for (i = 0U; i < active; ++i) {
+                if (sgl_threadpool_worker_is_eligible(&pool->workers[i], node) == SGL_TRUE) {
+                    task->slots[task->slot_count] = pool->workers[i].deque_index;
+                    task->slot_count++;
+                }
+            }
+        }
+
+        for (i = 0U; i < task->slot_count; ++i) {
+            offset = sgl_threadpool_deque_offset(i, operation_count, task->slot_count);
+            deque = sgl_threadpool_task_deque(task, task->slots[i]);
+            deque->items = &task->items[offset];
+            deque->top = 0;
+            deque->bottom = (sgl_int32_t)(
+                sgl_threadpool_deque_offset(i + 1U, operation_count, task->slot_count) - offset);
+        }
+    }
+
+    return task;
+}
+
+/* Refills the caller's queue in submission order. */
+static void sgl_threadpool_restore_operations(const sgl_threadpool_task_t *task)
+{
+    (void)sgl_queue_enqueue_bulk(task->operations, task->items, task->operation_count);
+}
+
+static SGL_ALWAYS_INLINE sgl_bool_t sgl_threadpool_is_range_task(const sgl_threadpool_task_t *task)
+{
+    sgl_bool_t result = SGL_FALSE;
+
+    if ((task->range_routine != SGL_NULL) || (task->scratch_routine != SGL_NULL)) {
+        result = SGL_TRUE;
+    }
+
+    return result;
+}
+
+/* Takes the routine's first operation or chunk of task. */
+static sgl_bool_t sgl_threadpool_claim_work(
+    sgl_threadpool_task_t *task,
+    sgl_threadpool_routine_context_t *routine)
+{
+    sgl_bool_t is_claimed;
+
+    is_claimed = SGL_FALSE;
+    if (sgl_threadpool_is_range_task(task) == SGL_TRUE) {
+        routine->first_chunk =
+            sgl_osal_atomic_uint32_fetch_increment_relaxed(&task->next_chunk);
+        if (routine->first_chunk < task->operation_count) {
+            is_claimed = SGL_TRUE;
+        }
+    }
+    else {
+        routine->first_operation =
+            sgl_threadpool_take_operation(task, routine->deque_index);
+        if (routine->first_operation != SGL_NULL) {
+            is_claimed = SGL_TRUE;
+        }
+    }
+    if (is_claimed == SGL_TRUE) {
+        routine->task = task;
+    }
+
+    return is_claimed;
+}
+
+/*
+ * Whether a worker should step out of its NORMAL routine before the next
+ * operation.  detour_generation remembers a detour that found nothing it
+ * could claim, such as HIGH work tied to another node, so the worker does
+ * not take the pool lock again until another routine is published.
+ */
+static sgl_bool_t sgl_threadpool_should_detour(
+    const sgl_threadpool_t *pool,
+    const sgl_threadpool_routine_context_t *routine)
+{
+    sgl_bool_t result = SGL_FALSE;
+
+    if ((routine->task->priority == SGL_THREADPOOL_PRIORITY_NORMAL) &&
+        (routine->deque_index != SGL_THREADPOOL_SUBMITTER_DEQUE) &&
+        (sgl_osal_atomic_uint32_load_relaxed(&pool->high_tasks) != 0U) &&
+        (sgl_osal_atomic_uint32_load_relaxed(&pool->routine_generation) !=
+         routine->detour_generation)) {
+        result = SGL_TRUE;
+    }
+
+    return result;
+}
+
+/* Folds one claim into the worker's EWMA; the first claim seeds it. */
+static void sgl_threadpool_record_throughput(
+    const sgl_threadpool_routine_context_t *routine,
+    sgl_int64_t units,
+    sgl_uint64_t elapsed_ns)
+{
+    sgl_uint64_t sample;
+    sgl_uint64_t average;
+    sgl_uint64_t divisor;
+
+    if ((routine->throughput != SGL_NULL) && (units > 0)) {
+        /* coarse clocks may report 0; take it as the shortest measurable time */
+        divisor = (elapsed_ns == 0U) ? 1U : elapsed_ns;
+        sample = (((sgl_uint64_t)units * SGL_THREADPOOL_NS_PER_US) <<
+                  SGL_THREADPOOL_THROUGHPUT_SHIFT) / divisor;
+        average = sgl_osal_atomic_uint32_load_relaxed(routine->throughput);
+        if (average != 0U) {
+            sample = ((average * (SGL_THREADPOOL_THROUGHPUT_WEIGHT - 1U)) + sample) /
+                     SGL_THREADPOOL_THROUGHPUT_WEIGHT;
+        }
+        if (sample > SGL_THREADPOOL_THROUGHPUT_MAX) {
+            sample = SGL_THREADPOOL_THROUGHPUT_MAX;
+        }
+        if (sample == 0U) {
+            /* 0 means no history */
+            sample = 1U;
+        }
+        sgl_osal_atomic_uint32_store_relaxed(routine->throughput, (sgl_uint32_t)sample);
+    }
+}
+
+/*
+ * Number of chunks for the next claim, at least 1.  With the ratio capped
+ * at 2, each claim is at most remaining / participants, so racing claims
+ * overshoot operation_count by about one range and next_chunk stays far
+ * from wrapping.
+ */
+static sgl_uint32_t sgl_threadpool_claim_size(
+    const sgl_threadpool_t *pool,
+    const sgl_threadpool_routine_context_t *routine)
+{
+    const sgl_threadpool_task_t *task;
+    sgl_uint64_t remaining;
+    sgl_uint64_t participants;
+    sgl_uint64_t own;
+    sgl_uint64_t total;
+    sgl_uint64_t measured;
+    sgl_uint64_t ratio;
+    sgl_uint64_t claim;
+    sgl_uint32_t next;
+    sgl_size_t active;
+    sgl_size_t i;
+
+    task = routine->task;
+    claim = 1U;
+    next = sgl_osal_atomic_uint32_load_relaxed(&task->next_chunk);
+    if (next < task->operation_count) {
+        active = sgl_threadpool_active_threads(pool);
+        remaining = (sgl_uint64_t)task->operation_count - next;
+        participants = (sgl_uint64_t)active + 1U;
+        total = 0U;
+        measured = 0U;
+        for (i = 0U; i < active; ++i) {
+            own = sgl_osal_atomic_uint32_load_relaxed(&pool->workers[i].throughput);
+            if (own != 0U) {
+                total += own;
+                measured++;
+            }
+        }
+        own = 0U;
+        if (routine->throughput != SGL_NULL) {
+            own = sgl_osal_atomic_uint32_load_relaxed(routine->throughput);
+        }
+        /* own / mean in Q8, 1.0 without history on either side, at most 2.0 */
+        ratio = SGL_THREADPOOL_CLAIM_RATIO_ONE;
+        if ((own != 0U) && (measured != 0U)) {
+            ratio = (own * SGL_THREADPOOL_CLAIM_RATIO_ONE) / (total / measured);
+            if (ratio > (2U * SGL_THREADPOOL_CLAIM_RATIO_ONE)) {
+                ratio = 2U * SGL_THREADPOOL_CLAIM_RATIO_ONE;
+            }
+        }
+        claim = (remaining * ratio) / (2U * participants * SGL_THREADPOOL_CLAIM_RATIO_ONE);
+        if (claim == 0U) {
+            claim = 1U;
+        }
+    }
+
+    return (sgl_uint32_t)claim;
+}
+
+/* Latches is_cancelled once the deadline has passed. */
+static sgl_bool_t sgl_threadpool_token_expired(sgl_threadpool_token_t *token)
+{
+    sgl_bool_t result;
+    sgl_uint64_t deadline_ns;
+
+    result = SGL_FALSE;
+    if (token != SGL_NULL) {
+        deadline_ns = sgl_osal_atomic_uint64_load_relaxed(&token->deadline_ns);
+        if (sgl_osal_atomic_uint32_load_relaxed(&token->is_cancelled) != 0U) {
+            result = SGL_TRUE;
+        }
+        else if ((deadline_ns != 0U) &&
+                 (sgl_osal_get_monotonic_ns() >= deadline_ns)) {
+            sgl_osal_atomic_uint32_store_relaxed(&token->is_cancelled, 1U);
+            result = SGL_TRUE;
+        }
+        else {
+            /* keep running */
+        }
+    }
+
+    return result;
+}
+
+/*
+ * Returns SGL_TRUE when it stopped early for HIGH work.  Claims made after
+ * the task's token expired are skipped rather than run, so the chunk
+ * counter still reaches the end and completion works as usual.
+ */
+static sgl_bool_t sgl_threadpool_execute_range(
+    const sgl_threadpool_t *pool,
+    const sgl_threadpool_routine_context_t *routine,
+    sgl_size_t *completed_operations)
+{
+    sgl_threadpool_task_t *task;
+    sgl_int64_t begin;
+    sgl_int64_t end;
+    sgl_uint64_t start_ns;
+    sgl_uint32_t chunk;
+    sgl_uint32_t claim;
+    sgl_bool_t is_suspended;
+
+    task = routine->task;
+    chunk = routine->first_chunk;
+    claim = 1U;
+    is_suspended = SGL_FALSE;
+    while (chunk < task->operation_count) {
+        if (claim > (task->operation_count - chunk)) {
+            claim = (sgl_uint32_t)(task->operation_count - chunk);
+        }
+        begin = (sgl_int64_t)task->range_begin + ((sgl_int64_t)chunk * task->grain);
+        end = begin + ((sgl_int64_t)claim * task->grain);
+        if (end > task->range_end) {
+            end = task->range_end;
+        }
+        if (sgl_threadpool_token_expired(task->token) == SGL_TRUE) {
+            sgl_osal_atomic_uint32_store_relaxed(&task->is_cancelled, 1U);
+        }
+        else {
+            start_ns = sgl_osal_get_monotonic_ns();
+            if (task->scratch_routine != SGL_NULL) {
+                task->scratch_routine(
+                    (sgl_int32_t)begin, (sgl_int32_t)end, routine->scratch, task->cookie);
+                if (routine->scratch != SGL_NULL) {
+                    sgl_threadpool_scratch_reset(routine->scratch);
+                }
+            }
+            else {
+                task->range_routine((sgl_int32_t)begin, (sgl_int32_t)end, task->cookie);
+            }
+            sgl_threadpool_record_throughput(
+                routine, end - begin, sgl_osal_get_monotonic_ns() - start_ns);
+            *completed_operations += claim;
+        }
+        if (sgl_threadpool_should_detour(pool, routine) == SGL_TRUE) {
+            /* the next chunk is claimed when the worker comes back */
+            is_suspended = SGL_TRUE;
+            chunk = (sgl_uint32_t)task->operation_count;
+        }
+        else {
+            claim = sgl_threadpool_claim_size(pool, routine);
+            chunk = sgl_osal_atomic_uint32_fetch_add_relaxed(&task->next_chunk, claim);
+        }
+    }
+
+    return is_suspended;
+}
+
+/* Called under pool->lock for every published task. */
+static void sgl_threadpool_track_dispatch(sgl_threadpool_t *pool)
+{
+    sgl_uint64_t now;
+    sgl_uint64_t interval;
+    sgl_uint64_t average;
+    sgl_uint64_t budget;
+
+    if (pool->wait_policy == SGL_THREADPOOL_WAIT_ADAPTIVE) {
+        now = sgl_osal_get_monotonic_ns();
+        if (pool->last_dispatch_ns != 0U) {
+            interval = now - pool->last_dispatch_ns;
+            average = pool->dispatch_interval_ns;
+            if (average == 0U) {
+                average = interval;
+            }
+            else if (interval >= average) {
+                average += (interval - average) >> 2;
+            }
+            else {
+                average -= (average - interval) >> 2;
+            }
+            pool->dispatch_interval_ns = average;
+
+            /* the next dispatch is not expected within any affordable spin */
+            budget = 0U;
+            if (average <= pool->spin_limit_ns) {
+                budget = average * 2U;
+                if (budget > pool->spin_limit_ns) {
+                    budget = pool->spin_limit_ns;
+                }
+            }
+            sgl_osal_atomic_uint32_store_relaxed(&pool->spin_ns, (sgl_uint32_t)budget);
+        }
+        pool->last_dispatch_ns = now;
+    }
+}
+
+/*
+ * Waits for *value to move away from expected for as long as the wait
+ * policy allows.  The clock is read once per batch of relax hints, so the
+ * spin itself stays off the vDSO.  Returns SGL_TRUE when the value moved
+ * while spinning; otherwise the caller parks.
+ */
+static sgl_bool_t sgl_threadpool_spin_until_changed(
+    const sgl_threadpool_t *pool,
+    const sgl_osal_atomic_uint32_t *value,
+    sgl_uint32_t expected)
+{
+    sgl_uint64_t deadline;
+    sgl_uint32_t budget;
+    sgl_uint32_t iteration;
+    sgl_bool_t is_spinning;
+    sgl_bool_t is_changed;
+
+    is_spinning = (pool->wait_policy == SGL_THREADPOOL_WAIT_PARK) ? SGL_FALSE : SGL_TRUE;
+    is_changed = SGL_FALSE;
+    deadline = 0U;
+    if (pool->wait_policy == SGL_THREADPOOL_WAIT_ADAPTIVE) {
+        budget = sgl_osal_atomic_uint32_load_relaxed(&pool->spin_ns);
+        if (budget == 0U) {
+            is_spinning = SGL_FALSE;
+        }
+        else {
+            deadline = sgl_osal_get_monotonic_ns() + budget;
+        }
+    }
+
+    while (is_spinning == SGL_TRUE) {
+        for (iteration = 0U;
+             (iteration < SGL_THREADPOOL_SPIN_BATCH) &&
+             (sgl_osal_atomic_uint32_load_acquire(value) == expected);
+             ++iteration) {
+            SGL_CPU_RELAX();
+        }
+        if (sgl_osal_atomic_uint32_load_acquire(value) != expected) {
+            is_spinning = SGL_FALSE;
+            is_changed = SGL_TRUE;
+        }
+        else if (pool->wait_policy == SGL_THREADPOOL_WAIT_SPIN) {
+            /* keep an oversubscribed CPU usable by whoever will move it */
+            sgl_osal_yield_thread();
+        }
+        else if (sgl_osal_get_monotonic_ns() >= deadline) {
+            is_spinning = SGL_FALSE;
+        }
+        else {
+            /* budget left */
+        }
+    }
+    if (is_changed == SGL_TRUE) {
+        sgl_osal_atomic_uint64_add_relaxed(&sgl_threadpool_stats_of(pool)->spin_wakeups, 1U);
+    }
+
+    return is_changed;
+}
+
+/* Spins, then parks on queue until *value is no longer expected. */
+static void sgl_threadpool_wait_until_changed(
+    sgl_threadpool_t *pool,
+    sgl_osal_wait_queue_t *queue,
+    const sgl_osal_atomic_uint32_t *value,
+    sgl_uint32_t expected)
+{
+    (void)sgl_threadpool_spin_until_changed(pool, value, expected);
+    while (sgl_osal_atomic_uint32_load_acquire(value) == expected) {
+        sgl_osal_atomic_uint64_add_relaxed(&sgl_threadpool_stats_of(pool)->parks, 1U);
+        sgl_osal_wait_on_address(queue, value, expected);
+    }
+}
+
+/*
+ * Wakes up to count threads parked on value, which the caller has already
+ * advanced.  Called without pool->lock; spinning-only pools never park.
+ */
+static void sgl_threadpool_wake_waiters(
+    sgl_threadpool_t *pool,
+    sgl_osal_wait_queue_t *queue,
+    sgl_osal_atomic_uint32_t *value,
+    sgl_size_t count)
+{
+    sgl_int32_t wake_count;
+
+    if ((count > 0U) && (pool->wait_policy != SGL_THREADPOOL_WAIT_SPIN)) {
+        wake_count = SGL_OSAL_WAKE_ALL;
+        if (count < (sgl_size_t)SGL_OSAL_WAKE_ALL) {
+            wake_count = (sgl_int32_t)count;
+        }
+        sgl_osal_wake_address(queue, value, wake_count);
+    }
+}
+
+static void sgl_threadpool_unlink_task(
+    sgl_threadpool_t *pool,
+    sgl_threadpool_task_t *previous,
+    sgl_threadpool_task_t *task)
+{
+    if (previous == SGL_NULL) {
+        pool->head = task->next;
+    }
+    else {
+        previous->next = task->next;
+    }
+    if (pool->tail == task) {
+        pool->tail = previous;
+    }
+    task->next = SGL_NULL;
+    task->is_listed = SGL_FALSE;
+    if (task->priority == SGL_THREADPOOL_PRIORITY_HIGH) {
+        /* written under pool->lock only; workers poll it without */
+        sgl_osal_atomic_uint32_store_relaxed(
+            &pool->high_tasks, sgl_osal_atomic_uint32_load_relaxed(&pool->high_tasks) - 1U);
+    }
+}
+
+/* HIGH tasks go behind the last HIGH task, NORMAL ones at the tail. */
+static void sgl_threadpool_link_task(
+    sgl_threadpool_t *pool,
+    sgl_threadpool_task_t *task)
+{
+    sgl_threadpool_task_t *previous;
+    sgl_threadpool_task_t *current;
+
+    previous = pool->tail;
+    if (task->priority == SGL_THREADPOOL_PRIORITY_HIGH) {
+        previous = SGL_NULL;
+        current = pool->head;
+        while ((current != SGL_NULL) &&
+               (current->priority == SGL_THREADPOOL_PRIORITY_HIGH)) {
+            previous = current;
+            current = current->next;
+        }
+        sgl_osal_atomic_uint32_store_relaxed(
+            &pool->high_tasks, sgl_osal_atomic_uint32_load_relaxed(&pool->high_tasks) + 1U);
+    }
+    if (previous == SGL_NULL) {
+        task->next = pool->head;
+        pool->head = task;
+    }
+    else {
+        task->next = previous->next;
+        previous->next = task;
+    }
+    if (task->next == SGL_NULL) {
+        pool->tail = task;
+    }
+    task->is_listed = SGL_TRUE;
+}
+
+/* The list holds at most max_routine_lists tasks per priority, so a walk is cheap. */
+static void sgl_threadpool_remove_task(
+    sgl_threadpool_t *pool,
+    sgl_threadpool_task_t *task)
+{
+    sgl_threadpool_task_t *previous;
+    sgl_threadpool_task_t *current;
+
+    previous = SGL_NULL;
+    current = pool->head;
+    while ((current != SGL_NULL) && (current != task)) {
+        previous = current;
+        current = current->next;
+    }
+    if (current != SGL_NULL) {
+        sgl_threadpool_unlink_task(pool, previous, task);
+    }
+}
+
+/*
+ * Claims the first task of at least minimum priority that still has an
+ * operation to hand out; HIGH tasks lead the list.  Tasks found empty are
+ * unlinked on the way, so later scans skip them.
+ */
+static sgl_bool_t sgl_threadpool_claim_locked(
+    sgl_threadpool_t *pool,
+    sgl_threadpool_routine_context_t *routine,
+    sgl_threadpool_priority_t minimum)
+{
+    const sgl_threadpool_worker_t *worker;
+    sgl_threadpool_task_t *previous;
+    sgl_threadpool_task_t *task;
+    sgl_threadpool_task_t *next;
+    sgl_bool_t is_claimed;
+
+    /* only workers scan the list; deque i + 1 belongs to worker i */
+    worker = &pool->workers[routine->deque_index - 1U];
+    is_claimed = SGL_FALSE;
+    previous = SGL_NULL;
+    task = pool->head;
+    while ((task != SGL_NULL) && (task->priority >= minimum) &&
+           (is_claimed == SGL_FALSE)) {
+        next = task->next;
+        if (sgl_threadpool_worker_is_eligible(worker, task->node) == SGL_FALSE) {
+            /* left to the workers of the task's node */
+        }
+        else if (sgl_threadpool_claim_work(task, routine) == SGL_TRUE) {
+            task->active_workers++;
+            is_claimed = SGL_TRUE;
+        }
+        else {
+            sgl_threadpool_unlink_task(pool, previous, task);
+        }
+        if (task->is_listed == SGL_TRUE) {
+            previous = task;
+        }
+        task = next;
+    }
+
+    return is_claimed;
+}
+
+static sgl_bool_t sgl_threadpool_try_claim_routine(
+    sgl_threadpool_t *pool,
+    sgl_threadpool_routine_context_t *routine)
+{
+    sgl_bool_t is_claimed;
+    sgl_uint32_t generation;
+
+    is_claimed = SGL_FALSE;
+    routine->task = SGL_NULL;
+    routine->first_operation = SGL_NULL;
+    /* routine->deque_index is the caller's own deque */
+
+    sgl_threadpool_lock(pool);
+    while ((pool->is_exit_threadpool == SGL_FALSE) &&
+           (is_claimed == SGL_FALSE)) {
+        if ((routine->deque_index - 1U) >= sgl_threadpool_active_threads(pool)) {
+            /*
+             * Parked by a resize.  No spinning: the count changes rarely,
+             * and a parked worker must not compete for the CPUs it gave up.
+             */
+            generation = sgl_osal_atomic_uint32_load_acquire(
+                &pool->resize_generation);
+            sgl_osal_mutex_unlock(&pool->lock);
+            while (sgl_osal_atomic_uint32_load_acquire(&pool->resize_generation) == generation) {
+                sgl_osal_wait_on_address(&pool->resize_wait, &pool->resize_generation, generation);
+            }
+            sgl_threadpool_lock(pool);
+        }
+        else {
+            generation = sgl_osal_atomic_uint32_load_acquire(
+                &pool->routine_generation);
+            is_claimed = sgl_threadpool_claim_locked(
+                pool, routine, SGL_THREADPOOL_PRIORITY_NORMAL);
+            if (is_claimed == SGL_FALSE) {
+                /*
+                 * Nothing runnable.  Wait without the lock until the
+                 * generation moves past the one observed while scanning;
+                 * resize and destroy advance it as well.
+                 */
+                sgl_osal_mutex_unlock(&pool->lock);
+                sgl_threadpool_wait_until_changed(
+                    pool, &pool->worker_wait, &pool->routine_generation, generation);
+                sgl_threadpool_lock(pool);
+            }
+        }
+    }
+    sgl_osal_mutex_unlock(&pool->lock);
+
+    return is_claimed;
+}
+
+/*
+ * Runs the claimed operation and whatever the participant can take after
+ * it.  Returns SGL_TRUE when it stopped early for HIGH work; the worker
+ * then serves that and resumes by claiming from the same task again,
+ * still counted as its participant.
+ */
+static sgl_bool_t sgl_threadpool_execute_routine(
+    const sgl_threadpool_routine_context_t *routine,
+    const sgl_threadpool_t *pool,
+    const char *role)
+{
+    sgl_threadpool_task_t *task;
+    const sgl_threadpool_t *outer;
+    void *current;
+    sgl_size_t completed_operations;
+    sgl_bool_t is_suspended;
+
+    task = routine->task;
+    completed_operations = 0U;
+    is_suspended = SGL_FALSE;
+    outer = sgl_threadpool_current_pool;
+    sgl_threadpool_current_pool = pool;
+#if defined(SGL_CFG_HAS_LTTNG)
+    SGL_TRACE_THREADPOOL_PARTICIPANT_BEGIN(pool, task->generation, role);
+#else
+    SGL_UNUSED(role);
+#endif
+    if (sgl_threadpool_is_range_task(task) == SGL_TRUE) {
+        is_suspended = sgl_threadpool_execute_range(pool, routine, &completed_operations);
+    }
+    else {
+        current = routine->first_operation;
+        while (current != SGL_NULL) {
+            /* skipped operations are still taken, so the deques drain */
+            if (sgl_threadpool_token_expired(task->token) == SGL_TRUE) {
+                sgl_osal_atomic_uint32_store_relaxed(&task->is_cancelled, 1U);
+            }
+            else {
+                task->routine(current, task->cookie);
+                completed_operations++;
+            }
+            if (sgl_threadpool_should_detour(pool, routine) == SGL_TRUE) {
+                is_suspended = SGL_TRUE;
+                current = SGL_NULL;
+            }
+            else {
+                current = sgl_threadpool_take_operation(task, routine->deque_index);
+            }
+        }
+    }
+    sgl_osal_atomic_uint64_add_relaxed(
+        &sgl_threadpool_stats_of(pool)->operations, (sgl_uint64_t)completed_operations);
+    if ((task->token != SGL_NULL) && (completed_operations != 0U)) {
+        (void)sgl_osal_atomic_uint32_fetch_add_relaxed(
+            &task->token->completed, (sgl_uint32_t)completed_operations);
+    }
+#if defined(SGL_CFG_HAS_LTTNG)
+    SGL_TRACE_THREADPOOL_PARTICIPANT_END(
+        pool, task->generation, role, completed_operations);
+#endif
+    sgl_threadpool_current_pool = outer;
+
+    return is_suspended;
+}
+
+/*
+ * Joins queued HIGH tasks with the worker's second context, routine, until
+ * none is left that it may claim, then returns to the suspended one.  HIGH
+ * routines never suspend, so this does not nest.
+ */
+static void sgl_threadpool_serve_high_priority(
+    sgl_threadpool_t *pool,
+    sgl_threadpool_routine_context_t *suspended,
+    sgl_threadpool_routine_context_t *routine)
+{
+    sgl_bool_t is_claimed;
+    sgl_uint32_t generation;
+
+    is_claimed = SGL_TRUE;
+    while ((is_claimed == SGL_TRUE) &&
+           (sgl_osal_atomic_uint32_load_relaxed(&pool->high_tasks) != 0U)) {
+        routine->task = SGL_NULL;
+        routine->first_operation = SGL_NULL;
+        sgl_threadpool_lock(pool);
+        generation = sgl_osal_atomic_uint32_load_relaxed(&pool->routine_generation);
+        is_claimed = SGL_FALSE;
+        if (pool->is_exit_threadpool == SGL_FALSE) {
+            is_claimed = sgl_threadpool_claim_locked(
+                pool, routine, SGL_THREADPOOL_PRIORITY_HIGH);
+        }
+        sgl_osal_mutex_unlock(&pool->lock);
+        if (is_claimed == SGL_TRUE) {
+            (void)sgl_threadpool_execute_routine(routine, pool, SGL_TRACE_ROLE_WORKER);
+            sgl_threadpool_finish_routine(pool, routine);
+        }
+        else {
+            suspended->detour_generation = generation;
+        }
+    }
+}
+
+/*
+ * Called after a participant found every deque of the task empty, so once the count
+ * of participants drops to zero no operation of the task is left anywhere.
+ */
+static void sgl_threadpool_finish_routine(
+    sgl_threadpool_t *pool,
+    sgl_threadpool_routine_context_t *routine)
+{
+    sgl_threadpool_task_t *task;
+    sgl_bool_t is_completed;
+
+    task = routine->task;
+    is_completed = SGL_FALSE;
+    sgl_threadpool_lock(pool);
+    if ((routine->deque_index == SGL_THREADPOOL_SUBMITTER_DEQUE) &&
+        (routine->scratch != SGL_NULL)) {
+        pool->free_scratch[pool->free_scratch_count] = routine->scratch;
+        pool->free_scratch_count++;
+        routine->scratch = SGL_NULL;
+    }
+    if (task->active_workers > 0U) {
+        task->active_workers--;
+    }
+    if (task->active_workers == 0U) {
+        if (task->is_listed == SGL_TRUE) {
+            sgl_threadpool_remove_task(pool, task);
+        }
+        pool->inflight_tasks[task->priority]--;
+        /* the task may be freed by its waiter from here on */
+        (void)sgl_osal_atomic_uint32_increment_release(&task->is_done);
+        (void)sgl_osal_atomic_uint32_increment_release(&pool->completion_generation);
+        is_completed = SGL_TRUE;
+    }
+    sgl_osal_mutex_unlock(&pool->lock);
+
+    if (is_completed == SGL_TRUE) {
+        /* any parked submitter may be the one waiting for this task */
+        sgl_threadpool_wake_waiters(
+            pool, &pool->submitter_wait, &pool->completion_generation,
+            (sgl_size_t)SGL_OSAL_WAKE_ALL);
+    }
+}
+
+/*
+ * Recomputes active_threads from the requested count and the CPU quota.
+ * Called under pool->lock, or before the workers exist; on SGL_TRUE the
+ * caller wakes the workers with sgl_threadpool_wake_resized() once it has
+ * released the lock.
+ */
+static sgl_bool_t sgl_threadpool_apply_thread_count(sgl_threadpool_t *pool)
+{
+    sgl_threadpool_task_t *task;
+    sgl_size_t target;
+    sgl_bool_t is_changed;
+
+    is_changed = SGL_FALSE;
+    target = pool->requested_threads;
+    if ((pool->cpu_quota > 0U) && (pool->cpu_quota < target)) {
+        target = pool->cpu_quota;
+    }
+    if (target != sgl_threadpool_active_threads(pool)) {
+        sgl_osal_atomic_uint32_store_relaxed(&pool->active_threads, (sgl_uint32_t)target);
+        for (task = pool->head; task != SGL_NULL; task = task->next) {
+            if (sgl_threadpool_node_has_worker(pool, task->node) == SGL_FALSE) {
+                /* nobody left on its node to claim it */
+                task->node = -1;
+            }
+        }
+        /* parked workers re-check their index; idle ones rescan */
+        (void)sgl_osal_atomic_uint32_increment_release(&pool->resize_generation);
+        (void)sgl_osal_atomic_uint32_increment_release(&pool->routine_generation);
+        is_changed = SGL_TRUE;
+    }
+
+    return is_changed;
+}
+
+static void sgl_threadpool_wake_resized(sgl_threadpool_t *pool)
+{
+    /* resize parking ignores the wait policy, so always wake it */
+    sgl_osal_wake_address(&pool->resize_wait, &pool->resize_generation, SGL_OSAL_WAKE_ALL);
+    sgl_threadpool_wake_waiters(
+        pool, &pool->worker_wait, &pool->routine_generation,
+        (sgl_size_t)SGL_OSAL_WAKE_ALL);
+}
+
+/*
+ * Re-reads the cgroup CPU quota at most once per check interval.  The CAS
+ * on the check time elects a single submitter to read it, outside
+ * pool->lock since it goes to the file system.
+ */
+static void sgl_threadpool_follow_cpu_quota(sgl_threadpool_t *pool)
+{
+    sgl_uint32_t now_ms;
+    sgl_int32_t last_ms;
+    sgl_size_t quota;
+    sgl_bool_t is_changed;
+
+    if (pool->is_following_quota == SGL_TRUE) {
+        now_ms = (sgl_uint32_t)(sgl_osal_get_monotonic_ns() / SGL_THREADPOOL_NS_PER_MS);
+        last_ms = sgl_osal_atomic_int32_load_relaxed(&pool->quota_check_ms);
+        /* unsigned difference stays right across the 49-day wrap */
+        if (((now_ms - (sgl_uint32_t)last_ms) >= SGL_THREADPOOL_QUOTA_CHECK_INTERVAL_MS) &&
+            (sgl_osal_atomic_int32_compare_exchange(
+                 &pool->quota_check_ms, last_ms, (sgl_int32_t)now_ms) == SGL_TRUE)) {
+            quota = sgl_osal_get_cpu_quota();
+            sgl_threadpool_lock(pool);
+            pool->cpu_quota = quota;
+            is_changed = sgl_threadpool_apply_thread_count(pool);
+            sgl_osal_mutex_unlock(&pool->lock);
+            if (is_changed == SGL_TRUE) {
+                sgl_threadpool_wake_resized(pool);
+            }
+        }
+    }
+}
+
+/* The pool that owns the workers of pool, which may be a lane. */
+static SGL_ALWAYS_INLINE sgl_threadpool_t *sgl_threadpool_shared(const sgl_threadpool_t *pool)
+{
+    return (pool != SGL_NULL) ? pool->shared : SGL_NULL;
+}
+
+/* The worker of pool the calling thread is, SGL_NULL for other threads. */
+static SGL_ALWAYS_INLINE sgl_threadpool_worker_t *sgl_threadpool_nested_worker(const sgl_threadpool_t *pool)
+{
+    sgl_threadpool_worker_t *worker;
+
+    worker = sgl_threadpool_current_worker;
+    if ((worker != SGL_NULL) && (worker->pool != pool)) {
+        worker = SGL_NULL;
+    }
+
+    return worker;
+}
+
+/* Whether the calling thread is inside one of pool's routines. */
+static SGL_ALWAYS_INLINE sgl_bool_t sgl_threadpool_is_nested(const sgl_threadpool_t *pool)
+{
+    return (sgl_threadpool_current_pool == pool) ? SGL_TRUE : SGL_FALSE;
+}
+
+/* Every priority may have max_routine_lists tasks, each with one submitter. */
+static SGL_ALWAYS_INLINE sgl_size_t sgl_threadpool_submitter_slots(const sgl_threadpool_t *pool)
+{
+    return pool->max_routine_lists * SGL_THREADPOOL_PRIORITY_COUNT;
+}
+
+static SGL_ALWAYS_INLINE sgl_threadpool_scratch_t *sgl_threadpool_scratch_at(
+    const sgl_threadpool_t *pool,
+    sgl_size_t index)
+{
+    sgl_threadpool_scratch_t *result;
+
+    /* SGL-MEM-DEV-001: typed conversion from generic storage. */
+    /* cppcheck-suppress misra-c2012-11.5 */
+    result = (sgl_threadpool_scratch_t *)(void *)&pool->scratch_arenas[index * SGL_THREADPOOL_SCRATCH_STRIDE];
+
+    return result;
+}
+
+/*
+ * One allocation holds a cache-line spaced arena per worker and per
+ * possible submitter, followed by the stack of free submitter arenas.
+ */
+static sgl_bool_t sgl_threadpool_create_scratch(sgl_threadpool_t *pool)
+{
+    sgl_bool_t result = SGL_FALSE;
+    sgl_size_t count;
+    sgl_size_t i;
+
+    count = pool->num_threads + sgl_threadpool_submitter_slots(pool);
+    pool->scratch_arenas = sgl_memory_as_uint8(sgl_malloc(
+        (count * SGL_THREADPOOL_SCRATCH_STRIDE) +
+        (sgl_threadpool_submitter_slots(pool) * sizeof(sgl_threadpool_scratch_t *))));
+    if (pool->scratch_arenas != SGL_NULL) {
+        pool->free_scratch = sgl_threadpool_memory_as_scratch_array(
+            &pool->scratch_arenas[count * SGL_THREADPOOL_SCRATCH_STRIDE]);
+        for (i = 0U; i < count; ++i) {
+            sgl_threadpool_scratch_init(sgl_threadpool_scratch_at(pool, i));
+        }
+        for (i = 0U; i < pool->num_threads; ++i) {
+            pool->workers[i].scratch = sgl_threadpool_scratch_at(pool, i);
+        }
+        for (i = 0U; i < sgl_threadpool_submitter_slots(pool); ++i) {
+            pool->free_scratch[i] = sgl_threadpool_scratch_at(pool, pool->num_threads + i);
+        }
+        pool->free_scratch_count = sgl_threadpool_submitter_slots(pool);
+        result = SGL_TRUE;
+    }
+
+    return result;
+}
+
+/* Called once every worker has exited and no submitter is inside the pool. */
+static void sgl_threadpool_destroy_scratch(sgl_threadpool_t *pool)
+{
+    sgl_size_t i;
+
+    if (pool->scratch_arenas != SGL_NULL) {
+        for (i = 0U; i < (pool->num_threads + sgl_threadpool_submitter_slots(pool)); ++i) {
+            sgl_threadpool_scratch_release(sgl_threadpool_scratch_at(pool, i));
+        }
+        SGL_SAFE_FREE(pool->scratch_arenas);
+    }
+}
+
+/*
+ * Workers inherit the affinity of the thread that creates them, so the
+ * creating thread takes on each worker's CPU set just before spawning it and
+ * restores its own mask afterwards.  A placement that cannot be applied
+ * fails creation instead of silently leaving workers unpinned.
+ */
+static sgl_result_t sgl_threadpool_spawn_workers(
+    sgl_threadpool_t *pool,
+    const sgl_threadpool_cpu_set_t *sets)
+{
+    sgl_result_t result = SGL_SUCCESS;
+    sgl_threadpool_cpu_set_t original;
+    sgl_size_t i;
+
+    if ((sets != SGL_NULL) &&
+        (sgl_osal_thread_get_affinity(original.bits, SGL_THREADPOOL_CPU_SET_WORDS) == SGL_FALSE)) {
+        result = SGL_ERROR_NOT_SUPPORTED;
+    }
+
+    for (i = 0U; (result == SGL_SUCCESS) && (i < pool->num_threads); ++i) {
+        if (sets != SGL_NULL) {
+            if (sgl_osal_thread_set_affinity(sets[i].bits, SGL_THREADPOOL_CPU_SET_WORDS) == SGL_FALSE) {
+                result = SGL_ERROR_INVALID_ARGUMENTS;
+            }
+            else {
+                pool->workers[i].node = sgl_threadpool_cpu_set_node(&sets[i]);
+            }
+        }
+        if (result == SGL_SUCCESS) {
+            pool->workers[i].thread = sgl_thread_create(
+                sgl_threadpool_routine, (sgl_osal_thread_arg_t)&pool->workers[i]);
+        }
+    }
+
+    if (sets != SGL_NULL) {
+        (void)sgl_osal_thread_set_affinity(original.bits, SGL_THREADPOOL_CPU_SET_WORDS);
+    }
+
+    return result;
+}
+
+void sgl_threadpool_options_init(
+    sgl_threadpool_options_t *options,
+    sgl_size_t num_threads,
+    sgl_size_t max_routine_lists,
+    const char *base_name)
+{
+    if (options != SGL_NULL) {
+        options->num_threads = num_threads;
+        options->max_routine_lists = max_routine_lists;
+        options->base_name = base_name;
+        options->placement = SGL_THREADPOOL_PLACEMENT_NONE;
+        options->cpu_sets = SGL_NULL;
+        options->numa_node = -1;
+        options->is_node_local = SGL_FALSE;
+        options->wait_policy = SGL_THREADPOOL_WAIT_ADAPTIVE;
+        options->spin_limit_us = SGL_THREADPOOL_DEFAULT_SPIN_LIMIT_US;
+        options->max_threads = 0U;
+        options->follow_cpu_quota = SGL_FALSE;
+    }
+}
+
+sgl_threadpool_t *sgl_threadpool_create_with_options(const sgl_threadpool_options_t *options)
+{
+    sgl_threadpool_t *pool = SGL_NULL;
+    sgl_threadpool_cpu_set_t *sets = SGL_NULL;
+    sgl_result_t result = SGL_SUCCESS;
+    sgl_bool_t is_pinned = SGL_FALSE;
+    sgl_size_t max_threads = 0U;
+    sgl_size_t i;
+
+    if (options != SGL_NULL) {
+        max_threads = (options->max_threads == 0U) ? options->num_threads : options->max_threads;
+    }
+
+    /* max_routine_lists bounds the number of routines in flight at once. */
+    if ((options == SGL_NULL) ||
+        (options->num_threads == 0U) || (options->max_routine_lists == 0U) ||
+        (options->num_threads > max_threads) ||
+        (max_threads > SGL_THREADPOOL_MAX_OPERATIONS) ||
+        (options->wait_policy < SGL_THREADPOOL_WAIT_ADAPTIVE) ||
+        (options->wait_policy > SGL_THREADPOOL_WAIT_PARK) ||
+        (options->spin_limit_us > SGL_THREADPOOL_MAX_SPIN_LIMIT_US)) {
+        result = SGL_ERROR_INVALID_ARGUMENTS;
+    }
+    else {
+        sets = sgl_threadpool_memory_as_cpu_set(
+            sgl_malloc(max_threads * sizeof(sgl_threadpool_cpu_set_t)));
+        if (sets == SGL_NULL) {
+            result = SGL_ERROR_MEMORY_ALLOCATION;
+        }
+        else {
+            result = sgl_threadpool_plan_placement(options, max_threads, sets, &is_pinned);
+        }
+    }
+
+    if (result == SGL_SUCCESS) {
+        /* create instance handle */
+        pool = sgl_memory_as_threadpool(sgl_calloc(1, sizeof(sgl_threadpool_t)));
+    }
+
+    if (pool != SGL_NULL) {
+        pool->shared = pool;
+        pool->priority = SGL_THREADPOOL_PRIORITY_NORMAL;
+        pool->num_threads = max_threads;
+        pool->requested_threads = options->num_threads;
+        pool->active_threads = 0U;
+        pool->is_following_quota = options->follow_cpu_quota;
+        pool->cpu_quota = 0U;
+        if (pool->is_following_quota == SGL_TRUE) {
+            pool->cpu_quota = sgl_osal_get_cpu_quota();
+            pool->quota_check_ms = (sgl_int32_t)(sgl_uint32_t)(
+                sgl_osal_get_monotonic_ns() / SGL_THREADPOOL_NS_PER_MS);
+        }
+        pool->max_routine_lists = options->max_routine_lists;
+        pool->is_node_local = options->is_node_local;
+        pool->wait_policy = options->wait_policy;
+        pool->spin_limit_ns = (sgl_uint64_t)options->spin_limit_us * SGL_THREADPOOL_NS_PER_US;
+        pool->last_dispatch_ns = 0U;
+        pool->dispatch_interval_ns = 0U;
+        /* spin up to the limit until there is an interval to go by */
+        pool->spin_ns = (sgl_uint32_t)pool->spin_limit_ns;
+        pool->is_exit_threadpool = SGL_FALSE;
+        pool->routine_generation = 0U;
+        pool->completion_generation = 0U;
+        pool->resize_generation = 0U;
+        pool->head = SGL_NULL;
+        pool->tail = SGL_NULL;
+        pool->inflight_tasks[SGL_THREADPOOL_PRIORITY_NORMAL] = 0U;
+        pool->inflight_tasks[SGL_THREADPOOL_PRIORITY_HIGH] = 0U;
+        pool->high_tasks = 0U;
+        /* no worker exists yet, so nothing needs waking */
+        (void)sgl_threadpool_apply_thread_count(pool);
+
+        /* create mutex & wait queues */
+        sgl_osal_mutex_init(&pool->lock);
+        sgl_osal_wait_queue_init(&pool->worker_wait);
+        sgl_osal_wait_queue_init(&pool->submitter_wait);
+        sgl_osal_wait_queue_init(&pool->resize_wait);
+
+        /* allocate worker basket */
+        pool->workers = sgl_threadpool_memory_as_worker(
+            sgl_malloc(pool->num_threads * sizeof(sgl_threadpool_worker_t)));
+        if ((pool->workers != SGL_NULL) &&
+            (sgl_threadpool_create_scratch(pool) == SGL_FALSE)) {
+            SGL_SAFE_FREE(pool->workers);
+        }
+        if (pool->workers != SGL_NULL) {
+            /* one slot per worker and one for the submitting threads */
+            pool->stats = sgl_memory_as_uint8(sgl_calloc(
+                pool->num_threads + 1U, SGL_THREADPOOL_STATS_STRIDE));
+            if (pool->stats == SGL_NULL) {
+                sgl_threadpool_destroy_scratch(pool);
+                SGL_SAFE_FREE(pool->workers);
+            }
+        }
+        if (pool->workers != SGL_NULL) {
+            /* create threads; deque 0 of every task belongs to the submitter */
+            pool->base_name = options->base_name;
+            for (i = 0; i < pool->num_threads; ++i) {
+                pool->workers[i].pool = pool;
+                pool->workers[i].deque_index = SGL_THREADPOOL_SUBMITTER_DEQUE + 1U + i;
+                pool->workers[i].node = -1;
+                pool->workers[i].stats = sgl_threadpool_stats_at(pool, i);
+                pool->workers[i].throughput = 0U;
+                pool->workers[i].thread = NULL_THREAD;
+            }
+            if (sgl_threadpool_spawn_workers(
+                    pool, (is_pinned == SGL_TRUE) ? sets : SGL_NULL) != SGL_SUCCESS) {
+                (void)sgl_threadpool_destroy(pool);
+                pool = SGL_NULL;
+            }
+        }
+        else {
+            sgl_osal_mutex_destroy(&pool->lock);
+            sgl_osal_wait_queue_destroy(&pool->worker_wait);
+            sgl_osal_wait_queue_destroy(&pool->submitter_wait);
+            sgl_osal_wait_queue_destroy(&pool->resize_wait);
+            sgl_free(pool);
+            pool = SGL_NULL;
+        }
+    }
+    SGL_SAFE_FREE(sets);
+
+    return pool;
+}
+
+sgl_threadpool_t *sgl_threadpool_create(sgl_size_t num_threads, sgl_size_t max_routine_lists, const char *base_name)
+{
+    sgl_threadpool_options_t options;
+
+    sgl_threadpool_options_init(&options, num_threads, max_routine_lists, base_name);
+
+    return sgl_threadpool_create_with_options(&options);
+}
+
+sgl_result_t sgl_threadpool_destroy(sgl_threadpool_t *pool)
+{
+    sgl_result_t result = SGL_SUCCESS;
+
+    if ((pool != SGL_NULL) && (pool->shared != pool)) {
+        /* a lane owns nothing but itself */
+        sgl_free(pool);
+    }
+    else if (pool != SGL_NULL) {
+        /*
+         * Set exit flag and wake workers under the same lock they use to read
+         * it.  Writing it outside the lock races with waiting workers.
+         */
+        sgl_threadpool_lock(pool);
+        pool->is_exit_threadpool = SGL_TRUE;
+        /* releases workers and submitters waiting on the generations */
+        (void)sgl_osal_atomic_uint32_increment_release(&pool->routine_generation);
+        (void)sgl_osal_atomic_uint32_increment_release(&pool->completion_generation);
+        (void)sgl_osal_atomic_uint32_increment_release(&pool->resize_generation);
+        sgl_osal_mutex_unlock(&pool->lock);
+        sgl_osal_wake_address(&pool->worker_wait, &pool->routine_generation, SGL_OSAL_WAKE_ALL);
+        sgl_osal_wake_address(&pool->submitter_wait, &pool->completion_generation, SGL_OSAL_WAKE_ALL);
+        sgl_osal_wake_address(&pool->resize_wait, &pool->resize_generation, SGL_OSAL_WAKE_ALL);
+
+        /* Join all worker threads to ensure they have finished execution */
+        for (sgl_size_t i = 0; i < pool->num_threads; ++i) {
+            if (pool->workers[i].thread != NULL_THREAD) {
+                sgl_osal_thread_join(pool->workers[i].thread);
+            }
+        }
+
+        /* Destroy synchronization primitives */
+        sgl_osal_mutex_destroy(&pool->lock);
+        sgl_osal_wait_queue_destroy(&pool->worker_wait);
+        sgl_osal_wait_queue_destroy(&pool->submitter_wait);
+        sgl_osal_wait_queue_destroy(&pool->resize_wait);
+
+        /* Free scratch arenas and worker array */
+        sgl_threadpool_destroy_scratch(pool);
+        SGL_SAFE_FREE(pool->stats);
+        SGL_SAFE_FREE(pool->workers);
+
+        /* Free the pool object itself */
+        sgl_free(pool);
+    }
+    else {
+        result = SGL_ERROR_INVALID_ARGUMENTS;
+    }
+
+    return result;
+}
+
+sgl_size_t sgl_threadpool_get_num_threads(const sgl_threadpool_t *pool)
+{
+    sgl_size_t num_threads;
+
+    num_threads = 0U;
+    if (pool != SGL_NULL) {
+        num_threads = sgl_threadpool_active_threads(pool->shared);
+    }
+
+    return num_threads;
+}
+
+sgl_result_t sgl_threadpool_set_num_threads(sgl_threadpool_t *pool, sgl_size_t num_threads)
+{
+    sgl_result_t result = SGL_SUCCESS;
+    sgl_threadpool_t *shared;
+    sgl_bool_t is_changed;
+
+    shared = sgl_threadpool_shared(pool);
+    if ((shared == SGL_NULL) || (num_threads == 0U) || (num_threads > shared->num_threads)) {
+        result = SGL_ERROR_INVALID_ARGUMENTS;
+    }
+    else {
+        sgl_threadpool_lock(shared);
+        shared->requested_threads = num_threads;
+        is_changed = sgl_threadpool_apply_thread_count(shared);
+        sgl_osal_mutex_unlock(&shared->lock);
+        if (is_changed == SGL_TRUE) {
+            sgl_threadpool_wake_resized(shared);
+        }
+    }
+
+    return result;
+}
+
+sgl_threadpool_t *sgl_threadpool_create_lane(sgl_threadpool_t *pool, sgl_threadpool_priority_t priority)
+{
+    sgl_threadpool_t *lane = SGL_NULL;
+
+    if ((pool != SGL_NULL) &&
+        (priority >= SGL_THREADPOOL_PRIORITY_NORMAL) &&
+        (priority <= SGL_THREADPOOL_PRIORITY_HIGH)) {
+        lane = sgl_memory_as_threadpool(sgl_calloc(1, sizeof(sgl_threadpool_t)));
+        if (lane != SGL_NULL) {
+            /* a lane of a lane shares the same workers */
+            lane->shared = pool->shared;
+            lane->priority = priority;
+        }
+    }
+
+    return lane;
+}
+
+sgl_threadpool_token_t *sgl_threadpool_token_create(void)
+{
+    return sgl_threadpool_memory_as_token(sgl_calloc(1, sizeof(sgl_threadpool_token_t)));
+}
+
+sgl_result_t sgl_threadpool_token_destroy(sgl_threadpool_token_t *token)
+{
+    sgl_result_t result = SGL_SUCCESS;
+
+    if (token != SGL_NULL) {
+        sgl_free(token);
+    }
+    else {
+        result = SGL_ERROR_INVALID_ARGUMENTS;
+    }
+
+    return result;
+}
+
+sgl_result_t sgl_threadpool_token_set_deadline(sgl_threadpool_token_t *token, sgl_uint64_t deadline_ns)
+{
+    sgl_result_t result = SGL_SUCCESS;
+
+    if (token != SGL_NULL) {
+        sgl_osal_atomic_uint64_store_relaxed(&token->deadline_ns, deadline_ns);
+    }
+    else {
+        result = SGL_ERROR_INVALID_ARGUMENTS;
+    }
+
+    return result;
+}
+
+sgl_result_t sgl_threadpool_token_cancel(sgl_threadpool_token_t *token)
+{
+    sgl_result_t result = SGL_SUCCESS;
+
+    if (token != SGL_NULL) {
+        sgl_osal_atomic_uint32_store_relaxed(&token->is_cancelled, 1U);
+    }
+    else {
+        result = SGL_ERROR_INVALID_ARGUMENTS;
+    }
+
+    return result;
+}
+
+sgl_result_t sgl_threadpool_token_reset(sgl_threadpool_token_t *token)
+{
+    sgl_result_t result = SGL_SUCCESS;
+
+    if (token != SGL_NULL) {
+        sgl_osal_atomic_uint32_store_relaxed(&token->is_cancelled, 0U);
+        sgl_osal_atomic_uint32_store_relaxed(&token->completed, 0U);
+    }
+    else {
+        result = SGL_ERROR_INVALID_ARGUMENTS;
+    }
+
+    return result;
+}
+
+sgl_bool_t sgl_threadpool_token_is_cancelled(const sgl_threadpool_token_t *token)
+{
+    sgl_bool_t result = SGL_FALSE;
+    sgl_uint64_t deadline_ns;
+
+    if (token != SGL_NULL) {
+        deadline_ns = sgl_osal_atomic_uint64_load_relaxed(&token->deadline_ns);
+        if ((sgl_osal_atomic_uint32_load_relaxed(&token->is_cancelled) != 0U) ||
+            ((deadline_ns != 0U) &&
+             (sgl_osal_get_monotonic_ns() >= deadline_ns))) {
+            result = SGL_TRUE;
+        }
+    }
+
+    return result;
+}
+
+sgl_size_t sgl_threadpool_token_get_completed(const sgl_threadpool_token_t *token)
+{
+    sgl_size_t result = 0U;
+
+    if (token != SGL_NULL) {
+        result = (sgl_size_t)sgl_osal_atomic_uint32_load_relaxed(&token->completed);
+    }
+
+    return result;
+}
+
+/* The root pool is shared by every lane, so only lanes carry a token. */
+sgl_result_t sgl_threadpool_set_token(sgl_threadpool_t *lane, sgl_threadpool_token_t *token)
+{
+    sgl_result_t result = SGL_SUCCESS;
+
+    if ((lane != SGL_NULL) && (lane->shared != lane)) {
+        lane->token = token;
+    }
+    else {
+        result = SGL_ERROR_INVALID_ARGUMENTS;
+    }
+
+    return result;
+}
+
+sgl_threadpool_token_t *sgl_threadpool_get_token(const sgl_threadpool_t *pool)
+{
+    return (pool != SGL_NULL) ? pool->token : SGL_NULL;
+}
+
+/* Sums the slots; writers keep going, so each counter is read only once. */
+sgl_result_t sgl_threadpool_get_stats(const sgl_threadpool_t *pool, sgl_threadpool_stats_t *stats)
+{
+    sgl_result_t result = SGL_SUCCESS;
+    const sgl_threadpool_stats_slot_t *slot;
+    const sgl_threadpool_t *shared;
+    sgl_size_t i;
+
+    shared = sgl_threadpool_shared(pool);
+    if ((shared == SGL_NULL) || (stats == SGL_NULL)) {
+        result = SGL_ERROR_INVALID_ARGUMENTS;
+    }
+    else {
+        (void)sgl_memset(stats, 0, sizeof(*stats));
+        for (i = 0U; i <= shared->num_threads; ++i) {
+            slot = sgl_threadpool_stats_at(shared, i);
+            if (i < shared->num_threads) {
+                stats->worker_operations += sgl_osal_atomic_uint64_load_relaxed(&slot->operations);
+            }
+            else {
+                stats->submitter_operations = sgl_osal_atomic_uint64_load_relaxed(&slot->operations);
+            }
+            stats->dispatches += sgl_osal_atomic_uint64_load_relaxed(&slot->dispatches);
+            stats->spin_wakeups += sgl_osal_atomic_uint64_load_relaxed(&slot->spin_wakeups);
+            stats->parks += sgl_osal_atomic_uint64_load_relaxed(&slot->parks);
+            stats->completion_waits += sgl_osal_atomic_uint64_load_relaxed(&slot->completion_waits);
+            stats->completion_wait_ns += sgl_osal_atomic_uint64_load_relaxed(&slot->completion_wait_ns);
+            stats->lock_contentions += sgl_osal_atomic_uint64_load_relaxed(&slot->lock_contentions);
+        }
+    }
+
+    return result;
+}
+
+/*
+ * Publishes a task.  When participant is given, the submitting thread owns
+ * deque 0 and reserves its first operation before the task becomes visible,
+ * so it always has work and joins without a wake-up.
+ */
+static sgl_result_t sgl_threadpool_publish_task(
+    sgl_threadpool_t *pool,
+    sgl_threadpool_task_t *task,
+    sgl_threadpool_routine_context_t *participant)
+{
+    sgl_result_t result = SGL_SUCCESS;
+    sgl_size_t remaining;
+    sgl_size_t wake_count;
+    sgl_uint32_t generation;
+
+    wake_count = 0U;
+    sgl_threadpool_follow_cpu_quota(pool);
+    sgl_threadpool_lock(pool);
+    /* a nested task may be what frees the budget, so it never waits for it */
+    while ((pool->inflight_tasks[task->priority] >= pool->max_routine_lists) &&
+           (sgl_threadpool_is_nested(pool) == SGL_FALSE) &&
+           (pool->is_exit_threadpool == SGL_FALSE)) {
+        /* a completion advances the generation under the lock */
+        generation = sgl_osal_atomic_uint32_load_acquire(&pool->completion_generation);
+        sgl_osal_mutex_unlock(&pool->lock);
+        sgl_threadpool_wait_until_changed(
+            pool, &pool->submitter_wait, &pool->completion_generation, generation);
+        sgl_threadpool_lock(pool);
+    }
+
+    if (pool->is_exit_threadpool == SGL_FALSE) {
+        if ((participant != SGL_NULL) &&
+            (sgl_threadpool_claim_work(task, participant) == SGL_TRUE)) {
+            task->active_workers = 1U;
+            if ((task->scratch_routine != SGL_NULL) && (pool->free_scratch_count > 0U)) {
+                pool->free_scratch_count--;
+                participant->scratch = pool->free_scratch[pool->free_scratch_count];
+            }
+        }
+        remaining = task->operation_count - task->active_workers;
+        sgl_threadpool_track_dispatch(pool);
+        sgl_osal_atomic_uint64_add_relaxed(&sgl_threadpool_stats_of(pool)->dispatches, 1U);
+        task->generation = sgl_osal_atomic_uint32_increment_release(
+            &pool->routine_generation);
+        SGL_TRACE_THREADPOOL_DISPATCH_BEGIN(
+            pool,
+            task->generation,
+            task->operation_count,
+            (remaining < sgl_threadpool_active_threads(pool)) ?
+                remaining : sgl_threadpool_active_threads(pool),
+            sgl_threadpool_active_threads(pool));
+        if ((remaining == 0U) && (task->active_workers == 0U)) {
+            /* nothing to run: complete on the spot */
+            task->is_done = 1U;
+        }
+        else {
+            pool->inflight_tasks[task->priority]++;
+            if (remaining > 0U) {
+                sgl_threadpool_link_task(pool, task);
+            }
+            /*
+             * The submitting participant may hold the only operation.  A
+             * woken worker off the task's node could not claim it, so a
+             * node-local pool wakes everyone.
+             */
+            wake_count = remaining;
+            if (pool->is_node_local == SGL_TRUE) {
+                wake_count = (sgl_size_t)SGL_OSAL_WAKE_ALL;
+            }
+        }
+    }
+    else {
+        result = SGL_ERROR_INVALID_ARGUMENTS;
+    }
+    sgl_osal_mutex_unlock(&pool->lock);
+
+    sgl_threadpool_wake_waiters(
+        pool, &pool->worker_wait, &pool->routine_generation, wake_count);
+
+    return result;
+}
+
+static sgl_result_t sgl_threadpool_submit_internal(
+    sgl_threadpool_t *SGL_RESTRICT pool,
+    sgl_threadpool_routine_t routine,
+    sgl_queue_t *SGL_RESTRICT operations,
+    void *SGL_RESTRICT cookie,
+    sgl_bool_t preserve_operations,
+    sgl_threadpool_routine_context_t *participant,
+    sgl_threadpool_task_t **task)
 {
-    sgl_osal_thread_t *result;
+    sgl_result_t result = SGL_SUCCESS;
+    sgl_threadpool_task_t *new_task;
 
-    /* SGL-MEM-DEV-001: typed conversion from generic storage. */
-    /* cppcheck-suppress misra-c2012-11.5 */
-    result = (sgl_osal_thread_t *)memory;
+    new_task = SGL_NULL;
+    if ((pool != SGL_NULL) && (routine != SGL_NULL) &&
+        (operations != SGL_NULL) && (task != SGL_NULL)) {
+        new_task = sgl_threadpool_create_task(
+            pool->shared, operations, (participant != SGL_NULL) ? SGL_TRUE : SGL_FALSE,
+            sgl_threadpool_nested_worker(pool->shared),
+            sgl_threadpool_submitter_node(pool->shared));
+        if (new_task == SGL_NULL) {
+            result = SGL_ERROR_MEMORY_ALLOCATION;
+        }
+    }
+    else {
+        result = SGL_ERROR_INVALID_ARGUMENTS;
+    }
+
+    if (result == SGL_SUCCESS) {
+        new_task->pool = pool->shared;
+        new_task->priority = pool->priority;
+        new_task->token = pool->token;
+        new_task->routine = routine;
+        new_task->cookie = cookie;
+        new_task->preserve_operations = preserve_operations;
+        result = sgl_threadpool_publish_task(pool->shared, new_task, participant);
+        if (result == SGL_SUCCESS) {
+            *task = new_task;
+        }
+    }
+
+    if ((result != SGL_SUCCESS) && (new_task != SGL_NULL)) {
+        if (preserve_operations == SGL_TRUE) {
+            sgl_threadpool_restore_operations(new_task);
+        }
+        sgl_free(new_task);
+    }
 
     return result;
 }
 
-static sgl_osal_thread_return_t sgl_threadpool_routine(sgl_osal_thread_arg_t arg);
-static void sgl_threadpool_clear_routine(sgl_threadpool_t *pool);
-static sgl_queue_t *sgl_threadpool_create_completed_queue(const sgl_queue_t *operations);
-static sgl_bool_t sgl_threadpool_try_claim_routine(
-    sgl_threadpool_t *pool,
-    sgl_threadpool_routine_context_t *routine,
-    sgl_uint32_t *last_generation);
-static void sgl_threadpool_spin_until_changed(
-    const sgl_osal_atomic_uint32_t *generation,
-    sgl_uint32_t expected);
-static void sgl_threadpool_execute_routine(
-    const sgl_threadpool_routine_context_t *routine,
-    const sgl_threadpool_t *pool,
-    sgl_uint32_t generation,
-    const char *role);
-static void sgl_threadpool_finish_routine(sgl_threadpool_t *pool);
-static sgl_result_t sgl_threadpool_attach_routine_internal(
+sgl_result_t sgl_threadpool_submit_routine(
     sgl_threadpool_t *SGL_RESTRICT pool,
     sgl_threadpool_routine_t routine,
     sgl_queue_t *SGL_RESTRICT operations,
     void *SGL_RESTRICT cookie,
-    sgl_bool_t preserve_operations);
+    sgl_threadpool_task_t **task)
+{
+    sgl_result_t result;
+
+    result = sgl_threadpool_submit_internal(
+        pool, routine, operations, cookie, SGL_TRUE, SGL_NULL, task);
 
-static void sgl_threadpool_clear_routine(sgl_threadpool_t *pool)
+    return result;
+}
+
+sgl_result_t sgl_threadpool_submit_routine_consuming(
+    sgl_threadpool_t *SGL_RESTRICT pool,
+    sgl_threadpool_routine_t routine,
+    sgl_queue_t *SGL_RESTRICT operations,
+    void *SGL_RESTRICT cookie,
+    sgl_threadpool_task_t **task)
 {
-    pool->routine = SGL_NULL;
-    pool->cookie = SGL_NULL;
-    pool->operations = SGL_NULL;
-    pool->completed_operations = SGL_NULL;
-    pool->active_workers = 0U;
-    pool->claimed_workers = 0U;
-    pool->worker_limit = 0U;
-    pool->has_routine = SGL_FALSE;
-    pool->is_done = SGL_FALSE;
+    sgl_result_t result;
+
+    result = sgl_threadpool_submit_internal(
+        pool, routine, operations, cookie, SGL_FALSE, SGL_NULL, task);
+
+    return result;
 }
 
-static sgl_queue_t *sgl_threadpool_create_completed_queue(const sgl_queue_t *operations)
+sgl_result_t sgl_threadpool_test(const sgl_threadpool_task_t *task)
 {
-    sgl_queue_t *completed_operations;
-    sgl_size_t operation_count;
+    sgl_result_t result;
 
-    operation_count = sgl_queue_get_count(operations);
-    if (operation_count > 0U) {
-        completed_operations = sgl_queue_create(operation_count);
+    if (task == SGL_NULL) {
+        result = SGL_ERROR_INVALID_ARGUMENTS;
+    }
+    else if (sgl_osal_atomic_uint32_load_acquire(&task->is_done) == 0U) {
+        result = SGL_THREADPOOL_TASK_IS_PENDING;
+    }
+    else if (sgl_osal_atomic_uint32_load_relaxed(&task->is_cancelled) != 0U) {
+        result = SGL_THREADPOOL_CANCELLED;
     }
     else {
-        completed_operations = SGL_NULL;
+        result = SGL_SUCCESS;
     }
 
-    return completed_operations;
+    return result;
 }
 
-static void sgl_threadpool_spin_until_changed(
-    const sgl_osal_atomic_uint32_t *generation,
-    sgl_uint32_t expected)
+/*
+ * Runs a worker's claim to the end, stepping out for HIGH work in urgent
+ * whenever the routine suspends, and leaves the task.
+ */
+static void sgl_threadpool_run_claimed(
+    sgl_threadpool_t *pool,
+    sgl_threadpool_routine_context_t *routine,
+    sgl_threadpool_routine_context_t *urgent)
 {
-    sgl_uint32_t iteration;
+    sgl_bool_t is_suspended;
 
-    for (iteration = 0U;
-         (iteration < SGL_THREADPOOL_SPIN_WAIT_ITERATIONS) &&
-         (sgl_osal_atomic_uint32_load_acquire(generation) == expected);
-         ++iteration) {
-        SGL_CPU_RELAX();
+    is_suspended = sgl_threadpool_execute_routine(routine, pool, SGL_TRACE_ROLE_WORKER);
+    while (is_suspended == SGL_TRUE) {
+        sgl_threadpool_serve_high_priority(pool, routine, urgent);
+        is_suspended = SGL_FALSE;
+        if (sgl_threadpool_claim_work(routine->task, routine) == SGL_TRUE) {
+            is_suspended = sgl_threadpool_execute_routine(
+                routine, pool, SGL_TRACE_ROLE_WORKER);
+        }
     }
+    sgl_threadpool_finish_routine(pool, routine);
 }
 
-static sgl_bool_t sgl_threadpool_try_claim_routine(
+/*
+ * Help-first join for a routine waiting on a task of its own pool: take
+ * part in it before blocking.  A worker uses its own deque, where a nested
+ * submission put the operations; a submitting thread uses deque 0, which
+ * a submitted task leaves to whoever waits on it.  The worker's scratch
+ * arena may be in use by the routine that is waiting, so the contexts here
+ * have none.
+ */
+static void sgl_threadpool_help_task(
     sgl_threadpool_t *pool,
-    sgl_threadpool_routine_context_t *routine,
-    sgl_uint32_t *last_generation)
+    sgl_threadpool_task_t *task)
 {
+    sgl_threadpool_worker_t *worker;
+    sgl_threadpool_routine_context_t helper;
+    sgl_threadpool_routine_context_t urgent;
     sgl_bool_t is_claimed;
-    sgl_uint32_t generation;
-
-    is_claimed = SGL_FALSE;
-    routine->routine = SGL_NULL;
-    routine->cookie = SGL_NULL;
-    routine->operations = SGL_NULL;
-    routine->completed_operations = SGL_NULL;
-    routine->first_operation = SGL_NULL;
 
-    sgl_threadpool_spin_until_changed(
-        &pool->routine_generation, *last_generation);
-    sgl_osal_mutex_lock(&pool->lock);
-    while ((pool->is_exit_threadpool == SGL_FALSE) &&
-           (is_claimed == SGL_FALSE)) {
-        while ((pool->is_exit_threadpool == SGL_FALSE) &&
-               ((pool->has_routine == SGL_FALSE) ||
-                (pool->is_done == SGL_TRUE) ||
-                (pool->claimed_workers >= pool->worker_limit) ||
-                (sgl_osal_atomic_uint32_load_acquire(
-                     &pool->routine_generation) == *last_generation))) {
-            sgl_osal_cond_wait(&pool->worker_cond, &pool->lock);
+    worker = sgl_threadpool_nested_worker(pool);
+    if ((sgl_threadpool_is_nested(pool) == SGL_TRUE) &&
+        (sgl_osal_atomic_uint32_load_acquire(&task->is_done) == 0U)) {
+        helper.task = SGL_NULL;
+        helper.first_operation = SGL_NULL;
+        helper.first_chunk = 0U;
+        helper.deque_index = SGL_THREADPOOL_SUBMITTER_DEQUE;
+        helper.scratch = SGL_NULL;
+        helper.detour_generation = 0U;
+        helper.throughput = SGL_NULL;
+        if (worker != SGL_NULL) {
+            helper.deque_index = worker->deque_index;
+            helper.throughput = &worker->throughput;
         }
-
-        if (pool->is_exit_threadpool == SGL_FALSE) {
-            generation = sgl_osal_atomic_uint32_load_acquire(
-                &pool->routine_generation);
-            routine->first_operation = sgl_queue_dequeue(pool->operations);
-            if (routine->first_operation != SGL_NULL) {
-                routine->routine = pool->routine;
-                routine->cookie = pool->cookie;
-                routine->operations = pool->operations;
-                routine->completed_operations = pool->completed_operations;
-                *last_generation = generation;
-                pool->active_workers++;
-                pool->claimed_workers++;
-                is_claimed = SGL_TRUE;
-            }
-            else {
-                /*
-                 * Another participant reserved the final operation before this
-                 * worker acquired pool->lock.  Mark this generation observed
-                 * and sleep until new work is published without inflating the
-                 * active-worker count for an empty participant.
-                 */
-                *last_generation = generation;
-            }
+        urgent = helper;
+        is_claimed = SGL_FALSE;
+        sgl_threadpool_lock(pool);
+        if ((pool->is_exit_threadpool == SGL_FALSE) &&
+            ((worker == SGL_NULL) ||
+             (sgl_threadpool_worker_is_eligible(worker, task->node) == SGL_TRUE)) &&
+            (sgl_threadpool_claim_work(task, &helper) == SGL_TRUE)) {
+            task->active_workers++;
+            is_claimed = SGL_TRUE;
+        }
+        sgl_osal_mutex_unlock(&pool->lock);
+        if (is_claimed == SGL_TRUE) {
+            sgl_threadpool_run_claimed(pool, &helper, &urgent);
         }
     }
-    sgl_osal_mutex_unlock(&pool->lock);
-
-    return is_claimed;
 }
 
-static void sgl_threadpool_execute_routine(
-    const sgl_threadpool_routine_context_t *routine,
-    const sgl_threadpool_t *pool,
-    sgl_uint32_t generation,
-    const char *role)
+static void sgl_threadpool_wait_task(
+    sgl_threadpool_t *pool,
+    sgl_threadpool_task_t *task)
 {
-    void *current;
-#if defined(SGL_CFG_HAS_LTTNG)
-    sgl_size_t completed_operations;
+    sgl_threadpool_stats_slot_t *stats;
+    sgl_uint64_t start_ns;
+    sgl_uint32_t generation;
 
-    completed_operations = 0U;
-    SGL_TRACE_THREADPOOL_PARTICIPANT_BEGIN(pool, generation, role);
-#else
-    SGL_UNUSED(pool);
-    SGL_UNUSED(generation);
-    SGL_UNUSED(role);
-#endif
-    current = routine->first_operation;
-    while (current != SGL_NULL) {
-        routine->routine(current, routine->cookie);
-#if defined(SGL_CFG_HAS_LTTNG)
-        completed_operations++;
-#endif
-        if (routine->completed_operations != SGL_NULL) {
-            (void)sgl_queue_enqueue(routine->completed_operations, current);
+    stats = sgl_threadpool_stats_of(pool);
+    start_ns = 0U;
+    if (sgl_osal_atomic_uint32_load_acquire(&task->is_done) == 0U) {
+        start_ns = sgl_osal_get_monotonic_ns();
+        sgl_osal_atomic_uint64_add_relaxed(&stats->completion_waits, 1U);
+        (void)sgl_threadpool_spin_until_changed(pool, &task->is_done, 0U);
+    }
+    while (sgl_osal_atomic_uint32_load_acquire(&task->is_done) == 0U) {
+        /*
+         * is_done is published before the generation advances, so a
+         * generation read ahead of a still-pending is_done cannot already
+         * include this task's completion.
+         */
+        generation = sgl_osal_atomic_uint32_load_acquire(&pool->completion_generation);
+        if (sgl_osal_atomic_uint32_load_acquire(&task->is_done) == 0U) {
+            SGL_TRACE_THREADPOOL_COMPLETION_WAIT_BEGIN(pool, task->generation);
+            sgl_threadpool_wait_until_changed(
+                pool, &pool->submitter_wait, &pool->completion_generation, generation);
+            SGL_TRACE_THREADPOOL_COMPLETION_WAIT_END(pool, task->generation);
         }
-        current = sgl_queue_dequeue(routine->operations);
     }
-#if defined(SGL_CFG_HAS_LTTNG)
-    SGL_TRACE_THREADPOOL_PARTICIPANT_END(
-        pool, generation, role, completed_operations);
-#endif
-}
-
-static void sgl_threadpool_finish_routine(sgl_threadpool_t *pool)
-{
-    sgl_osal_mutex_lock(&pool->lock);
-    if (pool->active_workers > 0U) {
-        pool->active_workers--;
+    if (start_ns != 0U) {
+        sgl_osal_atomic_uint64_add_relaxed(
+            &stats->completion_wait_ns, sgl_osal_get_monotonic_ns() - start_ns);
     }
-    if (pool->active_workers == 0U) {
-        pool->is_done = SGL_TRUE;
-        (void)sgl_osal_atomic_uint32_increment_release(
-            &pool->completion_generation);
-        sgl_osal_cond_broadcast(&pool->submitter_cond);
+
+    if (task->preserve_operations == SGL_TRUE) {
+        sgl_threadpool_restore_operations(task);
     }
-    sgl_osal_mutex_unlock(&pool->lock);
+    SGL_TRACE_THREADPOOL_DISPATCH_END(
+        pool, task->generation, task->operation_count);
 }
 
-sgl_threadpool_t *sgl_threadpool_create(sgl_size_t num_threads, sgl_size_t max_routine_lists, const char *base_name)
+sgl_result_t sgl_threadpool_wait(sgl_threadpool_task_t **task)
 {
-    sgl_threadpool_t *pool = SGL_NULL;
-    sgl_size_t i;
+    sgl_result_t result;
 
-    /*
-     * max_routine_lists is retained as part of the public creation contract.
-     * The current implementation serializes attach_routine() calls internally,
-     * so a positive value means "routine submission is supported".
-     */
-    if ((num_threads > 0U) && (max_routine_lists > 0U)) {
-        /* create instance handle */
-        pool = sgl_memory_as_threadpool(sgl_calloc(1, sizeof(sgl_threadpool_t)));
-    }
+    result = sgl_threadpool_wait_all(task, 1U);
 
-    if (pool != SGL_NULL) {
-        pool->num_threads = num_threads;
-        pool->is_exit_threadpool = SGL_FALSE;
-        pool->routine_generation = 0U;
-        pool->completion_generation = 0U;
+    return result;
+}
 
-        /* create mutex & conditional variable */
-        sgl_osal_mutex_init(&pool->lock);
-        sgl_osal_cond_init(&pool->worker_cond);
-        sgl_osal_cond_init(&pool->submitter_cond);
+sgl_result_t sgl_threadpool_wait_all(sgl_threadpool_task_t **tasks, sgl_size_t count)
+{
+    sgl_result_t result = SGL_SUCCESS;
+    sgl_size_t i;
 
-        /* allocate thread basket */
-        pool->threads = sgl_threadpool_memory_as_osal_thread(
-            sgl_malloc(num_threads * sizeof(sgl_osal_thread_t)));
-        if (pool->threads != SGL_NULL) {
-            /* create threads */
-            pool->base_name = base_name;
-            for (i = 0; i < num_threads; ++i) {
-                pool->threads[i] = sgl_thread_create(sgl_threadpool_routine, (sgl_osal_thread_arg_t)pool);
+    if (tasks == SGL_NULL) {
+        result = SGL_ERROR_INVALID_ARGUMENTS;
+    }
+    else {
+        for (i = 0U; i < count; ++i) {
+            if (tasks[i] == SGL_NULL) {
+                result = SGL_ERROR_INVALID_ARGUMENTS;
+            }
+            else {
+                sgl_threadpool_help_task(tasks[i]->pool, tasks[i]);
+                sgl_threadpool_wait_task(tasks[i]->pool, tasks[i]);
+                if ((result == SGL_SUCCESS) &&
+                    (sgl_osal_atomic_uint32_load_relaxed(&tasks[i]->is_cancelled) != 0U)) {
+                    result = SGL_THREADPOOL_CANCELLED;
+                }
+                sgl_free(tasks[i]);
+                tasks[i] = SGL_NULL;
             }
-        }
-        else {
-            sgl_osal_mutex_destroy(&pool->lock);
-            sgl_osal_cond_destroy(&pool->worker_cond);
-            sgl_osal_cond_destroy(&pool->submitter_cond);
-            sgl_free(pool);
-            pool = SGL_NULL;
         }
     }
 
-    return pool;
+    return result;
 }
 
-sgl_result_t sgl_threadpool_destroy(sgl_threadpool_t *pool)
+static sgl_result_t sgl_threadpool_attach_routine_internal(
+    sgl_threadpool_t *SGL_RESTRICT pool,
+    sgl_threadpool_routine_t routine,
+    sgl_queue_t *SGL_RESTRICT operations,
+    void *SGL_RESTRICT cookie,
+    sgl_bool_t preserve_operations)
 {
-    sgl_result_t result = SGL_SUCCESS;
-
-    if (pool != SGL_NULL) {
-        /*
-         * Set exit flag and wake workers under the same lock they use to read
-         * it.  Writing it outside the lock races with waiting workers.
-         */
-        sgl_osal_mutex_lock(&pool->lock);
-        pool->is_exit_threadpool = SGL_TRUE;
-        sgl_osal_cond_broadcast(&pool->worker_cond);
-        sgl_osal_cond_broadcast(&pool->submitter_cond);
-        sgl_osal_mutex_unlock(&pool->lock);
+    sgl_result_t result;
+    sgl_threadpool_routine_context_t participant;
+    sgl_threadpool_task_t *task;
 
-        /* Join all worker threads to ensure they have finished execution */
-        for (sgl_size_t i = 0; i < pool->num_threads; ++i) {
-            if (pool->threads[i] != NULL_THREAD) {
-                sgl_osal_thread_join(pool->threads[i]);
-            }
+    /*
+     * attach_routine() returns only after all operations have completed and
+     * no worker still holds the caller's cookie pointer.
+     */
+    task = SGL_NULL;
+    participant.task = SGL_NULL;
+    participant.first_operation = SGL_NULL;
+    participant.first_chunk = 0U;
+    participant.deque_index = SGL_THREADPOOL_SUBMITTER_DEQUE;
+    participant.scratch = SGL_NULL;
+    participant.detour_generation = 0U;
+    participant.throughput = SGL_NULL;
+    result = sgl_threadpool_submit_internal(
+        pool, routine, operations, cookie, preserve_operations, &participant, &task);
+    if (result == SGL_SUCCESS) {
+        if (participant.first_operation != SGL_NULL) {
+            (void)sgl_threadpool_execute_routine(
+                &participant, pool->shared, SGL_TRACE_ROLE_SUBMITTER);
+            sgl_threadpool_finish_routine(pool->shared, &participant);
         }
-
-        /* Destroy synchronization primitives */
-        sgl_osal_mutex_destroy(&pool->lock);
-        sgl_osal_cond_destroy(&pool->worker_cond);
-        sgl_osal_cond_destroy(&pool->submitter_cond);
-
-        /* Free thread array */
-        SGL_SAFE_FREE(pool->threads);
-
-        /* Free the pool object itself */
-        sgl_free(pool);
-    }
-    else {
-        result = SGL_ERROR_INVALID_ARGUMENTS;
+        result = sgl_threadpool_wait(&task);
     }
 
     return result;
 }
 
-sgl_size_t sgl_threadpool_get_num_threads(const sgl_threadpool_t *pool)
+sgl_result_t sgl_threadpool_attach_routine(
+    sgl_threadpool_t *SGL_RESTRICT pool,
+    sgl_threadpool_routine_t routine,
+    sgl_queue_t *SGL_RESTRICT operations,
+    void *SGL_RESTRICT cookie)
 {
-    sgl_size_t num_threads;
+    sgl_result_t result;
 
-    num_threads = 0U;
-    if (pool != SGL_NULL) {
-        num_threads = pool->num_threads;
-    }
+    result = sgl_threadpool_attach_routine_internal(
+        pool, routine, operations, cookie, SGL_TRUE);
 
-    return num_threads;
+    return result;
 }
 
-static sgl_result_t sgl_threadpool_attach_routine_internal(
+sgl_result_t sgl_threadpool_attach_routine_consuming(
     sgl_threadpool_t *SGL_RESTRICT pool,
     sgl_threadpool_routine_t routine,
     sgl_queue_t *SGL_RESTRICT operations,
-    void *SGL_RESTRICT cookie,
-    sgl_bool_t preserve_operations)
+    void *SGL_RESTRICT cookie)
 {
-    sgl_result_t result = SGL_SUCCESS;
-    sgl_queue_t *completed_operations;
-    sgl_threadpool_routine_context_t routine_context;
-    sgl_uint32_t completion_generation;
-    sgl_uint32_t routine_generation;
-    sgl_size_t operation_count;
+    sgl_result_t result;
 
-    completed_operations = SGL_NULL;
-    routine_context.routine = routine;
-    routine_context.cookie = cookie;
-    routine_context.operations = operations;
-    routine_context.completed_operations = SGL_NULL;
-    routine_context.first_operation = SGL_NULL;
-    if ((pool != SGL_NULL) && (routine != SGL_NULL) && (operations != SGL_NULL)) {
-        operation_count = sgl_queue_get_count(operations);
-        if ((preserve_operations == SGL_TRUE) && (operation_count > 0U)) {
-            completed_operations = sgl_threadpool_create_completed_queue(operations);
-            if (completed_operations == SGL_NULL) {
-                result = SGL_ERROR_MEMORY_ALLOCATION;
-            }
-        }
+    result = sgl_threadpool_attach_routine_internal(
+        pool, routine, operations, cookie, SGL_FALSE);
 
-        if (result == SGL_SUCCESS) {
-            /*
-             * The pool owns the active routine state while workers are running.
-             * attach_routine() returns only after all operations have completed
-             * and no worker still holds the caller's cookie pointer.
-             */
-            sgl_osal_mutex_lock(&pool->lock);
-            while ((pool->has_routine == SGL_TRUE) &&
-                   (pool->is_exit_threadpool == SGL_FALSE)) {
-                sgl_osal_cond_wait(&pool->submitter_cond, &pool->lock);
-            }
-
-            if (pool->is_exit_threadpool == SGL_FALSE) {
-                completion_generation =
-                    sgl_osal_atomic_uint32_load_acquire(
-                        &pool->completion_generation);
-                pool->routine = routine;
-                pool->cookie = cookie;
-                pool->operations = operations;
-                pool->completed_operations = completed_operations;
-                routine_context.completed_operations = completed_operations;
-                if (operation_count > 0U) {
-                    routine_context.first_operation =
-                        sgl_queue_dequeue(operations);
-                }
-                pool->active_workers = (routine_context.first_operation != SGL_NULL)
-                    ? 1U
-                    : 0U;
-                pool->claimed_workers = 0U;
-                pool->worker_limit = 0U;
-                if ((operation_count > 1U) && (pool->num_threads > 1U)) {
-                    pool->worker_limit = operation_count - 1U;
-                    if (pool->worker_limit >= pool->num_threads) {
-                        pool->worker_limit = pool->num_threads - 1U;
-                    }
-                }
-                pool->has_routine = SGL_TRUE;
-                pool->is_done = (pool->active_workers == 0U)
-                    ? SGL_TRUE
-                    : SGL_FALSE;
-                routine_generation =
-                    sgl_osal_atomic_uint32_increment_release(
-                        &pool->routine_generation);
-                SGL_TRACE_THREADPOOL_DISPATCH_BEGIN(
-                    pool,
-                    routine_generation,
-                    operation_count,
-                    pool->worker_limit,
-                    pool->num_threads);
-                if (pool->worker_limit == 1U) {
-                    sgl_osal_cond_signal(&pool->worker_cond);
-                }
-                else if (pool->worker_limit > 1U) {
-                    sgl_osal_cond_broadcast(&pool->worker_cond);
-                }
-                sgl_osal_mutex_unlock(&pool->lock);
+    return result;
+}
 
-                if (routine_context.first_operation != SGL_NULL) {
-                    sgl_threadpool_execute_routine(
-                        &routine_context,
-                        pool,
-                        routine_generation,
-                        SGL_TRACE_ROLE_SUBMITTER);
-                    sgl_threadpool_finish_routine(pool);
-                    sgl_threadpool_spin_until_changed(
-                        &pool->completion_generation,
-                        completion_generation);
-                }
+/* Exactly one of range_routine and scratch_routine is set. */
+static sgl_result_t sgl_threadpool_parallel_for_internal(
+    sgl_threadpool_t *SGL_RESTRICT pool,
+    sgl_int32_t begin,
+    sgl_int32_t end,
+    sgl_int32_t grain,
+    sgl_threadpool_range_routine_t range_routine,
+    sgl_threadpool_scratch_routine_t scratch_routine,
+    void *SGL_RESTRICT cookie)
+{
+    sgl_result_t result = SGL_SUCCESS;
+    sgl_threadpool_task_t task;
+    sgl_threadpool_routine_context_t participant;
+    sgl_threadpool_worker_t *nested;
+    sgl_threadpool_t *shared;
+    sgl_int64_t chunk_count;
 
-                sgl_osal_mutex_lock(&pool->lock);
-                while (pool->is_done == SGL_FALSE) {
-                    SGL_TRACE_THREADPOOL_COMPLETION_WAIT_BEGIN(
-                        pool, routine_generation);
-                    sgl_osal_cond_wait(&pool->submitter_cond, &pool->lock);
-                    SGL_TRACE_THREADPOOL_COMPLETION_WAIT_END(
-                        pool, routine_generation);
-                }
+    chunk_count = 0;
+    shared = sgl_threadpool_shared(pool);
+    if ((pool == SGL_NULL) ||
+        ((range_routine == SGL_NULL) && (scratch_routine == SGL_NULL)) ||
+        (begin > end) || (grain <= 0)) {
+        result = SGL_ERROR_INVALID_ARGUMENTS;
+    }
+    else {
+        chunk_count = (((sgl_int64_t)end - (sgl_int64_t)begin) + grain - 1) / grain;
+        if (chunk_count > (sgl_int64_t)SGL_THREADPOOL_MAX_OPERATIONS) {
+            /* keeps the chunk counter far from wrapping */
+            result = SGL_ERROR_INVALID_ARGUMENTS;
+        }
+    }
 
-                if (completed_operations != SGL_NULL) {
-                    (void)sgl_queue_copy(operations, completed_operations);
-                }
-                SGL_TRACE_THREADPOOL_DISPATCH_END(
-                    pool, routine_generation, operation_count);
-                sgl_threadpool_clear_routine(pool);
-                sgl_osal_cond_broadcast(&pool->submitter_cond);
+    if ((result == SGL_SUCCESS) && (chunk_count > 0)) {
+        (void)sgl_memset(&task, 0, sizeof(task));
+        task.pool = shared;
+        task.priority = pool->priority;
+        task.token = pool->token;
+        task.range_routine = range_routine;
+        task.scratch_routine = scratch_routine;
+        task.cookie = cookie;
+        task.range_begin = begin;
+        task.range_end = end;
+        task.grain = grain;
+        task.node = sgl_threadpool_submitter_node(shared);
+        task.operation_count = (sgl_size_t)chunk_count;
+        participant.task = SGL_NULL;
+        participant.first_operation = SGL_NULL;
+        participant.first_chunk = 0U;
+        participant.deque_index = SGL_THREADPOOL_SUBMITTER_DEQUE;
+        participant.scratch = SGL_NULL;
+        participant.detour_generation = 0U;
+        participant.throughput = SGL_NULL;
+        nested = sgl_threadpool_nested_worker(shared);
+        if (nested != SGL_NULL) {
+            /* a nested caller runs on its worker's core */
+            participant.throughput = &nested->throughput;
+        }
+
+        /* same contract as attach: returns after the last chunk has run */
+        result = sgl_threadpool_publish_task(shared, &task, &participant);
+        if (result == SGL_SUCCESS) {
+            if (participant.task != SGL_NULL) {
+                (void)sgl_threadpool_execute_routine(
+                    &participant, shared, SGL_TRACE_ROLE_SUBMITTER);
+                sgl_threadpool_finish_routine(shared, &participant);
             }
-            else {
-                result = SGL_ERROR_INVALID_ARGUMENTS;
+            sgl_threadpool_wait_task(shared, &task);
+            if (sgl_osal_atomic_uint32_load_relaxed(&task.is_cancelled) != 0U) {
+                result = SGL_THREADPOOL_CANCELLED;
             }
-            sgl_osal_mutex_unlock(&pool->lock);
         }
-
-        sgl_queue_destroy(&completed_operations);
-    }
-    else {
-        result = SGL_ERROR_INVALID_ARGUMENTS;
     }
 
     return result;
 }
 
-sgl_result_t sgl_threadpool_attach_routine(
+sgl_result_t sgl_threadpool_parallel_for(
     sgl_threadpool_t *SGL_RESTRICT pool,
-    sgl_threadpool_routine_t routine,
-    sgl_queue_t *SGL_RESTRICT operations,
+    sgl_int32_t begin,
+    sgl_int32_t end,
+    sgl_int32_t grain,
+    sgl_threadpool_range_routine_t routine,
     void *SGL_RESTRICT cookie)
 {
     sgl_result_t result;
 
-    result = sgl_threadpool_attach_routine_internal(
-        pool, routine, operations, cookie, SGL_TRUE);
+    result = SGL_ERROR_INVALID_ARGUMENTS;
+    if (routine != SGL_NULL) {
+        result = sgl_threadpool_parallel_for_internal(
+            pool, begin, end, grain, routine, SGL_NULL, cookie);
+    }
 
     return result;
 }
 
-sgl_result_t sgl_threadpool_attach_routine_consuming(
+sgl_result_t sgl_threadpool_parallel_for_scratch(
     sgl_threadpool_t *SGL_RESTRICT pool,
-    sgl_threadpool_routine_t routine,
-    sgl_queue_t *SGL_RESTRICT operations,
+    sgl_int32_t begin,
+    sgl_int32_t end,
+    sgl_int32_t grain,
+    sgl_threadpool_scratch_routine_t routine,
     void *SGL_RESTRICT cookie)
 {
     sgl_result_t result;
 
-    result = sgl_threadpool_attach_routine_internal(
-        pool, routine, operations, cookie, SGL_FALSE);
+    result = SGL_ERROR_INVALID_ARGUMENTS;
+    if (routine != SGL_NULL) {
+        result = sgl_threadpool_parallel_for_internal(
+            pool, begin, end, grain, SGL_NULL, routine, cookie);
+    }
 
     return result;
 }
 
 static sgl_osal_thread_return_t sgl_threadpool_routine(sgl_osal_thread_arg_t arg)
 {
-    sgl_threadpool_t *pool = sgl_memory_as_threadpool(arg);
+    sgl_threadpool_worker_t *worker = sgl_threadpool_memory_as_worker(arg);
+    sgl_threadpool_t *pool = worker->pool;
     sgl_threadpool_routine_context_t routine;
-    sgl_uint32_t last_generation;
+    sgl_threadpool_routine_context_t urgent;
 
-    routine.routine = SGL_NULL;
-    routine.cookie = SGL_NULL;
-    routine.operations = SGL_NULL;
-    routine.completed_operations = SGL_NULL;
+    sgl_threadpool_current_worker = worker;
+    sgl_threadpool_current_pool = pool;
+    routine.task = SGL_NULL;
     routine.first_operation = SGL_NULL;
-    last_generation = 0U;
-    while (sgl_threadpool_try_claim_routine(
-               pool,
-               &routine,
-               &last_generation) == SGL_TRUE) {
-        sgl_threadpool_execute_routine(
-            &routine,
-            pool,
-            last_generation,
-            SGL_TRACE_ROLE_WORKER);
-        sgl_threadpool_finish_routine(pool);
+    routine.first_chunk = 0U;
+    routine.deque_index = worker->deque_index;
+    routine.scratch = worker->scratch;
+    routine.detour_generation = 0U;
+    routine.throughput = &worker->throughput;
+    /* a suspended chunk has already reset the arena, so both may share it */
+    urgent = routine;
+    while (sgl_threadpool_try_claim_routine(pool, &routine) == SGL_TRUE) {
+        sgl_threadpool_run_claimed(pool, &routine, &urgent);
     }
 
     EXIT_ROUTINE
@@ -0,0 +1,418 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright (c) 2025 Dylan Hong
+ *
+ * This code is released under the MIT License.
+ * For conditions of distribution and use, see the LICENSE file.
+ */
+#include <sgl-core.h>
+#include "sgl-osal.h"
+
+#define SGL_THREADPOOL_GRAPH_MAX_CHUNKS     ((sgl_size_t)0x7FFFFFFF)
+#define SGL_THREADPOOL_GRAPH_NO_EDGE        (~(sgl_size_t)0)
+#define SGL_THREADPOOL_GRAPH_SPIN_BATCH     (64U)
+
+typedef struct {
+    sgl_size_t upstream;
+    sgl_size_t next;
+    sgl_int32_t num;
+    sgl_int32_t den;
+    sgl_int32_t halo;
+} sgl_threadpool_graph_edge_t;
+
+typedef struct {
+    sgl_threadpool_range_routine_t routine;
+    void *cookie;
+    sgl_int32_t begin;
+    sgl_int32_t end;
+    sgl_int32_t grain;
+    sgl_size_t chunk_count;
+    sgl_size_t first_chunk;
+    sgl_size_t first_edge;
+    sgl_osal_atomic_uint32_t *done;
+    sgl_osal_atomic_int32_t done_prefix;
+} sgl_threadpool_graph_node_t;
+
+struct sgl_threadpool_graph {
+    sgl_threadpool_graph_node_t *nodes;
+    sgl_threadpool_graph_edge_t *edges;
+    sgl_size_t max_nodes;
+    sgl_size_t max_edges;
+    sgl_size_t node_count;
+    sgl_size_t edge_count;
+    sgl_size_t chunk_count;
+    const sgl_threadpool_token_t *token;
+};
+
+/*
+ * Design and Operation
+ * --------------------
+ * Chunks of all nodes are numbered in node order and the whole graph runs
+ * as one parallel_for over those numbers; a claim of several numbers runs
+ * them in order.  Since edges only point forward, every chunk a claimed
+ * chunk depends on has a lower number and was claimed before it, or earlier
+ * in the same claim; the lowest unfinished chunk therefore always has its
+ * inputs, so waiting participants cannot deadlock.
+ *
+ *   node 0 (decode): c0 c1 c2 c3
+ *   node 1 (resize):             c4 c5
+ *                     c4 needs rows of c0 c1, c5 rows of c2 c3
+ *
+ * A participant that claims c4 while c2 and c3 are still running starts as
+ * soon as c0 and c1 are done instead of waiting for the whole stage.
+ *
+ * Every chunk publishes a done flag with release semantics.  done_prefix
+ * records a count of leading chunks known to be done, so a barrier edge
+ * scans the upstream flags once per run rather than once per chunk.
+ *
+ * Once the pool's cancellation token fires, claims are skipped and never
+ * publish their flags, so waiting participants give up instead and every
+ * chunk still to run is skipped too.
+ */
+static SGL_ALWAYS_INLINE sgl_threadpool_graph_t *sgl_threadpool_memory_as_graph(void *memory)
+{
+    sgl_threadpool_graph_t *result;
+
+    /* SGL-MEM-DEV-001: typed conversion from generic storage. */
+    /* cppcheck-suppress misra-c2012-11.5 */
+    result = (sgl_threadpool_graph_t *)memory;
+
+    return result;
+}
+
+static SGL_ALWAYS_INLINE sgl_threadpool_graph_node_t *sgl_threadpool_memory_as_graph_node(void *memory)
+{
+    sgl_threadpool_graph_node_t *result;
+
+    /* SGL-MEM-DEV-001: typed conversion from generic storage. */
+    /* cppcheck-suppress misra-c2012-11.5 */
+    result = (sgl_threadpool_graph_node_t *)memory;
+
+    return result;
+}
+
+static SGL_ALWAYS_INLINE sgl_threadpool_graph_edge_t *sgl_threadpool_memory_as_graph_edge(void *memory)
+{
+    sgl_threadpool_graph_edge_t *result;
+
+    /* SGL-MEM-DEV-001: typed conversion from generic storage. */
+    /* cppcheck-suppress misra-c2012-11.5 */
+    result = (sgl_threadpool_graph_edge_t *)memory;
+
+    return result;
+}
+
+static SGL_ALWAYS_INLINE sgl_osal_atomic_uint32_t *sgl_threadpool_memory_as_flags(void *memory)
+{
+    sgl_osal_atomic_uint32_t *result;
+
+    /* SGL-MEM-DEV-001: typed conversion from generic storage. */
+    /* cppcheck-suppress misra-c2012-11.5 */
+    result = (sgl_osal_atomic_uint32_t *)memory;
+
+    return result;
+}
+
+/* Floor division by a positive divisor. */
+static sgl_int64_t sgl_threadpool_graph_floor_div(sgl_int64_t n, sgl_int64_t d)
+{
+    sgl_int64_t q;
+
+    q = n / d;
+    if (((n % d) != 0) && (n < 0)) {
+        q -= 1;
+    }
+
+    return q;
+}
+
+/*
+ * The node owning global chunk number chunk: the last one starting at or
+ * before it.  An empty node shares first_chunk with its successor, so it is
+ * never the last such node.
+ */
+static const sgl_threadpool_graph_node_t *sgl_threadpool_graph_find_node(
+    const sgl_threadpool_graph_t *graph,
+    sgl_size_t chunk)
+{
+    sgl_size_t low;
+    sgl_size_t high;
+    sgl_size_t middle;
+
+    low = 0U;
+    high = graph->node_count;
+    while ((high - low) > 1U) {
+        middle = low + ((high - low) / 2U);
+        if (graph->nodes[middle].first_chunk <= chunk) {
+            low = middle;
+        }
+        else {
+            high = middle;
+        }
+    }
+
+    return &graph->nodes[low];
+}
+
+static void sgl_threadpool_graph_wait_chunk(
+    const sgl_osal_atomic_uint32_t *done,
+    const sgl_threadpool_token_t *token)
+{
+    sgl_uint32_t iteration;
+    sgl_bool_t is_cancelled;
+
+    is_cancelled = SGL_FALSE;
+    while ((is_cancelled == SGL_FALSE) &&
+           (sgl_osal_atomic_uint32_load_acquire(done) == 0U)) {
+        for (iteration = 0U;
+             (iteration < SGL_THREADPOOL_GRAPH_SPIN_BATCH) &&
+             (sgl_osal_atomic_uint32_load_acquire(done) == 0U);
+             ++iteration) {
+            SGL_CPU_RELAX();
+        }
+        if (sgl_osal_atomic_uint32_load_acquire(done) == 0U) {
+            /* the chunk is running on another participant, or was skipped */
+            sgl_osal_yield_thread();
+            is_cancelled = sgl_threadpool_token_is_cancelled(token);
+        }
+    }
+}
+
+/* Waits until the upstream rows read by downstream rows [begin, end) are done. */
+static void sgl_threadpool_graph_wait_rows(
+    const sgl_threadpool_graph_t *graph,
+    sgl_threadpool_graph_node_t *upstream,
+    const sgl_threadpool_graph_edge_t *edge,
+    sgl_int32_t begin,
+    sgl_int32_t end)
+{
+    sgl_int64_t low;
+    sgl_int64_t high;
+    sgl_int32_t first;
+    sgl_int32_t last;
+    sgl_int32_t chunk;
+    sgl_int32_t prefix;
+
+    low = sgl_threadpool_graph_floor_div((sgl_int64_t)begin * edge->num, edge->den) - edge->halo;
+    high = -sgl_threadpool_graph_floor_div(-((sgl_int64_t)end * edge->num), edge->den) + edge->halo;
+    if (low < upstream->begin) {
+        low = upstream->begin;
+    }
+    if (high > upstream->end) {
+        high = upstream->end;
+    }
+
+    if (low < high) {
+        first = (sgl_int32_t)((low - upstream->begin) / upstream->grain);
+        last = (sgl_int32_t)(((high - upstream->begin) + upstream->grain - 1) / upstream->grain);
+        prefix = sgl_osal_atomic_int32_load_acquire(&upstream->done_prefix);
+        for (chunk = (first > prefix) ? first : prefix; chunk < last; ++chunk) {
+            sgl_threadpool_graph_wait_chunk(&upstream->done[chunk], graph->token);
+        }
+
+        /* chunks below prefix and [first, last) are done: extend the prefix */
+        if (first <= prefix) {
+            while ((prefix < last) &&
+                   (sgl_osal_atomic_int32_compare_exchange(
+                        &upstream->done_prefix, prefix, last) == SGL_FALSE)) {
+                prefix = sgl_osal_atomic_int32_load_acquire(&upstream->done_prefix);
+            }
+        }
+    }
+}
+
+static void sgl_threadpool_graph_chunk(
+    sgl_int32_t begin,
+    sgl_int32_t end,
+    void *SGL_RESTRICT cookie)
+{
+    const sgl_threadpool_graph_t *graph;
+    const sgl_threadpool_graph_node_t *node;
+    const sgl_threadpool_graph_edge_t *edge;
+    sgl_size_t edge_index;
+    sgl_size_t chunk;
+    sgl_size_t index;
+    sgl_int64_t row_begin;
+    sgl_int64_t row_end;
+
+    graph = sgl_threadpool_memory_as_graph(cookie);
+    for (index = (sgl_size_t)begin; index < (sgl_size_t)end; ++index) {
+        node = sgl_threadpool_graph_find_node(graph, index);
+        chunk = index - node->first_chunk;
+        row_begin = (sgl_int64_t)node->begin + ((sgl_int64_t)chunk * node->grain);
+        row_end = row_begin + node->grain;
+        if (row_end > node->end) {
+            row_end = node->end;
+        }
+
+        edge_index = node->first_edge;
+        while (edge_index != SGL_THREADPOOL_GRAPH_NO_EDGE) {
+            edge = &graph->edges[edge_index];
+            sgl_threadpool_graph_wait_rows(
+                graph, &graph->nodes[edge->upstream], edge,
+                (sgl_int32_t)row_begin, (sgl_int32_t)row_end);
+            edge_index = edge->next;
+        }
+
+        if (sgl_threadpool_token_is_cancelled(graph->token) == SGL_FALSE) {
+            node->routine((sgl_int32_t)row_begin, (sgl_int32_t)row_end, node->cookie);
+        }
+        (void)sgl_osal_atomic_uint32_increment_release(&node->done[chunk]);
+    }
+}
+
+sgl_threadpool_graph_t *sgl_threadpool_graph_create(sgl_size_t max_nodes, sgl_size_t max_edges)
+{
+    sgl_threadpool_graph_t *graph = SGL_NULL;
+
+    if (max_nodes > 0U) {
+        graph = sgl_threadpool_memory_as_graph(sgl_calloc(1, sizeof(sgl_threadpool_graph_t)));
+    }
+    if (graph != SGL_NULL) {
+        graph->max_nodes = max_nodes;
+        graph->max_edges = max_edges;
+        graph->nodes = sgl_threadpool_memory_as_graph_node(
+            sgl_calloc(max_nodes, sizeof(sgl_threadpool_graph_node_t)));
+        if (max_edges > 0U) {
+            graph->edges = sgl_threadpool_memory_as_graph_edge(
+                sgl_calloc(max_edges, sizeof(sgl_threadpool_graph_edge_t)));
+        }
+        if ((graph->nodes == SGL_NULL) ||
+            ((max_edges > 0U) && (graph->edges == SGL_NULL))) {
+            (void)sgl_threadpool_graph_destroy(graph);
+            graph = SGL_NULL;
+        }
+    }
+
+    return graph;
+}
+
+sgl_result_t sgl_threadpool_graph_destroy(sgl_threadpool_graph_t *graph)
+{
+    sgl_result_t result = SGL_SUCCESS;
+
+    if (graph != SGL_NULL) {
+        SGL_SAFE_FREE(graph->nodes);
+        SGL_SAFE_FREE(graph->edges);
+        sgl_free(graph);
+    }
+    else {
+        result = SGL_ERROR_INVALID_ARGUMENTS;
+    }
+
+    return result;
+}
+
+sgl_result_t sgl_threadpool_graph_add_node(
+    sgl_threadpool_graph_t *SGL_RESTRICT graph,
+    sgl_int32_t begin,
+    sgl_int32_t end,
+    sgl_int32_t grain,
+    sgl_threadpool_range_routine_t routine,
+    void *SGL_RESTRICT cookie,
+    sgl_size_t *SGL_RESTRICT node)
+{
+    sgl_result_t result = SGL_SUCCESS;
+    sgl_threadpool_graph_node_t *entry;
+    sgl_int64_t chunk_count;
+
+    chunk_count = 0;
+    if ((graph == SGL_NULL) || (routine == SGL_NULL) || (node == SGL_NULL) ||
+        (begin > end) || (grain <= 0) || (graph->node_count >= graph->max_nodes)) {
+        result = SGL_ERROR_INVALID_ARGUMENTS;
+    }
+    else {
+        chunk_count = (((sgl_int64_t)end - (sgl_int64_t)begin) + grain - 1) / grain;
+        if ((sgl_size_t)chunk_count > (SGL_THREADPOOL_GRAPH_MAX_CHUNKS - graph->chunk_count)) {
+            /* the whole graph runs as one parallel_for */
+            result = SGL_ERROR_INVALID_ARGUMENTS;
+        }
+    }
+
+    if (result == SGL_SUCCESS) {
+        entry = &graph->nodes[graph->node_count];
+        entry->routine = routine;
+        entry->cookie = cookie;
+        entry->begin = begin;
+        entry->end = end;
+        entry->grain = grain;
+        entry->chunk_count = (sgl_size_t)chunk_count;
+        entry->first_chunk = graph->chunk_count;
+        entry->first_edge = SGL_THREADPOOL_GRAPH_NO_EDGE;
+        entry->done = SGL_NULL;
+        entry->done_prefix = 0;
+        graph->chunk_count += (sgl_size_t)chunk_count;
+        *node = graph->node_count;
+        graph->node_count++;
+    }
+
+    return result;
+}
+
+sgl_result_t sgl_threadpool_graph_add_edge(
+    sgl_threadpool_graph_t *graph,
+    sgl_size_t upstream,
+    sgl_size_t downstream,
+    sgl_int32_t num,
+    sgl_int32_t den,
+    sgl_int32_t halo)
+{
+    sgl_result_t result = SGL_SUCCESS;
+    sgl_threadpool_graph_edge_t *edge;
+
+    if ((graph == SGL_NULL) || (graph->edge_count >= graph->max_edges) ||
+        (upstream >= downstream) || (downstream >= graph->node_count) ||
+        (num < 0) || (den <= 0) || (halo < 0)) {
+        result = SGL_ERROR_INVALID_ARGUMENTS;
+    }
+    else {
+        edge = &graph->edges[graph->edge_count];
+        edge->upstream = upstream;
+        edge->num = num;
+        edge->den = den;
+        edge->halo = halo;
+        edge->next = graph->nodes[downstream].first_edge;
+        graph->nodes[downstream].first_edge = graph->edge_count;
+        graph->edge_count++;
+    }
+
+    return result;
+}
+
+sgl_result_t sgl_threadpool_graph_run(
+    sgl_threadpool_t *SGL_RESTRICT pool,
+    sgl_threadpool_graph_t *SGL_RESTRICT graph)
+{
+    sgl_result_t result = SGL_SUCCESS;
+    sgl_osal_atomic_uint32_t *done = SGL_NULL;
+    sgl_size_t i;
+
+    if ((pool == SGL_NULL) || (graph == SGL_NULL)) {
+        result = SGL_ERROR_INVALID_ARGUMENTS;
+    }
+    else if (graph->chunk_count > 0U) {
+        done = sgl_threadpool_memory_as_flags(
+            sgl_calloc(graph->chunk_count, sizeof(sgl_osal_atomic_uint32_t)));
+        if (done == SGL_NULL) {
+            result = SGL_ERROR_MEMORY_ALLOCATION;
+        }
+    }
+    else {
+        /* nothing to run */
+    }
+
+    if (done != SGL_NULL) {
+        for (i = 0U; i < graph->node_count; ++i) {
+            graph->nodes[i].done = &done[graph->nodes[i].first_chunk];
+            graph->nodes[i].done_prefix = 0;
+        }
+        graph->token = sgl_threadpool_get_token(pool);
+        result = sgl_threadpool_parallel_for(
+            pool, 0, (sgl_int32_t)graph->chunk_count, 1,
+            sgl_threadpool_graph_chunk, graph);
+        sgl_free(done);
+    }
+
+    return result;
+}
@@ -0,0 +1,251 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright (c) 2025 Dylan Hong
+ *
+ * This code is released under the MIT License.
+ * For conditions of distribution and use, see the LICENSE file.
+ */
+#include <sgl-core.h>
+#include "sgl-osal.h"
+#include "threadpool_placement.h"
+
+typedef struct {
+    sgl_int32_t cpu;
+    sgl_int32_t node;
+    sgl_int32_t key;
+} sgl_threadpool_candidate_t;
+
+static SGL_ALWAYS_INLINE sgl_threadpool_candidate_t *sgl_threadpool_memory_as_candidate(void *memory)
+{
+    sgl_threadpool_candidate_t *result;
+
+    /* SGL-MEM-DEV-001: typed conversion from generic storage. */
+    /* cppcheck-suppress misra-c2012-11.5 */
+    result = (sgl_threadpool_candidate_t *)memory;
+
+    return result;
+}
+
+static SGL_ALWAYS_INLINE sgl_bool_t sgl_threadpool_cpu_set_has(
+    const sgl_threadpool_cpu_set_t *set,
+    sgl_int32_t cpu)
+{
+    sgl_bool_t result = SGL_FALSE;
+
+    if (((set->bits[cpu / 64] >> (sgl_uint32_t)(cpu % 64)) & 1U) != 0U) {
+        result = SGL_TRUE;
+    }
+
+    return result;
+}
+
+static SGL_ALWAYS_INLINE void sgl_threadpool_cpu_set_add(
+    sgl_threadpool_cpu_set_t *set,
+    sgl_int32_t cpu)
+{
+    set->bits[cpu / 64] |= (sgl_uint64_t)1U << (sgl_uint32_t)(cpu % 64);
+}
+
+static sgl_bool_t sgl_threadpool_cpu_set_is_empty(const sgl_threadpool_cpu_set_t *set)
+{
+    sgl_bool_t result = SGL_TRUE;
+    sgl_int32_t i;
+
+    for (i = 0; i < SGL_THREADPOOL_CPU_SET_WORDS; ++i) {
+        if (set->bits[i] != 0U) {
+            result = SGL_FALSE;
+        }
+    }
+
+    return result;
+}
+
+/* Stable insertion sort; candidate lists are a few hundred entries at most. */
+static void sgl_threadpool_sort_candidates(
+    sgl_threadpool_candidate_t *candidates,
+    sgl_int32_t count)
+{
+    sgl_threadpool_candidate_t current;
+    sgl_int32_t i;
+    sgl_int32_t j;
+
+    for (i = 1; i < count; ++i) {
+        current = candidates[i];
+        for (j = i; (j > 0) && (candidates[j - 1].key > current.key); --j) {
+            candidates[j] = candidates[j - 1];
+        }
+        candidates[j] = current;
+    }
+}
+
+/*
+ * Collects the CPUs the creating thread may use, on numa_node only when it
+ * is not negative, and orders them for the placement policy.
+ *
+ *   nodes:    node 0: c0 c1 c2   node 1: c3 c4 c5
+ *   COMPACT:  c0 c1 c2 c3 c4 c5          (node, cpu)
+ *   SCATTER:  c0 c3 c1 c4 c2 c5          (rank within node, node)
+ */
+static sgl_int32_t sgl_threadpool_collect_candidates(
+    const sgl_threadpool_options_t *options,
+    const sgl_threadpool_cpu_set_t *allowed,
+    sgl_threadpool_candidate_t *candidates)
+{
+    sgl_int32_t count;
+    sgl_int32_t cpu;
+    sgl_int32_t node;
+    sgl_int32_t rank;
+    sgl_int32_t i;
+
+    count = 0;
+    for (cpu = 0; cpu < SGL_THREADPOOL_MAX_CPUS; ++cpu) {
+        if (sgl_threadpool_cpu_set_has(allowed, cpu) == SGL_TRUE) {
+            node = sgl_osal_get_cpu_numa_node(cpu);
+            if ((options->numa_node < 0) || (node == options->numa_node)) {
+                candidates[count].cpu = cpu;
+                candidates[count].node = node;
+                candidates[count].key = (node * SGL_THREADPOOL_MAX_CPUS) + cpu;
+                count++;
+            }
+        }
+    }
+
+    sgl_threadpool_sort_candidates(candidates, count);
+    if (options->placement == SGL_THREADPOOL_PLACEMENT_SCATTER) {
+        rank = 0;
+        for (i = 0; i < count; ++i) {
+            if ((i > 0) && (candidates[i].node == candidates[i - 1].node)) {
+                rank++;
+            }
+            else {
+                rank = 0;
+            }
+            candidates[i].key = (rank * (SGL_OSAL_MAX_NUMA_NODES + 1)) +
+                                (candidates[i].node + 1);
+        }
+        sgl_threadpool_sort_candidates(candidates, count);
+    }
+
+    return count;
+}
+
+static sgl_result_t sgl_threadpool_plan_from_candidates(
+    const sgl_threadpool_options_t *options,
+    sgl_size_t num_workers,
+    sgl_threadpool_cpu_set_t *sets)
+{
+    sgl_result_t result = SGL_SUCCESS;
+    sgl_threadpool_cpu_set_t allowed;
+    sgl_threadpool_candidate_t *candidates;
+    sgl_int32_t count;
+    sgl_int32_t i;
+    sgl_size_t worker;
+
+    candidates = sgl_threadpool_memory_as_candidate(sgl_malloc(
+        sizeof(sgl_threadpool_candidate_t) * (sgl_size_t)SGL_THREADPOOL_MAX_CPUS));
+    if (candidates == SGL_NULL) {
+        result = SGL_ERROR_MEMORY_ALLOCATION;
+    }
+    else if (sgl_osal_thread_get_affinity(
+                 allowed.bits, SGL_THREADPOOL_CPU_SET_WORDS) == SGL_FALSE) {
+        result = SGL_ERROR_NOT_SUPPORTED;
+    }
+    else {
+        count = sgl_threadpool_collect_candidates(options, &allowed, candidates);
+        if (count == 0) {
+            /* numa_node has no CPU this thread may use */
+            result = SGL_ERROR_INVALID_ARGUMENTS;
+        }
+    }
+
+    if (result == SGL_SUCCESS) {
+        (void)sgl_memset(sets, 0, sizeof(sgl_threadpool_cpu_set_t) * num_workers);
+        for (worker = 0U; worker < num_workers; ++worker) {
+            if (options->placement == SGL_THREADPOOL_PLACEMENT_NONE) {
+                /* node binding only: the whole node for every worker */
+                for (i = 0; i < count; ++i) {
+                    sgl_threadpool_cpu_set_add(&sets[worker], candidates[i].cpu);
+                }
+            }
+            else {
+                sgl_threadpool_cpu_set_add(
+                    &sets[worker], candidates[worker % (sgl_size_t)count].cpu);
+            }
+        }
+    }
+    SGL_SAFE_FREE(candidates);
+
+    return result;
+}
+
+sgl_result_t sgl_threadpool_plan_placement(
+    const sgl_threadpool_options_t *options,
+    sgl_size_t num_workers,
+    sgl_threadpool_cpu_set_t *sets,
+    sgl_bool_t *is_pinned)
+{
+    sgl_result_t result = SGL_SUCCESS;
+    sgl_size_t worker;
+
+    *is_pinned = SGL_FALSE;
+    if (options->placement == SGL_THREADPOOL_PLACEMENT_EXPLICIT) {
+        if (options->cpu_sets == SGL_NULL) {
+            result = SGL_ERROR_INVALID_ARGUMENTS;
+        }
+        for (worker = 0U;
+             (result == SGL_SUCCESS) && (worker < num_workers);
+             ++worker) {
+            if (sgl_threadpool_cpu_set_is_empty(&options->cpu_sets[worker]) == SGL_TRUE) {
+                result = SGL_ERROR_INVALID_ARGUMENTS;
+            }
+            else {
+                sets[worker] = options->cpu_sets[worker];
+            }
+        }
+        *is_pinned = (result == SGL_SUCCESS) ? SGL_TRUE : SGL_FALSE;
+    }
+    else if ((options->placement == SGL_THREADPOOL_PLACEMENT_NONE) &&
+             (options->numa_node < 0)) {
+        /* inherit the creator's affinity */
+    }
+    else if ((options->placement == SGL_THREADPOOL_PLACEMENT_NONE) ||
+             (options->placement == SGL_THREADPOOL_PLACEMENT_COMPACT) ||
+             (options->placement == SGL_THREADPOOL_PLACEMENT_SCATTER)) {
+        result = sgl_threadpool_plan_from_candidates(options, num_workers, sets);
+        *is_pinned = (result == SGL_SUCCESS) ? SGL_TRUE : SGL_FALSE;
+    }
+    else {
+        result = SGL_ERROR_INVALID_ARGUMENTS;
+    }
+
+    return result;
+}
+
+sgl_int32_t sgl_threadpool_cpu_set_node(const sgl_threadpool_cpu_set_t *set)
+{
+    sgl_int32_t node;
+    sgl_int32_t cpu_node;
+    sgl_int32_t cpu;
+    sgl_bool_t is_first;
+
+    node = -1;
+    is_first = SGL_TRUE;
+    for (cpu = 0; cpu < SGL_THREADPOOL_MAX_CPUS; ++cpu) {
+        if (sgl_threadpool_cpu_set_has(set, cpu) == SGL_TRUE) {
+            cpu_node = sgl_osal_get_cpu_numa_node(cpu);
+            if (is_first == SGL_TRUE) {
+                node = cpu_node;
+                is_first = SGL_FALSE;
+            }
+            else if (cpu_node != node) {
+                node = -1;
+            }
+            else {
+                /* same node */
+            }
+        }
+    }
+
+    return node;
+}
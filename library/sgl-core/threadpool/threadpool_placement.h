@@ -0,0 +1,28 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright (c) 2025 Dylan Hong
+ *
+ * This code is released under the MIT License.
+ * For conditions of distribution and use, see the LICENSE file.
+ */
+#ifndef SGL_THREADPOOL_PLACEMENT_H_
+#define SGL_THREADPOOL_PLACEMENT_H_
+
+#include <sgl-core.h>
+
+/*
+ * Computes the CPU set of each of num_workers workers into sets.
+ * *is_pinned is SGL_FALSE when the workers simply inherit the creating
+ * thread's affinity and sets is left untouched.
+ */
+sgl_result_t sgl_threadpool_plan_placement(
+    const sgl_threadpool_options_t *options,
+    sgl_size_t num_workers,
+    sgl_threadpool_cpu_set_t *sets,
+    sgl_bool_t *is_pinned);
+
+/* NUMA node shared by every CPU of set, or -1 when they span several. */
+sgl_int32_t sgl_threadpool_cpu_set_node(const sgl_threadpool_cpu_set_t *set);
+
+#endif  /* !SGL_THREADPOOL_PLACEMENT_H_ */
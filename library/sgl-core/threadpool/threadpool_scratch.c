@@ -0,0 +1,127 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright (c) 2025 Dylan Hong
+ *
+ * This code is released under the MIT License.
+ * For conditions of distribution and use, see the LICENSE file.
+ */
+#include <sgl-core.h>
+#include <sgl_memory_cast.h>
+#include "threadpool_scratch.h"
+
+#define SGL_THREADPOOL_SCRATCH_ALIGN_UP(size) \
+    (((size) + SGL_THREADPOOL_SCRATCH_ALIGNMENT - 1U) & \
+     ~(SGL_THREADPOOL_SCRATCH_ALIGNMENT - 1U))
+#define SGL_THREADPOOL_SCRATCH_MAX_SIZE     (SGL_SIZE_MAX / 4U)
+
+/* Offset of the first cache-line boundary at or after raw. */
+static sgl_size_t sgl_threadpool_scratch_padding(const sgl_uint8_t *raw)
+{
+    sgl_uintptr_t address;
+
+    /* SGL-MEM-DEV-001: the address is only inspected for its alignment. */
+    /* cppcheck-suppress misra-c2012-11.4 */
+    address = (sgl_uintptr_t)raw;
+
+    return (sgl_size_t)((SGL_THREADPOOL_SCRATCH_ALIGNMENT -
+                         (address & (SGL_THREADPOOL_SCRATCH_ALIGNMENT - 1U))) &
+                        (SGL_THREADPOOL_SCRATCH_ALIGNMENT - 1U));
+}
+
+/*
+ * Overflow blocks chain through their first word:
+ *
+ *   raw: [next][pad ...][size bytes, cache-line aligned]
+ */
+static void *sgl_threadpool_scratch_overflow(
+    sgl_threadpool_scratch_t *scratch,
+    sgl_size_t size)
+{
+    sgl_uint8_t *raw;
+    void *result;
+
+    result = SGL_NULL;
+    raw = sgl_memory_as_uint8(sgl_malloc(
+        sizeof(void *) + SGL_THREADPOOL_SCRATCH_ALIGNMENT + size));
+    if (raw != SGL_NULL) {
+        sgl_memory_as_void_ptr_array(raw)[0] = scratch->overflow;
+        scratch->overflow = raw;
+        result = &raw[sizeof(void *) + sgl_threadpool_scratch_padding(&raw[sizeof(void *)])];
+    }
+
+    return result;
+}
+
+static void sgl_threadpool_scratch_free_overflow(sgl_threadpool_scratch_t *scratch)
+{
+    void *block;
+
+    while (scratch->overflow != SGL_NULL) {
+        block = scratch->overflow;
+        scratch->overflow = sgl_memory_as_void_ptr_array(block)[0];
+        sgl_free(block);
+    }
+}
+
+void sgl_threadpool_scratch_init(sgl_threadpool_scratch_t *scratch)
+{
+    scratch->raw = SGL_NULL;
+    scratch->base = SGL_NULL;
+    scratch->capacity = 0U;
+    scratch->used = 0U;
+    scratch->demand = 0U;
+    scratch->overflow = SGL_NULL;
+}
+
+void *sgl_threadpool_scratch_alloc(sgl_threadpool_scratch_t *scratch, sgl_size_t size)
+{
+    void *result = SGL_NULL;
+    sgl_size_t aligned;
+
+    if ((scratch != SGL_NULL) && (size > 0U) &&
+        (size <= SGL_THREADPOOL_SCRATCH_MAX_SIZE) &&
+        (scratch->demand <= SGL_THREADPOOL_SCRATCH_MAX_SIZE)) {
+        aligned = SGL_THREADPOOL_SCRATCH_ALIGN_UP(size);
+        scratch->demand += aligned;
+        if (aligned <= (scratch->capacity - scratch->used)) {
+            result = &scratch->base[scratch->used];
+            scratch->used += aligned;
+        }
+        else {
+            /* earlier pointers of this chunk stay valid; base grows at reset */
+            result = sgl_threadpool_scratch_overflow(scratch, aligned);
+        }
+    }
+
+    return result;
+}
+
+void sgl_threadpool_scratch_reset(sgl_threadpool_scratch_t *scratch)
+{
+    if (scratch->demand != 0U) {
+        sgl_threadpool_scratch_free_overflow(scratch);
+
+        if ((scratch->demand > scratch->capacity) &&
+            (scratch->demand <= SGL_THREADPOOL_SCRATCH_MAX_SIZE)) {
+            SGL_SAFE_FREE(scratch->raw);
+            scratch->base = SGL_NULL;
+            scratch->capacity = 0U;
+            scratch->raw = sgl_memory_as_uint8(sgl_malloc(
+                scratch->demand + SGL_THREADPOOL_SCRATCH_ALIGNMENT));
+            if (scratch->raw != SGL_NULL) {
+                scratch->base = &scratch->raw[sgl_threadpool_scratch_padding(scratch->raw)];
+                scratch->capacity = scratch->demand;
+            }
+        }
+        scratch->used = 0U;
+        scratch->demand = 0U;
+    }
+}
+
+void sgl_threadpool_scratch_release(sgl_threadpool_scratch_t *scratch)
+{
+    sgl_threadpool_scratch_free_overflow(scratch);
+    SGL_SAFE_FREE(scratch->raw);
+    sgl_threadpool_scratch_init(scratch);
+}
@@ -0,0 +1,38 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright (c) 2025 Dylan Hong
+ *
+ * This code is released under the MIT License.
+ * For conditions of distribution and use, see the LICENSE file.
+ */
+#ifndef SGL_THREADPOOL_SCRATCH_H_
+#define SGL_THREADPOOL_SCRATCH_H_
+
+#include <sgl-core.h>
+
+#define SGL_THREADPOOL_SCRATCH_ALIGNMENT    (64U)
+
+/*
+ * Bump arena owned by one participant.  base is carved from raw at a
+ * cache-line boundary; requests that do not fit go to overflow blocks, which
+ * live until the next reset.  demand is what the current chunk asked for in
+ * total, and the next reset grows base to it.
+ */
+struct sgl_threadpool_scratch {
+    sgl_uint8_t *raw;
+    sgl_uint8_t *base;
+    sgl_size_t capacity;
+    sgl_size_t used;
+    sgl_size_t demand;
+    void *overflow;
+};
+
+void sgl_threadpool_scratch_init(sgl_threadpool_scratch_t *scratch);
+
+/* Ends a chunk: releases overflow blocks and grows base to the chunk's demand. */
+void sgl_threadpool_scratch_reset(sgl_threadpool_scratch_t *scratch);
+
+void sgl_threadpool_scratch_release(sgl_threadpool_scratch_t *scratch);
+
+#endif  /* !SGL_THREADPOOL_SCRATCH_H_ */
@@ -0,0 +1,481 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright (c) 2025 Dylan Hong
+ *
+ * This code is released under the MIT License.
+ * For conditions of distribution and use, see the LICENSE file.
+ */
+#include <sgl-core.h>
+#include "warp.h"
+
+#if defined(SGL_CFG_HAS_THREAD)
+static void sgl_warp_routine(sgl_int32_t begin, sgl_int32_t end, void *SGL_RESTRICT cookie);
+#endif  /* !SGL_CFG_HAS_THREAD */
+
+static SGL_ALWAYS_INLINE void sgl_generic_warp_span_fixed(
+    const sgl_warp_span_t *span,
+    sgl_int32_t bpp)
+{
+    const sgl_uint8_t *s00;
+    const sgl_uint8_t *s10;
+    sgl_uint8_t *dst;
+    sgl_int64_t x;
+    sgl_int64_t y;
+    sgl_int32_t wx;
+    sgl_int32_t wy;
+    sgl_int32_t i;
+    sgl_int32_t ch;
+
+    dst = span->dst;
+    x = span->x;
+    y = span->y;
+    for (i = 0; i < span->count; ++i) {
+        wx = (sgl_int32_t)(x >> SGL_WARP_WEIGHT_SHIFT) & SGL_WARP_WEIGHT_MASK;
+        wy = (sgl_int32_t)(y >> SGL_WARP_WEIGHT_SHIFT) & SGL_WARP_WEIGHT_MASK;
+        s00 = &span->src[((sgl_ptrdiff_t)(y >> SGL_WARP_FRAC_BITS) * span->src_stride) +
+                         ((sgl_ptrdiff_t)(x >> SGL_WARP_FRAC_BITS) * bpp)];
+        s10 = &s00[span->src_stride];
+        for (ch = 0; ch < bpp; ++ch) {
+            dst[ch] = sgl_warp_blend(
+                (sgl_int32_t)s00[ch], (sgl_int32_t)s00[ch + bpp],
+                (sgl_int32_t)s10[ch], (sgl_int32_t)s10[ch + bpp],
+                wx, wy);
+        }
+        dst = &dst[bpp];
+        x += span->dx;
+        y += span->dy;
+    }
+}
+
+void sgl_generic_warp_span(const sgl_warp_span_t *span)
+{
+    switch (span->bpp) {
+    case SGL_BPP8:
+        sgl_generic_warp_span_fixed(span, SGL_BPP8);
+        break;
+    case SGL_BPP16:
+        sgl_generic_warp_span_fixed(span, SGL_BPP16);
+        break;
+    case SGL_BPP24:
+        sgl_generic_warp_span_fixed(span, SGL_BPP24);
+        break;
+    case SGL_BPP32:
+        sgl_generic_warp_span_fixed(span, SGL_BPP32);
+        break;
+    default:
+        sgl_generic_warp_span_fixed(span, span->bpp);
+        break;
+    }
+}
+
+/* Nearest samples: positions carry the half-pixel offset, so floor picks the closest pixel. */
+static SGL_ALWAYS_INLINE void sgl_generic_warp_span_nearest_fixed(
+    const sgl_warp_span_t *span,
+    sgl_int32_t bpp)
+{
+    const sgl_uint8_t *s;
+    sgl_uint8_t *dst;
+    sgl_int64_t x;
+    sgl_int64_t y;
+    sgl_int32_t i;
+    sgl_int32_t ch;
+
+    dst = span->dst;
+    x = span->x;
+    y = span->y;
+    for (i = 0; i < span->count; ++i) {
+        s = &span->src[((sgl_ptrdiff_t)(y >> SGL_WARP_FRAC_BITS) * span->src_stride) +
+                       ((sgl_ptrdiff_t)(x >> SGL_WARP_FRAC_BITS) * bpp)];
+        for (ch = 0; ch < bpp; ++ch) {
+            dst[ch] = s[ch];
+        }
+        dst = &dst[bpp];
+        x += span->dx;
+        y += span->dy;
+    }
+}
+
+void sgl_generic_warp_span_nearest(const sgl_warp_span_t *span)
+{
+    switch (span->bpp) {
+    case SGL_BPP8:
+        sgl_generic_warp_span_nearest_fixed(span, SGL_BPP8);
+        break;
+    case SGL_BPP16:
+        sgl_generic_warp_span_nearest_fixed(span, SGL_BPP16);
+        break;
+    case SGL_BPP24:
+        sgl_generic_warp_span_nearest_fixed(span, SGL_BPP24);
+        break;
+    case SGL_BPP32:
+        sgl_generic_warp_span_nearest_fixed(span, SGL_BPP32);
+        break;
+    default:
+        sgl_generic_warp_span_nearest_fixed(span, span->bpp);
+        break;
+    }
+}
+
+sgl_warp_span_kernel_t sgl_warp_select_span_kernel(
+    sgl_int32_t bpp,
+    sgl_warp_sampling_t sampling)
+{
+    sgl_warp_span_kernel_t kernel;
+
+    kernel = SGL_NULL;
+#if defined(SGL_WARP_HAS_SIMD_KERNELS)
+    kernel = sgl_simd_warp_span_kernel(bpp, sampling);
+#else
+    SGL_UNUSED_PARAM(bpp);
+#endif  /* !SGL_WARP_HAS_SIMD_KERNELS */
+    if (kernel != SGL_NULL) {
+        /* accelerated kernel */
+    }
+    else if (sampling == SGL_WARP_SAMPLING_NEAREST) {
+        kernel = sgl_generic_warp_span_nearest;
+    }
+    else {
+        kernel = sgl_generic_warp_span;
+    }
+
+    return kernel;
+}
+
+/*
+ * Narrows [*first, *last) to the pixels i with lo <= p + i * a < hi.  The
+ * bounds are solved exactly in integers, so the run contains precisely the
+ * positions the kernel will step through.
+ */
+static void sgl_warp_clip_axis(
+    sgl_int64_t p,
+    sgl_int64_t a,
+    sgl_int64_t lo,
+    sgl_int64_t hi,
+    sgl_int64_t *first,
+    sgl_int64_t *last)
+{
+    sgl_int64_t begin;
+    sgl_int64_t end;
+
+    if (a > 0) {
+        begin = -sgl_warp_floor_div(p - lo, a);
+        end = -sgl_warp_floor_div(p - hi, a);
+    }
+    else if (a < 0) {
+        begin = sgl_warp_floor_div(p - hi, -a) + 1;
+        end = sgl_warp_floor_div(p - lo, -a) + 1;
+    }
+    else if ((p >= lo) && (p < hi)) {
+        begin = *first;
+        end = *last;
+    }
+    else {
+        begin = *first;
+        end = *first;
+    }
+
+    /* keep first <= last inside the incoming range, even for an empty run */
+    if (begin < *first) {
+        begin = *first;
+    }
+    if (begin > *last) {
+        begin = *last;
+    }
+    if (end > *last) {
+        end = *last;
+    }
+    if (end < begin) {
+        end = begin;
+    }
+    *first = begin;
+    *last = end;
+}
+
+/*
+ * Pixels outside the interior run.  Bilinear samples on the last row or
+ * column clamp the missing neighbor; samples outside the source, and every
+ * nearest sample that reaches this path, take the border value.
+ */
+static void sgl_warp_edge_pixel(
+    const sgl_warp_data_t *data,
+    sgl_uint8_t *SGL_RESTRICT dst,
+    sgl_int64_t x,
+    sgl_int64_t y)
+{
+    const sgl_uint8_t *s00;
+    const sgl_uint8_t *s01;
+    const sgl_uint8_t *s10;
+    const sgl_uint8_t *s11;
+    sgl_int32_t x0;
+    sgl_int32_t y0;
+    sgl_int32_t x1;
+    sgl_int32_t y1;
+    sgl_int32_t wx;
+    sgl_int32_t wy;
+    sgl_int32_t ch;
+
+    if ((data->sampling == SGL_WARP_SAMPLING_NEAREST) || (x < 0) || (y < 0) ||
+        (x > ((sgl_int64_t)(data->s_width - 1) << SGL_WARP_FRAC_BITS)) ||
+        (y > ((sgl_int64_t)(data->s_height - 1) << SGL_WARP_FRAC_BITS))) {
+        for (ch = 0; ch < data->bpp; ++ch) {
+            dst[ch] = data->border;
+        }
+    }
+    else {
+        x0 = (sgl_int32_t)(x >> SGL_WARP_FRAC_BITS);
+        y0 = (sgl_int32_t)(y >> SGL_WARP_FRAC_BITS);
+        x1 = (x0 < (data->s_width - 1)) ? (x0 + 1) : x0;
+        y1 = (y0 < (data->s_height - 1)) ? (y0 + 1) : y0;
+        wx = (sgl_int32_t)(x >> SGL_WARP_WEIGHT_SHIFT) & SGL_WARP_WEIGHT_MASK;
+        wy = (sgl_int32_t)(y >> SGL_WARP_WEIGHT_SHIFT) & SGL_WARP_WEIGHT_MASK;
+        s00 = &data->src[((sgl_ptrdiff_t)y0 * data->src_stride) + ((sgl_ptrdiff_t)x0 * data->bpp)];
+        s01 = &data->src[((sgl_ptrdiff_t)y0 * data->src_stride) + ((sgl_ptrdiff_t)x1 * data->bpp)];
+        s10 = &data->src[((sgl_ptrdiff_t)y1 * data->src_stride) + ((sgl_ptrdiff_t)x0 * data->bpp)];
+        s11 = &data->src[((sgl_ptrdiff_t)y1 * data->src_stride) + ((sgl_ptrdiff_t)x1 * data->bpp)];
+        for (ch = 0; ch < data->bpp; ++ch) {
+            dst[ch] = sgl_warp_blend(
+                (sgl_int32_t)s00[ch], (sgl_int32_t)s01[ch],
+                (sgl_int32_t)s10[ch], (sgl_int32_t)s11[ch],
+                wx, wy);
+        }
+    }
+}
+
+void sgl_warp_affine_segment(
+    const sgl_warp_data_t *data,
+    sgl_uint8_t *SGL_RESTRICT dst_row,
+    sgl_int32_t start,
+    sgl_int32_t end,
+    sgl_int64_t x,
+    sgl_int64_t y,
+    sgl_int64_t dx,
+    sgl_int64_t dy)
+{
+    sgl_warp_span_t span;
+    sgl_int64_t first;
+    sgl_int64_t last;
+    sgl_int64_t i;
+    sgl_int64_t x_limit;
+    sgl_int64_t y_limit;
+
+    if (data->sampling == SGL_WARP_SAMPLING_NEAREST) {
+        /* interior: the rounded position lies inside the source */
+        x += SGL_WARP_HALF;
+        y += SGL_WARP_HALF;
+        x_limit = (sgl_int64_t)data->s_width << SGL_WARP_FRAC_BITS;
+        y_limit = (sgl_int64_t)data->s_height << SGL_WARP_FRAC_BITS;
+    }
+    else {
+        /* interior: both bilinear neighbors exist, so x < w - 1 and y < h - 1 */
+        x_limit = (sgl_int64_t)(data->s_width - 1) << SGL_WARP_FRAC_BITS;
+        y_limit = (sgl_int64_t)(data->s_height - 1) << SGL_WARP_FRAC_BITS;
+    }
+    first = 0;
+    last = (sgl_int64_t)end - (sgl_int64_t)start;
+    sgl_warp_clip_axis(x, dx, 0, x_limit, &first, &last);
+    sgl_warp_clip_axis(y, dy, 0, y_limit, &first, &last);
+
+    for (i = 0; i < first; ++i) {
+        sgl_warp_edge_pixel(
+            data, &dst_row[(start + i) * data->bpp], x + (i * dx), y + (i * dy));
+    }
+    if (last > first) {
+        span.dst = &dst_row[(start + first) * data->bpp];
+        span.src = data->src;
+        span.src_stride = data->src_stride;
+        span.bpp = data->bpp;
+        span.x = x + (first * dx);
+        span.y = y + (first * dy);
+        span.dx = dx;
+        span.dy = dy;
+        span.count = (sgl_int32_t)(last - first);
+        data->span(&span);
+    }
+    for (i = last; i < ((sgl_int64_t)end - (sgl_int64_t)start); ++i) {
+        sgl_warp_edge_pixel(
+            data, &dst_row[(start + i) * data->bpp], x + (i * dx), y + (i * dy));
+    }
+}
+
+/*
+ * Design and Operation
+ * --------------------
+ * The matrix maps destination pixels back to the source.  Along a row the
+ * source position moves by the first matrix column, so a row is one affine
+ * segment: no per-pixel matrix multiply, only two 64-bit adds.
+ *
+ *   row r:  p(i) = M * (i, r, 1) = p(0) + i * (m0, m3)
+ *
+ *   |<- edge ->|<------------ interior run ------------>|<- edge ->|
+ *    border or    branch-free span kernel (SIMD)          border or
+ *    clamped                                              clamped
+ *
+ * The interior run is solved per row from the exact fixed-point positions,
+ * so the span kernel never tests bounds.
+ */
+void sgl_warp_affine_range(
+    const sgl_warp_data_t *data,
+    sgl_int32_t start_row,
+    sgl_int32_t row_count)
+{
+    sgl_int32_t row;
+
+    for (row = start_row; row < (start_row + row_count); ++row) {
+        sgl_warp_affine_segment(
+            data,
+            &data->dst[(sgl_ptrdiff_t)row * data->dst_stride],
+            0,
+            data->d_width,
+            (data->matrix[1] * row) + data->matrix[2],
+            (data->matrix[4] * row) + data->matrix[5],
+            data->matrix[0],
+            data->matrix[3]);
+    }
+}
+
+sgl_int32_t sgl_warp_count_errors(
+    const sgl_uint8_t *dst,
+    sgl_int32_t d_width,
+    sgl_int32_t d_height,
+    const sgl_uint8_t *src,
+    sgl_int32_t s_width,
+    sgl_int32_t s_height,
+    sgl_int32_t bpp,
+    const sgl_int32_t *matrix)
+{
+    sgl_int32_t errcnt;
+
+    errcnt = 0;
+
+    /* check buffer address */
+    if ((dst == SGL_NULL) || (src == SGL_NULL) || (matrix == SGL_NULL) || (dst == src)) {
+        errcnt += 1;
+    }
+
+    /* check boundary */
+    if ((d_width <= 0) || (d_height <= 0) || (s_width <= 0) || (s_height <= 0)) {
+        errcnt += 1;
+    }
+    else if ((d_width > SGL_WARP_MAX_DIMENSION) || (d_height > SGL_WARP_MAX_DIMENSION) ||
+             (s_width > SGL_WARP_MAX_DIMENSION) || (s_height > SGL_WARP_MAX_DIMENSION)) {
+        /* keeps positions, offsets and SIMD gather indices in range */
+        errcnt += 1;
+    }
+    else {
+        /* valid geometry */
+    }
+
+    /* check bpp(bytes per pixel) */
+    if (bpp <= 0) {
+        errcnt += 1;
+    }
+    else if ((((sgl_int64_t)s_width * bpp) > SGL_WARP_MAX_STRIDE) ||
+             (((sgl_int64_t)d_width * bpp) > SGL_WARP_MAX_STRIDE)) {
+        errcnt += 1;
+    }
+    else {
+        /* valid pixel size */
+    }
+
+    return errcnt;
+}
+
+#if defined(SGL_CFG_HAS_THREAD)
+/*
+ * Rows are claimed in SGL_WARP_ROW_GRAIN blocks; parallel_for hands faster
+ * participants several blocks at once, so the split follows the workers
+ * active at the time of the call.
+ */
+static sgl_result_t sgl_warp_threaded(
+    sgl_threadpool_t *SGL_RESTRICT pool,
+    sgl_warp_data_t *data)
+{
+    sgl_result_t result;
+
+    /* multi-threaded warp */
+    result = sgl_threadpool_parallel_for(
+        pool, 0, data->d_height, SGL_WARP_ROW_GRAIN, sgl_warp_routine, (void *)data);
+
+    return result;
+}
+#endif  /* !SGL_CFG_HAS_THREAD */
+
+sgl_result_t sgl_warp_run(
+    sgl_threadpool_t *SGL_RESTRICT pool,
+    sgl_warp_data_t *data)
+{
+    sgl_result_t result;
+
+    result = SGL_SUCCESS;
+    if (pool == SGL_NULL) {
+        data->range(data, 0, data->d_height);
+    }
+#if defined(SGL_CFG_HAS_THREAD)
+    else if (sgl_threadpool_get_num_threads(pool) <= 1U) {
+        data->range(data, 0, data->d_height);
+    }
+    else {
+        result = sgl_warp_threaded(pool, data);
+    }
+#else
+    else {
+        result = SGL_ERROR_NOT_SUPPORTED;
+    }
+#endif  /* !SGL_CFG_HAS_THREAD */
+
+    return result;
+}
+
+sgl_result_t sgl_warp_affine(
+                sgl_threadpool_t *SGL_RESTRICT pool,
+                sgl_uint8_t *SGL_RESTRICT dst, sgl_int32_t d_width, sgl_int32_t d_height,
+                const sgl_uint8_t *SGL_RESTRICT src, sgl_int32_t s_width, sgl_int32_t s_height,
+                sgl_int32_t bpp, const sgl_int32_t matrix[6], sgl_uint8_t border)
+{
+    sgl_result_t result = SGL_SUCCESS;
+    sgl_warp_data_t data;
+    sgl_int32_t errcnt = 0;
+    sgl_int32_t i;
+
+    errcnt = sgl_warp_count_errors(
+        dst, d_width, d_height, src, s_width, s_height, bpp, matrix);
+
+    /* check error count */
+    if (errcnt != 0) {
+        result = SGL_ERROR_INVALID_ARGUMENTS;
+    }
+    else {
+        data.src = src;
+        data.dst = dst;
+        data.s_width = s_width;
+        data.s_height = s_height;
+        data.d_width = d_width;
+        data.d_height = d_height;
+        data.bpp = bpp;
+        data.src_stride = s_width * bpp;
+        data.dst_stride = d_width * bpp;
+        for (i = 0; i < 6; ++i) {
+            data.matrix[i] = (sgl_int64_t)matrix[i];
+        }
+        data.matrix[6] = 0;
+        data.matrix[7] = 0;
+        data.matrix[8] = SGL_WARP_ONE;
+        data.border = border;
+        data.sampling = SGL_WARP_SAMPLING_BILINEAR;
+        data.span = sgl_warp_select_span_kernel(bpp, data.sampling);
+        data.range = sgl_warp_affine_range;
+        result = sgl_warp_run(pool, &data);
+    }
+
+    return result;
+}
+
+#if defined(SGL_CFG_HAS_THREAD)
+static void sgl_warp_routine(sgl_int32_t begin, sgl_int32_t end, void *SGL_RESTRICT cookie)
+{
+    const sgl_warp_data_t *data = sgl_memory_as_warp_data(cookie);
+
+    data->range(data, begin, end - begin);
+}
+#endif  /* !SGL_CFG_HAS_THREAD */
@@ -0,0 +1,224 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright (c) 2025 Dylan Hong
+ *
+ * This code is released under the MIT License.
+ * For conditions of distribution and use, see the LICENSE file.
+ */
+#include <sgl-core.h>
+#include "warp.h"
+
+/*
+ * Projects a homogeneous coordinate to Q16.16, floor(n * 2^16 / w) for
+ * w > 0.  The fraction is produced by long division in two 8-bit steps, so
+ * no intermediate exceeds 64 bits.  Results beyond 2^24 pixels are clamped;
+ * they are far outside any source either way.
+ */
+static sgl_int64_t sgl_warp_project(sgl_int64_t n, sgl_int64_t w)
+{
+    sgl_int64_t result;
+    sgl_int64_t q;
+    sgl_int64_t r;
+    sgl_int64_t f;
+
+    q = sgl_warp_floor_div(n, w);
+    if (q >= SGL_WARP_MAX_PROJECTED) {
+        result = SGL_WARP_MAX_PROJECTED << SGL_WARP_FRAC_BITS;
+    }
+    else if (q < -SGL_WARP_MAX_PROJECTED) {
+        result = -(SGL_WARP_MAX_PROJECTED << SGL_WARP_FRAC_BITS);
+    }
+    else {
+        /* 0 <= r < w */
+        r = n - (q * w);
+        f = (r << 8) / w;
+        r = (r << 8) - (f * w);
+        f = (f << 8) + ((r << 8) / w);
+        result = (q * SGL_WARP_ONE) + f;
+    }
+
+    return result;
+}
+
+/*
+ * Segment whose denominator is not positive at one of its knots: the line
+ * crosses the horizon, so every pixel is projected on its own and pixels
+ * behind it take the border.
+ */
+static void sgl_warp_perspective_exact(
+    const sgl_warp_data_t *data,
+    sgl_uint8_t *SGL_RESTRICT dst_row,
+    sgl_int32_t start,
+    sgl_int32_t end,
+    sgl_int64_t xn,
+    sgl_int64_t yn,
+    sgl_int64_t wn)
+{
+    sgl_int64_t x;
+    sgl_int64_t y;
+    sgl_int64_t w;
+    sgl_int32_t i;
+
+    for (i = start; i < end; ++i) {
+        x = xn + (data->matrix[0] * (i - start));
+        y = yn + (data->matrix[3] * (i - start));
+        w = wn + (data->matrix[6] * (i - start));
+        if (w > 0) {
+            sgl_warp_affine_segment(
+                data, dst_row, i, i + 1,
+                sgl_warp_project(x, w), sgl_warp_project(y, w), 0, 0);
+        }
+        else {
+            (void)sgl_memset(&dst_row[i * data->bpp], (sgl_int32_t)data->border, (sgl_size_t)data->bpp);
+        }
+    }
+}
+
+/*
+ * Design and Operation
+ * --------------------
+ * Along a destination row the homogeneous source coordinate (X, Y, W) moves
+ * by the first matrix column, so it is carried incrementally.  The division
+ * is only done at knots every SGL_WARP_SEGMENT_PIXELS pixels; between two
+ * knots the source position is interpolated linearly, which turns the row
+ * into short affine segments for the clipped span kernels.
+ *
+ *   knot:    k0              k1              k2
+ *   exact:   (X/W, Y/W)      (X/W, Y/W)      (X/W, Y/W)
+ *            |--- 16 px ----|--- 16 px ----|-- tail --|
+ *   affine:  p(k0) + i * (p(k1) - p(k0)) / 16
+ *
+ * The error is the curvature of the projection over 16 pixels, well below a
+ * pixel for rectification-style warps, and the inner loops stay the same
+ * branch-free SIMD kernels as the affine warp.
+ */
+static void sgl_warp_perspective_range(
+    const sgl_warp_data_t *data,
+    sgl_int32_t start_row,
+    sgl_int32_t row_count)
+{
+    sgl_uint8_t *dst_row;
+    sgl_int64_t xs;
+    sgl_int64_t ys;
+    sgl_int64_t ws;
+    sgl_int64_t xe;
+    sgl_int64_t ye;
+    sgl_int64_t we;
+    sgl_int64_t px0;
+    sgl_int64_t py0;
+    sgl_int64_t px1;
+    sgl_int64_t py1;
+    sgl_int32_t row;
+    sgl_int32_t start;
+    sgl_int32_t end;
+
+    for (row = start_row; row < (start_row + row_count); ++row) {
+        dst_row = &data->dst[(sgl_ptrdiff_t)row * data->dst_stride];
+        xs = (data->matrix[1] * row) + data->matrix[2];
+        ys = (data->matrix[4] * row) + data->matrix[5];
+        ws = (data->matrix[7] * row) + data->matrix[8];
+        px0 = 0;
+        py0 = 0;
+        if (ws > 0) {
+            px0 = sgl_warp_project(xs, ws);
+            py0 = sgl_warp_project(ys, ws);
+        }
+
+        for (start = 0; start < data->d_width; start = end) {
+            end = start + SGL_WARP_SEGMENT_PIXELS;
+            if (end > data->d_width) {
+                end = data->d_width;
+            }
+            xe = xs + (data->matrix[0] * (end - start));
+            ye = ys + (data->matrix[3] * (end - start));
+            we = ws + (data->matrix[6] * (end - start));
+            px1 = 0;
+            py1 = 0;
+            if (we > 0) {
+                px1 = sgl_warp_project(xe, we);
+                py1 = sgl_warp_project(ye, we);
+            }
+
+            if ((ws > 0) && (we > 0)) {
+                sgl_warp_affine_segment(
+                    data, dst_row, start, end, px0, py0,
+                    sgl_warp_floor_div(px1 - px0, (sgl_int64_t)end - (sgl_int64_t)start),
+                    sgl_warp_floor_div(py1 - py0, (sgl_int64_t)end - (sgl_int64_t)start));
+            }
+            else {
+                sgl_warp_perspective_exact(data, dst_row, start, end, xs, ys, ws);
+            }
+
+            xs = xe;
+            ys = ye;
+            ws = we;
+            px0 = px1;
+            py0 = py1;
+        }
+    }
+}
+
+static sgl_result_t sgl_warp_perspective(
+    sgl_threadpool_t *SGL_RESTRICT pool,
+    sgl_uint8_t *SGL_RESTRICT dst, sgl_int32_t d_width, sgl_int32_t d_height,
+    const sgl_uint8_t *SGL_RESTRICT src, sgl_int32_t s_width, sgl_int32_t s_height,
+    sgl_int32_t bpp, const sgl_int32_t matrix[9], sgl_uint8_t border,
+    sgl_warp_sampling_t sampling)
+{
+    sgl_result_t result = SGL_SUCCESS;
+    sgl_warp_data_t data;
+    sgl_int32_t errcnt = 0;
+    sgl_int32_t i;
+
+    errcnt = sgl_warp_count_errors(
+        dst, d_width, d_height, src, s_width, s_height, bpp, matrix);
+
+    /* check error count */
+    if (errcnt != 0) {
+        result = SGL_ERROR_INVALID_ARGUMENTS;
+    }
+    else {
+        data.src = src;
+        data.dst = dst;
+        data.s_width = s_width;
+        data.s_height = s_height;
+        data.d_width = d_width;
+        data.d_height = d_height;
+        data.bpp = bpp;
+        data.src_stride = s_width * bpp;
+        data.dst_stride = d_width * bpp;
+        for (i = 0; i < 9; ++i) {
+            data.matrix[i] = (sgl_int64_t)matrix[i];
+        }
+        data.border = border;
+        data.sampling = sampling;
+        data.span = sgl_warp_select_span_kernel(bpp, sampling);
+        data.range = sgl_warp_perspective_range;
+        result = sgl_warp_run(pool, &data);
+    }
+
+    return result;
+}
+
+sgl_result_t sgl_warp_perspective_nearest(
+                sgl_threadpool_t *SGL_RESTRICT pool,
+                sgl_uint8_t *SGL_RESTRICT dst, sgl_int32_t d_width, sgl_int32_t d_height,
+                const sgl_uint8_t *SGL_RESTRICT src, sgl_int32_t s_width, sgl_int32_t s_height,
+                sgl_int32_t bpp, const sgl_int32_t matrix[9], sgl_uint8_t border)
+{
+    return sgl_warp_perspective(
+        pool, dst, d_width, d_height, src, s_width, s_height, bpp, matrix, border,
+        SGL_WARP_SAMPLING_NEAREST);
+}
+
+sgl_result_t sgl_warp_perspective_bilinear(
+                sgl_threadpool_t *SGL_RESTRICT pool,
+                sgl_uint8_t *SGL_RESTRICT dst, sgl_int32_t d_width, sgl_int32_t d_height,
+                const sgl_uint8_t *SGL_RESTRICT src, sgl_int32_t s_width, sgl_int32_t s_height,
+                sgl_int32_t bpp, const sgl_int32_t matrix[9], sgl_uint8_t border)
+{
+    return sgl_warp_perspective(
+        pool, dst, d_width, d_height, src, s_width, s_height, bpp, matrix, border,
+        SGL_WARP_SAMPLING_BILINEAR);
+}
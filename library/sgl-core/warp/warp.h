@@ -0,0 +1,185 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright (c) 2025 Dylan Hong
+ *
+ * This code is released under the MIT License.
+ * For conditions of distribution and use, see the LICENSE file.
+ */
+#ifndef WARP_H_
+#define WARP_H_
+
+#include <sgl-core.h>
+#include <sgl_memory_cast.h>
+
+#define SGL_WARP_FRAC_BITS              (16)
+#define SGL_WARP_WEIGHT_SHIFT           (SGL_WARP_FRAC_BITS - SGL_Q11_FRAC_BITS)
+#define SGL_WARP_WEIGHT_MASK            (SGL_Q11_ONE - 1)
+#define SGL_WARP_BLEND_BITS             (SGL_Q11_FRAC_BITS * 2)
+#define SGL_WARP_BLEND_HALF             (1 << (SGL_WARP_BLEND_BITS - 1))
+#define SGL_WARP_ROW_GRAIN              (8)
+#define SGL_WARP_MAX_DIMENSION          (32767)
+#define SGL_WARP_MAX_STRIDE             ((sgl_int64_t)0x7FFFFFFF)
+#define SGL_WARP_HALF                   ((sgl_int64_t)1 << (SGL_WARP_FRAC_BITS - 1))
+#define SGL_WARP_SEGMENT_PIXELS         (16)
+#define SGL_WARP_MAX_PROJECTED          ((sgl_int64_t)1 << 24)
+
+#if defined(SGL_CFG_HAS_NEON) || defined(SGL_CFG_HAS_AVX2)
+#define SGL_WARP_HAS_SIMD_KERNELS
+#endif  /* !SGL_CFG_HAS_NEON || SGL_CFG_HAS_AVX2 */
+
+typedef enum {
+    SGL_WARP_SAMPLING_BILINEAR,
+    SGL_WARP_SAMPLING_NEAREST,
+} sgl_warp_sampling_t;
+
+/*
+ * One clipped run of destination pixels.  x and y are the Q16.16 source
+ * position of the first pixel and dx/dy the per-pixel increments.  Every
+ * sample of the run, including its right and bottom neighbors, lies inside
+ * the source, so span kernels load without bounds checks.
+ */
+typedef struct {
+    sgl_uint8_t *SGL_RESTRICT dst;
+    const sgl_uint8_t *SGL_RESTRICT src;
+    sgl_int32_t src_stride;
+    sgl_int32_t bpp;
+    sgl_int64_t x;
+    sgl_int64_t y;
+    sgl_int64_t dx;
+    sgl_int64_t dy;
+    sgl_int32_t count;
+} sgl_warp_span_t;
+
+typedef void (*sgl_warp_span_kernel_t)(const sgl_warp_span_t *span);
+
+typedef struct sgl_warp_data sgl_warp_data_t;
+
+/* Warps destination rows [start_row, start_row + row_count). */
+typedef void (*sgl_warp_range_t)(
+    const sgl_warp_data_t *data,
+    sgl_int32_t start_row,
+    sgl_int32_t row_count);
+
+struct sgl_warp_data {
+    const sgl_uint8_t *SGL_RESTRICT src;
+    sgl_uint8_t *SGL_RESTRICT dst;
+    sgl_int32_t s_width;
+    sgl_int32_t s_height;
+    sgl_int32_t d_width;
+    sgl_int32_t d_height;
+    sgl_int32_t bpp;
+    sgl_int32_t src_stride;
+    sgl_int32_t dst_stride;
+    sgl_int64_t matrix[9];
+    sgl_uint8_t border;
+    sgl_warp_sampling_t sampling;
+    sgl_warp_span_kernel_t span;
+    sgl_warp_range_t range;
+};
+
+/*
+ * Bilinear blend of one channel in Q11.  The horizontal pass keeps Q11, the
+ * vertical pass produces Q22, and the sum is bounded by 255 << 22, so every
+ * step fits a signed 32-bit lane.  SIMD kernels use the same arithmetic and
+ * therefore produce identical bytes.
+ *
+ *   top    = p00 * (1 - wx) + p01 * wx
+ *   bottom = p10 * (1 - wx) + p11 * wx
+ *   value  = (top * (1 - wy) + bottom * wy + half) >> 22
+ */
+static SGL_ALWAYS_INLINE sgl_uint8_t sgl_warp_blend(
+    sgl_int32_t p00, sgl_int32_t p01, sgl_int32_t p10, sgl_int32_t p11,
+    sgl_int32_t wx, sgl_int32_t wy)
+{
+    sgl_int32_t top;
+    sgl_int32_t bottom;
+    sgl_int32_t value;
+
+    top = (p00 * (SGL_Q11_ONE - wx)) + (p01 * wx);
+    bottom = (p10 * (SGL_Q11_ONE - wx)) + (p11 * wx);
+    value = ((top * (SGL_Q11_ONE - wy)) + (bottom * wy) + SGL_WARP_BLEND_HALF) >>
+            SGL_WARP_BLEND_BITS;
+
+    return (sgl_uint8_t)value;
+}
+
+/* Floor division by a positive divisor. */
+static SGL_ALWAYS_INLINE sgl_int64_t sgl_warp_floor_div(sgl_int64_t n, sgl_int64_t d)
+{
+    sgl_int64_t q;
+
+    q = n / d;
+    if (((n % d) != 0) && (n < 0)) {
+        q -= 1;
+    }
+
+    return q;
+}
+
+/* Generic span kernels; SIMD kernels finish their tails with them. */
+void sgl_generic_warp_span(const sgl_warp_span_t *span);
+void sgl_generic_warp_span_nearest(const sgl_warp_span_t *span);
+
+/* Runs rows [start_row, start_row + row_count) of an affine warp. */
+void sgl_warp_affine_range(
+    const sgl_warp_data_t *data,
+    sgl_int32_t start_row,
+    sgl_int32_t row_count);
+
+/*
+ * Warps one affine segment of a destination row: pixels [start, end) with
+ * source position x + (i - start) * dx, y + (i - start) * dy.  Interior
+ * pixels go to the span kernel, pixels near or beyond the source edge take
+ * the clamped or border path.  The perspective warp feeds its
+ * piecewise-affine segments through here as well.
+ */
+void sgl_warp_affine_segment(
+    const sgl_warp_data_t *data,
+    sgl_uint8_t *SGL_RESTRICT dst_row,
+    sgl_int32_t start,
+    sgl_int32_t end,
+    sgl_int64_t x,
+    sgl_int64_t y,
+    sgl_int64_t dx,
+    sgl_int64_t dy);
+
+sgl_warp_span_kernel_t sgl_warp_select_span_kernel(
+    sgl_int32_t bpp,
+    sgl_warp_sampling_t sampling);
+
+/* Accelerated span kernel; SGL_NULL selects the generic implementation. */
+#if defined(SGL_WARP_HAS_SIMD_KERNELS)
+sgl_warp_span_kernel_t sgl_simd_warp_span_kernel(
+    sgl_int32_t bpp,
+    sgl_warp_sampling_t sampling);
+#endif  /* !SGL_WARP_HAS_SIMD_KERNELS */
+
+/* Buffer, geometry and pixel size checks shared by every warp entry point. */
+sgl_int32_t sgl_warp_count_errors(
+    const sgl_uint8_t *dst,
+    sgl_int32_t d_width,
+    sgl_int32_t d_height,
+    const sgl_uint8_t *src,
+    sgl_int32_t s_width,
+    sgl_int32_t s_height,
+    sgl_int32_t bpp,
+    const sgl_int32_t *matrix);
+
+/* Runs data->range over all destination rows, split into row blocks on pool. */
+sgl_result_t sgl_warp_run(
+    sgl_threadpool_t *SGL_RESTRICT pool,
+    sgl_warp_data_t *data);
+
+static SGL_ALWAYS_INLINE sgl_warp_data_t *sgl_memory_as_warp_data(void *memory)
+{
+    sgl_warp_data_t *result;
+
+    /* SGL-MEM-DEV-001: typed conversion from generic storage. */
+    /* cppcheck-suppress misra-c2012-11.5 */
+    result = (sgl_warp_data_t *)memory;
+
+    return result;
+}
+
+#endif  /* !WARP_H_ */
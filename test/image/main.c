@@ -0,0 +1,614 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright (c) 2025 Dylan Hong
+ *
+ * This code is released under the MIT License.
+ * For conditions of distribution and use, see the LICENSE file.
+ */
+#include <stdint.h>
+#include <stdio.h>
+#include <sgl-core.h>
+#include "util.h"
+
+#define TEST_WORKER_COUNT           (4U)
+#define TEST_WIDTH                  (157)
+#define TEST_HEIGHT                 (123)
+#define TEST_PADDING                (13)
+
+typedef enum {
+    TEST_METHOD_NEAREST,
+    TEST_METHOD_BILINEAR,
+    TEST_METHOD_BICUBIC,
+    TEST_METHOD_COUNT,
+} test_method_t;
+
+static int32_t test_format_bpp(sgl_pixel_format_t format)
+{
+    int32_t bpp;
+
+    switch (format) {
+    case SGL_PIXEL_FORMAT_RGB565:
+        bpp = 2;
+        break;
+    case SGL_PIXEL_FORMAT_RGB888:
+    case SGL_PIXEL_FORMAT_BGR888:
+        bpp = 3;
+        break;
+    case SGL_PIXEL_FORMAT_RGBA8888:
+    case SGL_PIXEL_FORMAT_BGRA8888:
+        bpp = 4;
+        break;
+    default:
+        bpp = 1;
+        break;
+    }
+
+    return bpp;
+}
+
+/* Allocates a padded image and fills every byte, padding included. */
+static sgl_uint8_t *test_create_image(
+    sgl_image_t *image, int32_t width, int32_t height, int32_t stride,
+    sgl_pixel_format_t format)
+{
+    sgl_uint8_t *buffer;
+    sgl_size_t size;
+    sgl_size_t index;
+
+    size = sgl_image_buffer_size(width, height, stride, format);
+    buffer = (sgl_uint8_t *)sgl_malloc(size);
+    if (buffer != SGL_NULL) {
+        for (index = 0U; index < size; ++index) {
+            buffer[index] = sgl_test_pattern_byte((int32_t)index, (int32_t)(index >> 10U), 1);
+        }
+        if (sgl_image_wrap(image, buffer, width, height, stride, format) != SGL_SUCCESS) {
+            SGL_SAFE_FREE(buffer);
+        }
+    }
+
+    return buffer;
+}
+
+/* Copies one plane of a view into a packed buffer. */
+static void test_pack_plane(
+    sgl_uint8_t *dst, const sgl_image_t *image, int32_t plane,
+    int32_t width, int32_t height, int32_t bpp)
+{
+    int32_t y;
+
+    for (y = 0; y < height; ++y) {
+        (void)sgl_memcpy(
+            &dst[(size_t)y * (size_t)width * (size_t)bpp],
+            &image->planes[plane][(size_t)y * (size_t)image->strides[plane]],
+            (size_t)width * (size_t)bpp);
+    }
+}
+
+static int test_compare_plane(
+    const sgl_uint8_t *packed, const sgl_image_t *image, int32_t plane,
+    int32_t width, int32_t height, int32_t bpp)
+{
+    int32_t y;
+    int32_t x;
+    int result;
+
+    result = 0;
+    for (y = 0; (result == 0) && (y < height); ++y) {
+        for (x = 0; x < (width * bpp); ++x) {
+            if (packed[((size_t)y * (size_t)width * (size_t)bpp) + (size_t)x] !=
+                image->planes[plane][((size_t)y * (size_t)image->strides[plane]) + (size_t)x]) {
+                result = 1;
+            }
+        }
+    }
+
+    return result;
+}
+
+static int test_image_wrap_and_crop(void)
+{
+    sgl_uint8_t buffer[64];
+    sgl_image_t image;
+    sgl_image_t view;
+    int result;
+
+    result = 0;
+
+    /* NV12 8x4 with stride 10: 40 luma bytes and 2 chroma rows */
+    if ((sgl_image_buffer_size(8, 4, 10, SGL_PIXEL_FORMAT_NV12) != 60U) ||
+        (sgl_image_buffer_size(7, 3, 0, SGL_PIXEL_FORMAT_I420) != (21U + 8U + 8U)) ||
+        (sgl_image_buffer_size(4, 4, 3, SGL_PIXEL_FORMAT_RGB888) != 0U)) {
+        result = 1;
+    }
+    if ((sgl_image_wrap(&image, buffer, 8, 4, 10, SGL_PIXEL_FORMAT_NV12) != SGL_SUCCESS) ||
+        (image.planes[0] != buffer) || (image.planes[1] != &buffer[40]) ||
+        (image.strides[1] != 10) || (image.planes[2] != SGL_NULL)) {
+        result = 1;
+    }
+
+    /* the view aliases the parent: no copy, same strides */
+    if ((sgl_image_crop(&view, &image, 2, 2, 5, 2) != SGL_SUCCESS) ||
+        (view.base != buffer) || (view.planes[0] != &buffer[22]) ||
+        (view.planes[1] != &buffer[52]) || (view.strides[0] != 10) ||
+        (view.width != 5) || (view.height != 2)) {
+        result = 1;
+    }
+    if (sgl_image_crop(&view, &image, 1, 2, 4, 2) != SGL_ERROR_INVALID_ARGUMENTS) {
+        result = 1;
+    }
+    if (sgl_image_crop(&view, &image, 2, 2, 7, 2) != SGL_ERROR_INVALID_ARGUMENTS) {
+        result = 1;
+    }
+    if ((sgl_image_wrap(&image, buffer, 7, 3, 0, SGL_PIXEL_FORMAT_I420) != SGL_SUCCESS) ||
+        (image.planes[1] != &buffer[21]) || (image.planes[2] != &buffer[29]) ||
+        (image.strides[1] != 4) || (image.strides[2] != 4)) {
+        result = 1;
+    }
+    if ((sgl_image_wrap(&image, buffer, 4, 4, 13, SGL_PIXEL_FORMAT_RGB888) != SGL_SUCCESS) ||
+        (sgl_image_crop(&view, &image, 1, 3, 3, 1) != SGL_SUCCESS) ||
+        (view.planes[0] != &buffer[42])) {
+        result = 1;
+    }
+    if (sgl_image_wrap(&image, SGL_NULL, 4, 4, 0, SGL_PIXEL_FORMAT_RGB888) !=
+        SGL_ERROR_INVALID_ARGUMENTS) {
+        result = 1;
+    }
+
+    if (result != 0) {
+        printf("FAIL wrap/crop\n");
+    }
+
+    return result;
+}
+
+/* An odd-width NV12 chroma row holds (width + 1) / 2 UV pairs. */
+static int test_image_odd_nv12(sgl_threadpool_t *pool)
+{
+    sgl_uint8_t src_buffer[32];
+    sgl_uint8_t dst_buffer[32];
+    sgl_uint8_t rot_buffer[32];
+    sgl_image_t src;
+    sgl_image_t dst;
+    sgl_image_t rot;
+    sgl_image_t view;
+    int32_t index;
+    int result;
+
+    result = 0;
+    for (index = 0; index < 32; ++index) {
+        src_buffer[index] = sgl_test_pattern_byte(index, 0, 0);
+        dst_buffer[index] = 0U;
+    }
+
+    /* 5x4: 20 luma bytes and 2 chroma rows of 3 UV pairs */
+    if ((sgl_image_buffer_size(5, 4, 0, SGL_PIXEL_FORMAT_NV12) != 32U) ||
+        (sgl_image_buffer_size(5, 4, 7, SGL_PIXEL_FORMAT_NV12) != 42U)) {
+        result = 1;
+    }
+    if ((sgl_image_wrap(&src, src_buffer, 5, 4, 0, SGL_PIXEL_FORMAT_NV12) != SGL_SUCCESS) ||
+        (sgl_image_wrap(&dst, dst_buffer, 5, 4, 0, SGL_PIXEL_FORMAT_NV12) != SGL_SUCCESS) ||
+        (sgl_image_wrap(&rot, rot_buffer, 4, 5, 0, SGL_PIXEL_FORMAT_NV12) != SGL_SUCCESS) ||
+        (src.planes[1] != &src_buffer[20]) || (src.strides[1] != 6)) {
+        result = 1;
+    }
+    if (result == 0) {
+        if ((sgl_image_convert(pool, &dst, &src) != SGL_SUCCESS) ||
+            (sgl_image_rotate(pool, &rot, &src, SGL_ROTATE_90) != SGL_SUCCESS) ||
+            (sgl_image_crop(&view, &src, 2, 2, 3, 2) != SGL_SUCCESS)) {
+            result = 1;
+        }
+    }
+    for (index = 0; (result == 0) && (index < 32); ++index) {
+        if (dst_buffer[index] != src_buffer[index]) {
+            result = 1;
+        }
+    }
+
+    if (result != 0) {
+        printf("FAIL odd-width NV12 pool=%s\n", (pool != SGL_NULL) ? "yes" : "no");
+    }
+
+    return result;
+}
+
+static sgl_result_t test_image_resize(
+    sgl_threadpool_t *pool, test_method_t method,
+    const sgl_image_t *dst, const sgl_image_t *src)
+{
+    sgl_result_t result;
+
+    switch (method) {
+    case TEST_METHOD_NEAREST:
+        result = sgl_image_resize_nearest(pool, dst, src);
+        break;
+    case TEST_METHOD_BILINEAR:
+        result = sgl_image_resize_bilinear(pool, dst, src);
+        break;
+    default:
+        result = sgl_image_resize_bicubic(pool, dst, src);
+        break;
+    }
+
+    return result;
+}
+
+static sgl_result_t test_packed_resize(
+    test_method_t method,
+    sgl_uint8_t *dst, int32_t d_width, int32_t d_height,
+    sgl_uint8_t *src, int32_t s_width, int32_t s_height, int32_t bpp)
+{
+    sgl_result_t result;
+
+#if defined(SGL_CFG_HAS_SIMD)
+    switch (method) {
+    case TEST_METHOD_NEAREST:
+        result = sgl_simd_resize_nearest(
+            SGL_NULL, SGL_NULL, dst, d_width, d_height, src, s_width, s_height, bpp);
+        break;
+    case TEST_METHOD_BILINEAR:
+        result = sgl_simd_resize_bilinear(
+            SGL_NULL, SGL_NULL, dst, d_width, d_height, src, s_width, s_height, bpp);
+        break;
+    default:
+        result = sgl_simd_resize_bicubic(
+            SGL_NULL, SGL_NULL, dst, d_width, d_height, src, s_width, s_height, bpp);
+        break;
+    }
+#else
+    switch (method) {
+    case TEST_METHOD_NEAREST:
+        result = sgl_generic_resize_nearest(
+            SGL_NULL, SGL_NULL, dst, d_width, d_height, src, s_width, s_height, bpp);
+        break;
+    case TEST_METHOD_BILINEAR:
+        result = sgl_generic_resize_bilinear(
+            SGL_NULL, SGL_NULL, dst, d_width, d_height, src, s_width, s_height, bpp);
+        break;
+    default:
+        result = sgl_generic_resize_bicubic(
+            SGL_NULL, SGL_NULL, dst, d_width, d_height, src, s_width, s_height, bpp);
+        break;
+    }
+#endif  /* !SGL_CFG_HAS_SIMD */
+
+    return result;
+}
+
+/*
+ * Resizing a cropped, padded view must match resizing a packed copy of the
+ * crop, plane by plane, and must leave the destination padding untouched.
+ *
+ *   padded src --crop--> view --image resize--> padded dst view
+ *   view --pack--> packed --packed resize--> expected
+ */
+static int test_image_resize_case(
+    sgl_threadpool_t *pool, test_method_t method, sgl_pixel_format_t format,
+    int32_t d_width, int32_t d_height)
+{
+    static const int32_t plane_bpp_nv12[2] = { 1, 2 };
+    sgl_image_t src_image;
+    sgl_image_t src_view;
+    sgl_image_t dst_image;
+    sgl_image_t dst_view;
+    sgl_uint8_t *src_buffer;
+    sgl_uint8_t *dst_buffer;
+    sgl_uint8_t *packed;
+    sgl_uint8_t *expected;
+    sgl_uint8_t *dst_copy;
+    sgl_size_t dst_size;
+    sgl_size_t index;
+    int32_t planes;
+    int32_t plane;
+    int32_t bpp;
+    int32_t shift;
+    int32_t d_stride;
+    int result;
+
+    result = 0;
+    bpp = test_format_bpp(format);
+    planes = (format == SGL_PIXEL_FORMAT_NV12) ? 2 : ((format == SGL_PIXEL_FORMAT_I420) ? 3 : 1);
+    d_stride = ((d_width + 8) * bpp) + TEST_PADDING;
+    src_buffer = test_create_image(
+        &src_image, TEST_WIDTH, TEST_HEIGHT, (TEST_WIDTH * bpp) + TEST_PADDING, format);
+    dst_buffer = test_create_image(&dst_image, d_width + 8, d_height + 6, d_stride, format);
+    dst_size = sgl_image_buffer_size(d_width + 8, d_height + 6, d_stride, format);
+    packed = (sgl_uint8_t *)sgl_malloc((size_t)TEST_WIDTH * (size_t)TEST_HEIGHT * 4U);
+    expected = (sgl_uint8_t *)sgl_malloc((size_t)d_width * (size_t)d_height * 4U);
+    dst_copy = (sgl_uint8_t *)sgl_malloc(dst_size);
+    if ((src_buffer == SGL_NULL) || (dst_buffer == SGL_NULL) || (packed == SGL_NULL) ||
+        (expected == SGL_NULL) || (dst_copy == SGL_NULL)) {
+        result = 1;
+    }
+
+    if (result == 0) {
+        (void)sgl_memcpy(dst_copy, dst_buffer, dst_size);
+        if ((sgl_image_crop(&src_view, &src_image, 10, 6, 91, 77) != SGL_SUCCESS) ||
+            (sgl_image_crop(&dst_view, &dst_image, 4, 2, d_width, d_height) != SGL_SUCCESS) ||
+            (test_image_resize(pool, method, &dst_view, &src_view) != SGL_SUCCESS)) {
+            result = 1;
+        }
+    }
+
+    for (plane = 0; (result == 0) && (plane < planes); ++plane) {
+        int32_t plane_bpp = (format == SGL_PIXEL_FORMAT_NV12) ? plane_bpp_nv12[plane] : bpp;
+        int32_t s_w;
+        int32_t s_h;
+        int32_t d_w;
+        int32_t d_h;
+
+        shift = (plane > 0) ? 1 : 0;
+        s_w = (91 + shift) >> shift;
+        s_h = (77 + shift) >> shift;
+        d_w = (d_width + shift) >> shift;
+        d_h = (d_height + shift) >> shift;
+        test_pack_plane(packed, &src_view, plane, s_w, s_h, plane_bpp);
+        if (test_packed_resize(method, expected, d_w, d_h, packed, s_w, s_h, plane_bpp) != SGL_SUCCESS) {
+            result = 1;
+        }
+        else {
+            result = test_compare_plane(expected, &dst_view, plane, d_w, d_h, plane_bpp);
+        }
+    }
+
+    /* bytes outside the destination view keep their fill */
+    if (result == 0) {
+        for (plane = 0; plane < planes; ++plane) {
+            int32_t plane_bpp = (format == SGL_PIXEL_FORMAT_NV12) ? plane_bpp_nv12[plane] : bpp;
+            int32_t d_w;
+            int32_t d_h;
+            int32_t y;
+            int32_t x;
+
+            shift = (plane > 0) ? 1 : 0;
+            d_w = (d_width + shift) >> shift;
+            d_h = (d_height + shift) >> shift;
+            for (y = 0; y < d_h; ++y) {
+                for (x = 0; x < (d_w * plane_bpp); ++x) {
+                    index = (size_t)(dst_view.planes[plane] - dst_buffer) +
+                        ((size_t)y * (size_t)dst_view.strides[plane]) + (size_t)x;
+                    dst_copy[index] = dst_buffer[index];
+                }
+            }
+        }
+        for (index = 0U; index < dst_size; ++index) {
+            if (dst_copy[index] != dst_buffer[index]) {
+                result = 1;
+            }
+        }
+    }
+
+    if (result != 0) {
+        printf("FAIL resize method=%d format=%d %dx%d pool=%s\n",
+               (int)method, (int)format, d_width, d_height,
+               (pool != SGL_NULL) ? "yes" : "no");
+    }
+    SGL_SAFE_FREE(src_buffer);
+    SGL_SAFE_FREE(dst_buffer);
+    SGL_SAFE_FREE(packed);
+    SGL_SAFE_FREE(expected);
+    SGL_SAFE_FREE(dst_copy);
+
+    return result;
+}
+
+static int test_image_rotate_case(
+    sgl_threadpool_t *pool, sgl_pixel_format_t format, sgl_rotation_t rotation)
+{
+    sgl_image_t src_image;
+    sgl_image_t src_view;
+    sgl_image_t dst_image;
+    sgl_uint8_t *src_buffer;
+    sgl_uint8_t *dst_buffer;
+    sgl_uint8_t *packed;
+    sgl_uint8_t *expected;
+    int32_t bpp;
+    int32_t d_width;
+    int32_t d_height;
+    int result;
+
+    result = 0;
+    bpp = test_format_bpp(format);
+    d_width = 64;
+    d_height = 38;
+    if ((rotation == SGL_ROTATE_90) || (rotation == SGL_ROTATE_270) ||
+        (rotation == SGL_TRANSPOSE) || (rotation == SGL_TRANSVERSE)) {
+        d_width = 38;
+        d_height = 64;
+    }
+    src_buffer = test_create_image(
+        &src_image, TEST_WIDTH, TEST_HEIGHT, (TEST_WIDTH * bpp) + TEST_PADDING, format);
+    dst_buffer = test_create_image(&dst_image, d_width, d_height, (d_width * bpp) + 5, format);
+    packed = (sgl_uint8_t *)sgl_malloc(64U * 38U * 4U);
+    expected = (sgl_uint8_t *)sgl_malloc(64U * 38U * 4U);
+    if ((src_buffer == SGL_NULL) || (dst_buffer == SGL_NULL) ||
+        (packed == SGL_NULL) || (expected == SGL_NULL)) {
+        result = 1;
+    }
+
+    if (result == 0) {
+        if ((sgl_image_crop(&src_view, &src_image, 7, 3, 64, 38) != SGL_SUCCESS) ||
+            (sgl_image_rotate(pool, &dst_image, &src_view, rotation) != SGL_SUCCESS)) {
+            result = 1;
+        }
+    }
+    if (result == 0) {
+        test_pack_plane(packed, &src_view, 0, 64, 38, bpp);
+        if (sgl_rotate(SGL_NULL, expected, packed, 64, 38, bpp, rotation) != SGL_SUCCESS) {
+            result = 1;
+        }
+        else {
+            result = test_compare_plane(expected, &dst_image, 0, d_width, d_height, bpp);
+        }
+    }
+
+    if (result != 0) {
+        printf("FAIL rotate format=%d rotation=%d pool=%s\n",
+               (int)format, (int)rotation, (pool != SGL_NULL) ? "yes" : "no");
+    }
+    SGL_SAFE_FREE(src_buffer);
+    SGL_SAFE_FREE(dst_buffer);
+    SGL_SAFE_FREE(packed);
+    SGL_SAFE_FREE(expected);
+
+    return result;
+}
+
+static int test_image_convert_case(
+    sgl_threadpool_t *pool, sgl_pixel_format_t dst_format, sgl_pixel_format_t src_format)
+{
+    static const int32_t rgb_order[2][3] = { { 0, 1, 2 }, { 2, 1, 0 } };
+    sgl_image_t src_image;
+    sgl_image_t src_view;
+    sgl_image_t dst_image;
+    sgl_uint8_t *src_buffer;
+    sgl_uint8_t *dst_buffer;
+    const sgl_uint8_t *s;
+    const sgl_uint8_t *d;
+    int32_t s_bpp;
+    int32_t d_bpp;
+    int32_t s_order;
+    int32_t d_order;
+    int32_t x;
+    int32_t y;
+    int32_t c;
+    int result;
+
+    result = 0;
+    s_bpp = test_format_bpp(src_format);
+    d_bpp = test_format_bpp(dst_format);
+    s_order = ((src_format == SGL_PIXEL_FORMAT_BGR888) || (src_format == SGL_PIXEL_FORMAT_BGRA8888)) ? 1 : 0;
+    d_order = ((dst_format == SGL_PIXEL_FORMAT_BGR888) || (dst_format == SGL_PIXEL_FORMAT_BGRA8888)) ? 1 : 0;
+    src_buffer = test_create_image(
+        &src_image, TEST_WIDTH, TEST_HEIGHT, (TEST_WIDTH * s_bpp) + TEST_PADDING, src_format);
+    dst_buffer = test_create_image(&dst_image, 61, 45, (61 * d_bpp) + 3, dst_format);
+    if ((src_buffer == SGL_NULL) || (dst_buffer == SGL_NULL)) {
+        result = 1;
+    }
+
+    if (result == 0) {
+        if ((sgl_image_crop(&src_view, &src_image, 20, 30, 61, 45) != SGL_SUCCESS) ||
+            (sgl_image_convert(pool, &dst_image, &src_view) != SGL_SUCCESS)) {
+            result = 1;
+        }
+    }
+    for (y = 0; (result == 0) && (y < 45); ++y) {
+        for (x = 0; x < 61; ++x) {
+            s = &src_view.planes[0][((size_t)y * (size_t)src_view.strides[0]) + ((size_t)x * (size_t)s_bpp)];
+            d = &dst_image.planes[0][((size_t)y * (size_t)dst_image.strides[0]) + ((size_t)x * (size_t)d_bpp)];
+            for (c = 0; c < 3; ++c) {
+                if (d[rgb_order[d_order][c]] !=
+                    ((s_bpp == 1) ? s[0] : s[rgb_order[s_order][c]])) {
+                    result = 1;
+                }
+            }
+            if ((d_bpp == 4) && (d[3] != ((s_bpp == 4) ? s[3] : 0xFFU))) {
+                result = 1;
+            }
+        }
+    }
+
+    if (result != 0) {
+        printf("FAIL convert %d->%d pool=%s\n",
+               (int)src_format, (int)dst_format, (pool != SGL_NULL) ? "yes" : "no");
+    }
+    SGL_SAFE_FREE(src_buffer);
+    SGL_SAFE_FREE(dst_buffer);
+
+    return result;
+}
+
+static int test_image_all(sgl_threadpool_t *pool)
+{
+    static const sgl_pixel_format_t resize_formats[] = {
+        SGL_PIXEL_FORMAT_GRAY8, SGL_PIXEL_FORMAT_RGB565, SGL_PIXEL_FORMAT_RGB888,
+        SGL_PIXEL_FORMAT_RGBA8888, SGL_PIXEL_FORMAT_NV12, SGL_PIXEL_FORMAT_I420
+    };
+    static const sgl_pixel_format_t rgb_formats[] = {
+        SGL_PIXEL_FORMAT_RGB888, SGL_PIXEL_FORMAT_BGR888,
+        SGL_PIXEL_FORMAT_RGBA8888, SGL_PIXEL_FORMAT_BGRA8888
+    };
+    sgl_image_t a;
+    sgl_image_t b;
+    sgl_uint8_t buffer[64];
+    int32_t method;
+    int32_t format;
+    int32_t other;
+    int32_t rotation;
+    int result;
+
+    result = 0;
+    for (method = 0; method < (int32_t)TEST_METHOD_COUNT; ++method) {
+        for (format = 0;
+             format < (int32_t)(sizeof(resize_formats) / sizeof(resize_formats[0]));
+             ++format) {
+            /* downscale, upscale and same size */
+            result |= test_image_resize_case(pool, (test_method_t)method, resize_formats[format], 45, 33);
+            result |= test_image_resize_case(pool, (test_method_t)method, resize_formats[format], 130, 101);
+            result |= test_image_resize_case(pool, (test_method_t)method, resize_formats[format], 91, 77);
+        }
+    }
+
+    for (rotation = (int32_t)SGL_ROTATE_0; rotation <= (int32_t)SGL_TRANSVERSE; ++rotation) {
+        for (format = 0; format < 4; ++format) {
+            result |= test_image_rotate_case(pool, resize_formats[format], (sgl_rotation_t)rotation);
+        }
+    }
+
+    for (format = 0; format < 4; ++format) {
+        for (other = 0; other < 4; ++other) {
+            result |= test_image_convert_case(pool, rgb_formats[other], rgb_formats[format]);
+        }
+        result |= test_image_convert_case(pool, rgb_formats[format], SGL_PIXEL_FORMAT_GRAY8);
+    }
+
+    result |= test_image_odd_nv12(pool);
+
+    /* format mismatches and reductions are rejected */
+    (void)sgl_image_wrap(&a, buffer, 4, 4, 0, SGL_PIXEL_FORMAT_RGB888);
+    (void)sgl_image_wrap(&b, &buffer[48], 4, 4, 0, SGL_PIXEL_FORMAT_GRAY8);
+    if ((sgl_image_resize_bilinear(pool, &b, &a) != SGL_ERROR_INVALID_ARGUMENTS) ||
+        (sgl_image_rotate(pool, &b, &a, SGL_ROTATE_90) != SGL_ERROR_INVALID_ARGUMENTS) ||
+        (sgl_image_convert(pool, &b, &a) != SGL_ERROR_NOT_SUPPORTED)) {
+        printf("FAIL invalid arguments pool=%s\n", (pool != SGL_NULL) ? "yes" : "no");
+        result = 1;
+    }
+
+    return result;
+}
+
+int main(void)
+{
+    sgl_threadpool_t *pool;
+    int result;
+
+    result = 0;
+    pool = SGL_NULL;
+    if (sgl_test_pool_initialize() != SGL_SUCCESS) {
+        result = 1;
+    }
+    if (result == 0) {
+        result |= test_image_wrap_and_crop();
+        result |= test_image_all(SGL_NULL);
+    }
+#if defined(SGL_CFG_HAS_THREAD)
+    if (result == 0) {
+        pool = sgl_threadpool_create(
+            TEST_WORKER_COUNT, SGL_THREADPOOL_DEFAULT_MAX_ROUTINE_LISTS, "image-test");
+        if (pool == SGL_NULL) {
+            result = 1;
+        }
+        else {
+            result |= test_image_all(pool);
+            (void)sgl_threadpool_destroy(pool);
+        }
+    }
+#endif  /* !SGL_CFG_HAS_THREAD */
+    if (sgl_memory_pool_deinitialize() != SGL_SUCCESS) {
+        result = 1;
+    }
+
+    printf("image test %s\n", (result == 0) ? "passed" : "failed");
+
+    return result;
+}
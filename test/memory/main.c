@@ -26,6 +26,9 @@
 #define TEST_THREAD_SLOT_COUNT          (64U)
 #define TEST_THREAD_ITERATIONS          (50000U)
 #define TEST_HANDOFF_BLOCK_COUNT        (512U)
+#define TEST_CLASS_BLOCK_SIZE           (1000U)
+#define TEST_MAGAZINE_BLOCK_COUNT       (8U)
+#define TEST_MAGAZINE_BLOCK_SIZE        (64U)
 
 typedef struct {
     unsigned char *memory;
@@ -379,6 +382,70 @@ static int test_fragmentation_and_coalescing(void)
     return result;
 }
 
+/*
+ * Size classes are searched a class above the request, so a pool with
+ * nothing but request-sized holes must still fall back to the request's
+ * own class.  Fill the pool with 1000-byte blocks, whose class spans
+ * [992, 1024), free every other one, and every hole must be reused while a
+ * request no hole can hold still fails.
+ */
+static int test_size_class_reuse(void)
+{
+    test_allocation_t blocks[TEST_EXHAUST_BLOCK_COUNT] = { { NULL, 0U, 0U } };
+    void *oversized;
+    size_t allocation_count = 0U;
+    size_t i;
+    int result = 0;
+
+    while (allocation_count < TEST_EXHAUST_BLOCK_COUNT) {
+        blocks[allocation_count].size = TEST_CLASS_BLOCK_SIZE;
+        blocks[allocation_count].signature =
+            0x60000000U + (uint32_t)allocation_count;
+        blocks[allocation_count].memory =
+            sgl_memory_as_uchar(sgl_malloc(blocks[allocation_count].size));
+        if (blocks[allocation_count].memory == NULL) {
+            break;
+        }
+        test_fill_allocation(&blocks[allocation_count]);
+        allocation_count++;
+    }
+    if ((allocation_count < 3U) ||
+        (allocation_count == TEST_EXHAUST_BLOCK_COUNT)) {
+        result = 1;
+    }
+
+    for (i = 1U; (i + 1U) < allocation_count; i += 2U) {
+        test_release_allocation(&blocks[i]);
+    }
+    oversized = sgl_malloc(TEST_CLASS_BLOCK_SIZE * 2U);
+    if (oversized != NULL) {
+        result = 1;
+    }
+    sgl_free(oversized);
+
+    for (i = 1U; ((i + 1U) < allocation_count) && (result == 0); i += 2U) {
+        blocks[i].size = TEST_CLASS_BLOCK_SIZE;
+        blocks[i].signature = 0x61000000U + (uint32_t)i;
+        blocks[i].memory = sgl_memory_as_uchar(sgl_malloc(blocks[i].size));
+        if (blocks[i].memory == NULL) {
+            result = 1;
+        }
+        else {
+            test_fill_allocation(&blocks[i]);
+        }
+    }
+    if ((result == 0) &&
+        (test_verify_all_active(blocks, allocation_count) != 0)) {
+        result = 1;
+    }
+
+    for (i = 0U; i < allocation_count; ++i) {
+        test_release_allocation(&blocks[i]);
+    }
+
+    return result;
+}
+
 static int test_randomized_sequential_stress(void)
 {
     test_allocation_t slots[TEST_SEQUENTIAL_SLOT_COUNT] = { { NULL, 0U, 0U } };
@@ -712,6 +779,109 @@ static int test_cross_thread_handoff(void)
 
     return result;
 }
+
+static void *test_magazine_thread_routine(void *argument)
+{
+    test_thread_argument_t *thread_argument;
+    test_allocation_t blocks[TEST_MAGAZINE_BLOCK_COUNT] = { { NULL, 0U, 0U } };
+    size_t i;
+    int result = 0;
+
+    thread_argument = test_memory_as_thread_argument(argument);
+    for (i = 0U; (i < TEST_MAGAZINE_BLOCK_COUNT) && (result == 0); ++i) {
+        blocks[i].size = TEST_MAGAZINE_BLOCK_SIZE * (i + 1U);
+        blocks[i].signature =
+            0x4D000000U + ((uint32_t)thread_argument->thread_index << 8U) + (uint32_t)i;
+        blocks[i].memory = sgl_memory_as_uchar(sgl_malloc(blocks[i].size));
+        if (blocks[i].memory == NULL) {
+            result = 1;
+        }
+        else {
+            test_fill_allocation(&blocks[i]);
+        }
+    }
+    if ((result == 0) &&
+        (test_verify_all_active(blocks, TEST_MAGAZINE_BLOCK_COUNT) != 0)) {
+        result = 1;
+    }
+    /* freed blocks stay with this thread until it exits */
+    for (i = 0U; i < TEST_MAGAZINE_BLOCK_COUNT; ++i) {
+        test_release_allocation(&blocks[i]);
+    }
+    thread_argument->result = result;
+
+    return NULL;
+}
+
+/*
+ * Blocks a thread frees stay in its magazine. Whatever exited threads held
+ * must be back in the pool, or the near-whole-pool request cannot be met.
+ * A second free of a cached block must be ignored, and the blocks this
+ * thread keeps at the end must be returned by deinitialization.
+ */
+static int test_thread_magazines(void)
+{
+    pthread_t threads[TEST_THREAD_COUNT];
+    test_thread_argument_t arguments[TEST_THREAD_COUNT];
+    void *blocks[TEST_MAGAZINE_BLOCK_COUNT] = { NULL };
+    void *whole;
+    void *first;
+    void *second;
+    size_t created_count = 0U;
+    size_t i = 0U;
+    int result = 0;
+
+    while ((i < TEST_THREAD_COUNT) && (result == 0)) {
+        arguments[i].thread_index = i;
+        arguments[i].result = 0;
+        if (pthread_create(
+                &threads[i],
+                NULL,
+                test_magazine_thread_routine,
+                &arguments[i]) != 0) {
+            result = 1;
+        }
+        else {
+            created_count++;
+        }
+        i++;
+    }
+    for (i = 0U; i < created_count; ++i) {
+        if (pthread_join(threads[i], NULL) != 0) {
+            result = 1;
+        }
+        if (arguments[i].result != 0) {
+            result = 1;
+        }
+    }
+
+    whole = sgl_malloc(TEST_POOL_SIZE - 1024U);
+    if (whole == NULL) {
+        result = 1;
+    }
+    sgl_free(whole);
+
+    for (i = 0U; (i < TEST_MAGAZINE_BLOCK_COUNT) && (result == 0); ++i) {
+        blocks[i] = sgl_malloc(TEST_MAGAZINE_BLOCK_SIZE);
+        if (blocks[i] == NULL) {
+            result = 1;
+        }
+    }
+    sgl_free(blocks[0]);
+    sgl_free(blocks[0]);
+    first = sgl_malloc(TEST_MAGAZINE_BLOCK_SIZE);
+    second = sgl_malloc(TEST_MAGAZINE_BLOCK_SIZE);
+    if ((first == NULL) || (second == NULL) || (first == second)) {
+        result = 1;
+    }
+    sgl_free(first);
+    sgl_free(second);
+    for (i = 1U; i < TEST_MAGAZINE_BLOCK_COUNT; ++i) {
+        sgl_free(blocks[i]);
+    }
+
+    return result;
+}
 #endif
 
 static int test_run_pool_case(const char *name, test_case_t test_case)
@@ -789,6 +959,9 @@ int main(void)
             test_fragmentation_and_coalescing) != 0) {
         result = 1;
     }
+    if (test_run_pool_case("size class reuse", test_size_class_reuse) != 0) {
+        result = 1;
+    }
     if (test_run_pool_case(
             "randomized sequential stress",
             test_randomized_sequential_stress) != 0) {
@@ -808,6 +981,9 @@ int main(void)
             test_cross_thread_handoff) != 0) {
         result = 1;
     }
+    if (test_run_pool_case("thread magazines", test_thread_magazines) != 0) {
+        result = 1;
+    }
 #endif
 
     if (result == 0) {
@@ -10,11 +10,31 @@
 #include <stdint.h>
 #include <assert.h>
 #include <sgl-core.h>
+#include <sgl-osal.h>
 
 #define ARRAY_SIZE(arr) sizeof(arr) / sizeof(arr[0])
 #define SGL_TEST_MEMORY_POOL_SIZE   (64U * 1024U)
+#define SGL_TEST_LAP_COUNT          (5U)
+#define SGL_TEST_BENCH_MAX_THREADS  (64U)
+#define SGL_TEST_BENCH_CAPACITY     (1024U)
+#define SGL_TEST_WAIT_TIMEOUT_NS    (1000000U)
+#define SGL_TEST_PIPELINE_CAPACITY  (4U)
+#define SGL_TEST_PIPELINE_ENTRIES   (4096U)
+#define SGL_TEST_SPSC_CAPACITY      (256U)
+#ifndef SGL_TEST_BENCH_OPERATIONS
+#define SGL_TEST_BENCH_OPERATIONS   (131072U)
+#endif
 
 static unsigned char sgl_test_memory_pool[SGL_TEST_MEMORY_POOL_SIZE];
+static unsigned char sgl_test_entries[SGL_TEST_BENCH_MAX_THREADS];
+
+/* Row descriptor as a resize stage would hand it to the next one. */
+typedef struct {
+    sgl_size_t sequence;
+    const void *row;
+    sgl_int32_t width;
+    sgl_int32_t stride;
+} sgl_test_row_t;
 
 static SGL_ALWAYS_INLINE const char *test_memory_as_const_char(void *memory)
 {
@@ -34,6 +54,613 @@ const char *cheat_string[] = {
     "power overwhelming"
 };
 
+/*
+ * Both capacities, a power of two and not, keep FIFO order over several
+ * laps of the ring, report full and empty at the edges, and copy in order.
+ */
+static int sgl_test_queue_laps(sgl_size_t capacity)
+{
+    sgl_queue_t *queue;
+    sgl_queue_t *copy;
+    sgl_size_t lap;
+    sgl_size_t i;
+    int result;
+
+    result = 0;
+    queue = sgl_queue_create(capacity);
+    copy = sgl_queue_create(capacity + 1U);
+    if ((queue == SGL_NULL) || (copy == SGL_NULL) ||
+        (sgl_queue_dequeue(queue) != SGL_NULL) ||
+        (sgl_queue_peek(queue) != SGL_NULL) ||
+        (sgl_queue_is_empty(queue) != SGL_QUEUE_IS_EMPTY)) {
+        result = 1;
+    }
+    for (lap = 0U; (result == 0) && (lap < SGL_TEST_LAP_COUNT); ++lap) {
+        for (i = 0U; (result == 0) && (i < capacity); ++i) {
+            if (sgl_queue_enqueue(queue, &sgl_test_entries[lap + i]) != SGL_QUEUE_IS_NOT_FULL) {
+                result = 1;
+            }
+        }
+        if ((result == 0) &&
+            ((sgl_queue_enqueue(queue, &sgl_test_entries[0]) != SGL_QUEUE_IS_FULL) ||
+             (sgl_queue_is_full(queue) != SGL_QUEUE_IS_FULL) ||
+             (sgl_queue_get_count(queue) != capacity) ||
+             (sgl_queue_peek(queue) != &sgl_test_entries[lap]) ||
+             (sgl_queue_copy(copy, queue) != SGL_SUCCESS) ||
+             (sgl_queue_copy(queue, copy) != SGL_ERROR_MISSMATCHED_CAPACITY))) {
+            result = 1;
+        }
+        for (i = 0U; (result == 0) && (i < capacity); ++i) {
+            if ((sgl_queue_dequeue(queue) != &sgl_test_entries[lap + i]) ||
+                (sgl_queue_dequeue(copy) != &sgl_test_entries[lap + i])) {
+                result = 1;
+            }
+        }
+        if ((result == 0) &&
+            ((sgl_queue_dequeue(queue) != SGL_NULL) ||
+             (sgl_queue_get_count(copy) != 0U))) {
+            result = 1;
+        }
+        /* shift the ring by one so the next lap wraps mid-way */
+        if ((result == 0) &&
+            ((sgl_queue_unsafe_enqueue(queue, &sgl_test_entries[0]) != SGL_QUEUE_IS_NOT_FULL) ||
+             (sgl_queue_dequeue(queue) != &sgl_test_entries[0]))) {
+            result = 1;
+        }
+    }
+    sgl_queue_destroy(&queue);
+    sgl_queue_destroy(&copy);
+
+    return result;
+}
+
+/*
+ * Bulk calls move what fits and keep FIFO order across the wrap: with the
+ * ring shifted by one, a full-capacity run ends back at cell 0.  A run with
+ * a NULL entry is refused whole.
+ */
+static int sgl_test_queue_bulk(sgl_size_t capacity)
+{
+    void *in[SGL_TEST_LAP_COUNT * 2U];
+    void *out[SGL_TEST_LAP_COUNT * 2U];
+    sgl_queue_t *queue;
+    sgl_size_t i;
+    int result;
+
+    result = 0;
+    for (i = 0U; i < ARRAY_SIZE(in); ++i) {
+        in[i] = &sgl_test_entries[i];
+        out[i] = SGL_NULL;
+    }
+    queue = sgl_queue_create(capacity);
+    if ((queue == SGL_NULL) ||
+        (sgl_queue_dequeue_bulk(queue, out, capacity) != 0U) ||
+        (sgl_queue_unsafe_enqueue(queue, &sgl_test_entries[0]) != SGL_QUEUE_IS_NOT_FULL) ||
+        (sgl_queue_dequeue(queue) != &sgl_test_entries[0]) ||
+        (sgl_queue_enqueue_bulk(queue, in, ARRAY_SIZE(in)) != capacity) ||
+        (sgl_queue_enqueue_bulk(queue, in, 1U) != 0U) ||
+        (sgl_queue_dequeue_bulk(queue, out, 1U) != 1U) ||
+        (sgl_queue_dequeue_bulk(queue, &out[1], ARRAY_SIZE(out) - 1U) != (capacity - 1U)) ||
+        (sgl_queue_is_empty(queue) != SGL_QUEUE_IS_EMPTY)) {
+        result = 1;
+    }
+    for (i = 0U; (result == 0) && (i < capacity); ++i) {
+        if (out[i] != in[i]) {
+            result = 1;
+        }
+    }
+    in[1] = SGL_NULL;
+    if ((result == 0) &&
+        ((sgl_queue_enqueue_bulk(queue, in, 2U) != 0U) ||
+         (sgl_queue_enqueue_bulk(SGL_NULL, in, 1U) != 0U) ||
+         (sgl_queue_dequeue_bulk(queue, SGL_NULL, 1U) != 0U) ||
+         (sgl_queue_get_count(queue) != 0U))) {
+        result = 1;
+    }
+    sgl_queue_destroy(&queue);
+
+    return result;
+}
+
+/*
+ * Waits time out at the edges, only blocking queues take them, and after a
+ * close the producer side fails at once while the consumer side drains.
+ */
+static int sgl_test_queue_blocking(void)
+{
+    sgl_queue_t *plain;
+    sgl_queue_t *queue;
+    void *data;
+    int result;
+
+    result = 0;
+    plain = sgl_queue_create(2U);
+    queue = sgl_queue_create_blocking(2U);
+    if ((plain == SGL_NULL) || (queue == SGL_NULL) ||
+        (sgl_queue_enqueue_wait(plain, &sgl_test_entries[0], 0U) != SGL_ERROR_INVALID_ARGUMENTS) ||
+        (sgl_queue_dequeue_wait(plain, &data, 0U) != SGL_ERROR_INVALID_ARGUMENTS) ||
+        (sgl_queue_dequeue_wait(queue, &data, 0U) != SGL_QUEUE_IS_EMPTY) ||
+        (sgl_queue_dequeue_wait(queue, &data, SGL_TEST_WAIT_TIMEOUT_NS) != SGL_QUEUE_IS_EMPTY) ||
+        (sgl_queue_enqueue_wait(queue, &sgl_test_entries[0], 0U) != SGL_QUEUE_IS_NOT_FULL) ||
+        (sgl_queue_enqueue(queue, &sgl_test_entries[1]) != SGL_QUEUE_IS_NOT_FULL) ||
+        (sgl_queue_enqueue_wait(queue, &sgl_test_entries[2], SGL_TEST_WAIT_TIMEOUT_NS) != SGL_QUEUE_IS_FULL)) {
+        result = 1;
+    }
+    if (result == 0) {
+        sgl_queue_close(queue);
+        if ((sgl_queue_enqueue_wait(queue, &sgl_test_entries[2], SGL_QUEUE_WAIT_FOREVER) != SGL_QUEUE_IS_CLOSED) ||
+            (sgl_queue_dequeue_wait(queue, &data, SGL_QUEUE_WAIT_FOREVER) != SGL_QUEUE_IS_NOT_EMPTY) ||
+            (data != &sgl_test_entries[0]) ||
+            (sgl_queue_dequeue_wait(queue, &data, SGL_QUEUE_WAIT_FOREVER) != SGL_QUEUE_IS_NOT_EMPTY) ||
+            (data != &sgl_test_entries[1]) ||
+            (sgl_queue_dequeue_wait(queue, &data, SGL_QUEUE_WAIT_FOREVER) != SGL_QUEUE_IS_CLOSED)) {
+            result = 1;
+        }
+    }
+    sgl_queue_destroy(&plain);
+    sgl_queue_destroy(&queue);
+
+    return result;
+}
+
+/*
+ * The SPSC ring rounds its capacity up to a power of two, hands out the
+ * same slot until it is committed or released, reports full and empty at
+ * the edges, and keeps FIFO order over several laps.
+ */
+static int sgl_test_spsc_ring(void)
+{
+    sgl_spsc_ring_t *ring;
+    sgl_test_row_t row;
+    sgl_test_row_t *slot;
+    sgl_size_t i;
+    int result;
+
+    result = 0;
+    ring = sgl_spsc_ring_create(3U, sizeof(sgl_test_row_t));
+    if ((ring == SGL_NULL) ||
+        (sgl_spsc_ring_create(0U, sizeof(sgl_test_row_t)) != SGL_NULL) ||
+        (sgl_spsc_ring_create(4U, 0U) != SGL_NULL) ||
+        (sgl_spsc_ring_get_capacity(ring) != 4U) ||
+        (sgl_spsc_ring_peek(ring) != SGL_NULL) ||
+        (sgl_spsc_ring_pop(ring, &row) != SGL_QUEUE_IS_EMPTY) ||
+        (sgl_spsc_ring_reserve(ring) != sgl_spsc_ring_reserve(ring))) {
+        result = 1;
+    }
+    for (i = 0U; (result == 0) && (i < 4U); ++i) {
+        /* cppcheck-suppress misra-c2012-11.5 */
+        slot = (sgl_test_row_t *)sgl_spsc_ring_reserve(ring);
+        if (slot == SGL_NULL) {
+            result = 1;
+        }
+        else {
+            slot->sequence = i;
+            sgl_spsc_ring_commit(ring);
+        }
+    }
+    row.sequence = 4U;
+    if ((result == 0) &&
+        ((sgl_spsc_ring_reserve(ring) != SGL_NULL) ||
+         (sgl_spsc_ring_push(ring, &row) != SGL_QUEUE_IS_FULL) ||
+         (sgl_spsc_ring_get_count(ring) != 4U) ||
+         (sgl_spsc_ring_peek(ring) != sgl_spsc_ring_peek(ring)))) {
+        result = 1;
+    }
+    /* keep the ring full while it laps: pop the oldest, push the next */
+    for (i = 0U; (result == 0) && (i < (SGL_TEST_LAP_COUNT * 4U)); ++i) {
+        if ((sgl_spsc_ring_pop(ring, &row) != SGL_QUEUE_IS_NOT_EMPTY) ||
+            (row.sequence != i)) {
+            result = 1;
+        }
+        row.sequence = i + 4U;
+        if ((result == 0) && (sgl_spsc_ring_push(ring, &row) != SGL_QUEUE_IS_NOT_FULL)) {
+            result = 1;
+        }
+    }
+    for (i = 0U; (result == 0) && (i < 4U); ++i) {
+        /* cppcheck-suppress misra-c2012-11.5 */
+        slot = (sgl_test_row_t *)sgl_spsc_ring_peek(ring);
+        if ((slot == SGL_NULL) || (slot->sequence != ((SGL_TEST_LAP_COUNT * 4U) + i))) {
+            result = 1;
+        }
+        sgl_spsc_ring_release(ring);
+    }
+    if ((result == 0) && (sgl_spsc_ring_get_count(ring) != 0U)) {
+        result = 1;
+    }
+    sgl_spsc_ring_destroy(&ring);
+
+    return result;
+}
+
+#if defined(SGL_CFG_HAS_THREAD)
+/*
+ * Streaming pipeline
+ * ------------------
+ * A producer stage pushes a sequence through a ring much smaller than it
+ * and closes; the consumer blocks on the other end.  Both sides park in
+ * turn, and the consumer must see every entry in order before the close.
+ */
+static sgl_osal_thread_return_t sgl_test_pipeline_producer(sgl_osal_thread_arg_t argument)
+{
+    sgl_queue_t *queue;
+    sgl_size_t i;
+
+    /* cppcheck-suppress misra-c2012-11.5 */
+    queue = (sgl_queue_t *)argument;
+    for (i = 0U; i < SGL_TEST_PIPELINE_ENTRIES; ++i) {
+        (void)sgl_queue_enqueue_wait(
+            queue, &sgl_test_entries[i % SGL_TEST_BENCH_MAX_THREADS], SGL_QUEUE_WAIT_FOREVER);
+    }
+    sgl_queue_close(queue);
+
+    EXIT_ROUTINE
+}
+
+static int sgl_test_queue_pipeline(void)
+{
+    sgl_osal_thread_t producer;
+    sgl_queue_t *queue;
+    sgl_result_t status;
+    sgl_size_t received;
+    void *data;
+    int result;
+
+    result = 0;
+    received = 0U;
+    producer = NULL_THREAD;
+    queue = sgl_queue_create_blocking(SGL_TEST_PIPELINE_CAPACITY);
+    if (queue != SGL_NULL) {
+        producer = sgl_thread_create(sgl_test_pipeline_producer, queue);
+    }
+    if (producer == NULL_THREAD) {
+        result = 1;
+    }
+    status = SGL_QUEUE_IS_NOT_EMPTY;
+    while ((result == 0) && (status == SGL_QUEUE_IS_NOT_EMPTY)) {
+        status = sgl_queue_dequeue_wait(queue, &data, SGL_QUEUE_WAIT_FOREVER);
+        if (status == SGL_QUEUE_IS_NOT_EMPTY) {
+            if (data != &sgl_test_entries[received % SGL_TEST_BENCH_MAX_THREADS]) {
+                result = 1;
+            }
+            received++;
+        }
+    }
+    if (producer != NULL_THREAD) {
+        sgl_osal_thread_join(producer);
+    }
+    if ((result == 0) &&
+        ((status != SGL_QUEUE_IS_CLOSED) || (received != SGL_TEST_PIPELINE_ENTRIES))) {
+        result = 1;
+    }
+    sgl_queue_destroy(&queue);
+
+    return result;
+}
+
+/*
+ * Contended throughput
+ * --------------------
+ * Every thread enqueues its own entry and dequeues whatever comes next,
+ * operations times, so at most one entry per thread is in the ring and
+ * every call contends with all other threads on the same positions.  The
+ * reference ring is the spinlock-protected queue this one replaced.
+ */
+typedef struct {
+    void *data[SGL_TEST_BENCH_CAPACITY];
+    sgl_size_t capacity;
+    sgl_size_t count;
+    sgl_size_t head;
+    sgl_size_t tail;
+    sgl_osal_spinlock_t lock;
+} sgl_test_spinlock_queue_t;
+
+typedef struct {
+    sgl_queue_t *queue;
+    sgl_test_spinlock_queue_t *reference;
+    sgl_size_t index;
+    sgl_size_t operations;
+    sgl_size_t received[SGL_TEST_BENCH_MAX_THREADS];
+} sgl_test_bench_thread_t;
+
+static sgl_bool_t sgl_test_spinlock_enqueue(sgl_test_spinlock_queue_t *queue, void *data)
+{
+    sgl_bool_t result = SGL_FALSE;
+
+    sgl_osal_spinlock_lock(&queue->lock);
+    if (queue->count < queue->capacity) {
+        queue->data[queue->head] = data;
+        queue->head = (queue->head + 1U) % queue->capacity;
+        queue->count++;
+        result = SGL_TRUE;
+    }
+    sgl_osal_spinlock_unlock(&queue->lock);
+
+    return result;
+}
+
+static void *sgl_test_spinlock_dequeue(sgl_test_spinlock_queue_t *queue)
+{
+    void *data = SGL_NULL;
+
+    sgl_osal_spinlock_lock(&queue->lock);
+    if (queue->count > 0U) {
+        data = queue->data[queue->tail];
+        queue->tail = (queue->tail + 1U) % queue->capacity;
+        queue->count--;
+    }
+    sgl_osal_spinlock_unlock(&queue->lock);
+
+    return data;
+}
+
+static sgl_osal_thread_return_t sgl_test_bench_thread(sgl_osal_thread_arg_t argument)
+{
+    sgl_test_bench_thread_t *context;
+    unsigned char *entry;
+    sgl_size_t i;
+    sgl_bool_t is_queued;
+
+    /* cppcheck-suppress misra-c2012-11.5 */
+    context = (sgl_test_bench_thread_t *)argument;
+    for (i = 0U; i < context->operations; ++i) {
+        is_queued = SGL_FALSE;
+        while (is_queued == SGL_FALSE) {
+            if (context->queue != SGL_NULL) {
+                is_queued = (sgl_queue_enqueue(
+                    context->queue, &sgl_test_entries[context->index]) == SGL_QUEUE_IS_NOT_FULL) ?
+                    SGL_TRUE : SGL_FALSE;
+            }
+            else {
+                is_queued = sgl_test_spinlock_enqueue(
+                    context->reference, &sgl_test_entries[context->index]);
+            }
+        }
+        entry = SGL_NULL;
+        while (entry == SGL_NULL) {
+            /* a producer between its claim and its write hides later entries */
+            if (context->queue != SGL_NULL) {
+                /* cppcheck-suppress misra-c2012-11.5 */
+                entry = (unsigned char *)sgl_queue_dequeue(context->queue);
+            }
+            else {
+                /* cppcheck-suppress misra-c2012-11.5 */
+                entry = (unsigned char *)sgl_test_spinlock_dequeue(context->reference);
+            }
+            if (entry == SGL_NULL) {
+                sgl_osal_yield_thread();
+            }
+        }
+        context->received[entry - sgl_test_entries]++;
+    }
+
+    EXIT_ROUTINE
+}
+
+/* Returns operations per microsecond, or a negative value on a lost or duplicated entry. */
+static double sgl_test_bench_run(
+    sgl_queue_t *queue,
+    sgl_test_spinlock_queue_t *reference,
+    sgl_size_t thread_count)
+{
+    static sgl_test_bench_thread_t contexts[SGL_TEST_BENCH_MAX_THREADS];
+    sgl_osal_thread_t threads[SGL_TEST_BENCH_MAX_THREADS];
+    sgl_size_t received;
+    sgl_uint64_t start_ns;
+    sgl_uint64_t elapsed_ns;
+    sgl_size_t i;
+    sgl_size_t j;
+    double result;
+
+    (void)sgl_memset(contexts, 0, sizeof(contexts));
+    start_ns = sgl_osal_get_monotonic_ns();
+    for (i = 0U; i < thread_count; ++i) {
+        contexts[i].queue = queue;
+        contexts[i].reference = reference;
+        contexts[i].index = i;
+        contexts[i].operations = SGL_TEST_BENCH_OPERATIONS / thread_count;
+        threads[i] = sgl_thread_create(sgl_test_bench_thread, &contexts[i]);
+    }
+    for (i = 0U; i < thread_count; ++i) {
+        if (threads[i] != NULL_THREAD) {
+            sgl_osal_thread_join(threads[i]);
+        }
+    }
+    elapsed_ns = sgl_osal_get_monotonic_ns() - start_ns;
+
+    result = (double)(2U * (SGL_TEST_BENCH_OPERATIONS / thread_count) * thread_count) * 1000.0 /
+             (double)((elapsed_ns != 0U) ? elapsed_ns : 1U);
+    for (j = 0U; j < thread_count; ++j) {
+        received = 0U;
+        for (i = 0U; i < thread_count; ++i) {
+            received += contexts[i].received[j];
+        }
+        if ((threads[j] == NULL_THREAD) || (received != contexts[j].operations)) {
+            result = -1.0;
+        }
+    }
+
+    return result;
+}
+
+static int sgl_test_queue_benchmark(void)
+{
+    static sgl_test_spinlock_queue_t reference;
+    sgl_queue_t *queue;
+    sgl_size_t thread_count;
+    double lock_free;
+    double spinlock;
+    int result;
+
+    result = 0;
+    reference.capacity = SGL_TEST_BENCH_CAPACITY;
+    sgl_osal_spinlock_init(&reference.lock);
+    queue = sgl_queue_create(SGL_TEST_BENCH_CAPACITY);
+    if (queue == SGL_NULL) {
+        result = 1;
+    }
+    printf("threads  lock-free ops/us  spinlock ops/us\n");
+    for (thread_count = 1U;
+         (result == 0) && (thread_count <= SGL_TEST_BENCH_MAX_THREADS);
+         thread_count *= 2U) {
+        lock_free = sgl_test_bench_run(queue, SGL_NULL, thread_count);
+        spinlock = sgl_test_bench_run(SGL_NULL, &reference, thread_count);
+        printf("%7zu  %16.2f  %15.2f\n", (size_t)thread_count, lock_free, spinlock);
+        if ((lock_free < 0.0) || (spinlock < 0.0) ||
+            (sgl_queue_get_count(queue) != 0U)) {
+            result = 1;
+        }
+    }
+    sgl_queue_destroy(&queue);
+    sgl_osal_spinlock_destroy(&reference.lock);
+
+    return result;
+}
+
+/*
+ * SPSC throughput
+ * ---------------
+ * One producer thread hands row descriptors to the consumer, which checks
+ * their order.  The SPSC ring builds each descriptor in its slot; the MPMC
+ * queue can only carry pointers, so its descriptors come from a second
+ * queue of free ones that the consumer hands them back to.
+ */
+typedef struct {
+    sgl_spsc_ring_t *ring;
+    sgl_queue_t *queue;
+    sgl_queue_t *free_rows;
+} sgl_test_spsc_bench_t;
+
+static sgl_osal_thread_return_t sgl_test_spsc_bench_producer(sgl_osal_thread_arg_t argument)
+{
+    sgl_test_spsc_bench_t *context;
+    sgl_test_row_t *slot;
+    sgl_size_t i;
+
+    /* cppcheck-suppress misra-c2012-11.5 */
+    context = (sgl_test_spsc_bench_t *)argument;
+    for (i = 0U; i < SGL_TEST_BENCH_OPERATIONS; ++i) {
+        slot = SGL_NULL;
+        while (slot == SGL_NULL) {
+            if (context->ring != SGL_NULL) {
+                /* cppcheck-suppress misra-c2012-11.5 */
+                slot = (sgl_test_row_t *)sgl_spsc_ring_reserve(context->ring);
+            }
+            else {
+                /* cppcheck-suppress misra-c2012-11.5 */
+                slot = (sgl_test_row_t *)sgl_queue_dequeue(context->free_rows);
+            }
+            if (slot == SGL_NULL) {
+                sgl_osal_yield_thread();
+            }
+        }
+        slot->sequence = i;
+        slot->row = sgl_test_entries;
+        slot->width = (sgl_int32_t)SGL_TEST_BENCH_MAX_THREADS;
+        slot->stride = (sgl_int32_t)SGL_TEST_BENCH_MAX_THREADS;
+        if (context->ring != SGL_NULL) {
+            sgl_spsc_ring_commit(context->ring);
+        }
+        else {
+            (void)sgl_queue_enqueue(context->queue, slot);
+        }
+    }
+
+    EXIT_ROUTINE
+}
+
+/* Returns descriptors per microsecond, or a negative value on a lost or reordered one. */
+static double sgl_test_spsc_bench_run(sgl_test_spsc_bench_t *context)
+{
+    sgl_osal_thread_t producer;
+    const sgl_test_row_t *slot;
+    sgl_uint64_t start_ns;
+    sgl_uint64_t elapsed_ns;
+    sgl_size_t i;
+    double result;
+
+    result = 0.0;
+    start_ns = sgl_osal_get_monotonic_ns();
+    producer = sgl_thread_create(sgl_test_spsc_bench_producer, context);
+    if (producer == NULL_THREAD) {
+        result = -1.0;
+    }
+    for (i = 0U; (result == 0.0) && (i < SGL_TEST_BENCH_OPERATIONS); ++i) {
+        slot = SGL_NULL;
+        while (slot == SGL_NULL) {
+            if (context->ring != SGL_NULL) {
+                /* cppcheck-suppress misra-c2012-11.5 */
+                slot = (const sgl_test_row_t *)sgl_spsc_ring_peek(context->ring);
+            }
+            else {
+                /* cppcheck-suppress misra-c2012-11.5 */
+                slot = (const sgl_test_row_t *)sgl_queue_dequeue(context->queue);
+            }
+            if (slot == SGL_NULL) {
+                sgl_osal_yield_thread();
+            }
+        }
+        if ((slot->sequence != i) || (slot->width != (sgl_int32_t)SGL_TEST_BENCH_MAX_THREADS)) {
+            result = -1.0;
+        }
+        if (context->ring != SGL_NULL) {
+            sgl_spsc_ring_release(context->ring);
+        }
+        else {
+            (void)sgl_queue_enqueue(context->free_rows, slot);
+        }
+    }
+    if (producer != NULL_THREAD) {
+        sgl_osal_thread_join(producer);
+    }
+    elapsed_ns = sgl_osal_get_monotonic_ns() - start_ns;
+    if (result == 0.0) {
+        result = (double)SGL_TEST_BENCH_OPERATIONS * 1000.0 /
+                 (double)((elapsed_ns != 0U) ? elapsed_ns : 1U);
+    }
+
+    return result;
+}
+
+static int sgl_test_spsc_benchmark(void)
+{
+    static sgl_test_row_t rows[SGL_TEST_SPSC_CAPACITY];
+    sgl_test_spsc_bench_t context;
+    sgl_size_t i;
+    double spsc;
+    double mpmc;
+    int result;
+
+    result = 0;
+    context.ring = sgl_spsc_ring_create(SGL_TEST_SPSC_CAPACITY, sizeof(sgl_test_row_t));
+    context.queue = SGL_NULL;
+    context.free_rows = SGL_NULL;
+    spsc = -1.0;
+    if (context.ring != SGL_NULL) {
+        spsc = sgl_test_spsc_bench_run(&context);
+    }
+    sgl_spsc_ring_destroy(&context.ring);
+    context.queue = sgl_queue_create(SGL_TEST_SPSC_CAPACITY);
+    context.free_rows = sgl_queue_create(SGL_TEST_SPSC_CAPACITY);
+    mpmc = -1.0;
+    if ((context.queue != SGL_NULL) && (context.free_rows != SGL_NULL)) {
+        for (i = 0U; i < SGL_TEST_SPSC_CAPACITY; ++i) {
+            (void)sgl_queue_unsafe_enqueue(context.free_rows, &rows[i]);
+        }
+        mpmc = sgl_test_spsc_bench_run(&context);
+    }
+    sgl_queue_destroy(&context.queue);
+    sgl_queue_destroy(&context.free_rows);
+    printf("1:1 row descriptors  spsc ops/us  mpmc ops/us\n");
+    printf("                     %11.2f  %11.2f\n", spsc, mpmc);
+    if ((spsc < 0.0) || (mpmc < 0.0)) {
+        result = 1;
+    }
+
+    return result;
+}
+#endif  /* SGL_CFG_HAS_THREAD */
+
 int main(int argc, char *argv[]) {
     sgl_queue_t *queue = NULL;
     size_t capacity = ARRAY_SIZE(cheat_string);
@@ -69,6 +696,25 @@ int main(int argc, char *argv[]) {
         else {
             result = 1;
         }
+        if ((sgl_test_queue_laps(4U) != 0) ||
+            (sgl_test_queue_laps(3U) != 0) ||
+            (sgl_test_queue_bulk(4U) != 0) ||
+            (sgl_test_queue_bulk(3U) != 0) ||
+            (sgl_test_queue_blocking() != 0) ||
+            (sgl_test_spsc_ring() != 0)) {
+            result = 1;
+        }
+#if defined(SGL_CFG_HAS_THREAD)
+        if ((result == 0) && (sgl_test_queue_pipeline() != 0)) {
+            result = 1;
+        }
+        if ((result == 0) && (sgl_test_queue_benchmark() != 0)) {
+            result = 1;
+        }
+        if ((result == 0) && (sgl_test_spsc_benchmark() != 0)) {
+            result = 1;
+        }
+#endif
         printf("----------End Queue Test-------------\n");
     }
     if (sgl_memory_pool_deinitialize() != SGL_SUCCESS) {
@@ -0,0 +1,400 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright (c) 2025 Dylan Hong
+ *
+ * This code is released under the MIT License.
+ * For conditions of distribution and use, see the LICENSE file.
+ */
+#include <stdint.h>
+#include <stdio.h>
+#include <sgl-core.h>
+#include "util.h"
+
+#define TEST_MAX_BPP                (5)
+#define TEST_LARGE_WIDTH            (1031)
+#define TEST_LARGE_HEIGHT           (777)
+#define TEST_WORKER_COUNT           (4U)
+
+typedef struct {
+    int32_t width;
+    int32_t height;
+} test_size_t;
+
+typedef enum {
+    TEST_METHOD_NEAREST,
+    TEST_METHOD_BILINEAR,
+    TEST_METHOD_BICUBIC,
+    TEST_METHOD_COUNT,
+} test_method_t;
+
+static const char *test_rotation_names[] = {
+    "rotate-0", "rotate-90", "rotate-180", "rotate-270",
+    "flip-horizontal", "flip-vertical", "transpose", "transverse"
+};
+
+/*
+ * Reference placement of source pixel (x, y) for a w x h source.
+ *
+ *   90 : (h - 1 - y, x)        270 : (y, w - 1 - x)
+ *   T  : (y, x)                TV  : (h - 1 - y, w - 1 - x)
+ */
+static void test_reference_position(
+    sgl_rotation_t rotation,
+    int32_t width, int32_t height,
+    int32_t x, int32_t y,
+    int32_t *dx, int32_t *dy, int32_t *d_width)
+{
+    *d_width = width;
+    switch (rotation) {
+    case SGL_ROTATE_90:
+        *dx = height - 1 - y;
+        *dy = x;
+        *d_width = height;
+        break;
+    case SGL_ROTATE_180:
+        *dx = width - 1 - x;
+        *dy = height - 1 - y;
+        break;
+    case SGL_ROTATE_270:
+        *dx = y;
+        *dy = width - 1 - x;
+        *d_width = height;
+        break;
+    case SGL_FLIP_HORIZONTAL:
+        *dx = width - 1 - x;
+        *dy = y;
+        break;
+    case SGL_FLIP_VERTICAL:
+        *dx = x;
+        *dy = height - 1 - y;
+        break;
+    case SGL_TRANSPOSE:
+        *dx = y;
+        *dy = x;
+        *d_width = height;
+        break;
+    case SGL_TRANSVERSE:
+        *dx = height - 1 - y;
+        *dy = width - 1 - x;
+        *d_width = height;
+        break;
+    default:
+        *dx = x;
+        *dy = y;
+        break;
+    }
+}
+
+static int test_rotate_case(
+    sgl_threadpool_t *pool,
+    int32_t width, int32_t height,
+    int32_t bpp, sgl_rotation_t rotation)
+{
+    sgl_uint8_t *src;
+    sgl_uint8_t *dst;
+    size_t size;
+    int32_t x;
+    int32_t y;
+    int32_t c;
+    int32_t dx;
+    int32_t dy;
+    int32_t d_width;
+    int result;
+
+    result = 0;
+    size = (size_t)width * (size_t)height * (size_t)bpp;
+    src = (sgl_uint8_t *)sgl_malloc(size);
+    dst = (sgl_uint8_t *)sgl_malloc(size);
+    if ((src == SGL_NULL) || (dst == SGL_NULL)) {
+        result = 1;
+    }
+
+    if (result == 0) {
+        for (y = 0; y < height; ++y) {
+            for (x = 0; x < width; ++x) {
+                for (c = 0; c < bpp; ++c) {
+                    src[(((size_t)y * (size_t)width) + (size_t)x) * (size_t)bpp + (size_t)c] =
+                        sgl_test_pattern_byte(x, y, c);
+                }
+            }
+        }
+        (void)sgl_memset(dst, 0x5A, size);
+        if (sgl_rotate(pool, dst, src, width, height, bpp, rotation) != SGL_SUCCESS) {
+            result = 1;
+        }
+    }
+
+    for (y = 0; (result == 0) && (y < height); ++y) {
+        for (x = 0; (result == 0) && (x < width); ++x) {
+            test_reference_position(rotation, width, height, x, y, &dx, &dy, &d_width);
+            for (c = 0; c < bpp; ++c) {
+                if (dst[(((size_t)dy * (size_t)d_width) + (size_t)dx) * (size_t)bpp + (size_t)c] !=
+                    sgl_test_pattern_byte(x, y, c)) {
+                    result = 1;
+                }
+            }
+        }
+    }
+
+    if (result != 0) {
+        printf("FAIL %s %dx%d bpp=%d pool=%s\n",
+               test_rotation_names[rotation], width, height, bpp,
+               (pool != SGL_NULL) ? "yes" : "no");
+    }
+    SGL_SAFE_FREE(src);
+    SGL_SAFE_FREE(dst);
+
+    return result;
+}
+
+static int test_rotate_invalid_arguments(void)
+{
+    sgl_uint8_t buffer[16];
+    int result;
+
+    result = 0;
+    if (sgl_rotate(SGL_NULL, SGL_NULL, buffer, 2, 2, 1, SGL_ROTATE_90) !=
+        SGL_ERROR_INVALID_ARGUMENTS) {
+        result = 1;
+    }
+    if (sgl_rotate(SGL_NULL, buffer, &buffer[8], 2, 2, 1, (sgl_rotation_t)99) !=
+        SGL_ERROR_INVALID_ARGUMENTS) {
+        result = 1;
+    }
+    if (sgl_rotate(SGL_NULL, &buffer[8], buffer, 0, 2, 1, SGL_ROTATE_0) !=
+        SGL_ERROR_INVALID_ARGUMENTS) {
+        result = 1;
+    }
+
+    return result;
+}
+
+static int test_rotate_all(sgl_threadpool_t *pool)
+{
+    static const test_size_t sizes[] = {
+        { 1, 1 }, { 1, 9 }, { 9, 1 }, { 8, 8 }, { 7, 13 },
+        { 16, 24 }, { 65, 3 }, { 67, 129 }, { 130, 71 }
+    };
+    int32_t size_index;
+    int32_t bpp;
+    int32_t rotation;
+    int result;
+
+    result = 0;
+    for (size_index = 0;
+         size_index < (int32_t)(sizeof(sizes) / sizeof(sizes[0]));
+         ++size_index) {
+        for (bpp = 1; bpp <= TEST_MAX_BPP; ++bpp) {
+            for (rotation = (int32_t)SGL_ROTATE_0;
+                 rotation <= (int32_t)SGL_TRANSVERSE;
+                 ++rotation) {
+                result |= test_rotate_case(
+                    pool, sizes[size_index].width, sizes[size_index].height,
+                    bpp, (sgl_rotation_t)rotation);
+            }
+        }
+    }
+
+    /* large enough to cross the threadpool threshold */
+    for (rotation = (int32_t)SGL_ROTATE_0;
+         rotation <= (int32_t)SGL_TRANSVERSE;
+         ++rotation) {
+        result |= test_rotate_case(
+            pool, TEST_LARGE_WIDTH, TEST_LARGE_HEIGHT, 4,
+            (sgl_rotation_t)rotation);
+        result |= test_rotate_case(
+            pool, TEST_LARGE_WIDTH, TEST_LARGE_HEIGHT, 3,
+            (sgl_rotation_t)rotation);
+    }
+
+    return result;
+}
+
+static sgl_result_t test_resize(
+    test_method_t method,
+    sgl_uint8_t *dst, int32_t d_width, int32_t d_height,
+    sgl_uint8_t *src, int32_t s_width, int32_t s_height, int32_t bpp)
+{
+    sgl_result_t result;
+
+    switch (method) {
+    case TEST_METHOD_NEAREST:
+        result = sgl_generic_resize_nearest(
+            SGL_NULL, SGL_NULL, dst, d_width, d_height, src, s_width, s_height, bpp);
+        break;
+    case TEST_METHOD_BILINEAR:
+        result = sgl_generic_resize_bilinear(
+            SGL_NULL, SGL_NULL, dst, d_width, d_height, src, s_width, s_height, bpp);
+        break;
+    default:
+        result = sgl_generic_resize_bicubic(
+            SGL_NULL, SGL_NULL, dst, d_width, d_height, src, s_width, s_height, bpp);
+        break;
+    }
+
+    return result;
+}
+
+static sgl_result_t test_resize_rotate(
+    sgl_threadpool_t *pool, test_method_t method,
+    sgl_uint8_t *dst, int32_t d_width, int32_t d_height,
+    sgl_uint8_t *src, int32_t s_width, int32_t s_height, int32_t bpp,
+    sgl_rotation_t rotation)
+{
+    sgl_result_t result;
+
+    switch (method) {
+    case TEST_METHOD_NEAREST:
+        result = sgl_generic_resize_nearest_rotate(
+            pool, SGL_NULL, dst, d_width, d_height, src, s_width, s_height, bpp, rotation);
+        break;
+    case TEST_METHOD_BILINEAR:
+        result = sgl_generic_resize_bilinear_rotate(
+            pool, SGL_NULL, dst, d_width, d_height, src, s_width, s_height, bpp, rotation);
+        break;
+    default:
+        result = sgl_generic_resize_bicubic_rotate(
+            pool, SGL_NULL, dst, d_width, d_height, src, s_width, s_height, bpp, rotation);
+        break;
+    }
+
+    return result;
+}
+
+/*
+ * The fused path must match resize followed by rotate byte for byte, because
+ * every band reuses the rows of the full-image look-up table.
+ *
+ *   src --resize--> R --sgl_rotate--> expected
+ *   src --------resize_rotate-------> fused
+ */
+static int test_resize_rotate_case(
+    sgl_threadpool_t *pool, test_method_t method,
+    int32_t s_width, int32_t s_height, int32_t d_width, int32_t d_height,
+    int32_t bpp, sgl_rotation_t rotation)
+{
+    sgl_uint8_t *src;
+    sgl_uint8_t *resized;
+    sgl_uint8_t *expected;
+    sgl_uint8_t *fused;
+    size_t s_size;
+    size_t d_size;
+    size_t index;
+    int32_t r_width;
+    int32_t r_height;
+    int result;
+
+    result = 0;
+    r_width = d_width;
+    r_height = d_height;
+    if ((rotation == SGL_ROTATE_90) || (rotation == SGL_ROTATE_270) ||
+        (rotation == SGL_TRANSPOSE) || (rotation == SGL_TRANSVERSE)) {
+        r_width = d_height;
+        r_height = d_width;
+    }
+    s_size = (size_t)s_width * (size_t)s_height * (size_t)bpp;
+    d_size = (size_t)d_width * (size_t)d_height * (size_t)bpp;
+    src = (sgl_uint8_t *)sgl_malloc(s_size);
+    resized = (sgl_uint8_t *)sgl_malloc(d_size);
+    expected = (sgl_uint8_t *)sgl_malloc(d_size);
+    fused = (sgl_uint8_t *)sgl_malloc(d_size);
+    if ((src == SGL_NULL) || (resized == SGL_NULL) ||
+        (expected == SGL_NULL) || (fused == SGL_NULL)) {
+        result = 1;
+    }
+
+    if (result == 0) {
+        for (index = 0U; index < s_size; ++index) {
+            src[index] = sgl_test_pattern_byte((int32_t)index, (int32_t)(index >> 9U), 0);
+        }
+        if ((test_resize(method, resized, r_width, r_height, src, s_width, s_height, bpp) != SGL_SUCCESS) ||
+            (sgl_rotate(SGL_NULL, expected, resized, r_width, r_height, bpp, rotation) != SGL_SUCCESS) ||
+            (test_resize_rotate(pool, method, fused, d_width, d_height,
+                                src, s_width, s_height, bpp, rotation) != SGL_SUCCESS)) {
+            result = 1;
+        }
+    }
+    for (index = 0U; (result == 0) && (index < d_size); ++index) {
+        if (fused[index] != expected[index]) {
+            result = 1;
+        }
+    }
+
+    if (result != 0) {
+        printf("FAIL resize-rotate method=%d %s %dx%d->%dx%d bpp=%d pool=%s\n",
+               (int)method, test_rotation_names[rotation], s_width, s_height,
+               d_width, d_height, bpp, (pool != SGL_NULL) ? "yes" : "no");
+    }
+    SGL_SAFE_FREE(src);
+    SGL_SAFE_FREE(resized);
+    SGL_SAFE_FREE(expected);
+    SGL_SAFE_FREE(fused);
+
+    return result;
+}
+
+static int test_resize_rotate_all(sgl_threadpool_t *pool)
+{
+    int32_t method;
+    int32_t bpp;
+    int32_t rotation;
+    int result;
+
+    result = 0;
+    for (method = 0; method < (int32_t)TEST_METHOD_COUNT; ++method) {
+        for (bpp = 1; bpp <= 4; ++bpp) {
+            for (rotation = (int32_t)SGL_ROTATE_0;
+                 rotation <= (int32_t)SGL_TRANSVERSE;
+                 ++rotation) {
+                /* downscale and upscale, with partial bands and tiles */
+                result |= test_resize_rotate_case(
+                    pool, (test_method_t)method, 403, 301, 131, 97,
+                    bpp, (sgl_rotation_t)rotation);
+                result |= test_resize_rotate_case(
+                    pool, (test_method_t)method, 37, 29, 83, 150,
+                    bpp, (sgl_rotation_t)rotation);
+            }
+        }
+    }
+
+    return result;
+}
+
+int main(void)
+{
+    sgl_threadpool_t *pool;
+    int result;
+
+    result = 0;
+    pool = SGL_NULL;
+    if (sgl_test_pool_initialize() != SGL_SUCCESS) {
+        result = 1;
+    }
+    if (result == 0) {
+        result |= test_rotate_invalid_arguments();
+        result |= test_rotate_all(SGL_NULL);
+        result |= test_resize_rotate_all(SGL_NULL);
+    }
+#if defined(SGL_CFG_HAS_THREAD)
+    if (result == 0) {
+        pool = sgl_threadpool_create(
+            TEST_WORKER_COUNT, SGL_THREADPOOL_DEFAULT_MAX_ROUTINE_LISTS, "rotate-test");
+        if (pool == SGL_NULL) {
+            result = 1;
+        }
+        else {
+            result |= test_rotate_all(pool);
+            result |= test_resize_rotate_all(pool);
+            (void)sgl_threadpool_destroy(pool);
+        }
+    }
+#endif  /* !SGL_CFG_HAS_THREAD */
+    if (sgl_memory_pool_deinitialize() != SGL_SUCCESS) {
+        result = 1;
+    }
+
+    printf("rotate test %s\n", (result == 0) ? "passed" : "failed");
+
+    return result;
+}
@@ -16,6 +16,26 @@
 #define SGL_TEST_ITERATION_COUNT     (2000U)
 #define SGL_TEST_TASK_COUNT          (8U)
 #define SGL_TEST_WORKER_COUNT        (8U)
+#define SGL_TEST_ASYNC_TASK_COUNT    (6U)
+#define SGL_TEST_STEAL_TASK_COUNT    (257U)
+#define SGL_TEST_STEAL_SPIN_COUNT    (20000U)
+#define SGL_TEST_RANGE_BEGIN         (-37)
+#define SGL_TEST_RANGE_END           (1000)
+#define SGL_TEST_RANGE_GRAIN         (7)
+#define SGL_TEST_SCRATCH_ALIGNMENT   (64U)
+#define SGL_TEST_SCRATCH_FIXED_SIZE  (48U)
+#define SGL_TEST_SCRATCH_ROW_SIZE    (16U)
+#define SGL_TEST_PLACED_WORKER_COUNT (4U)
+#define SGL_TEST_SPIN_LIMIT_US_INVALID (1000001U)
+#define SGL_TEST_RESIZE_MAX_WORKERS  (4U)
+#define SGL_TEST_RESIZE_CHUNKS       (64)
+#define SGL_TEST_GRAPH_ROWS          (256)
+#define SGL_TEST_GRAPH_RUN_COUNT     (3U)
+#define SGL_TEST_PRIORITY_INVALID    (2)
+#define SGL_TEST_CLAIM_CHUNKS        (1000)
+#define SGL_TEST_NESTED_ITEMS        (16U)
+#define SGL_TEST_NESTED_ROWS         (64)
+#define SGL_TEST_CANCEL_CHUNKS       (256)
 
 typedef struct {
     uint32_t execution_count;
@@ -26,6 +46,13 @@ typedef struct {
     int result;
 } sgl_test_submitter_context_t;
 
+typedef struct {
+    uint32_t planes[SGL_TEST_GRAPH_ROWS];
+    uint32_t converted[SGL_TEST_GRAPH_ROWS];
+    uint32_t scaled[SGL_TEST_GRAPH_ROWS / 2];
+    uint32_t total;
+} sgl_test_graph_frame_t;
+
 static SGL_ALIGNED(64) unsigned char
     sgl_test_memory_pool[SGL_TEST_MEMORY_POOL_SIZE];
 
@@ -44,8 +71,8 @@ static void sgl_test_threadpool_routine(void *current, void *cookie)
  * attach_routine_consuming() is synchronous, so a task must be incremented
  * exactly once before its owner publishes the next iteration.
  *
- *   submitter[0..3] -> serialized publication -> shared worker generation
- *                   <- synchronous completion <- operation queue drained
+ *   submitter[0..3] -> concurrent tasks in flight -> shared workers
+ *                   <- synchronous completion     <- own queue drained
  */
 static sgl_osal_thread_return_t sgl_test_threadpool_submitter(
     sgl_osal_thread_arg_t argument)
@@ -146,34 +173,1398 @@ static int sgl_test_threadpool_preserves_queue(sgl_threadpool_t *threadpool)
     return result;
 }
 
-int main(void)
+static void sgl_test_threadpool_uneven_routine(void *current, void *cookie)
 {
-    sgl_test_submitter_context_t contexts[SGL_TEST_SUBMITTER_COUNT];
-    sgl_osal_thread_t submitters[SGL_TEST_SUBMITTER_COUNT];
+    sgl_test_threadpool_task_t *task;
+    volatile uint32_t spin;
+
+    /* cppcheck-suppress misra-c2012-11.5 */
+    task = (sgl_test_threadpool_task_t *)current;
+    /* cppcheck-suppress misra-c2012-11.5 */
+    if (task == (sgl_test_threadpool_task_t *)cookie) {
+        for (spin = 0U; spin < SGL_TEST_STEAL_SPIN_COUNT; ++spin) {
+        }
+    }
+    task->execution_count++;
+}
+
+/*
+ * Operations are dealt in blocks over the submitter and worker deques.  A
+ * count that is not a multiple of the deque count leaves them uneven and
+ * the slow first operation keeps the submitter busy, so the rest of its
+ * deque has to be stolen.  The preserving attach must still run every
+ * operation once and hand the queue back in its original order.
+ *
+ *   queue: t0(slow) t1 ... t256 -> deques 0..8 -> steal -> t0 t1 ... t256
+ */
+static int sgl_test_threadpool_steals(sgl_threadpool_t *threadpool)
+{
+    static sgl_test_threadpool_task_t tasks[SGL_TEST_STEAL_TASK_COUNT];
+    sgl_queue_t *queue;
+    sgl_size_t task_index;
+    int result;
+
+    result = 0;
+    queue = sgl_queue_create(SGL_TEST_STEAL_TASK_COUNT);
+    if (queue == SGL_NULL) {
+        result = 1;
+    }
+    for (task_index = 0U;
+         (result == 0) && (task_index < SGL_TEST_STEAL_TASK_COUNT);
+         ++task_index) {
+        tasks[task_index].execution_count = 0U;
+        if (sgl_queue_unsafe_enqueue(queue, &tasks[task_index]) !=
+            SGL_QUEUE_IS_NOT_FULL) {
+            result = 1;
+        }
+    }
+    if ((result == 0) &&
+        (sgl_threadpool_attach_routine(
+             threadpool,
+             sgl_test_threadpool_uneven_routine,
+             queue,
+             &tasks[0]) != SGL_SUCCESS)) {
+        result = 1;
+    }
+    if ((result == 0) &&
+        (sgl_queue_get_count(queue) != SGL_TEST_STEAL_TASK_COUNT)) {
+        result = 1;
+    }
+    for (task_index = 0U;
+         (result == 0) && (task_index < SGL_TEST_STEAL_TASK_COUNT);
+         ++task_index) {
+        if ((sgl_queue_dequeue(queue) != &tasks[task_index]) ||
+            (tasks[task_index].execution_count != 1U)) {
+            result = 1;
+        }
+    }
+    sgl_queue_destroy(&queue);
+
+    return result;
+}
+
+static void sgl_test_threadpool_range_routine(
+    sgl_int32_t begin,
+    sgl_int32_t end,
+    void *SGL_RESTRICT cookie)
+{
+    uint32_t *visits;
+    sgl_int32_t index;
+
+    /* cppcheck-suppress misra-c2012-11.5 */
+    visits = (uint32_t *)cookie;
+    if (((begin - SGL_TEST_RANGE_BEGIN) % SGL_TEST_RANGE_GRAIN) != 0) {
+        /* chunks start on grain boundaries; poison the entry to fail */
+        visits[0] += 2U;
+    }
+    for (index = begin; index < end; ++index) {
+        visits[index - SGL_TEST_RANGE_BEGIN]++;
+    }
+}
+
+/*
+ * parallel_for covers [begin, end) once in grain-sized chunks, the last one
+ * short, and rejects empty grains and reversed ranges.  An empty range
+ * succeeds without calling the routine.
+ */
+static int sgl_test_threadpool_parallel_for(sgl_threadpool_t *threadpool)
+{
+    static uint32_t visits[SGL_TEST_RANGE_END - SGL_TEST_RANGE_BEGIN];
+    sgl_int32_t index;
+    int result;
+
+    result = 0;
+    (void)sgl_memset(visits, 0, sizeof(visits));
+    if (sgl_threadpool_parallel_for(
+            threadpool, SGL_TEST_RANGE_BEGIN, SGL_TEST_RANGE_END,
+            SGL_TEST_RANGE_GRAIN, sgl_test_threadpool_range_routine,
+            visits) != SGL_SUCCESS) {
+        result = 1;
+    }
+    if ((result == 0) &&
+        (sgl_threadpool_parallel_for(
+             threadpool, 5, 5, SGL_TEST_RANGE_GRAIN,
+             sgl_test_threadpool_range_routine, visits) != SGL_SUCCESS)) {
+        result = 1;
+    }
+    for (index = 0;
+         (result == 0) && (index < (SGL_TEST_RANGE_END - SGL_TEST_RANGE_BEGIN));
+         ++index) {
+        if (visits[index] != 1U) {
+            result = 1;
+        }
+    }
+    if ((result == 0) &&
+        ((sgl_threadpool_parallel_for(
+              threadpool, 0, 8, 0,
+              sgl_test_threadpool_range_routine, visits) != SGL_ERROR_INVALID_ARGUMENTS) ||
+         (sgl_threadpool_parallel_for(
+              threadpool, 8, 0, 1,
+              sgl_test_threadpool_range_routine, visits) != SGL_ERROR_INVALID_ARGUMENTS) ||
+         (sgl_threadpool_parallel_for(
+              threadpool, 0, 8, 1, SGL_NULL, visits) != SGL_ERROR_INVALID_ARGUMENTS) ||
+         (sgl_threadpool_parallel_for(
+              SGL_NULL, 0, 8, 1,
+              sgl_test_threadpool_range_routine, visits) != SGL_ERROR_INVALID_ARGUMENTS))) {
+        result = 1;
+    }
+
+    return result;
+}
+
+typedef struct {
     sgl_threadpool_t *threadpool;
-    sgl_size_t created_submitters;
+    uint32_t visits[SGL_TEST_NESTED_ROWS];
+    sgl_test_threadpool_task_t tasks[SGL_TEST_TASK_COUNT];
+    int result;
+} sgl_test_nested_item_t;
+
+typedef struct {
+    sgl_osal_atomic_uint32_t calls;
+    sgl_osal_atomic_uint32_t misaligned;
+    uint32_t visits[SGL_TEST_CLAIM_CHUNKS];
+} sgl_test_claim_record_t;
+
+static void sgl_test_threadpool_claim_routine(
+    sgl_int32_t begin,
+    sgl_int32_t end,
+    void *SGL_RESTRICT cookie)
+{
+    sgl_test_claim_record_t *record;
+    sgl_int32_t index;
+
+    /* cppcheck-suppress misra-c2012-11.5 */
+    record = (sgl_test_claim_record_t *)cookie;
+    (void)sgl_osal_atomic_uint32_increment_release(&record->calls);
+    if (((begin % SGL_TEST_RANGE_GRAIN) != 0) ||
+        (((end % SGL_TEST_RANGE_GRAIN) != 0) && (end != SGL_TEST_CLAIM_CHUNKS))) {
+        (void)sgl_osal_atomic_uint32_increment_release(&record->misaligned);
+    }
+    for (index = begin; index < end; ++index) {
+        record->visits[index]++;
+    }
+}
+
+/*
+ * A claim after the first takes a share of what is left rather than one
+ * chunk, so a long range needs fewer routine calls than chunks.  Claims
+ * stay whole grains, with only the end of the range short.
+ */
+static int sgl_test_threadpool_claims(sgl_threadpool_t *threadpool)
+{
+    static sgl_test_claim_record_t record;
+    sgl_int32_t index;
+    int result;
+
+    result = 0;
+    (void)sgl_memset(&record, 0, sizeof(record));
+    if ((sgl_threadpool_parallel_for(
+             threadpool, 0, SGL_TEST_CLAIM_CHUNKS, SGL_TEST_RANGE_GRAIN,
+             sgl_test_threadpool_claim_routine, &record) != SGL_SUCCESS) ||
+        (sgl_osal_atomic_uint32_load_acquire(&record.misaligned) != 0U) ||
+        (sgl_osal_atomic_uint32_load_acquire(&record.calls) >=
+         (uint32_t)((SGL_TEST_CLAIM_CHUNKS + SGL_TEST_RANGE_GRAIN - 1) / SGL_TEST_RANGE_GRAIN))) {
+        result = 1;
+    }
+    for (index = 0; (result == 0) && (index < SGL_TEST_CLAIM_CHUNKS); ++index) {
+        if (record.visits[index] != 1U) {
+            result = 1;
+        }
+    }
+
+    return result;
+}
+
+static sgl_bool_t sgl_test_scratch_is_aligned(const void *memory)
+{
+    /* cppcheck-suppress misra-c2012-11.4 */
+    return (((sgl_uintptr_t)memory & (SGL_TEST_SCRATCH_ALIGNMENT - 1U)) == 0U) ?
+        SGL_TRUE : SGL_FALSE;
+}
+
+/*
+ * Takes a fixed block plus one that grows with the chunk position, so later
+ * chunks outgrow the arena and exercise both the overflow path and the
+ * regrowth at reset.
+ */
+static void sgl_test_threadpool_scratch_routine(
+    sgl_int32_t begin,
+    sgl_int32_t end,
+    sgl_threadpool_scratch_t *SGL_RESTRICT scratch,
+    void *SGL_RESTRICT cookie)
+{
+    uint32_t *visits;
+    sgl_uint8_t *fixed;
+    sgl_uint8_t *growing;
+    sgl_size_t growing_size;
+    sgl_int32_t index;
+
+    /* cppcheck-suppress misra-c2012-11.5 */
+    visits = (uint32_t *)cookie;
+    growing_size = (sgl_size_t)(begin - SGL_TEST_RANGE_BEGIN + 1) * SGL_TEST_SCRATCH_ROW_SIZE;
+    /* cppcheck-suppress misra-c2012-11.5 */
+    fixed = (sgl_uint8_t *)sgl_threadpool_scratch_alloc(scratch, SGL_TEST_SCRATCH_FIXED_SIZE);
+    /* cppcheck-suppress misra-c2012-11.5 */
+    growing = (sgl_uint8_t *)sgl_threadpool_scratch_alloc(scratch, growing_size);
+    if ((fixed == SGL_NULL) || (growing == SGL_NULL) ||
+        (sgl_test_scratch_is_aligned(fixed) == SGL_FALSE) ||
+        (sgl_test_scratch_is_aligned(growing) == SGL_FALSE) ||
+        ((growing >= fixed) && (growing < &fixed[SGL_TEST_SCRATCH_FIXED_SIZE]))) {
+        visits[0] += 2U;
+    }
+    else {
+        /* both blocks are writable to their full size */
+        (void)sgl_memset(fixed, 0xA5, SGL_TEST_SCRATCH_FIXED_SIZE);
+        (void)sgl_memset(growing, 0x5A, growing_size);
+        if (fixed[SGL_TEST_SCRATCH_FIXED_SIZE - 1U] != 0xA5U) {
+            visits[0] += 2U;
+        }
+    }
+    for (index = begin; index < end; ++index) {
+        visits[index - SGL_TEST_RANGE_BEGIN]++;
+    }
+}
+
+/*
+ * parallel_for_scratch hands each chunk cache-line aligned, non-overlapping
+ * scratch memory, covers the range once and rejects a missing routine.
+ */
+static int sgl_test_threadpool_parallel_for_scratch(sgl_threadpool_t *threadpool)
+{
+    static uint32_t visits[SGL_TEST_RANGE_END - SGL_TEST_RANGE_BEGIN];
+    sgl_int32_t index;
+    sgl_uint32_t run;
+    int result;
+
+    result = 0;
+    for (run = 0U; (result == 0) && (run < 2U); ++run) {
+        (void)sgl_memset(visits, 0, sizeof(visits));
+        if (sgl_threadpool_parallel_for_scratch(
+                threadpool, SGL_TEST_RANGE_BEGIN, SGL_TEST_RANGE_END,
+                SGL_TEST_RANGE_GRAIN, sgl_test_threadpool_scratch_routine,
+                visits) != SGL_SUCCESS) {
+            result = 1;
+        }
+        for (index = 0;
+             (result == 0) && (index < (SGL_TEST_RANGE_END - SGL_TEST_RANGE_BEGIN));
+             ++index) {
+            if (visits[index] != 1U) {
+                result = 1;
+            }
+        }
+    }
+    if ((result == 0) &&
+        ((sgl_threadpool_parallel_for_scratch(
+              threadpool, 0, 8, 1, SGL_NULL, visits) != SGL_ERROR_INVALID_ARGUMENTS) ||
+         (sgl_threadpool_scratch_alloc(SGL_NULL, 1U) != SGL_NULL))) {
+        result = 1;
+    }
+
+    return result;
+}
+
+static int sgl_test_threadpool_run_with_options(const sgl_threadpool_options_t *options)
+{
+    sgl_threadpool_cpu_set_t before;
+    sgl_threadpool_cpu_set_t after;
+    sgl_threadpool_t *threadpool;
+    sgl_size_t word;
+    int result;
+
+    result = 0;
+    (void)sgl_osal_thread_get_affinity(before.bits, SGL_THREADPOOL_CPU_SET_WORDS);
+    threadpool = sgl_threadpool_create_with_options(options);
+    (void)sgl_osal_thread_get_affinity(after.bits, SGL_THREADPOOL_CPU_SET_WORDS);
+    if (threadpool == SGL_NULL) {
+        result = 1;
+    }
+    for (word = 0U; word < SGL_THREADPOOL_CPU_SET_WORDS; ++word) {
+        if (before.bits[word] != after.bits[word]) {
+            /* the creating thread must get its own mask back */
+            result = 1;
+        }
+    }
+    if ((result == 0) &&
+        ((sgl_test_threadpool_preserves_queue(threadpool) != 0) ||
+         (sgl_test_threadpool_steals(threadpool) != 0) ||
+         (sgl_test_threadpool_parallel_for(threadpool) != 0))) {
+        result = 1;
+    }
+    if ((threadpool != SGL_NULL) &&
+        (sgl_threadpool_destroy(threadpool) != SGL_SUCCESS)) {
+        result = 1;
+    }
+
+    return result;
+}
+
+/*
+ * Every placement policy runs the scheduling checks on a pool pinned inside
+ * the CPUs this process may use, node-local dispatch included.  Placements
+ * that cannot be satisfied fail creation.
+ */
+static int sgl_test_threadpool_placement(void)
+{
+    sgl_threadpool_cpu_set_t sets[SGL_TEST_PLACED_WORKER_COUNT];
+    sgl_threadpool_cpu_set_t allowed;
+    sgl_threadpool_options_t options;
     sgl_size_t index;
+    sgl_int32_t node;
     int result;
 
     result = 0;
-    created_submitters = 0U;
-    threadpool = SGL_NULL;
-    if (sgl_memory_pool_initialize(
-            sgl_test_memory_pool,
-            sizeof(sgl_test_memory_pool)) != SGL_SUCCESS) {
+    if (sgl_osal_thread_get_affinity(allowed.bits, SGL_THREADPOOL_CPU_SET_WORDS) == SGL_FALSE) {
         result = 1;
     }
-    if (result == 0) {
-        threadpool = sgl_threadpool_create(
-            SGL_TEST_WORKER_COUNT,
-            SGL_TEST_SUBMITTER_COUNT,
-            "threadpool-test");
-        if (threadpool == SGL_NULL) {
+    node = sgl_osal_get_current_numa_node();
+
+    sgl_threadpool_options_init(
+        &options, SGL_TEST_PLACED_WORKER_COUNT, SGL_TEST_SUBMITTER_COUNT, "placed");
+    options.placement = SGL_THREADPOOL_PLACEMENT_COMPACT;
+    options.is_node_local = SGL_TRUE;
+    if ((result == 0) && (sgl_test_threadpool_run_with_options(&options) != 0)) {
+        result = 1;
+    }
+    options.placement = SGL_THREADPOOL_PLACEMENT_SCATTER;
+    if ((result == 0) && (sgl_test_threadpool_run_with_options(&options) != 0)) {
+        result = 1;
+    }
+    options.placement = SGL_THREADPOOL_PLACEMENT_NONE;
+    options.numa_node = (node < 0) ? 0 : node;
+    if ((result == 0) && (sgl_test_threadpool_run_with_options(&options) != 0)) {
+        result = 1;
+    }
+    for (index = 0U; index < SGL_TEST_PLACED_WORKER_COUNT; ++index) {
+        sets[index] = allowed;
+    }
+    options.placement = SGL_THREADPOOL_PLACEMENT_EXPLICIT;
+    options.numa_node = -1;
+    options.cpu_sets = sets;
+    if ((result == 0) && (sgl_test_threadpool_run_with_options(&options) != 0)) {
+        result = 1;
+    }
+
+    /* unsatisfiable placements */
+    (void)sgl_memset(&sets[1], 0, sizeof(sets[1]));
+    if ((result == 0) && (sgl_threadpool_create_with_options(&options) != SGL_NULL)) {
+        result = 1;
+    }
+    options.cpu_sets = SGL_NULL;
+    if ((result == 0) && (sgl_threadpool_create_with_options(&options) != SGL_NULL)) {
+        result = 1;
+    }
+    options.placement = SGL_THREADPOOL_PLACEMENT_COMPACT;
+    options.numa_node = SGL_OSAL_MAX_NUMA_NODES;
+    if ((result == 0) && (sgl_threadpool_create_with_options(&options) != SGL_NULL)) {
+        result = 1;
+    }
+    if ((result == 0) && (sgl_threadpool_create_with_options(SGL_NULL) != SGL_NULL)) {
+        result = 1;
+    }
+
+    return result;
+}
+
+static sgl_test_graph_frame_t *sgl_test_as_graph_frame(void *cookie)
+{
+    /* cppcheck-suppress misra-c2012-11.5 */
+    return (sgl_test_graph_frame_t *)cookie;
+}
+
+static void sgl_test_graph_decode(sgl_int32_t begin, sgl_int32_t end, void *SGL_RESTRICT cookie)
+{
+    sgl_test_graph_frame_t *frame = sgl_test_as_graph_frame(cookie);
+    sgl_int32_t row;
+
+    for (row = begin; row < end; ++row) {
+        frame->planes[row] = (uint32_t)row + 1U;
+    }
+}
+
+static void sgl_test_graph_convert(sgl_int32_t begin, sgl_int32_t end, void *SGL_RESTRICT cookie)
+{
+    sgl_test_graph_frame_t *frame = sgl_test_as_graph_frame(cookie);
+    sgl_int32_t row;
+
+    for (row = begin; row < end; ++row) {
+        frame->converted[row] = frame->planes[row];
+        if (row > 0) {
+            frame->converted[row] += frame->planes[row - 1];
+        }
+        if (row < (SGL_TEST_GRAPH_ROWS - 1)) {
+            frame->converted[row] += frame->planes[row + 1];
+        }
+    }
+}
+
+static void sgl_test_graph_scale(sgl_int32_t begin, sgl_int32_t end, void *SGL_RESTRICT cookie)
+{
+    sgl_test_graph_frame_t *frame = sgl_test_as_graph_frame(cookie);
+    sgl_int32_t row;
+
+    for (row = begin; row < end; ++row) {
+        frame->scaled[row] = frame->converted[row * 2] + frame->converted[(row * 2) + 1];
+    }
+}
+
+static void sgl_test_graph_pack(sgl_int32_t begin, sgl_int32_t end, void *SGL_RESTRICT cookie)
+{
+    sgl_test_graph_frame_t *frame = sgl_test_as_graph_frame(cookie);
+    sgl_int32_t row;
+
+    SGL_UNUSED(begin);
+    SGL_UNUSED(end);
+    frame->total = 0U;
+    for (row = 0; row < (SGL_TEST_GRAPH_ROWS / 2); ++row) {
+        frame->total += frame->scaled[row];
+    }
+}
+
+/*
+ * decode -> convert (3-row window) -> scale (2:1) -> pack (barrier).  A
+ * chunk that ran before the rows it reads were written would leave a wrong
+ * sum behind, and a race on them is what the sanitizer builds look for.
+ */
+static int sgl_test_threadpool_graph(sgl_threadpool_t *threadpool)
+{
+    static sgl_test_graph_frame_t frame;
+    sgl_threadpool_graph_t *graph;
+    sgl_size_t decode;
+    sgl_size_t convert;
+    sgl_size_t scale;
+    sgl_size_t pack;
+    sgl_size_t spare;
+    uint32_t expected;
+    uint32_t run;
+    sgl_int32_t row;
+    int result;
+
+    result = 0;
+    expected = 0U;
+    for (row = 0; row < SGL_TEST_GRAPH_ROWS; ++row) {
+        /* each row is counted once in its own sum and once per neighbor */
+        expected += (uint32_t)row + 1U;
+        expected += ((row > 0) && (row < (SGL_TEST_GRAPH_ROWS - 1))) ?
+            ((uint32_t)row + 1U) * 2U : ((uint32_t)row + 1U);
+    }
+
+    graph = sgl_threadpool_graph_create(4U, 3U);
+    if ((graph == SGL_NULL) ||
+        (sgl_threadpool_graph_add_node(
+             graph, 0, SGL_TEST_GRAPH_ROWS, 16, sgl_test_graph_decode, &frame, &decode) != SGL_SUCCESS) ||
+        (sgl_threadpool_graph_add_node(
+             graph, 0, SGL_TEST_GRAPH_ROWS, 8, sgl_test_graph_convert, &frame, &convert) != SGL_SUCCESS) ||
+        (sgl_threadpool_graph_add_node(
+             graph, 0, SGL_TEST_GRAPH_ROWS / 2, 4, sgl_test_graph_scale, &frame, &scale) != SGL_SUCCESS) ||
+        (sgl_threadpool_graph_add_node(
+             graph, 0, 1, 1, sgl_test_graph_pack, &frame, &pack) != SGL_SUCCESS) ||
+        (sgl_threadpool_graph_add_edge(graph, decode, convert, 1, 1, 1) != SGL_SUCCESS) ||
+        (sgl_threadpool_graph_add_edge(graph, convert, scale, 2, 1, 0) != SGL_SUCCESS) ||
+        (sgl_threadpool_graph_add_edge(
+             graph, scale, pack, 1, 1, SGL_TEST_GRAPH_ROWS) != SGL_SUCCESS)) {
+        result = 1;
+    }
+
+    for (run = 0U; (result == 0) && (run < SGL_TEST_GRAPH_RUN_COUNT); ++run) {
+        (void)sgl_memset(&frame, 0, sizeof(frame));
+        if ((sgl_threadpool_graph_run(threadpool, graph) != SGL_SUCCESS) ||
+            (frame.total != expected)) {
             result = 1;
         }
     }
+
+    /* backward edges, full graphs and bad scales are rejected */
+    if ((result == 0) &&
+        ((sgl_threadpool_graph_add_edge(graph, convert, decode, 1, 1, 0) != SGL_ERROR_INVALID_ARGUMENTS) ||
+         (sgl_threadpool_graph_add_node(
+              graph, 0, 1, 1, sgl_test_graph_pack, &frame, &spare) != SGL_ERROR_INVALID_ARGUMENTS) ||
+         (sgl_threadpool_graph_add_edge(graph, decode, pack, 1, 1, 0) != SGL_ERROR_INVALID_ARGUMENTS) ||
+         (sgl_threadpool_graph_run(SGL_NULL, graph) != SGL_ERROR_INVALID_ARGUMENTS))) {
+        result = 1;
+    }
+    if (graph != SGL_NULL) {
+        (void)sgl_threadpool_graph_destroy(graph);
+    }
+
+    graph = sgl_threadpool_graph_create(2U, 1U);
     if ((result == 0) &&
-        (sgl_test_threadpool_preserves_queue(threadpool) != 0)) {
+        ((graph == SGL_NULL) ||
+         (sgl_threadpool_graph_add_node(
+              graph, 0, 1, 1, sgl_test_graph_pack, &frame, &decode) != SGL_SUCCESS) ||
+         (sgl_threadpool_graph_add_node(
+              graph, 0, 1, 1, sgl_test_graph_pack, &frame, &pack) != SGL_SUCCESS) ||
+         (sgl_threadpool_graph_add_edge(graph, decode, pack, 1, 0, 0) != SGL_ERROR_INVALID_ARGUMENTS) ||
+         (sgl_threadpool_graph_add_edge(graph, decode, pack, -1, 1, 0) != SGL_ERROR_INVALID_ARGUMENTS))) {
+        result = 1;
+    }
+    if (graph != SGL_NULL) {
+        (void)sgl_threadpool_graph_destroy(graph);
+    }
+
+    return result;
+}
+
+/*
+ * Every wait policy must complete the scheduling checks; spinning-only
+ * workers also have to notice destroy without ever parking.  Unknown
+ * policies and spin limits beyond one second fail creation.
+ */
+static int sgl_test_threadpool_wait_policies(void)
+{
+    sgl_threadpool_options_t options;
+    int result;
+
+    result = 0;
+    sgl_threadpool_options_init(
+        &options, SGL_TEST_PLACED_WORKER_COUNT, SGL_TEST_SUBMITTER_COUNT, "waiting");
+    options.wait_policy = SGL_THREADPOOL_WAIT_SPIN;
+    if (sgl_test_threadpool_run_with_options(&options) != 0) {
+        result = 1;
+    }
+    options.wait_policy = SGL_THREADPOOL_WAIT_PARK;
+    if ((result == 0) && (sgl_test_threadpool_run_with_options(&options) != 0)) {
+        result = 1;
+    }
+    options.wait_policy = SGL_THREADPOOL_WAIT_ADAPTIVE;
+    options.spin_limit_us = 0U;
+    if ((result == 0) && (sgl_test_threadpool_run_with_options(&options) != 0)) {
+        result = 1;
+    }
+
+    options.spin_limit_us = SGL_TEST_SPIN_LIMIT_US_INVALID;
+    if ((result == 0) && (sgl_threadpool_create_with_options(&options) != SGL_NULL)) {
+        result = 1;
+    }
+    options.spin_limit_us = 0U;
+    options.wait_policy = (sgl_threadpool_wait_policy_t)(SGL_THREADPOOL_WAIT_PARK + 1);
+    if ((result == 0) && (sgl_threadpool_create_with_options(&options) != SGL_NULL)) {
+        result = 1;
+    }
+
+    return result;
+}
+
+/*
+ * More tasks than max_routine_lists are kept in flight from one thread, so
+ * submission also exercises the in-flight bound.  Every task owns its queue
+ * and operations; wait_all must observe each operation exactly once.
+ *
+ *   submit x6 (blocks while 4 in flight) -> test until done -> wait_all
+ */
+static int sgl_test_threadpool_async(sgl_threadpool_t *threadpool)
+{
+    sgl_test_threadpool_task_t tasks[SGL_TEST_ASYNC_TASK_COUNT][SGL_TEST_TASK_COUNT];
+    sgl_threadpool_task_t *handles[SGL_TEST_ASYNC_TASK_COUNT];
+    sgl_queue_t *queues[SGL_TEST_ASYNC_TASK_COUNT];
+    sgl_queue_t *empty;
+    sgl_threadpool_task_t *empty_handle;
+    sgl_size_t index;
+    sgl_size_t task_index;
+    int result;
+
+    result = 0;
+    for (index = 0U; index < SGL_TEST_ASYNC_TASK_COUNT; ++index) {
+        handles[index] = SGL_NULL;
+        queues[index] = sgl_queue_create(SGL_TEST_TASK_COUNT);
+        if (queues[index] == SGL_NULL) {
+            result = 1;
+        }
+        for (task_index = 0U;
+             (result == 0) && (task_index < SGL_TEST_TASK_COUNT);
+             ++task_index) {
+            tasks[index][task_index].execution_count = 0U;
+            (void)sgl_queue_unsafe_enqueue(queues[index], &tasks[index][task_index]);
+        }
+    }
+
+    for (index = 0U;
+         (result == 0) && (index < SGL_TEST_ASYNC_TASK_COUNT);
+         ++index) {
+        if (((index % 2U) == 0U) &&
+            (sgl_threadpool_submit_routine(
+                 threadpool, sgl_test_threadpool_routine,
+                 queues[index], SGL_NULL, &handles[index]) != SGL_SUCCESS)) {
+            result = 1;
+        }
+        if (((index % 2U) != 0U) &&
+            (sgl_threadpool_submit_routine_consuming(
+                 threadpool, sgl_test_threadpool_routine,
+                 queues[index], SGL_NULL, &handles[index]) != SGL_SUCCESS)) {
+            result = 1;
+        }
+    }
+
+    /* test() never blocks and turns to SGL_SUCCESS once the task drained */
+    if (result == 0) {
+        while (sgl_threadpool_test(handles[0]) == SGL_THREADPOOL_TASK_IS_PENDING) {
+            sgl_osal_yield_thread();
+        }
+        if (sgl_threadpool_test(handles[0]) != SGL_SUCCESS) {
+            result = 1;
+        }
+        if (sgl_threadpool_wait(&handles[0]) != SGL_SUCCESS) {
+            result = 1;
+        }
+        if ((handles[0] != SGL_NULL) ||
+            (sgl_threadpool_wait_all(&handles[1], SGL_TEST_ASYNC_TASK_COUNT - 1U) != SGL_SUCCESS)) {
+            result = 1;
+        }
+    }
+
+    for (index = 0U;
+         (result == 0) && (index < SGL_TEST_ASYNC_TASK_COUNT);
+         ++index) {
+        if ((handles[index] != SGL_NULL) ||
+            (sgl_queue_get_count(queues[index]) !=
+             (((index % 2U) == 0U) ? SGL_TEST_TASK_COUNT : 0U))) {
+            result = 1;
+        }
+        for (task_index = 0U; task_index < SGL_TEST_TASK_COUNT; ++task_index) {
+            if (tasks[index][task_index].execution_count != 1U) {
+                result = 1;
+            }
+        }
+    }
+
+    /* an empty task completes at submission */
+    empty = sgl_queue_create(1U);
+    empty_handle = SGL_NULL;
+    if ((result == 0) &&
+        ((sgl_threadpool_submit_routine(
+              threadpool, sgl_test_threadpool_routine,
+              empty, SGL_NULL, &empty_handle) != SGL_SUCCESS) ||
+         (sgl_threadpool_test(empty_handle) != SGL_SUCCESS) ||
+         (sgl_threadpool_wait(&empty_handle) != SGL_SUCCESS))) {
+        result = 1;
+    }
+    if (sgl_threadpool_test(SGL_NULL) != SGL_ERROR_INVALID_ARGUMENTS) {
+        result = 1;
+    }
+    sgl_queue_destroy(&empty);
+    for (index = 0U; index < SGL_TEST_ASYNC_TASK_COUNT; ++index) {
+        sgl_queue_destroy(&queues[index]);
+    }
+
+    return result;
+}
+
+static void sgl_test_threadpool_participant_routine(
+    sgl_int32_t begin,
+    sgl_int32_t end,
+    sgl_threadpool_scratch_t *SGL_RESTRICT scratch,
+    void *SGL_RESTRICT cookie)
+{
+    sgl_threadpool_scratch_t **participants;
+    sgl_int32_t index;
+
+    /* cppcheck-suppress misra-c2012-11.5 */
+    participants = (sgl_threadpool_scratch_t **)cookie;
+    for (index = begin; index < end; ++index) {
+        participants[index] = scratch;
+    }
+}
+
+/*
+ * Each participant brings its own scratch arena, so the distinct arenas seen
+ * by a range bound the number of threads that ran it: the submitter plus
+ * the active workers.
+ */
+static int sgl_test_threadpool_count_participants(
+    sgl_threadpool_t *threadpool,
+    sgl_size_t *count)
+{
+    static sgl_threadpool_scratch_t *participants[SGL_TEST_RESIZE_CHUNKS];
+    sgl_int32_t index;
+    sgl_int32_t other;
+    sgl_bool_t is_new;
+    int result;
+
+    result = 0;
+    *count = 0U;
+    (void)sgl_memset(participants, 0, sizeof(participants));
+    if (sgl_threadpool_parallel_for_scratch(
+            threadpool, 0, SGL_TEST_RESIZE_CHUNKS, 1,
+            sgl_test_threadpool_participant_routine, participants) != SGL_SUCCESS) {
+        result = 1;
+    }
+    for (index = 0; (result == 0) && (index < SGL_TEST_RESIZE_CHUNKS); ++index) {
+        is_new = (participants[index] != SGL_NULL) ? SGL_TRUE : SGL_FALSE;
+        for (other = 0; other < index; ++other) {
+            if (participants[other] == participants[index]) {
+                is_new = SGL_FALSE;
+            }
+        }
+        if (is_new == SGL_TRUE) {
+            (*count)++;
+        }
+    }
+
+    return result;
+}
+
+/*
+ * The active worker count moves within [1, max_threads] without recreating
+ * the pool.  Work queued before a shrink still completes, and a shrunk pool
+ * runs ranges on no more than its active workers plus the submitter.
+ *
+ *   create 2 of 4 -> shrink to 1 -> grow to 4 -> invalid counts rejected
+ */
+static int sgl_test_threadpool_resize(void)
+{
+    sgl_threadpool_options_t options;
+    sgl_threadpool_t *threadpool;
+    sgl_size_t participants;
+    int result;
+
+    result = 0;
+    sgl_threadpool_options_init(&options, 2U, SGL_TEST_SUBMITTER_COUNT, "resizing");
+    options.max_threads = SGL_TEST_RESIZE_MAX_WORKERS;
+    threadpool = sgl_threadpool_create_with_options(&options);
+    if ((threadpool == SGL_NULL) ||
+        (sgl_threadpool_get_num_threads(threadpool) != 2U)) {
+        result = 1;
+    }
+
+    if ((result == 0) &&
+        ((sgl_threadpool_set_num_threads(threadpool, 1U) != SGL_SUCCESS) ||
+         (sgl_threadpool_get_num_threads(threadpool) != 1U) ||
+         (sgl_test_threadpool_async(threadpool) != 0) ||
+         (sgl_test_threadpool_parallel_for(threadpool) != 0) ||
+         (sgl_test_threadpool_count_participants(threadpool, &participants) != 0) ||
+         (participants > 2U))) {
+        result = 1;
+    }
+    if ((result == 0) &&
+        ((sgl_threadpool_set_num_threads(threadpool, SGL_TEST_RESIZE_MAX_WORKERS) != SGL_SUCCESS) ||
+         (sgl_threadpool_get_num_threads(threadpool) != SGL_TEST_RESIZE_MAX_WORKERS) ||
+         (sgl_test_threadpool_steals(threadpool) != 0) ||
+         (sgl_test_threadpool_count_participants(threadpool, &participants) != 0) ||
+         (participants > (SGL_TEST_RESIZE_MAX_WORKERS + 1U)))) {
+        result = 1;
+    }
+    if ((result == 0) &&
+        ((sgl_threadpool_set_num_threads(threadpool, 0U) != SGL_ERROR_INVALID_ARGUMENTS) ||
+         (sgl_threadpool_set_num_threads(
+              threadpool, SGL_TEST_RESIZE_MAX_WORKERS + 1U) != SGL_ERROR_INVALID_ARGUMENTS) ||
+         (sgl_threadpool_set_num_threads(SGL_NULL, 1U) != SGL_ERROR_INVALID_ARGUMENTS) ||
+         (sgl_threadpool_get_num_threads(threadpool) != SGL_TEST_RESIZE_MAX_WORKERS))) {
+        result = 1;
+    }
+    if (threadpool != SGL_NULL) {
+        (void)sgl_threadpool_destroy(threadpool);
+    }
+
+    /* the quota may cap the count but never below one worker */
+    options.follow_cpu_quota = SGL_TRUE;
+    threadpool = sgl_threadpool_create_with_options(&options);
+    if ((result == 0) &&
+        ((threadpool == SGL_NULL) ||
+         (sgl_threadpool_get_num_threads(threadpool) == 0U) ||
+         (sgl_threadpool_get_num_threads(threadpool) > 2U) ||
+         (sgl_test_threadpool_parallel_for(threadpool) != 0))) {
+        result = 1;
+    }
+    if (threadpool != SGL_NULL) {
+        (void)sgl_threadpool_destroy(threadpool);
+    }
+
+    options.follow_cpu_quota = SGL_FALSE;
+    options.max_threads = 1U;
+    if ((result == 0) && (sgl_threadpool_create_with_options(&options) != SGL_NULL)) {
+        result = 1;
+    }
+
+    return result;
+}
+
+static void sgl_test_threadpool_gated_routine(void *current, void *cookie)
+{
+    sgl_test_threadpool_task_t *task;
+    sgl_osal_atomic_uint32_t *gate;
+
+    /* cppcheck-suppress misra-c2012-11.5 */
+    task = (sgl_test_threadpool_task_t *)current;
+    /* cppcheck-suppress misra-c2012-11.5 */
+    gate = (sgl_osal_atomic_uint32_t *)cookie;
+    while (sgl_osal_atomic_uint32_load_acquire(gate) == 0U) {
+        sgl_osal_yield_thread();
+    }
+    task->execution_count++;
+}
+
+/*
+ * NORMAL routines held at a gate fill the NORMAL budget and every worker.
+ * A HIGH attach must still go through on its own budget and complete
+ * before the gate opens; the NORMAL routines then finish as usual.
+ *
+ *   NORMAL x max_routine_lists (gated) | HIGH attach -> done | open gate
+ */
+static int sgl_test_threadpool_priorities(sgl_threadpool_t *threadpool)
+{
+    sgl_test_threadpool_task_t gated[SGL_TEST_SUBMITTER_COUNT][SGL_TEST_TASK_COUNT];
+    sgl_test_threadpool_task_t urgent[SGL_TEST_TASK_COUNT];
+    sgl_threadpool_task_t *handles[SGL_TEST_SUBMITTER_COUNT];
+    sgl_queue_t *queues[SGL_TEST_SUBMITTER_COUNT];
+    sgl_queue_t *urgent_queue;
+    sgl_threadpool_t *lane;
+    sgl_osal_atomic_uint32_t gate;
+    sgl_size_t index;
+    sgl_size_t task_index;
+    int result;
+
+    result = 0;
+    gate = 0U;
+    lane = sgl_threadpool_create_lane(threadpool, SGL_THREADPOOL_PRIORITY_HIGH);
+    urgent_queue = sgl_queue_create(SGL_TEST_TASK_COUNT);
+    if ((lane == SGL_NULL) || (urgent_queue == SGL_NULL) ||
+        (sgl_threadpool_get_num_threads(lane) != sgl_threadpool_get_num_threads(threadpool))) {
+        result = 1;
+    }
+    for (task_index = 0U; (result == 0) && (task_index < SGL_TEST_TASK_COUNT); ++task_index) {
+        urgent[task_index].execution_count = 0U;
+        (void)sgl_queue_unsafe_enqueue(urgent_queue, &urgent[task_index]);
+    }
+    for (index = 0U; index < SGL_TEST_SUBMITTER_COUNT; ++index) {
+        handles[index] = SGL_NULL;
+        queues[index] = sgl_queue_create(SGL_TEST_TASK_COUNT);
+        if (queues[index] == SGL_NULL) {
+            result = 1;
+        }
+        for (task_index = 0U;
+             (result == 0) && (task_index < SGL_TEST_TASK_COUNT);
+             ++task_index) {
+            gated[index][task_index].execution_count = 0U;
+            (void)sgl_queue_unsafe_enqueue(queues[index], &gated[index][task_index]);
+        }
+        if ((result == 0) &&
+            (sgl_threadpool_submit_routine(
+                 threadpool, sgl_test_threadpool_gated_routine,
+                 queues[index], &gate, &handles[index]) != SGL_SUCCESS)) {
+            result = 1;
+        }
+    }
+
+    if ((result == 0) &&
+        (sgl_threadpool_attach_routine(
+             lane, sgl_test_threadpool_routine, urgent_queue, SGL_NULL) != SGL_SUCCESS)) {
+        result = 1;
+    }
+    for (task_index = 0U; task_index < SGL_TEST_TASK_COUNT; ++task_index) {
+        if (urgent[task_index].execution_count != 1U) {
+            result = 1;
+        }
+    }
+    for (index = 0U; index < SGL_TEST_SUBMITTER_COUNT; ++index) {
+        if ((handles[index] != SGL_NULL) &&
+            (sgl_threadpool_test(handles[index]) != SGL_THREADPOOL_TASK_IS_PENDING)) {
+            result = 1;
+        }
+    }
+
+    (void)sgl_osal_atomic_uint32_increment_release(&gate);
+    for (index = 0U; index < SGL_TEST_SUBMITTER_COUNT; ++index) {
+        if ((handles[index] != SGL_NULL) &&
+            (sgl_threadpool_wait(&handles[index]) != SGL_SUCCESS)) {
+            result = 1;
+        }
+        for (task_index = 0U;
+             (queues[index] != SGL_NULL) && (task_index < SGL_TEST_TASK_COUNT);
+             ++task_index) {
+            if (gated[index][task_index].execution_count != 1U) {
+                result = 1;
+            }
+        }
+        sgl_queue_destroy(&queues[index]);
+    }
+
+    /* a lane is accepted wherever its pool is */
+    if ((result == 0) &&
+        ((sgl_test_threadpool_async(lane) != 0) ||
+         (sgl_test_threadpool_parallel_for(lane) != 0) ||
+         (sgl_test_threadpool_parallel_for_scratch(lane) != 0))) {
+        result = 1;
+    }
+    if ((sgl_threadpool_create_lane(SGL_NULL, SGL_THREADPOOL_PRIORITY_HIGH) != SGL_NULL) ||
+        (sgl_threadpool_create_lane(
+             threadpool, (sgl_threadpool_priority_t)SGL_TEST_PRIORITY_INVALID) != SGL_NULL)) {
+        result = 1;
+    }
+    if ((lane != SGL_NULL) && (sgl_threadpool_destroy(lane) != SGL_SUCCESS)) {
+        result = 1;
+    }
+    sgl_queue_destroy(&urgent_queue);
+
+    return result;
+}
+
+static void sgl_test_threadpool_row_routine(
+    sgl_int32_t begin,
+    sgl_int32_t end,
+    void *SGL_RESTRICT cookie)
+{
+    uint32_t *visits;
+    sgl_int32_t index;
+
+    /* cppcheck-suppress misra-c2012-11.5 */
+    visits = (uint32_t *)cookie;
+    for (index = begin; index < end; ++index) {
+        visits[index]++;
+    }
+}
+
+/* An outer operation: a parallel_for and a submit + wait on the same pool. */
+static void sgl_test_threadpool_nested_routine(void *current, void *cookie)
+{
+    sgl_test_nested_item_t *item;
+    sgl_threadpool_t *threadpool;
+    sgl_threadpool_task_t *handle;
+    sgl_queue_t *queue;
+    sgl_size_t index;
+
+    SGL_UNUSED_PARAM(cookie);
+    /* cppcheck-suppress misra-c2012-11.5 */
+    item = (sgl_test_nested_item_t *)current;
+    threadpool = item->threadpool;
+    handle = SGL_NULL;
+    if (sgl_threadpool_parallel_for(
+            threadpool, 0, SGL_TEST_NESTED_ROWS, 1,
+            sgl_test_threadpool_row_routine, item->visits) != SGL_SUCCESS) {
+        item->result = 1;
+    }
+    queue = sgl_queue_create(SGL_TEST_TASK_COUNT);
+    if (queue == SGL_NULL) {
+        item->result = 1;
+    }
+    for (index = 0U; (queue != SGL_NULL) && (index < SGL_TEST_TASK_COUNT); ++index) {
+        (void)sgl_queue_unsafe_enqueue(queue, &item->tasks[index]);
+    }
+    if ((queue != SGL_NULL) &&
+        ((sgl_threadpool_submit_routine(
+              threadpool, sgl_test_threadpool_routine,
+              queue, SGL_NULL, &handle) != SGL_SUCCESS) ||
+         (sgl_threadpool_wait(&handle) != SGL_SUCCESS))) {
+        item->result = 1;
+    }
+    sgl_queue_destroy(&queue);
+}
+
+static int sgl_test_threadpool_run_nested(sgl_threadpool_t *threadpool, sgl_bool_t is_async)
+{
+    static sgl_test_nested_item_t items[SGL_TEST_NESTED_ITEMS];
+    sgl_threadpool_task_t *handle;
+    sgl_queue_t *queue;
+    sgl_size_t index;
+    sgl_size_t task_index;
+    sgl_int32_t row;
+    int result;
+
+    result = 0;
+    handle = SGL_NULL;
+    (void)sgl_memset(items, 0, sizeof(items));
+    queue = sgl_queue_create(SGL_TEST_NESTED_ITEMS);
+    if (queue == SGL_NULL) {
+        result = 1;
+    }
+    for (index = 0U; (result == 0) && (index < SGL_TEST_NESTED_ITEMS); ++index) {
+        items[index].threadpool = threadpool;
+        (void)sgl_queue_unsafe_enqueue(queue, &items[index]);
+    }
+    if ((result == 0) && (is_async == SGL_TRUE) &&
+        ((sgl_threadpool_submit_routine(
+              threadpool, sgl_test_threadpool_nested_routine,
+              queue, SGL_NULL, &handle) != SGL_SUCCESS) ||
+         (sgl_threadpool_wait(&handle) != SGL_SUCCESS))) {
+        result = 1;
+    }
+    if ((result == 0) && (is_async == SGL_FALSE) &&
+        (sgl_threadpool_attach_routine(
+             threadpool, sgl_test_threadpool_nested_routine,
+             queue, SGL_NULL) != SGL_SUCCESS)) {
+        result = 1;
+    }
+    for (index = 0U; (result == 0) && (index < SGL_TEST_NESTED_ITEMS); ++index) {
+        if (items[index].result != 0) {
+            result = 1;
+        }
+        for (row = 0; row < SGL_TEST_NESTED_ROWS; ++row) {
+            if (items[index].visits[row] != 1U) {
+                result = 1;
+            }
+        }
+        for (task_index = 0U; task_index < SGL_TEST_TASK_COUNT; ++task_index) {
+            if (items[index].tasks[task_index].execution_count != 1U) {
+                result = 1;
+            }
+        }
+    }
+    sgl_queue_destroy(&queue);
+
+    return result;
+}
+
+/*
+ * Routines may submit to the pool they run on.  A pool with one worker and
+ * a budget of one routine can only finish when the nested work skips the
+ * budget and the worker runs its own submission while waiting for it.
+ *
+ *   outer op (worker) -> parallel_for + submit/wait -> same pool
+ */
+static int sgl_test_threadpool_nested(sgl_threadpool_t *threadpool)
+{
+    sgl_threadpool_t *single;
+    int result;
+
+    result = 0;
+    single = sgl_threadpool_create(1U, 1U, "nested");
+    if ((single == SGL_NULL) ||
+        (sgl_test_threadpool_run_nested(single, SGL_TRUE) != 0) ||
+        (sgl_test_threadpool_run_nested(single, SGL_FALSE) != 0)) {
+        result = 1;
+    }
+    if (single != SGL_NULL) {
+        (void)sgl_threadpool_destroy(single);
+    }
+    if ((result == 0) &&
+        ((sgl_test_threadpool_run_nested(threadpool, SGL_TRUE) != 0) ||
+         (sgl_test_threadpool_run_nested(threadpool, SGL_FALSE) != 0))) {
+        result = 1;
+    }
+
+    return result;
+}
+
+typedef struct {
+    sgl_threadpool_token_t *token;
+    sgl_osal_atomic_uint32_t calls;
+    uint32_t visits[SGL_TEST_CANCEL_CHUNKS];
+} sgl_test_cancel_record_t;
+
+/* Counts the rows and fires the token from inside the run. */
+static void sgl_test_threadpool_cancel_routine(
+    sgl_int32_t begin,
+    sgl_int32_t end,
+    void *SGL_RESTRICT cookie)
+{
+    sgl_test_cancel_record_t *record;
+    sgl_int32_t index;
+
+    /* cppcheck-suppress misra-c2012-11.5 */
+    record = (sgl_test_cancel_record_t *)cookie;
+    (void)sgl_osal_atomic_uint32_fetch_add_relaxed(&record->calls, 1U);
+    for (index = begin; index < end; ++index) {
+        record->visits[index]++;
+    }
+    (void)sgl_threadpool_token_cancel(record->token);
+}
+
+static uint32_t sgl_test_cancel_visited(const sgl_test_cancel_record_t *record)
+{
+    uint32_t total;
+    sgl_size_t index;
+
+    total = 0U;
+    for (index = 0U; index < (sgl_size_t)SGL_TEST_CANCEL_CHUNKS; ++index) {
+        total += record->visits[index];
+    }
+
+    return total;
+}
+
+/*
+ * A token on a lane stops what is submitted through it: a fired or expired
+ * token skips every operation, one fired from inside a routine leaves the
+ * run partial with the count of what ran, and a graph whose first stage
+ * cancels returns instead of waiting for the skipped rows.
+ */
+static int sgl_test_threadpool_cancellation(sgl_threadpool_t *threadpool)
+{
+    static sgl_test_cancel_record_t record;
+    sgl_test_threadpool_task_t tasks[SGL_TEST_TASK_COUNT];
+    sgl_threadpool_graph_t *graph;
+    sgl_threadpool_token_t *token;
+    sgl_threadpool_task_t *handle;
+    sgl_threadpool_t *lane;
+    sgl_queue_t *queue;
+    sgl_size_t index;
+    sgl_size_t stage;
+    int result;
+
+    result = 0;
+    handle = SGL_NULL;
+    graph = SGL_NULL;
+    (void)sgl_memset(&record, 0, sizeof(record));
+    (void)sgl_memset(tasks, 0, sizeof(tasks));
+    lane = sgl_threadpool_create_lane(threadpool, SGL_THREADPOOL_PRIORITY_NORMAL);
+    token = sgl_threadpool_token_create();
+    queue = sgl_queue_create(SGL_TEST_TASK_COUNT);
+    if ((lane == SGL_NULL) || (token == SGL_NULL) || (queue == SGL_NULL)) {
+        result = 1;
+    }
+    for (index = 0U; (result == 0) && (index < SGL_TEST_TASK_COUNT); ++index) {
+        (void)sgl_queue_unsafe_enqueue(queue, &tasks[index]);
+    }
+    if ((result == 0) &&
+        ((sgl_threadpool_set_token(threadpool, token) != SGL_ERROR_INVALID_ARGUMENTS) ||
+         (sgl_threadpool_set_token(SGL_NULL, token) != SGL_ERROR_INVALID_ARGUMENTS) ||
+         (sgl_threadpool_token_cancel(SGL_NULL) != SGL_ERROR_INVALID_ARGUMENTS) ||
+         (sgl_threadpool_token_is_cancelled(token) != SGL_FALSE) ||
+         (sgl_threadpool_set_token(lane, token) != SGL_SUCCESS) ||
+         (sgl_threadpool_get_token(lane) != token) ||
+         (sgl_threadpool_get_token(threadpool) != SGL_NULL))) {
+        result = 1;
+    }
+
+    /* fired before submission: nothing runs */
+    record.token = token;
+    if ((result == 0) &&
+        ((sgl_threadpool_token_cancel(token) != SGL_SUCCESS) ||
+         (sgl_threadpool_parallel_for(
+              lane, 0, SGL_TEST_CANCEL_CHUNKS, 1,
+              sgl_test_threadpool_cancel_routine, &record) != SGL_THREADPOOL_CANCELLED) ||
+         (sgl_threadpool_attach_routine(
+              lane, sgl_test_threadpool_routine, queue, SGL_NULL) != SGL_THREADPOOL_CANCELLED) ||
+         (sgl_threadpool_submit_routine(
+              lane, sgl_test_threadpool_routine, queue, SGL_NULL, &handle) != SGL_SUCCESS) ||
+         (sgl_threadpool_wait(&handle) != SGL_THREADPOOL_CANCELLED) ||
+         (sgl_osal_atomic_uint32_load_relaxed(&record.calls) != 0U) ||
+         (sgl_threadpool_token_get_completed(token) != 0U) ||
+         (sgl_queue_get_count(queue) != SGL_TEST_TASK_COUNT))) {
+        result = 1;
+    }
+    for (index = 0U; (result == 0) && (index < SGL_TEST_TASK_COUNT); ++index) {
+        if (tasks[index].execution_count != 0U) {
+            result = 1;
+        }
+    }
+
+    /* a deadline in the past counts as fired */
+    if ((result == 0) &&
+        ((sgl_threadpool_token_reset(token) != SGL_SUCCESS) ||
+         (sgl_threadpool_token_set_deadline(token, 1U) != SGL_SUCCESS) ||
+         (sgl_threadpool_token_is_cancelled(token) != SGL_TRUE) ||
+         (sgl_threadpool_attach_routine(
+              lane, sgl_test_threadpool_routine, queue, SGL_NULL) != SGL_THREADPOOL_CANCELLED) ||
+         (sgl_threadpool_token_get_completed(token) != 0U) ||
+         (sgl_threadpool_token_set_deadline(token, 0U) != SGL_SUCCESS))) {
+        result = 1;
+    }
+
+    /* fired by the first chunk: the rest of the range is skipped */
+    if ((result == 0) &&
+        ((sgl_threadpool_token_reset(token) != SGL_SUCCESS) ||
+         (sgl_threadpool_parallel_for(
+              lane, 0, SGL_TEST_CANCEL_CHUNKS, 1,
+              sgl_test_threadpool_cancel_routine, &record) != SGL_THREADPOOL_CANCELLED) ||
+         (sgl_threadpool_token_get_completed(token) == 0U) ||
+         (sgl_threadpool_token_get_completed(token) >= (sgl_size_t)SGL_TEST_CANCEL_CHUNKS) ||
+         (sgl_threadpool_token_get_completed(token) != (sgl_size_t)sgl_test_cancel_visited(&record)))) {
+        result = 1;
+    }
+
+    /* the first stage cancels; the barrier stage must not wait for it */
+    if (result == 0) {
+        graph = sgl_threadpool_graph_create(2U, 1U);
+        if ((graph == SGL_NULL) ||
+            (sgl_threadpool_graph_add_node(
+                 graph, 0, SGL_TEST_CANCEL_CHUNKS, 1,
+                 sgl_test_threadpool_cancel_routine, &record, &stage) != SGL_SUCCESS) ||
+            (sgl_threadpool_graph_add_node(
+                 graph, 0, SGL_TEST_CANCEL_CHUNKS, 1,
+                 sgl_test_threadpool_cancel_routine, &record, &stage) != SGL_SUCCESS) ||
+            (sgl_threadpool_graph_add_edge(
+                 graph, 0U, 1U, 1, 1, SGL_TEST_CANCEL_CHUNKS) != SGL_SUCCESS) ||
+            (sgl_threadpool_token_reset(token) != SGL_SUCCESS) ||
+            (sgl_threadpool_graph_run(lane, graph) != SGL_THREADPOOL_CANCELLED) ||
+            (sgl_threadpool_token_get_completed(token) >= (2U * (sgl_size_t)SGL_TEST_CANCEL_CHUNKS))) {
+            result = 1;
+        }
+    }
+
+    /* reset: everything runs again */
+    (void)sgl_memset(record.visits, 0, sizeof(record.visits));
+    if ((result == 0) &&
+        ((sgl_threadpool_token_reset(token) != SGL_SUCCESS) ||
+         (sgl_threadpool_set_token(lane, SGL_NULL) != SGL_SUCCESS) ||
+         (sgl_threadpool_parallel_for(
+              lane, 0, SGL_TEST_CANCEL_CHUNKS, 1,
+              sgl_test_threadpool_cancel_routine, &record) != SGL_SUCCESS) ||
+         (sgl_test_cancel_visited(&record) != (uint32_t)SGL_TEST_CANCEL_CHUNKS) ||
+         (sgl_threadpool_token_reset(token) != SGL_SUCCESS) ||
+         (sgl_threadpool_set_token(lane, token) != SGL_SUCCESS) ||
+         (sgl_threadpool_attach_routine(
+              lane, sgl_test_threadpool_routine, queue, SGL_NULL) != SGL_SUCCESS) ||
+         (sgl_threadpool_token_get_completed(token) != SGL_TEST_TASK_COUNT))) {
+        result = 1;
+    }
+    for (index = 0U; (result == 0) && (index < SGL_TEST_TASK_COUNT); ++index) {
+        if (tasks[index].execution_count != 1U) {
+            result = 1;
+        }
+    }
+
+    if (graph != SGL_NULL) {
+        (void)sgl_threadpool_graph_destroy(graph);
+    }
+    sgl_queue_destroy(&queue);
+    if (lane != SGL_NULL) {
+        (void)sgl_threadpool_destroy(lane);
+    }
+    if (token != SGL_NULL) {
+        (void)sgl_threadpool_token_destroy(token);
+    }
+
+    return result;
+}
+
+/*
+ * Every operation and chunk is counted once, by a worker or by the
+ * submitter, and every attach and parallel_for is one dispatch.  A lane
+ * reads the same counters as its pool.
+ */
+static int sgl_test_threadpool_stats(sgl_threadpool_t *threadpool)
+{
+    static uint32_t visits[SGL_TEST_RANGE_END - SGL_TEST_RANGE_BEGIN];
+    sgl_test_threadpool_task_t tasks[SGL_TEST_TASK_COUNT];
+    sgl_threadpool_stats_t before;
+    sgl_threadpool_stats_t after;
+    sgl_threadpool_stats_t lane_stats;
+    sgl_threadpool_t *lane;
+    sgl_queue_t *queue;
+    sgl_uint64_t operations;
+    sgl_uint64_t chunks;
+    sgl_size_t index;
+    int result;
+
+    result = 0;
+    chunks = (sgl_uint64_t)(((SGL_TEST_RANGE_END - SGL_TEST_RANGE_BEGIN) +
+                             SGL_TEST_RANGE_GRAIN - 1) / SGL_TEST_RANGE_GRAIN);
+    (void)sgl_memset(tasks, 0, sizeof(tasks));
+    (void)sgl_memset(visits, 0, sizeof(visits));
+    lane = sgl_threadpool_create_lane(threadpool, SGL_THREADPOOL_PRIORITY_HIGH);
+    queue = sgl_queue_create(SGL_TEST_TASK_COUNT);
+    if ((lane == SGL_NULL) || (queue == SGL_NULL)) {
+        result = 1;
+    }
+    for (index = 0U; (result == 0) && (index < SGL_TEST_TASK_COUNT); ++index) {
+        (void)sgl_queue_unsafe_enqueue(queue, &tasks[index]);
+    }
+    if ((result == 0) &&
+        ((sgl_threadpool_get_stats(threadpool, &before) != SGL_SUCCESS) ||
+         (sgl_threadpool_attach_routine(
+              threadpool, sgl_test_threadpool_routine, queue, SGL_NULL) != SGL_SUCCESS) ||
+         (sgl_threadpool_parallel_for(
+              lane, SGL_TEST_RANGE_BEGIN, SGL_TEST_RANGE_END, SGL_TEST_RANGE_GRAIN,
+              sgl_test_threadpool_range_routine, visits) != SGL_SUCCESS) ||
+         (sgl_threadpool_get_stats(threadpool, &after) != SGL_SUCCESS) ||
+         (sgl_threadpool_get_stats(lane, &lane_stats) != SGL_SUCCESS))) {
+        result = 1;
+    }
+    if (result == 0) {
+        /* a multi-chunk claim counts each of its chunks */
+        operations = (after.submitter_operations - before.submitter_operations) +
+                     (after.worker_operations - before.worker_operations);
+        if ((operations != ((sgl_uint64_t)SGL_TEST_TASK_COUNT + chunks)) ||
+            ((after.dispatches - before.dispatches) != 2U) ||
+            ((after.completion_waits - before.completion_waits) > 2U) ||
+            (after.completion_wait_ns < before.completion_wait_ns) ||
+            (lane_stats.dispatches < after.dispatches) ||
+            (lane_stats.worker_operations < after.worker_operations)) {
+            result = 1;
+        }
+    }
+    if ((result == 0) &&
+        ((sgl_threadpool_get_stats(SGL_NULL, &after) != SGL_ERROR_INVALID_ARGUMENTS) ||
+         (sgl_threadpool_get_stats(threadpool, SGL_NULL) != SGL_ERROR_INVALID_ARGUMENTS))) {
+        result = 1;
+    }
+    sgl_queue_destroy(&queue);
+    if (lane != SGL_NULL) {
+        (void)sgl_threadpool_destroy(lane);
+    }
+
+    return result;
+}
+
+int main(void)
+{
+    sgl_test_submitter_context_t contexts[SGL_TEST_SUBMITTER_COUNT];
+    sgl_osal_thread_t submitters[SGL_TEST_SUBMITTER_COUNT];
+    sgl_threadpool_t *threadpool;
+    sgl_size_t created_submitters;
+    sgl_size_t index;
+    int result;
+
+    result = 0;
+    created_submitters = 0U;
+    threadpool = SGL_NULL;
+    if (sgl_memory_pool_initialize(
+            sgl_test_memory_pool,
+            sizeof(sgl_test_memory_pool)) != SGL_SUCCESS) {
+        result = 1;
+    }
+    if (result == 0) {
+        threadpool = sgl_threadpool_create(
+            SGL_TEST_WORKER_COUNT,
+            SGL_TEST_SUBMITTER_COUNT,
+            "threadpool-test");
+        if (threadpool == SGL_NULL) {
+            result = 1;
+        }
+    }
+    if ((result == 0) &&
+        (sgl_test_threadpool_preserves_queue(threadpool) != 0)) {
+        result = 1;
+    }
+    if ((result == 0) &&
+        (sgl_test_threadpool_async(threadpool) != 0)) {
+        result = 1;
+    }
+    if ((result == 0) &&
+        (sgl_test_threadpool_steals(threadpool) != 0)) {
+        result = 1;
+    }
+    if ((result == 0) &&
+        (sgl_test_threadpool_parallel_for(threadpool) != 0)) {
+        result = 1;
+    }
+    if ((result == 0) &&
+        (sgl_test_threadpool_parallel_for_scratch(threadpool) != 0)) {
+        result = 1;
+    }
+    if ((result == 0) &&
+        (sgl_test_threadpool_claims(threadpool) != 0)) {
+        result = 1;
+    }
+    if ((result == 0) &&
+        (sgl_test_threadpool_graph(threadpool) != 0)) {
+        result = 1;
+    }
+    if ((result == 0) &&
+        (sgl_test_threadpool_placement() != 0)) {
+        result = 1;
+    }
+    if ((result == 0) &&
+        (sgl_test_threadpool_wait_policies() != 0)) {
+        result = 1;
+    }
+    if ((result == 0) &&
+        (sgl_test_threadpool_resize() != 0)) {
+        result = 1;
+    }
+    if ((result == 0) &&
+        (sgl_test_threadpool_priorities(threadpool) != 0)) {
+        result = 1;
+    }
+    if ((result == 0) &&
+        (sgl_test_threadpool_nested(threadpool) != 0)) {
+        result = 1;
+    }
+    if ((result == 0) &&
+        (sgl_test_threadpool_cancellation(threadpool) != 0)) {
+        result = 1;
+    }
+    if ((result == 0) &&
+        (sgl_test_threadpool_stats(threadpool) != 0)) {
         result = 1;
     }
 
@@ -210,7 +1601,7 @@ int main(void)
     if (result == 0) {
         (void)printf(
             "threadpool stress: %u operations passed\n",
-            (unsigned int)(SGL_TEST_TASK_COUNT +
+            (unsigned int)(SGL_TEST_TASK_COUNT + SGL_TEST_STEAL_TASK_COUNT +
                 (SGL_TEST_SUBMITTER_COUNT * SGL_TEST_ITERATION_COUNT *
                  SGL_TEST_TASK_COUNT)));
     }
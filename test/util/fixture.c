@@ -0,0 +1,35 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright (c) 2025 Dylan Hong
+ *
+ * This code is released under the MIT License.
+ * For conditions of distribution and use, see the LICENSE file.
+ */
+#include <stdint.h>
+#include <sgl-core.h>
+#include "util.h"
+
+/*
+ * Kept apart from the PNG helpers so the pool storage is only linked into
+ * the regression apps that call sgl_test_pool_initialize().
+ */
+#define SGL_TEST_POOL_SIZE              (24U * 1024U * 1024U)
+
+static SGL_ALIGNED(64) unsigned char sgl_test_pool[SGL_TEST_POOL_SIZE];
+
+sgl_result_t sgl_test_pool_initialize(void)
+{
+    return sgl_memory_pool_initialize(sgl_test_pool, sizeof(sgl_test_pool));
+}
+
+sgl_uint8_t sgl_test_pattern_byte(int32_t x, int32_t y, int32_t channel)
+{
+    uint32_t mixed;
+
+    mixed = ((uint32_t)x * 0x9E37U) ^ ((uint32_t)y * 0x85EBU) ^
+        ((uint32_t)channel * 0xC2B2U);
+    mixed ^= mixed >> 7U;
+
+    return (sgl_uint8_t)mixed;
+}
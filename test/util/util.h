@@ -23,4 +23,10 @@ int32_t sgl_test_save_data(const char *path, uint8_t *data, int32_t datasize);
 
 uint64_t sgl_test_get_timestamp_us(uint64_t start_us);
 
+/* Shared regression fixture: a 64-byte aligned sgl memory pool. */
+sgl_result_t sgl_test_pool_initialize(void);
+
+/* Deterministic, well-mixed byte for pixel (x, y) and channel. */
+sgl_uint8_t sgl_test_pattern_byte(int32_t x, int32_t y, int32_t channel);
+
 #endif  /* !UTIL_H_ */
@@ -0,0 +1,603 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright (c) 2025 Dylan Hong
+ *
+ * This code is released under the MIT License.
+ * For conditions of distribution and use, see the LICENSE file.
+ */
+#include <stdint.h>
+#include <stdio.h>
+#include <sgl-core.h>
+#include "util.h"
+
+#define TEST_MAX_BPP                (5)
+#define TEST_WORKER_COUNT           (4U)
+#define TEST_BORDER                 (0xA5U)
+
+/* cos(30 deg) and sin(30 deg) in Q16.16 */
+#define TEST_COS30                  (56756)
+#define TEST_SIN30                  (32768)
+
+typedef struct {
+    int32_t width;
+    int32_t height;
+} test_size_t;
+
+typedef struct {
+    const char *name;
+    int32_t matrix[9];
+} test_matrix_t;
+
+/*
+ * Per-pixel reference for a Q16.16 source position: explicit bounds checks
+ * and the documented Q11 bilinear blend with the last row and column clamped.
+ */
+static sgl_uint8_t test_reference_bilinear(
+    const sgl_uint8_t *src, int32_t width, int32_t height, int32_t bpp,
+    int64_t sx, int64_t sy, int32_t channel)
+{
+    int32_t x0;
+    int32_t y0;
+    int32_t x1;
+    int32_t y1;
+    int32_t wx;
+    int32_t wy;
+    int32_t top;
+    int32_t bottom;
+    sgl_uint8_t value;
+
+    if ((sx < 0) || (sy < 0) ||
+        (sx > ((int64_t)(width - 1) * SGL_WARP_ONE)) ||
+        (sy > ((int64_t)(height - 1) * SGL_WARP_ONE))) {
+        value = (sgl_uint8_t)TEST_BORDER;
+    }
+    else {
+        x0 = (int32_t)(sx / SGL_WARP_ONE);
+        y0 = (int32_t)(sy / SGL_WARP_ONE);
+        x1 = (x0 < (width - 1)) ? (x0 + 1) : x0;
+        y1 = (y0 < (height - 1)) ? (y0 + 1) : y0;
+        wx = (int32_t)((sx % SGL_WARP_ONE) >> 5);
+        wy = (int32_t)((sy % SGL_WARP_ONE) >> 5);
+        top = ((int32_t)src[((y0 * width) + x0) * bpp + channel] * (2048 - wx)) +
+              ((int32_t)src[((y0 * width) + x1) * bpp + channel] * wx);
+        bottom = ((int32_t)src[((y1 * width) + x0) * bpp + channel] * (2048 - wx)) +
+                 ((int32_t)src[((y1 * width) + x1) * bpp + channel] * wx);
+        value = (sgl_uint8_t)(((top * (2048 - wy)) + (bottom * wy) + (1 << 21)) >> 22);
+    }
+
+    return value;
+}
+
+/* Nearest reference: round to the closest pixel center, border outside. */
+static sgl_uint8_t test_reference_nearest(
+    const sgl_uint8_t *src, int32_t width, int32_t height, int32_t bpp,
+    int64_t sx, int64_t sy, int32_t channel)
+{
+    sgl_uint8_t value;
+
+    sx += SGL_WARP_ONE / 2;
+    sy += SGL_WARP_ONE / 2;
+    if ((sx < 0) || (sy < 0) ||
+        (sx >= ((int64_t)width * SGL_WARP_ONE)) ||
+        (sy >= ((int64_t)height * SGL_WARP_ONE))) {
+        value = (sgl_uint8_t)TEST_BORDER;
+    }
+    else {
+        value = src[((((int32_t)(sy / SGL_WARP_ONE) * width) + (int32_t)(sx / SGL_WARP_ONE)) * bpp) + channel];
+    }
+
+    return value;
+}
+
+/* Affine reference: full matrix multiply per pixel. */
+static sgl_uint8_t test_reference_sample(
+    const sgl_uint8_t *src, int32_t width, int32_t height, int32_t bpp,
+    const int32_t matrix[6], int32_t x, int32_t y, int32_t channel)
+{
+    int64_t sx;
+    int64_t sy;
+
+    sx = ((int64_t)matrix[0] * x) + ((int64_t)matrix[1] * y) + matrix[2];
+    sy = ((int64_t)matrix[3] * x) + ((int64_t)matrix[4] * y) + matrix[5];
+
+    return test_reference_bilinear(src, width, height, bpp, sx, sy, channel);
+}
+
+static int64_t test_floor_div(int64_t n, int64_t d)
+{
+    int64_t q;
+
+    q = n / d;
+    if (((n % d) != 0) && (n < 0)) {
+        q -= 1;
+    }
+
+    return q;
+}
+
+/*
+ * Perspective reference following the documented scheme: exact projection
+ * at knots every 16 pixels, linear steps in between, exact per-pixel
+ * projection when a knot lies behind the horizon.  Returns 0 when the pixel
+ * takes the border.
+ */
+static int test_reference_position(
+    const int32_t matrix[9], int32_t d_width, int32_t x, int32_t y,
+    int64_t *sx, int64_t *sy)
+{
+    int64_t h[2][3];
+    int32_t knots[2];
+    int32_t k;
+    int32_t r;
+    int result;
+
+    knots[0] = (x / 16) * 16;
+    knots[1] = ((knots[0] + 16) < d_width) ? (knots[0] + 16) : d_width;
+    for (k = 0; k < 2; ++k) {
+        for (r = 0; r < 3; ++r) {
+            h[k][r] = ((int64_t)matrix[(r * 3) + 0] * knots[k]) +
+                      ((int64_t)matrix[(r * 3) + 1] * y) + matrix[(r * 3) + 2];
+        }
+    }
+
+    result = 1;
+    if ((h[0][2] > 0) && (h[1][2] > 0)) {
+        int64_t x0 = test_floor_div(h[0][0] * SGL_WARP_ONE, h[0][2]);
+        int64_t y0 = test_floor_div(h[0][1] * SGL_WARP_ONE, h[0][2]);
+        int64_t x1 = test_floor_div(h[1][0] * SGL_WARP_ONE, h[1][2]);
+        int64_t y1 = test_floor_div(h[1][1] * SGL_WARP_ONE, h[1][2]);
+
+        *sx = x0 + ((x - knots[0]) * test_floor_div(x1 - x0, knots[1] - knots[0]));
+        *sy = y0 + ((x - knots[0]) * test_floor_div(y1 - y0, knots[1] - knots[0]));
+    }
+    else {
+        int64_t w = ((int64_t)matrix[6] * x) + ((int64_t)matrix[7] * y) + matrix[8];
+
+        if (w > 0) {
+            *sx = test_floor_div(
+                (((int64_t)matrix[0] * x) + ((int64_t)matrix[1] * y) + matrix[2]) * SGL_WARP_ONE, w);
+            *sy = test_floor_div(
+                (((int64_t)matrix[3] * x) + ((int64_t)matrix[4] * y) + matrix[5]) * SGL_WARP_ONE, w);
+        }
+        else {
+            result = 0;
+        }
+    }
+
+    return result;
+}
+
+static void test_make_matrices(
+    test_matrix_t *matrices, int32_t width, int32_t height)
+{
+    int32_t cx;
+    int32_t cy;
+
+    cx = (width - 1) * (SGL_WARP_ONE / 2);
+    cy = (height - 1) * (SGL_WARP_ONE / 2);
+
+    matrices[0].name = "identity";
+    matrices[0].matrix[0] = SGL_WARP_ONE;
+    matrices[0].matrix[1] = 0;
+    matrices[0].matrix[2] = 0;
+    matrices[0].matrix[3] = 0;
+    matrices[0].matrix[4] = SGL_WARP_ONE;
+    matrices[0].matrix[5] = 0;
+
+    matrices[1].name = "translate";
+    matrices[1].matrix[0] = SGL_WARP_ONE;
+    matrices[1].matrix[1] = 0;
+    matrices[1].matrix[2] = (SGL_WARP_ONE * 7) / 2;
+    matrices[1].matrix[3] = 0;
+    matrices[1].matrix[4] = SGL_WARP_ONE;
+    matrices[1].matrix[5] = -((SGL_WARP_ONE * 9) / 4);
+
+    /* rotate by 30 degrees about the image center */
+    matrices[2].name = "rotate-30";
+    matrices[2].matrix[0] = TEST_COS30;
+    matrices[2].matrix[1] = -TEST_SIN30;
+    matrices[2].matrix[2] = cx - (int32_t)((((int64_t)TEST_COS30 * cx) - ((int64_t)TEST_SIN30 * cy)) / SGL_WARP_ONE);
+    matrices[2].matrix[3] = TEST_SIN30;
+    matrices[2].matrix[4] = TEST_COS30;
+    matrices[2].matrix[5] = cy - (int32_t)((((int64_t)TEST_SIN30 * cx) + ((int64_t)TEST_COS30 * cy)) / SGL_WARP_ONE);
+
+    /* mirrored, sheared and scaled: negative steps in both axes */
+    matrices[3].name = "mirror-shear";
+    matrices[3].matrix[0] = -((SGL_WARP_ONE * 3) / 4);
+    matrices[3].matrix[1] = SGL_WARP_ONE / 5;
+    matrices[3].matrix[2] = (width - 1) * SGL_WARP_ONE;
+    matrices[3].matrix[3] = -(SGL_WARP_ONE / 7);
+    matrices[3].matrix[4] = -((SGL_WARP_ONE * 5) / 4);
+    matrices[3].matrix[5] = (height - 1) * SGL_WARP_ONE;
+
+    /* degenerate: every row samples one source column */
+    matrices[4].name = "column";
+    matrices[4].matrix[0] = 0;
+    matrices[4].matrix[1] = 0;
+    matrices[4].matrix[2] = (width * SGL_WARP_ONE) / 3;
+    matrices[4].matrix[3] = 0;
+    matrices[4].matrix[4] = SGL_WARP_ONE / 2;
+    matrices[4].matrix[5] = SGL_WARP_ONE / 3;
+
+    /* every row starts and ends beyond the source: an empty interior run */
+    matrices[5].name = "offscreen";
+    matrices[5].matrix[0] = SGL_WARP_ONE;
+    matrices[5].matrix[1] = 0;
+    matrices[5].matrix[2] = -((width + 40) * SGL_WARP_ONE);
+    matrices[5].matrix[3] = 0;
+    matrices[5].matrix[4] = SGL_WARP_ONE;
+    matrices[5].matrix[5] = 0;
+}
+
+static int test_warp_case(
+    sgl_threadpool_t *pool, const test_matrix_t *matrix,
+    int32_t s_width, int32_t s_height, int32_t d_width, int32_t d_height,
+    int32_t bpp)
+{
+    sgl_uint8_t *src;
+    sgl_uint8_t *dst;
+    size_t s_size;
+    size_t d_size;
+    int32_t x;
+    int32_t y;
+    int32_t c;
+    int result;
+
+    result = 0;
+    s_size = (size_t)s_width * (size_t)s_height * (size_t)bpp;
+    d_size = (size_t)d_width * (size_t)d_height * (size_t)bpp;
+    src = (sgl_uint8_t *)sgl_malloc(s_size);
+    dst = (sgl_uint8_t *)sgl_malloc(d_size);
+    if ((src == SGL_NULL) || (dst == SGL_NULL)) {
+        result = 1;
+    }
+
+    if (result == 0) {
+        for (y = 0; y < s_height; ++y) {
+            for (x = 0; x < s_width; ++x) {
+                for (c = 0; c < bpp; ++c) {
+                    src[(((size_t)y * (size_t)s_width) + (size_t)x) * (size_t)bpp + (size_t)c] =
+                        sgl_test_pattern_byte(x, y, c);
+                }
+            }
+        }
+        (void)sgl_memset(dst, 0x5A, d_size);
+        if (sgl_warp_affine(pool, dst, d_width, d_height, src, s_width, s_height,
+                            bpp, matrix->matrix, (sgl_uint8_t)TEST_BORDER) != SGL_SUCCESS) {
+            result = 1;
+        }
+    }
+
+    for (y = 0; (result == 0) && (y < d_height); ++y) {
+        for (x = 0; (result == 0) && (x < d_width); ++x) {
+            for (c = 0; c < bpp; ++c) {
+                if (dst[(((size_t)y * (size_t)d_width) + (size_t)x) * (size_t)bpp + (size_t)c] !=
+                    test_reference_sample(src, s_width, s_height, bpp, matrix->matrix, x, y, c)) {
+                    result = 1;
+                }
+            }
+        }
+    }
+
+    if (result != 0) {
+        printf("FAIL %s %dx%d->%dx%d bpp=%d pool=%s\n",
+               matrix->name, s_width, s_height, d_width, d_height, bpp,
+               (pool != SGL_NULL) ? "yes" : "no");
+    }
+    SGL_SAFE_FREE(src);
+    SGL_SAFE_FREE(dst);
+
+    return result;
+}
+
+static void test_make_homographies(
+    test_matrix_t *matrices, int32_t width, int32_t height)
+{
+    int32_t i;
+
+    for (i = 0; i < 3; ++i) {
+        matrices[i].matrix[0] = SGL_WARP_ONE * 4;
+        matrices[i].matrix[1] = 0;
+        matrices[i].matrix[2] = 0;
+        matrices[i].matrix[3] = 0;
+        matrices[i].matrix[4] = SGL_WARP_ONE * 4;
+        matrices[i].matrix[5] = 0;
+        matrices[i].matrix[6] = 0;
+        matrices[i].matrix[7] = 0;
+        matrices[i].matrix[8] = SGL_WARP_ONE * 4;
+    }
+
+    /* keystone: rows shrink toward the bottom of the destination */
+    matrices[0].name = "keystone";
+    matrices[0].matrix[1] = SGL_WARP_ONE;
+    matrices[0].matrix[7] = 3000;
+
+    /* general projective map with translation and shear */
+    matrices[1].name = "projective";
+    matrices[1].matrix[0] = (SGL_WARP_ONE * 7) / 2;
+    matrices[1].matrix[1] = -(SGL_WARP_ONE / 3);
+    matrices[1].matrix[2] = width * SGL_WARP_ONE;
+    matrices[1].matrix[3] = SGL_WARP_ONE / 2;
+    matrices[1].matrix[4] = (SGL_WARP_ONE * 9) / 2;
+    matrices[1].matrix[5] = -(height * SGL_WARP_ONE);
+    matrices[1].matrix[6] = 700;
+    matrices[1].matrix[7] = -1100;
+
+    /* the horizon w == 0 crosses the destination */
+    matrices[2].name = "horizon";
+    matrices[2].matrix[6] = 9000;
+    matrices[2].matrix[7] = -14000;
+    matrices[2].matrix[8] = SGL_WARP_ONE * 2;
+}
+
+static int test_perspective_case(
+    sgl_threadpool_t *pool, const test_matrix_t *matrix,
+    int32_t s_width, int32_t s_height, int32_t d_width, int32_t d_height,
+    int32_t bpp, int nearest)
+{
+    sgl_uint8_t *src;
+    sgl_uint8_t *dst;
+    sgl_uint8_t expected;
+    size_t s_size;
+    size_t d_size;
+    int64_t sx;
+    int64_t sy;
+    int32_t x;
+    int32_t y;
+    int32_t c;
+    sgl_result_t status;
+    int result;
+
+    result = 0;
+    s_size = (size_t)s_width * (size_t)s_height * (size_t)bpp;
+    d_size = (size_t)d_width * (size_t)d_height * (size_t)bpp;
+    src = (sgl_uint8_t *)sgl_malloc(s_size);
+    dst = (sgl_uint8_t *)sgl_malloc(d_size);
+    if ((src == SGL_NULL) || (dst == SGL_NULL)) {
+        result = 1;
+    }
+
+    if (result == 0) {
+        for (y = 0; y < s_height; ++y) {
+            for (x = 0; x < s_width; ++x) {
+                for (c = 0; c < bpp; ++c) {
+                    src[(((size_t)y * (size_t)s_width) + (size_t)x) * (size_t)bpp + (size_t)c] =
+                        sgl_test_pattern_byte(x, y, c);
+                }
+            }
+        }
+        (void)sgl_memset(dst, 0x5A, d_size);
+        if (nearest != 0) {
+            status = sgl_warp_perspective_nearest(
+                pool, dst, d_width, d_height, src, s_width, s_height,
+                bpp, matrix->matrix, (sgl_uint8_t)TEST_BORDER);
+        }
+        else {
+            status = sgl_warp_perspective_bilinear(
+                pool, dst, d_width, d_height, src, s_width, s_height,
+                bpp, matrix->matrix, (sgl_uint8_t)TEST_BORDER);
+        }
+        if (status != SGL_SUCCESS) {
+            result = 1;
+        }
+    }
+
+    for (y = 0; (result == 0) && (y < d_height); ++y) {
+        for (x = 0; (result == 0) && (x < d_width); ++x) {
+            int inside = test_reference_position(matrix->matrix, d_width, x, y, &sx, &sy);
+
+            for (c = 0; c < bpp; ++c) {
+                if (inside == 0) {
+                    expected = (sgl_uint8_t)TEST_BORDER;
+                }
+                else if (nearest != 0) {
+                    expected = test_reference_nearest(src, s_width, s_height, bpp, sx, sy, c);
+                }
+                else {
+                    expected = test_reference_bilinear(src, s_width, s_height, bpp, sx, sy, c);
+                }
+                if (dst[(((size_t)y * (size_t)d_width) + (size_t)x) * (size_t)bpp + (size_t)c] != expected) {
+                    result = 1;
+                }
+            }
+        }
+    }
+
+    if (result != 0) {
+        printf("FAIL perspective-%s %s %dx%d->%dx%d bpp=%d pool=%s\n",
+               (nearest != 0) ? "nearest" : "bilinear",
+               matrix->name, s_width, s_height, d_width, d_height, bpp,
+               (pool != SGL_NULL) ? "yes" : "no");
+    }
+    SGL_SAFE_FREE(src);
+    SGL_SAFE_FREE(dst);
+
+    return result;
+}
+
+/* An affine homography must reproduce sgl_warp_affine() byte for byte. */
+static int test_perspective_affine_case(
+    sgl_threadpool_t *pool, const test_matrix_t *matrix,
+    int32_t width, int32_t height, int32_t bpp)
+{
+    sgl_uint8_t *src;
+    sgl_uint8_t *affine;
+    sgl_uint8_t *perspective;
+    int32_t homography[9];
+    size_t size;
+    size_t index;
+    int32_t i;
+    int result;
+
+    result = 0;
+    size = (size_t)width * (size_t)height * (size_t)bpp;
+    src = (sgl_uint8_t *)sgl_malloc(size);
+    affine = (sgl_uint8_t *)sgl_malloc(size);
+    perspective = (sgl_uint8_t *)sgl_malloc(size);
+    if ((src == SGL_NULL) || (affine == SGL_NULL) || (perspective == SGL_NULL)) {
+        result = 1;
+    }
+
+    if (result == 0) {
+        for (index = 0U; index < size; ++index) {
+            src[index] = sgl_test_pattern_byte((int32_t)index, 3, 1);
+        }
+        for (i = 0; i < 6; ++i) {
+            homography[i] = matrix->matrix[i];
+        }
+        homography[6] = 0;
+        homography[7] = 0;
+        homography[8] = SGL_WARP_ONE;
+        if ((sgl_warp_affine(pool, affine, width, height, src, width, height,
+                             bpp, matrix->matrix, (sgl_uint8_t)TEST_BORDER) != SGL_SUCCESS) ||
+            (sgl_warp_perspective_bilinear(pool, perspective, width, height, src, width, height,
+                                           bpp, homography, (sgl_uint8_t)TEST_BORDER) != SGL_SUCCESS)) {
+            result = 1;
+        }
+    }
+    for (index = 0U; (result == 0) && (index < size); ++index) {
+        if (affine[index] != perspective[index]) {
+            result = 1;
+        }
+    }
+
+    if (result != 0) {
+        printf("FAIL perspective-affine %s %dx%d bpp=%d pool=%s\n",
+               matrix->name, width, height, bpp, (pool != SGL_NULL) ? "yes" : "no");
+    }
+    SGL_SAFE_FREE(src);
+    SGL_SAFE_FREE(affine);
+    SGL_SAFE_FREE(perspective);
+
+    return result;
+}
+
+static int test_warp_invalid_arguments(void)
+{
+    static const int32_t identity[6] = { SGL_WARP_ONE, 0, 0, 0, SGL_WARP_ONE, 0 };
+    static const int32_t homography[9] = {
+        SGL_WARP_ONE, 0, 0, 0, SGL_WARP_ONE, 0, 0, 0, SGL_WARP_ONE
+    };
+    sgl_uint8_t buffer[16];
+    int result;
+
+    result = 0;
+    if (sgl_warp_affine(SGL_NULL, SGL_NULL, 2, 2, buffer, 2, 2, 1, identity, 0U) !=
+        SGL_ERROR_INVALID_ARGUMENTS) {
+        result = 1;
+    }
+    if (sgl_warp_affine(SGL_NULL, &buffer[8], 2, 2, buffer, 2, 2, 1, SGL_NULL, 0U) !=
+        SGL_ERROR_INVALID_ARGUMENTS) {
+        result = 1;
+    }
+    if (sgl_warp_affine(SGL_NULL, &buffer[8], 2, 0, buffer, 2, 2, 1, identity, 0U) !=
+        SGL_ERROR_INVALID_ARGUMENTS) {
+        result = 1;
+    }
+    if (sgl_warp_affine(SGL_NULL, &buffer[8], 2, 2, buffer, 40000, 2, 1, identity, 0U) !=
+        SGL_ERROR_INVALID_ARGUMENTS) {
+        result = 1;
+    }
+    if (sgl_warp_perspective_nearest(SGL_NULL, &buffer[8], 2, 2, buffer, 2, 2, 1, SGL_NULL, 0U) !=
+        SGL_ERROR_INVALID_ARGUMENTS) {
+        result = 1;
+    }
+    if (sgl_warp_perspective_bilinear(SGL_NULL, &buffer[8], 2, 2, buffer, 2, 2, 0, homography, 0U) !=
+        SGL_ERROR_INVALID_ARGUMENTS) {
+        result = 1;
+    }
+
+    return result;
+}
+
+static int test_warp_all(sgl_threadpool_t *pool)
+{
+    static const test_size_t sizes[] = {
+        { 1, 1 }, { 2, 2 }, { 1, 7 }, { 17, 13 }, { 203, 151 }
+    };
+    test_matrix_t matrices[6];
+    test_matrix_t homographies[3];
+    int32_t size_index;
+    int32_t matrix_index;
+    int32_t bpp;
+    int32_t width;
+    int32_t height;
+    int result;
+
+    result = 0;
+    for (size_index = 0;
+         size_index < (int32_t)(sizeof(sizes) / sizeof(sizes[0]));
+         ++size_index) {
+        width = sizes[size_index].width;
+        height = sizes[size_index].height;
+        test_make_matrices(matrices, width, height);
+        for (matrix_index = 0;
+             matrix_index < (int32_t)(sizeof(matrices) / sizeof(matrices[0]));
+             ++matrix_index) {
+            for (bpp = 1; bpp <= TEST_MAX_BPP; ++bpp) {
+                /* same size, and a wider and shorter destination */
+                result |= test_warp_case(
+                    pool, &matrices[matrix_index], width, height, width, height, bpp);
+                result |= test_warp_case(
+                    pool, &matrices[matrix_index], width, height,
+                    width + 11, (height / 2) + 1, bpp);
+                result |= test_perspective_affine_case(
+                    pool, &matrices[matrix_index], width, height, bpp);
+            }
+        }
+
+        test_make_homographies(homographies, width, height);
+        for (matrix_index = 0;
+             matrix_index < (int32_t)(sizeof(homographies) / sizeof(homographies[0]));
+             ++matrix_index) {
+            for (bpp = 1; bpp <= TEST_MAX_BPP; ++bpp) {
+                result |= test_perspective_case(
+                    pool, &homographies[matrix_index], width, height, width, height, bpp, 1);
+                result |= test_perspective_case(
+                    pool, &homographies[matrix_index], width, height, width, height, bpp, 0);
+                result |= test_perspective_case(
+                    pool, &homographies[matrix_index], width, height,
+                    width + 11, (height / 2) + 1, bpp, 0);
+            }
+        }
+    }
+
+    return result;
+}
+
+int main(void)
+{
+    sgl_threadpool_t *pool;
+    int result;
+
+    result = 0;
+    pool = SGL_NULL;
+    if (sgl_test_pool_initialize() != SGL_SUCCESS) {
+        result = 1;
+    }
+    if (result == 0) {
+        result |= test_warp_invalid_arguments();
+        result |= test_warp_all(SGL_NULL);
+    }
+#if defined(SGL_CFG_HAS_THREAD)
+    if (result == 0) {
+        pool = sgl_threadpool_create(
+            TEST_WORKER_COUNT, SGL_THREADPOOL_DEFAULT_MAX_ROUTINE_LISTS, "warp-test");
+        if (pool == SGL_NULL) {
+            result = 1;
+        }
+        else {
+            result |= test_warp_all(pool);
+            (void)sgl_threadpool_destroy(pool);
+        }
+    }
+#endif  /* !SGL_CFG_HAS_THREAD */
+    if (sgl_memory_pool_deinitialize() != SGL_SUCCESS) {
+        result = 1;
+    }
+
+    printf("warp test %s\n", (result == 0) ? "passed" : "failed");
+
+    return result;
+}